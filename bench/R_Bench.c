@@ -0,0 +1,122 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "R_Bench.h"
+
+volatile size_t R_Bench_sink;
+
+struct R_Bench {
+  const char* filter;
+  size_t samples;
+  size_t warmup;
+  size_t max_size;
+  FILE* output;
+  size_t reported;
+};
+
+static uint64_t R_Bench_now(void) {
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return (uint64_t)time.tv_sec*1000000000ull + (uint64_t)time.tv_nsec;
+}
+
+static int R_Bench_compareDoubles(const void* a, const void* b) {
+  double left = *(const double*)a;
+  double right = *(const double*)b;
+  return (left > right) - (left < right);
+}
+
+R_Bench* R_Bench_create(int argc, char** argv) {
+  R_Bench* bench = calloc(1, sizeof(R_Bench));
+  if (bench == NULL) return NULL;
+  bench->samples = 11;
+  bench->warmup = 2;
+  bench->max_size = 10000;
+  bench->output = stdout;
+  for (int i=1; i<argc; i++) {
+    const char* value = i+1 < argc ? argv[i+1] : NULL;
+    if (strcmp(argv[i], "--filter") == 0 && value) bench->filter = value, i++;
+    else if (strcmp(argv[i], "--samples") == 0 && value) bench->samples = strtoul(value, NULL, 10), i++;
+    else if (strcmp(argv[i], "--warmup") == 0 && value) bench->warmup = strtoul(value, NULL, 10), i++;
+    else if (strcmp(argv[i], "--max-size") == 0 && value) bench->max_size = strtoul(value, NULL, 10), i++;
+    else if (strcmp(argv[i], "--output") == 0 && value) {
+      bench->output = fopen(value, "w");
+      if (bench->output == NULL) {
+        fprintf(stderr, "Can't open %s\n", value);
+        free(bench);
+        return NULL;
+      }
+      i++;
+    }
+    else {
+      fprintf(stderr, "Unknown option %s\n", argv[i]);
+      free(bench);
+      return NULL;
+    }
+  }
+  if (bench->samples == 0) bench->samples = 1;
+  fprintf(bench->output, "{\"samples\":%zu,\"warmup\":%zu,\"benchmarks\":[", bench->samples, bench->warmup);
+  return bench;
+}
+
+int R_Bench_destroy(R_Bench* bench) {
+  if (bench == NULL) return 1;
+  fprintf(bench->output, "\n]}\n");
+  if (bench->output != stdout) fclose(bench->output);
+  free(bench);
+  return 0;
+}
+
+bool R_Bench_includesSize(R_Bench* bench, size_t size) {
+  return size <= bench->max_size;
+}
+
+static double R_Bench_sample(R_Bench_Setup setup, R_Bench_Run run, R_Bench_Teardown teardown, size_t size) {
+  void* context = setup ? setup(size) : NULL;
+  uint64_t begin = R_Bench_now();
+  run(context, size);
+  uint64_t end = R_Bench_now();
+  if (teardown) teardown(context);
+  return (double)(end - begin);
+}
+
+void R_Bench_measure(R_Bench* bench, const char* name, size_t size, size_t operations, R_Bench_Setup setup, R_Bench_Run run, R_Bench_Teardown teardown) {
+  if (bench == NULL || run == NULL || !R_Bench_includesSize(bench, size)) return;
+  if (bench->filter != NULL && strstr(name, bench->filter) == NULL) return;
+  if (operations == 0) operations = 1;
+
+  for (size_t i=0; i<bench->warmup; i++) R_Bench_sample(setup, run, teardown, size);
+  double* samples = malloc(bench->samples*sizeof(double));
+  if (samples == NULL) return;
+  for (size_t i=0; i<bench->samples; i++) samples[i] = R_Bench_sample(setup, run, teardown, size) / operations;
+  qsort(samples, bench->samples, sizeof(double), R_Bench_compareDoubles);
+
+  double median = samples[bench->samples/2];
+  size_t p99_index = (bench->samples*99 + 99)/100;
+  double p99 = samples[(p99_index ? p99_index : 1) - 1];
+  fprintf(bench->output, "%s\n  {\"name\":\"%s\",\"size\":%zu,\"operations\":%zu,\"median_ns_per_op\":%.3f,\"p99_ns_per_op\":%.3f,\"min_ns_per_op\":%.3f}",
+    bench->reported++ ? "," : "", name, size, operations, median, p99, samples[0]);
+  fflush(bench->output);
+  fprintf(stderr, "%-36s %8zu %12.1f ns/op (p99 %.1f)\n", name, size, median, p99);
+  free(samples);
+}
+
+int main(int argc, char** argv) {
+  R_Bench* bench = R_Bench_create(argc, argv);
+  if (bench == NULL) return 1;
+  R_List_bench(bench);
+  R_Dictionary_bench(bench);
+  R_MutableString_bench(bench);
+  R_MutableData_bench(bench);
+  R_Events_bench(bench);
+  R_Json_bench(bench);
+  R_PersistentDictionary_bench(bench);
+  R_ConcurrentDictionary_bench(bench);
+  R_Queue_bench(bench);
+  R_ThreadPool_bench(bench);
+  R_OrderedDictionary_bench(bench);
+  R_Trie_bench(bench);
+  return R_Bench_destroy(bench);
+}
@@ -0,0 +1,76 @@
+#ifndef R_Bench_h
+#define R_Bench_h
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/*  R_Bench
+    A small benchmark harness. Each case is run a few times to warm up, then timed for a number of samples. The
+   median and 99th percentile are reported in nanoseconds per operation.
+ */
+typedef struct R_Bench R_Bench;
+
+/*  R_Bench_Setup
+    Builds the state a sample needs, outside of the timed region. size is the case's size parameter.
+ */
+typedef void* (*R_Bench_Setup)(size_t size);
+
+/*  R_Bench_Run
+    The timed region. Must perform the number of operations given to R_Bench_measure.
+ */
+typedef void (*R_Bench_Run)(void* context, size_t size);
+
+/*  R_Bench_Teardown
+    Frees whatever R_Bench_Setup made, outside of the timed region.
+ */
+typedef void (*R_Bench_Teardown)(void* context);
+
+/*  R_Bench_sink
+    Cases store results here so the compiler can't drop the work being timed.
+ */
+extern volatile size_t R_Bench_sink;
+
+/*  R_Bench_create
+    Reads the command line. Options are:
+      --filter <text>   only run cases whose name contains text
+      --samples <n>     timed samples per case (default 11)
+      --warmup <n>      untimed runs per case (default 2)
+      --max-size <n>    skip sizes above n (default 10000)
+      --output <file>   write the JSON report to a file instead of stdout
+ */
+R_Bench* R_Bench_create(int argc, char** argv);
+
+/*  R_Bench_destroy
+    Finishes the JSON report and frees the harness. Returns the process exit code.
+ */
+int R_Bench_destroy(R_Bench* bench);
+
+/*  R_Bench_includesSize
+    Returns false if the size is above --max-size. Cases should skip building state for sizes that won't run.
+ */
+bool R_Bench_includesSize(R_Bench* bench, size_t size);
+
+/*  R_Bench_measure
+    Runs and reports one case. name and size identify the case, operations is how many operations one call to run
+   performs. setup and teardown may be NULL.
+ */
+void R_Bench_measure(R_Bench* bench, const char* name, size_t size, size_t operations, R_Bench_Setup setup, R_Bench_Run run, R_Bench_Teardown teardown);
+
+/*  Suites
+    Each container has its own suite file.
+ */
+void R_List_bench(R_Bench* bench);
+void R_Dictionary_bench(R_Bench* bench);
+void R_MutableString_bench(R_Bench* bench);
+void R_MutableData_bench(R_Bench* bench);
+void R_Events_bench(R_Bench* bench);
+void R_Json_bench(R_Bench* bench);
+void R_PersistentDictionary_bench(R_Bench* bench);
+void R_ConcurrentDictionary_bench(R_Bench* bench);
+void R_Queue_bench(R_Bench* bench);
+void R_ThreadPool_bench(R_Bench* bench);
+void R_OrderedDictionary_bench(R_Bench* bench);
+void R_Trie_bench(R_Bench* bench);
+
+#endif /* R_Bench_h */
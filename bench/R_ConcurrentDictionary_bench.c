@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "R_OS.h"
+#include "R_Dictionary.h"
+#include "R_ConcurrentDictionary.h"
+#include "R_Bench.h"
+
+/*  Keys in the dictionary, and lookups each thread makes per sample. The size of each case is its thread count, so
+   ns/op falling as the size grows means reads scale.
+ */
+#define R_ConcurrentDictionary_bench_KEYS 100
+#define R_ConcurrentDictionary_bench_LOOKUPS 100000
+
+typedef struct {
+  R_ConcurrentDictionary* concurrent;
+  R_Dictionary* dictionary;
+  pthread_mutex_t lock;
+  char keys[R_ConcurrentDictionary_bench_KEYS][24];
+  size_t sums[64];
+} R_ConcurrentDictionary_bench_Context;
+
+typedef struct {
+  R_ConcurrentDictionary_bench_Context* shared;
+  size_t thread;
+} R_ConcurrentDictionary_bench_Thread;
+
+static void* R_ConcurrentDictionary_bench_filled(size_t size) {
+  R_ConcurrentDictionary_bench_Context* context = malloc(sizeof(R_ConcurrentDictionary_bench_Context));
+  context->concurrent = R_Type_New(R_ConcurrentDictionary);
+  context->dictionary = R_Type_New(R_Dictionary);
+  pthread_mutex_init(&context->lock, NULL);
+  for (size_t i=0; i<R_ConcurrentDictionary_bench_KEYS; i++) {
+    snprintf(context->keys[i], sizeof(context->keys[i]), "key%zu", i);
+    R_ConcurrentDictionary_setInteger(context->concurrent, context->keys[i], (int)i);
+    R_Dictionary_setInteger(context->dictionary, context->keys[i], (int)i);
+  }
+  return context;
+}
+
+static void R_ConcurrentDictionary_bench_delete(void* context) {
+  R_ConcurrentDictionary_bench_Context* self = context;
+  R_Type_Delete(self->concurrent);
+  R_Type_Delete(self->dictionary);
+  pthread_mutex_destroy(&self->lock);
+  free(self);
+}
+
+static void R_ConcurrentDictionary_bench_readConcurrent(void* argument) {
+  R_ConcurrentDictionary_bench_Thread* thread = argument;
+  R_ConcurrentDictionary_bench_Context* self = thread->shared;
+  size_t sum = 0;
+  for (size_t i=0; i<R_ConcurrentDictionary_bench_LOOKUPS; i++) sum += R_ConcurrentDictionary_getInteger(self->concurrent, self->keys[(i + thread->thread) % R_ConcurrentDictionary_bench_KEYS]);
+  self->sums[thread->thread] = sum;
+}
+
+static void R_ConcurrentDictionary_bench_readLocked(void* argument) {
+  R_ConcurrentDictionary_bench_Thread* thread = argument;
+  R_ConcurrentDictionary_bench_Context* self = thread->shared;
+  size_t sum = 0;
+  for (size_t i=0; i<R_ConcurrentDictionary_bench_LOOKUPS; i++) {
+    pthread_mutex_lock(&self->lock);
+    sum += R_Dictionary_getInteger(self->dictionary, self->keys[(i + thread->thread) % R_ConcurrentDictionary_bench_KEYS]);
+    pthread_mutex_unlock(&self->lock);
+  }
+  self->sums[thread->thread] = sum;
+}
+
+static void R_ConcurrentDictionary_bench_run(R_ConcurrentDictionary_bench_Context* self, size_t threads, R_OS_Task task) {
+  R_ConcurrentDictionary_bench_Thread arguments[64];
+  void* contexts[64];
+  for (size_t i=0; i<threads; i++) {
+    arguments[i] = (R_ConcurrentDictionary_bench_Thread){self, i};
+    contexts[i] = &arguments[i];
+  }
+  R_OS_parallelRun(task, contexts, threads);
+  for (size_t i=0; i<threads; i++) R_Bench_sink += self->sums[i];
+}
+
+static void R_ConcurrentDictionary_bench_getInteger(void* context, size_t size) {
+  R_ConcurrentDictionary_bench_run(context, size, R_ConcurrentDictionary_bench_readConcurrent);
+}
+
+static void R_ConcurrentDictionary_bench_lockedGetInteger(void* context, size_t size) {
+  R_ConcurrentDictionary_bench_run(context, size, R_ConcurrentDictionary_bench_readLocked);
+}
+
+void R_ConcurrentDictionary_bench(R_Bench* bench) {
+  const size_t threads[] = {1, 2, 4, 8};
+  for (size_t i=0; i<sizeof(threads)/sizeof(threads[0]); i++) {
+    size_t size = threads[i];
+    R_Bench_measure(bench, "R_ConcurrentDictionary_getInteger", size, size*R_ConcurrentDictionary_bench_LOOKUPS, R_ConcurrentDictionary_bench_filled, R_ConcurrentDictionary_bench_getInteger, R_ConcurrentDictionary_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_lockedGetInteger", size, size*R_ConcurrentDictionary_bench_LOOKUPS, R_ConcurrentDictionary_bench_filled, R_ConcurrentDictionary_bench_lockedGetInteger, R_ConcurrentDictionary_bench_delete);
+  }
+}
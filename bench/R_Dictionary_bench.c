@@ -0,0 +1,91 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "R_Dictionary.h"
+#include "R_Bench.h"
+
+/*  Lookups per sample for the get cases. Gets are spread evenly over the keys so that a linear search pays its
+   average cost.
+ */
+#define R_Dictionary_bench_LOOKUPS 1000
+
+typedef struct {
+  R_Dictionary* dictionary;
+  char (*keys)[24];
+} R_Dictionary_bench_Context;
+
+static void* R_Dictionary_bench_keys(size_t size) {
+  R_Dictionary_bench_Context* context = malloc(sizeof(R_Dictionary_bench_Context));
+  context->dictionary = R_Type_New(R_Dictionary);
+  context->keys = malloc(size*sizeof(*context->keys));
+  for (size_t i=0; i<size; i++) snprintf(context->keys[i], sizeof(context->keys[i]), "key%zu", i);
+  return context;
+}
+
+static void* R_Dictionary_bench_filled(size_t size) {
+  R_Dictionary_bench_Context* context = R_Dictionary_bench_keys(size);
+  for (size_t i=0; i<size; i++) R_Dictionary_setInteger(context->dictionary, context->keys[i], (int)i);
+  return context;
+}
+
+static void R_Dictionary_bench_delete(void* context) {
+  R_Dictionary_bench_Context* self = context;
+  R_Type_Delete(self->dictionary);
+  free(self->keys);
+  free(self);
+}
+
+static void R_Dictionary_bench_add(void* context, size_t size) {
+  R_Dictionary_bench_Context* self = context;
+  for (size_t i=0; i<size; i++) R_Integer_set(R_Dictionary_add(self->dictionary, self->keys[i], R_Integer), (int)i);
+}
+
+static void R_Dictionary_bench_setInteger(void* context, size_t size) {
+  R_Dictionary_bench_Context* self = context;
+  for (size_t i=0; i<size; i++) R_Dictionary_setInteger(self->dictionary, self->keys[i], (int)i);
+}
+
+static void R_Dictionary_bench_get(void* context, size_t size) {
+  R_Dictionary_bench_Context* self = context;
+  size_t found = 0;
+  for (size_t i=0; i<R_Dictionary_bench_LOOKUPS; i++) found += R_Dictionary_get(self->dictionary, self->keys[i*size/R_Dictionary_bench_LOOKUPS]) != NULL;
+  R_Bench_sink = found;
+}
+
+static void R_Dictionary_bench_getInteger(void* context, size_t size) {
+  R_Dictionary_bench_Context* self = context;
+  size_t sum = 0;
+  for (size_t i=0; i<R_Dictionary_bench_LOOKUPS; i++) sum += R_Dictionary_getInteger(self->dictionary, self->keys[i*size/R_Dictionary_bench_LOOKUPS]);
+  R_Bench_sink = sum;
+}
+
+static void R_Dictionary_bench_merge(void* context, size_t size) {
+  R_Dictionary_bench_Context* self = context;
+  R_Dictionary* target = R_Type_New(R_Dictionary);
+  R_Bench_sink = R_Dictionary_size(R_Dictionary_merge(target, self->dictionary));
+  R_Type_Delete(target);
+}
+
+static void R_Dictionary_bench_mergeMove(void* context, size_t size) {
+  R_Dictionary_bench_Context* self = context;
+  R_Dictionary* target = R_Type_New(R_Dictionary);
+  R_Bench_sink = R_Dictionary_size(R_Dictionary_mergeMove(target, self->dictionary));
+  R_Type_Delete(target);
+}
+
+void R_Dictionary_bench(R_Bench* bench) {
+  const size_t sizes[] = {10, 100, 1000, 10000, 100000, 1000000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_Dictionary_add", size, size, R_Dictionary_bench_keys, R_Dictionary_bench_add, R_Dictionary_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_setInteger", size, size, R_Dictionary_bench_keys, R_Dictionary_bench_setInteger, R_Dictionary_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_get", size, R_Dictionary_bench_LOOKUPS, R_Dictionary_bench_filled, R_Dictionary_bench_get, R_Dictionary_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_getInteger", size, R_Dictionary_bench_LOOKUPS, R_Dictionary_bench_filled, R_Dictionary_bench_getInteger, R_Dictionary_bench_delete);
+  }
+  //Copying merges search the target for every key, so they stop at sizes where that's still quick
+  const size_t merge_sizes[] = {10, 100, 1000, 10000};
+  for (size_t i=0; i<sizeof(merge_sizes)/sizeof(merge_sizes[0]); i++) {
+    size_t size = merge_sizes[i];
+    R_Bench_measure(bench, "R_Dictionary_merge", size, size, R_Dictionary_bench_filled, R_Dictionary_bench_merge, R_Dictionary_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_mergeMove", size, size, R_Dictionary_bench_filled, R_Dictionary_bench_mergeMove, R_Dictionary_bench_delete);
+  }
+}
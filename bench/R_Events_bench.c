@@ -0,0 +1,42 @@
+#include <stdlib.h>
+#include "R_Events.h"
+#include "R_Bench.h"
+
+static void R_Events_bench_callback(void* target, const char* event_key, void* payload) {
+  (*(size_t*)target)++;
+}
+
+static size_t R_Events_bench_calls;
+
+static void* R_Events_bench_listeners(size_t listeners) {
+  R_Events* events = R_Type_New(R_Events);
+  for (size_t i=0; i<listeners; i++) R_Events_register(events, "tick", &R_Events_bench_calls, R_Events_bench_callback);
+  R_Events_register(events, "other", &R_Events_bench_calls, R_Events_bench_callback);
+  return events;
+}
+
+static void R_Events_bench_delete(void* events) {
+  R_Bench_sink = R_Events_bench_calls;
+  R_Type_Delete(events);
+}
+
+/*  R_Events_bench_notify
+    The number of notifications per sample is fixed, size is the number of listeners on the key.
+ */
+#define R_Events_bench_NOTIFICATIONS 10000
+static void R_Events_bench_notify(void* events, size_t size) {
+  for (size_t i=0; i<R_Events_bench_NOTIFICATIONS; i++) R_Events_notify(events, "tick", NULL);
+}
+
+static void R_Events_bench_notifyMissing(void* events, size_t size) {
+  for (size_t i=0; i<R_Events_bench_NOTIFICATIONS; i++) R_Events_notify(events, "nobody", NULL);
+}
+
+void R_Events_bench(R_Bench* bench) {
+  const size_t sizes[] = {1, 10, 100};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_Events_notify", size, R_Events_bench_NOTIFICATIONS, R_Events_bench_listeners, R_Events_bench_notify, R_Events_bench_delete);
+  }
+  R_Bench_measure(bench, "R_Events_notify_unregistered", 1, R_Events_bench_NOTIFICATIONS, R_Events_bench_listeners, R_Events_bench_notifyMissing, R_Events_bench_delete);
+}
@@ -0,0 +1,186 @@
+#include <stdlib.h>
+#include "R_Dictionary.h"
+#include "R_Path.h"
+#include "R_Bench.h"
+
+typedef struct {
+  R_MutableString* json;
+  R_Dictionary* dictionary;
+  R_MutableString* output;
+  R_MutableData* cbor;
+  R_Path* path;
+} R_Json_bench_Context;
+
+#define R_Json_bench_OrdersPath "orders[3].line_items[*].price"
+
+typedef R_MutableString* (*R_Json_bench_Corpus)(size_t size);
+
+/*  Corpora
+    orders is the real-world document used by the speed test. The others are generated with size elements.
+ */
+static R_MutableString* R_Json_bench_orders(size_t size) {
+#include "../test/R_Dictionary_large_json.data"
+  return large_json;
+}
+
+static R_MutableString* R_Json_bench_numbers(size_t size) {
+  R_MutableString* json = R_MutableString_appendCString(R_Type_New(R_MutableString), "{\"values\":[");
+  for (size_t i=0; i<size; i++) {
+    if (i > 0) R_MutableString_push(json, ',');
+    if (i % 2) R_MutableString_appendFloat(json, i * 0.25f);
+    else R_MutableString_appendInt(json, (int)i);
+  }
+  return R_MutableString_appendCString(json, "]}");
+}
+
+static R_MutableString* R_Json_bench_records(size_t size) {
+  R_MutableString* json = R_MutableString_appendCString(R_Type_New(R_MutableString), "{\"records\":[");
+  for (size_t i=0; i<size; i++) {
+    if (i > 0) R_MutableString_push(json, ',');
+    R_MutableString_appendCString(json, "{\"id\":");
+    R_MutableString_appendInt(json, (int)i);
+    R_MutableString_appendCString(json, ",\"name\":\"record number ");
+    R_MutableString_appendInt(json, (int)i);
+    R_MutableString_appendCString(json, "\",\"active\":true,\"parent\":null,\"tags\":[\"a\",\"b\\n\"],\"score\":1.5}");
+  }
+  return R_MutableString_appendCString(json, "]}");
+}
+
+static R_MutableString* R_Json_bench_keys(size_t size) {
+  R_MutableString* json = R_MutableString_appendCString(R_Type_New(R_MutableString), "{");
+  for (size_t i=0; i<size; i++) {
+    if (i > 0) R_MutableString_push(json, ',');
+    R_MutableString_appendCString(json, "\"key");
+    R_MutableString_appendInt(json, (int)i);
+    R_MutableString_appendCString(json, "\":\"value\"");
+  }
+  return R_MutableString_appendCString(json, "}");
+}
+
+static R_Json_bench_Context* R_Json_bench_context(R_Json_bench_Corpus corpus, size_t size) {
+  R_Json_bench_Context* context = malloc(sizeof(R_Json_bench_Context));
+  context->json = corpus(size);
+  context->dictionary = R_Type_New(R_Dictionary);
+  context->output = R_Type_New(R_MutableString);
+  context->cbor = R_Type_New(R_MutableData);
+  context->path = R_Path_compile(R_Type_New(R_Path), R_Json_bench_OrdersPath);
+  return context;
+}
+
+static void* R_Json_bench_parsed(R_Json_bench_Corpus corpus, size_t size) {
+  R_Json_bench_Context* context = R_Json_bench_context(corpus, size);
+  R_Dictionary_fromJson(context->dictionary, context->json);
+  R_Dictionary_toCbor(context->dictionary, context->cbor);
+  return context;
+}
+
+static void* R_Json_bench_ordersSource(size_t size) { return R_Json_bench_context(R_Json_bench_orders, size); }
+static void* R_Json_bench_numbersSource(size_t size) { return R_Json_bench_context(R_Json_bench_numbers, size); }
+static void* R_Json_bench_recordsSource(size_t size) { return R_Json_bench_context(R_Json_bench_records, size); }
+static void* R_Json_bench_keysSource(size_t size) { return R_Json_bench_context(R_Json_bench_keys, size); }
+static void* R_Json_bench_ordersParsed(size_t size) { return R_Json_bench_parsed(R_Json_bench_orders, size); }
+static void* R_Json_bench_numbersParsed(size_t size) { return R_Json_bench_parsed(R_Json_bench_numbers, size); }
+static void* R_Json_bench_recordsParsed(size_t size) { return R_Json_bench_parsed(R_Json_bench_records, size); }
+static void* R_Json_bench_keysParsed(size_t size) { return R_Json_bench_parsed(R_Json_bench_keys, size); }
+
+static void R_Json_bench_delete(void* context) {
+  R_Json_bench_Context* self = context;
+  R_Type_Delete(self->json);
+  R_Type_Delete(self->dictionary);
+  R_Type_Delete(self->output);
+  R_Type_Delete(self->cbor);
+  R_Type_Delete(self->path);
+  free(self);
+}
+
+static void R_Json_bench_parse(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_Dictionary_fromJson(self->dictionary, self->json) != NULL;
+}
+
+static void R_Json_bench_parseTyped(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_Dictionary_fromJsonWithOptions(self->dictionary, self->json, R_Dictionary_JsonOption_TypedArrays) != NULL;
+}
+
+static void R_Json_bench_parseLazy(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_Dictionary_fromJsonWithOptions(self->dictionary, self->json, R_Dictionary_JsonOption_Lazy) != NULL;
+}
+
+static void R_Json_bench_parseParallel(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_Dictionary_fromJsonWithOptions(self->dictionary, self->json, R_Dictionary_JsonOption_Parallel) != NULL;
+}
+
+static void R_Json_bench_serialize(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_MutableString_length(R_Dictionary_toJson(self->dictionary, self->output));
+}
+
+static void R_Json_bench_serializeCanonical(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_MutableString_length(R_Dictionary_toJsonWithOptions(self->dictionary, self->output, R_Dictionary_JsonOutput_Canonical));
+}
+
+static void R_Json_bench_hash(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = (size_t)R_Dictionary_hash(self->dictionary);
+}
+
+static void R_Json_bench_parseCbor(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_Dictionary_fromCbor(self->dictionary, self->cbor) != NULL;
+}
+
+static void R_Json_bench_serializeCbor(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  R_Bench_sink = R_MutableData_size(R_Dictionary_toCbor(self->dictionary, self->cbor));
+}
+
+static void R_Json_bench_pathGet(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  for (size_t i=0; i<1000; i++) R_Bench_sink += (size_t)R_Path_get(self->path, self->dictionary);
+}
+
+static void R_Json_bench_pathCompileGet(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  for (size_t i=0; i<1000; i++) R_Bench_sink += (size_t)R_Path_get(R_Path_compile(self->path, R_Json_bench_OrdersPath), self->dictionary);
+}
+
+static void R_Json_bench_pathGetJson(void* context, size_t size) {
+  R_Json_bench_Context* self = context;
+  for (size_t i=0; i<1000; i++) R_Bench_sink += R_MutableString_length(R_Path_getJson(self->path, self->json, self->output));
+}
+
+/*  R_Json_bench
+    Every case times one whole document, so ns/op is per document.
+ */
+void R_Json_bench(R_Bench* bench) {
+  R_Bench_measure(bench, "R_Dictionary_fromJson_orders", 31, 1, R_Json_bench_ordersSource, R_Json_bench_parse, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Dictionary_fromJson_orders_lazy", 31, 1, R_Json_bench_ordersSource, R_Json_bench_parseLazy, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Dictionary_fromJson_orders_parallel", 31, 1, R_Json_bench_ordersSource, R_Json_bench_parseParallel, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Dictionary_toJson_orders", 31, 1, R_Json_bench_ordersParsed, R_Json_bench_serialize, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Dictionary_fromCbor_orders", 31, 1, R_Json_bench_ordersParsed, R_Json_bench_parseCbor, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Dictionary_toCbor_orders", 31, 1, R_Json_bench_ordersParsed, R_Json_bench_serializeCbor, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Path_get_orders", 31, 1000, R_Json_bench_ordersParsed, R_Json_bench_pathGet, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Path_compile_get_orders", 31, 1000, R_Json_bench_ordersParsed, R_Json_bench_pathCompileGet, R_Json_bench_delete);
+  R_Bench_measure(bench, "R_Path_getJson_orders", 31, 1000, R_Json_bench_ordersSource, R_Json_bench_pathGetJson, R_Json_bench_delete);
+  const size_t sizes[] = {100, 10000, 1000000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_Dictionary_fromJson_numbers", size, 1, R_Json_bench_numbersSource, R_Json_bench_parse, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_fromJson_numbers_typed", size, 1, R_Json_bench_numbersSource, R_Json_bench_parseTyped, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_toJson_numbers", size, 1, R_Json_bench_numbersParsed, R_Json_bench_serialize, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_fromJson_records", size, 1, R_Json_bench_recordsSource, R_Json_bench_parse, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_fromJson_records_lazy", size, 1, R_Json_bench_recordsSource, R_Json_bench_parseLazy, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_fromJson_records_parallel", size, 1, R_Json_bench_recordsSource, R_Json_bench_parseParallel, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_toJson_records", size, 1, R_Json_bench_recordsParsed, R_Json_bench_serialize, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_toJson_records_canonical", size, 1, R_Json_bench_recordsParsed, R_Json_bench_serializeCanonical, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_hash_records", size, 1, R_Json_bench_recordsParsed, R_Json_bench_hash, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_fromCbor_records", size, 1, R_Json_bench_recordsParsed, R_Json_bench_parseCbor, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_toCbor_records", size, 1, R_Json_bench_recordsParsed, R_Json_bench_serializeCbor, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_fromJson_keys", size, 1, R_Json_bench_keysSource, R_Json_bench_parse, R_Json_bench_delete);
+    R_Bench_measure(bench, "R_Dictionary_toJson_keys", size, 1, R_Json_bench_keysParsed, R_Json_bench_serialize, R_Json_bench_delete);
+  }
+}
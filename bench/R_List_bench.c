@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include "R_List.h"
+#include "R_Bench.h"
+
+static void* R_List_bench_empty(size_t size) {
+  return R_Type_New(R_List);
+}
+
+static void* R_List_bench_filled(size_t size) {
+  R_List* list = R_Type_New(R_List);
+  R_List_reserve(list, size);
+  for (size_t i=0; i<size; i++) R_Integer_set(R_List_add(list, R_Integer), (int)i);
+  return list;
+}
+
+static void* R_List_bench_reversed(size_t size) {
+  R_List* list = R_Type_New(R_List);
+  R_List_reserve(list, size);
+  for (size_t i=size; i>0; i--) R_Integer_set(R_List_add(list, R_Integer), (int)i);
+  return list;
+}
+
+static void R_List_bench_delete(void* list) {
+  R_Type_Delete(list);
+}
+
+static void R_List_bench_append(void* list, size_t size) {
+  for (size_t i=0; i<size; i++) R_Integer_set(R_List_add(list, R_Integer), (int)i);
+}
+
+static void R_List_bench_iterate(void* list, size_t size) {
+  size_t sum = 0;
+  R_List_each(list, R_Integer, integer) sum += R_Integer_get(integer);
+  R_Bench_sink = sum;
+}
+
+static void R_List_bench_shift(void* list, size_t size) {
+  for (size_t i=0; i<size; i++) R_List_shift(list);
+}
+
+static void R_List_bench_pop(void* list, size_t size) {
+  for (size_t i=0; i<size; i++) R_List_pop(list);
+}
+
+static void R_List_bench_removeFirst(void* list, size_t size) {
+  for (size_t i=0; i<size; i++) R_List_removeIndex(list, 0);
+}
+
+static bool R_List_bench_isOdd(void* object, void* context) {
+  return R_Integer_get(object) & 1;
+}
+
+static void R_List_bench_removeIf(void* list, size_t size) {
+  R_Bench_sink = R_List_removeIf(list, R_List_bench_isOdd, NULL);
+}
+
+static void R_List_bench_sort(void* list, size_t size) {
+  R_List_sort(list, NULL);
+}
+
+static void* R_List_bench_square(void* object, void* context) {
+  int value = R_Integer_get(object);
+  return R_Integer_set(R_Type_New(R_Integer), value*value);
+}
+
+static void R_List_bench_map(void* list, size_t size) {
+  R_Type_Delete(R_List_map(list, R_List_bench_square, NULL, 0));
+}
+
+static void R_List_bench_add(void* accumulator, void* object, void* context) {
+  R_Integer_set(accumulator, R_Integer_get(accumulator) + R_Integer_get(object));
+}
+
+//Compare with R_List_each, the same sum in a serial loop
+static void R_List_bench_reduce(void* list, size_t size) {
+  R_Integer* sum = R_Type_New(R_Integer);
+  R_List_reduce(list, sum, R_List_bench_add, R_List_bench_add, NULL, 0);
+  R_Bench_sink = R_Integer_get(sum);
+  R_Type_Delete(sum);
+}
+
+void R_List_bench(R_Bench* bench) {
+  const size_t sizes[] = {100, 10000, 1000000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_List_add", size, size, R_List_bench_empty, R_List_bench_append, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_each", size, size, R_List_bench_filled, R_List_bench_iterate, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_shift", size, size, R_List_bench_filled, R_List_bench_shift, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_pop", size, size, R_List_bench_filled, R_List_bench_pop, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_removeIndex_first", size, size, R_List_bench_filled, R_List_bench_removeFirst, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_removeIf_half", size, size, R_List_bench_filled, R_List_bench_removeIf, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_sort_reversed", size, size, R_List_bench_reversed, R_List_bench_sort, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_map_square", size, size, R_List_bench_filled, R_List_bench_map, R_List_bench_delete);
+    R_Bench_measure(bench, "R_List_reduce_sum", size, size, R_List_bench_filled, R_List_bench_reduce, R_List_bench_delete);
+  }
+}
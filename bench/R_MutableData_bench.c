@@ -0,0 +1,41 @@
+#include <stdlib.h>
+#include "R_MutableData.h"
+#include "R_Bench.h"
+
+static void* R_MutableData_bench_empty(size_t size) {
+  return R_Type_New(R_MutableData);
+}
+
+static void* R_MutableData_bench_filled(size_t size) {
+  R_MutableData* data = R_Type_New(R_MutableData);
+  for (size_t i=0; i<size; i++) R_MutableData_push(data, (uint8_t)i);
+  return data;
+}
+
+static void R_MutableData_bench_delete(void* data) {
+  R_Type_Delete(data);
+}
+
+static void R_MutableData_bench_push(void* data, size_t size) {
+  for (size_t i=0; i<size; i++) R_MutableData_push(data, (uint8_t)i);
+}
+
+static void R_MutableData_bench_shift(void* data, size_t size) {
+  size_t sum = 0;
+  for (size_t i=0; i<size; i++) sum += R_MutableData_shift(data);
+  R_Bench_sink = sum;
+}
+
+static void R_MutableData_bench_unshift(void* data, size_t size) {
+  for (size_t i=0; i<size; i++) R_MutableData_unshift(data, (uint8_t)i);
+}
+
+void R_MutableData_bench(R_Bench* bench) {
+  const size_t sizes[] = {100, 10000, 1000000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_MutableData_push", size, size, R_MutableData_bench_empty, R_MutableData_bench_push, R_MutableData_bench_delete);
+    R_Bench_measure(bench, "R_MutableData_shift", size, size, R_MutableData_bench_filled, R_MutableData_bench_shift, R_MutableData_bench_delete);
+    R_Bench_measure(bench, "R_MutableData_unshift", size, size, R_MutableData_bench_empty, R_MutableData_bench_unshift, R_MutableData_bench_delete);
+  }
+}
@@ -0,0 +1,75 @@
+#include <stdlib.h>
+#include "R_MutableString.h"
+#include "R_List.h"
+#include "R_Bench.h"
+
+static void* R_MutableString_bench_empty(size_t size) {
+  return R_Type_New(R_MutableString);
+}
+
+/*  R_MutableString_bench_haystack
+    size characters of filler with the needle at the very end, so find has to scan all of it.
+ */
+static void* R_MutableString_bench_haystack(size_t size) {
+  R_MutableString* string = R_Type_New(R_MutableString);
+  for (size_t i=0; i+6<size; i++) R_MutableString_push(string, 'a' + i%7);
+  R_MutableString_appendCString(string, "needle");
+  return string;
+}
+
+static void* R_MutableString_bench_csv(size_t size) {
+  R_MutableString* string = R_Type_New(R_MutableString);
+  for (size_t i=0; i<size; i++) {
+    if (i > 0) R_MutableString_push(string, ',');
+    R_MutableString_appendInt(string, (int)i);
+  }
+  return string;
+}
+
+static void R_MutableString_bench_delete(void* string) {
+  R_Type_Delete(string);
+}
+
+static void R_MutableString_bench_appendCString(void* string, size_t size) {
+  for (size_t i=0; i<size; i++) R_MutableString_appendCString(string, "word ");
+}
+
+static void R_MutableString_bench_push(void* string, size_t size) {
+  for (size_t i=0; i<size; i++) R_MutableString_push(string, 'x');
+}
+
+static void R_MutableString_bench_find(void* string, size_t size) {
+  R_Bench_sink = R_MutableString_find(string, "needle");
+}
+
+static void R_MutableString_bench_split(void* string, size_t size) {
+  R_List* tokens = R_MutableString_split(string, ",", R_Type_New(R_List));
+  R_Bench_sink = R_List_size(tokens);
+  R_Type_Delete(tokens);
+}
+
+static void R_MutableString_bench_copy(void* string, size_t size) {
+  R_MutableString* copy = R_Type_Copy(string);
+  R_Bench_sink = R_MutableString_length(copy);
+  R_Type_Delete(copy);
+}
+
+//Copies, then writes to the copy, which pays for the bytes after all
+static void R_MutableString_bench_copyAndPush(void* string, size_t size) {
+  R_MutableString* copy = R_Type_Copy(string);
+  R_Bench_sink = R_MutableString_length(R_MutableString_push(copy, 'x'));
+  R_Type_Delete(copy);
+}
+
+void R_MutableString_bench(R_Bench* bench) {
+  const size_t sizes[] = {100, 10000, 1000000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_MutableString_appendCString", size, size, R_MutableString_bench_empty, R_MutableString_bench_appendCString, R_MutableString_bench_delete);
+    R_Bench_measure(bench, "R_MutableString_push", size, size, R_MutableString_bench_empty, R_MutableString_bench_push, R_MutableString_bench_delete);
+    R_Bench_measure(bench, "R_MutableString_find_bytes", size, size, R_MutableString_bench_haystack, R_MutableString_bench_find, R_MutableString_bench_delete);
+    R_Bench_measure(bench, "R_MutableString_split", size, size, R_MutableString_bench_csv, R_MutableString_bench_split, R_MutableString_bench_delete);
+    R_Bench_measure(bench, "R_MutableString_copy", size, 1, R_MutableString_bench_haystack, R_MutableString_bench_copy, R_MutableString_bench_delete);
+    R_Bench_measure(bench, "R_MutableString_copy_push", size, 1, R_MutableString_bench_haystack, R_MutableString_bench_copyAndPush, R_MutableString_bench_delete);
+  }
+}
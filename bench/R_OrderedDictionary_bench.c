@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "R_OrderedDictionary.h"
+#include "R_Bench.h"
+
+//Lookups per sample for the get case, spread evenly over the keys as in R_Dictionary_bench
+#define R_OrderedDictionary_bench_LOOKUPS 1000
+
+//Pairs visited per range scan
+#define R_OrderedDictionary_bench_RANGE 100
+
+typedef struct {
+  R_OrderedDictionary* dictionary;
+  char (*keys)[24];
+} R_OrderedDictionary_bench_Context;
+
+static void* R_OrderedDictionary_bench_keys(size_t size) {
+  R_OrderedDictionary_bench_Context* context = malloc(sizeof(R_OrderedDictionary_bench_Context));
+  context->dictionary = R_Type_New(R_OrderedDictionary);
+  context->keys = malloc(size*sizeof(*context->keys));
+  for (size_t i=0; i<size; i++) snprintf(context->keys[i], sizeof(context->keys[i]), "key%zu", i);
+  return context;
+}
+
+static void* R_OrderedDictionary_bench_filled(size_t size) {
+  R_OrderedDictionary_bench_Context* context = R_OrderedDictionary_bench_keys(size);
+  for (size_t i=0; i<size; i++) R_OrderedDictionary_setInteger(context->dictionary, context->keys[i], (int)i);
+  return context;
+}
+
+static void R_OrderedDictionary_bench_delete(void* context) {
+  R_OrderedDictionary_bench_Context* self = context;
+  R_Type_Delete(self->dictionary);
+  free(self->keys);
+  free(self);
+}
+
+static void R_OrderedDictionary_bench_setInteger(void* context, size_t size) {
+  R_OrderedDictionary_bench_Context* self = context;
+  for (size_t i=0; i<size; i++) R_OrderedDictionary_setInteger(self->dictionary, self->keys[i], (int)i);
+}
+
+static void R_OrderedDictionary_bench_getInteger(void* context, size_t size) {
+  R_OrderedDictionary_bench_Context* self = context;
+  size_t sum = 0;
+  for (size_t i=0; i<R_OrderedDictionary_bench_LOOKUPS; i++) sum += R_OrderedDictionary_getInteger(self->dictionary, self->keys[i*size/R_OrderedDictionary_bench_LOOKUPS]);
+  R_Bench_sink = sum;
+}
+
+static bool R_OrderedDictionary_bench_count(R_KeyValuePair* pair, void* context) {
+  return ++*(size_t*)context < R_OrderedDictionary_bench_RANGE;
+}
+
+//Scans from a key in the middle, so the cost is the descent plus the pairs visited rather than the size
+static void R_OrderedDictionary_bench_range(void* context, size_t size) {
+  R_OrderedDictionary_bench_Context* self = context;
+  size_t count = 0;
+  R_Bench_sink = R_OrderedDictionary_range(self->dictionary, self->keys[size/2], NULL, R_OrderedDictionary_bench_count, &count);
+}
+
+void R_OrderedDictionary_bench(R_Bench* bench) {
+  const size_t sizes[] = {100, 10000, 1000000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_OrderedDictionary_setInteger", size, size, R_OrderedDictionary_bench_keys, R_OrderedDictionary_bench_setInteger, R_OrderedDictionary_bench_delete);
+    R_Bench_measure(bench, "R_OrderedDictionary_getInteger", size, R_OrderedDictionary_bench_LOOKUPS, R_OrderedDictionary_bench_filled, R_OrderedDictionary_bench_getInteger, R_OrderedDictionary_bench_delete);
+    R_Bench_measure(bench, "R_OrderedDictionary_range_100", size, R_OrderedDictionary_bench_RANGE, R_OrderedDictionary_bench_filled, R_OrderedDictionary_bench_range, R_OrderedDictionary_bench_delete);
+  }
+}
@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "R_Dictionary.h"
+#include "R_PersistentDictionary.h"
+#include "R_Bench.h"
+
+/*  Versions made per sample. Each one changes a single key of a dictionary that keeps all the others, the way a
+   reader holding a snapshot and a writer updating it would.
+ */
+#define R_PersistentDictionary_bench_VERSIONS 100
+
+typedef struct {
+  R_Dictionary* dictionary;
+  R_PersistentDictionary* persistent;
+  char (*keys)[24];
+} R_PersistentDictionary_bench_Context;
+
+static void* R_PersistentDictionary_bench_filled(size_t size) {
+  R_PersistentDictionary_bench_Context* context = malloc(sizeof(R_PersistentDictionary_bench_Context));
+  context->dictionary = R_Type_New(R_Dictionary);
+  context->keys = malloc(size*sizeof(*context->keys));
+  for (size_t i=0; i<size; i++) {
+    snprintf(context->keys[i], sizeof(context->keys[i]), "key%zu", i);
+    R_Dictionary_setInteger(context->dictionary, context->keys[i], (int)i);
+  }
+  R_PersistentDictionary* empty = R_Type_New(R_PersistentDictionary);
+  context->persistent = R_PersistentDictionary_fromDictionary(empty, context->dictionary);
+  R_Type_Delete(empty);
+  return context;
+}
+
+static void R_PersistentDictionary_bench_delete(void* context) {
+  R_PersistentDictionary_bench_Context* self = context;
+  R_Type_Delete(self->persistent);
+  R_Type_Delete(self->dictionary);
+  free(self->keys);
+  free(self);
+}
+
+static void R_PersistentDictionary_bench_copySet(void* context, size_t size) {
+  R_PersistentDictionary_bench_Context* self = context;
+  size_t sum = 0;
+  for (size_t i=0; i<R_PersistentDictionary_bench_VERSIONS; i++) {
+    R_Dictionary* version = R_Type_Copy(self->dictionary);
+    R_Dictionary_setInteger(version, self->keys[i*size/R_PersistentDictionary_bench_VERSIONS], -(int)i);
+    sum += R_Dictionary_size(version);
+    R_Type_Delete(version);
+  }
+  R_Bench_sink = sum;
+}
+
+static void R_PersistentDictionary_bench_setInteger(void* context, size_t size) {
+  R_PersistentDictionary_bench_Context* self = context;
+  size_t sum = 0;
+  for (size_t i=0; i<R_PersistentDictionary_bench_VERSIONS; i++) {
+    R_PersistentDictionary* version = R_PersistentDictionary_setInteger(self->persistent, self->keys[i*size/R_PersistentDictionary_bench_VERSIONS], -(int)i);
+    sum += R_PersistentDictionary_size(version);
+    R_Type_Delete(version);
+  }
+  R_Bench_sink = sum;
+}
+
+static void R_PersistentDictionary_bench_getInteger(void* context, size_t size) {
+  R_PersistentDictionary_bench_Context* self = context;
+  size_t sum = 0;
+  for (size_t i=0; i<R_PersistentDictionary_bench_VERSIONS; i++) sum += R_PersistentDictionary_getInteger(self->persistent, self->keys[i*size/R_PersistentDictionary_bench_VERSIONS]);
+  R_Bench_sink = sum;
+}
+
+void R_PersistentDictionary_bench(R_Bench* bench) {
+  //Setup fills an R_Dictionary to convert from, which stops being quick past these sizes
+  const size_t sizes[] = {10, 100, 1000, 10000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_Dictionary_copySet", size, R_PersistentDictionary_bench_VERSIONS, R_PersistentDictionary_bench_filled, R_PersistentDictionary_bench_copySet, R_PersistentDictionary_bench_delete);
+    R_Bench_measure(bench, "R_PersistentDictionary_setInteger", size, R_PersistentDictionary_bench_VERSIONS, R_PersistentDictionary_bench_filled, R_PersistentDictionary_bench_setInteger, R_PersistentDictionary_bench_delete);
+    R_Bench_measure(bench, "R_PersistentDictionary_getInteger", size, R_PersistentDictionary_bench_VERSIONS, R_PersistentDictionary_bench_filled, R_PersistentDictionary_bench_getInteger, R_PersistentDictionary_bench_delete);
+  }
+}
@@ -0,0 +1,78 @@
+#include <stdlib.h>
+#include "R_OS.h"
+#include "R_Queue.h"
+#include "R_Bench.h"
+
+//Objects passed through the queue per sample
+#define R_Queue_bench_OBJECTS 100000
+
+typedef struct {
+  R_Queue* queue;
+  R_Integer** objects;
+  size_t producers;
+  size_t producers_left;
+} R_Queue_bench_Context;
+
+typedef struct {
+  R_Queue_bench_Context* shared;
+  size_t thread;
+} R_Queue_bench_Thread;
+
+static void* R_Queue_bench_setup(size_t size) {
+  R_Queue_bench_Context* context = malloc(sizeof(R_Queue_bench_Context));
+  context->queue = R_Queue_setCapacity(R_Type_New(R_Queue), 1024);
+  context->objects = malloc(R_Queue_bench_OBJECTS*sizeof(R_Integer*));
+  for (size_t i=0; i<R_Queue_bench_OBJECTS; i++) context->objects[i] = R_Integer_set(R_Type_New(R_Integer), (int)i);
+  context->producers = size;
+  context->producers_left = size;
+  return context;
+}
+
+static void R_Queue_bench_teardown(void* context) {
+  R_Queue_bench_Context* self = context;
+  for (size_t i=0; i<R_Queue_bench_OBJECTS; i++) R_Type_Delete(self->objects[i]);
+  R_Type_Delete(self->queue);
+  free(self->objects);
+  free(self);
+}
+
+//Pushes and pops on one thread, so the cost is the queue's own with nothing to wait for
+static void R_Queue_bench_pushPop(void* context, size_t size) {
+  R_Queue_bench_Context* self = context;
+  for (size_t i=0; i<R_Queue_bench_OBJECTS; i++) {
+    R_Queue_push(self->queue, self->objects[i]);
+    self->objects[i] = R_Queue_pop(self->queue);
+  }
+}
+
+//Producers pass every object to the consumers, which put them back where they came from
+static void R_Queue_bench_stage(void* argument) {
+  R_Queue_bench_Thread* thread = argument;
+  R_Queue_bench_Context* self = thread->shared;
+  if (thread->thread < self->producers) {
+    for (size_t i=thread->thread; i<R_Queue_bench_OBJECTS; i+=self->producers) R_Queue_pushWait(self->queue, self->objects[i]);
+    if (__atomic_sub_fetch(&self->producers_left, 1, __ATOMIC_ACQ_REL) == 0) R_Queue_close(self->queue);
+    return;
+  }
+  R_Integer* object = NULL;
+  while ((object = R_Queue_popWait(self->queue)) != NULL) self->objects[R_Integer_get(object)] = object;
+}
+
+static void R_Queue_bench_pipeline(void* context, size_t size) {
+  R_Queue_bench_Thread arguments[64];
+  void* contexts[64];
+  for (size_t i=0; i<size*2; i++) {
+    arguments[i] = (R_Queue_bench_Thread){context, i};
+    contexts[i] = &arguments[i];
+  }
+  R_OS_parallelRun(R_Queue_bench_stage, contexts, size*2);
+}
+
+void R_Queue_bench(R_Bench* bench) {
+  R_Bench_measure(bench, "R_Queue_pushPop", 1, R_Queue_bench_OBJECTS, R_Queue_bench_setup, R_Queue_bench_pushPop, R_Queue_bench_teardown);
+  //The size is the number of producers, each with a consumer of its own
+  const size_t pairs[] = {1, 2, 4};
+  for (size_t i=0; i<sizeof(pairs)/sizeof(pairs[0]); i++) {
+    R_Bench_measure(bench, "R_Queue_pipeline", pairs[i], R_Queue_bench_OBJECTS, R_Queue_bench_setup, R_Queue_bench_pipeline, R_Queue_bench_teardown);
+  }
+}
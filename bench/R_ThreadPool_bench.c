@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include "R_OS.h"
+#include "R_ThreadPool.h"
+#include "R_Bench.h"
+
+/*  Calls to R_OS_parallelRun per sample, each with size small tasks, once with a pool installed and once starting
+   threads on every call. The difference is what the pool saves per task.
+ */
+#define R_ThreadPool_bench_ROUNDS 100
+#define R_ThreadPool_bench_WORK 1000
+#define R_ThreadPool_bench_VALUES 1000000
+
+typedef struct {
+  R_ThreadPool* pool;
+  size_t* values;
+  size_t sums[256];
+  void* contexts[256];
+} R_ThreadPool_bench_Context;
+
+static void* R_ThreadPool_bench_setup(size_t size) {
+  R_ThreadPool_bench_Context* context = malloc(sizeof(R_ThreadPool_bench_Context));
+  context->pool = R_Type_New(R_ThreadPool);
+  context->values = malloc(R_ThreadPool_bench_VALUES*sizeof(size_t));
+  for (size_t i=0; i<R_ThreadPool_bench_VALUES; i++) context->values[i] = i;
+  for (size_t i=0; i<size; i++) context->contexts[i] = &context->sums[i];
+  return context;
+}
+
+static void R_ThreadPool_bench_teardown(void* context) {
+  R_ThreadPool_bench_Context* self = context;
+  R_ThreadPool_install(NULL);
+  R_Type_Delete(self->pool);
+  free(self->values);
+  free(self);
+}
+
+static void R_ThreadPool_bench_task(void* context) {
+  size_t* sum = context;
+  for (size_t i=0; i<R_ThreadPool_bench_WORK; i++) *sum += i;
+}
+
+static void R_ThreadPool_bench_rounds(R_ThreadPool_bench_Context* self, size_t size) {
+  for (size_t round=0; round<R_ThreadPool_bench_ROUNDS; round++) R_OS_parallelRun(R_ThreadPool_bench_task, self->contexts, size);
+  R_Bench_sink += self->sums[0];
+}
+
+static void R_ThreadPool_bench_pooled(void* context, size_t size) {
+  R_ThreadPool_bench_Context* self = context;
+  R_ThreadPool_install(self->pool);
+  R_ThreadPool_bench_rounds(self, size);
+  R_ThreadPool_install(NULL);
+}
+
+static void R_ThreadPool_bench_spawned(void* context, size_t size) {
+  R_ThreadPool_bench_rounds(context, size);
+}
+
+static void R_ThreadPool_bench_sumRange(void* context, size_t begin, size_t end) {
+  R_ThreadPool_bench_Context* self = context;
+  size_t sum = 0;
+  for (size_t i=begin; i<end; i++) sum += self->values[i];
+  __atomic_add_fetch(&self->sums[0], sum, __ATOMIC_RELAXED);
+}
+
+static void R_ThreadPool_bench_parallelFor(void* context, size_t size) {
+  R_ThreadPool_bench_Context* self = context;
+  R_ThreadPool_parallelFor(self->pool, R_ThreadPool_bench_sumRange, self, R_ThreadPool_bench_VALUES);
+  R_Bench_sink += self->sums[0];
+}
+
+void R_ThreadPool_bench(R_Bench* bench) {
+  //The size is the number of tasks per call
+  const size_t tasks[] = {4, 16, 64};
+  for (size_t i=0; i<sizeof(tasks)/sizeof(tasks[0]); i++) {
+    R_Bench_measure(bench, "R_ThreadPool_parallelRun", tasks[i], R_ThreadPool_bench_ROUNDS*tasks[i], R_ThreadPool_bench_setup, R_ThreadPool_bench_pooled, R_ThreadPool_bench_teardown);
+    R_Bench_measure(bench, "R_ThreadPool_spawnedRun", tasks[i], R_ThreadPool_bench_ROUNDS*tasks[i], R_ThreadPool_bench_setup, R_ThreadPool_bench_spawned, R_ThreadPool_bench_teardown);
+  }
+  R_Bench_measure(bench, "R_ThreadPool_parallelFor", 1, R_ThreadPool_bench_VALUES, R_ThreadPool_bench_setup, R_ThreadPool_bench_parallelFor, R_ThreadPool_bench_teardown);
+}
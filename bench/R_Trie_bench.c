@@ -0,0 +1,79 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "R_Trie.h"
+#include "R_Bench.h"
+
+//Lookups per sample for the get cases, spread evenly over the keys as in R_Dictionary_bench
+#define R_Trie_bench_LOOKUPS 1000
+
+typedef struct {
+  R_Trie* trie;
+  char (*keys)[48];
+} R_Trie_bench_Context;
+
+//Keys share a long prefix and fan out over a few groups, as metric names and routes do
+static void* R_Trie_bench_keys(size_t size) {
+  R_Trie_bench_Context* context = malloc(sizeof(R_Trie_bench_Context));
+  context->trie = R_Type_New(R_Trie);
+  context->keys = malloc(size*sizeof(*context->keys));
+  for (size_t i=0; i<size; i++) snprintf(context->keys[i], sizeof(context->keys[i]), "service.orders.%zu.key%zu", i % 16, i);
+  return context;
+}
+
+static void* R_Trie_bench_filled(size_t size) {
+  R_Trie_bench_Context* context = R_Trie_bench_keys(size);
+  for (size_t i=0; i<size; i++) R_Integer_set(R_Trie_add(context->trie, context->keys[i], R_Integer), (int)i);
+  return context;
+}
+
+static void R_Trie_bench_delete(void* context) {
+  R_Trie_bench_Context* self = context;
+  R_Type_Delete(self->trie);
+  free(self->keys);
+  free(self);
+}
+
+static void R_Trie_bench_add(void* context, size_t size) {
+  R_Trie_bench_Context* self = context;
+  for (size_t i=0; i<size; i++) R_Integer_set(R_Trie_add(self->trie, self->keys[i], R_Integer), (int)i);
+}
+
+static void R_Trie_bench_get(void* context, size_t size) {
+  R_Trie_bench_Context* self = context;
+  size_t found = 0;
+  for (size_t i=0; i<R_Trie_bench_LOOKUPS; i++) found += R_Trie_get(self->trie, self->keys[i*size/R_Trie_bench_LOOKUPS]) != NULL;
+  R_Bench_sink = found;
+}
+
+//Each lookup is a key with a suffix after it, so the match is the whole key
+static void R_Trie_bench_longestPrefix(void* context, size_t size) {
+  R_Trie_bench_Context* self = context;
+  char string[64];
+  size_t length = 0;
+  for (size_t i=0; i<R_Trie_bench_LOOKUPS; i++) {
+    snprintf(string, sizeof(string), "%s/suffix", self->keys[i*size/R_Trie_bench_LOOKUPS]);
+    R_Trie_longestPrefix(self->trie, string, &length);
+  }
+  R_Bench_sink = length;
+}
+
+static bool R_Trie_bench_count(const char* key, void* value, void* context) {
+  return true;
+}
+
+//One of the 16 groups, so the scan visits a sixteenth of the keys
+static void R_Trie_bench_eachWithPrefix(void* context, size_t size) {
+  R_Trie_bench_Context* self = context;
+  R_Bench_sink = R_Trie_eachWithPrefix(self->trie, "service.orders.7.", R_Trie_bench_count, NULL);
+}
+
+void R_Trie_bench(R_Bench* bench) {
+  const size_t sizes[] = {100, 10000, 1000000};
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+    size_t size = sizes[i];
+    R_Bench_measure(bench, "R_Trie_add", size, size, R_Trie_bench_keys, R_Trie_bench_add, R_Trie_bench_delete);
+    R_Bench_measure(bench, "R_Trie_get", size, R_Trie_bench_LOOKUPS, R_Trie_bench_filled, R_Trie_bench_get, R_Trie_bench_delete);
+    R_Bench_measure(bench, "R_Trie_longestPrefix", size, R_Trie_bench_LOOKUPS, R_Trie_bench_filled, R_Trie_bench_longestPrefix, R_Trie_bench_delete);
+    R_Bench_measure(bench, "R_Trie_eachWithPrefix", size, size/16, R_Trie_bench_filled, R_Trie_bench_eachWithPrefix, R_Trie_bench_delete);
+  }
+}
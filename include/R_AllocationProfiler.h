@@ -0,0 +1,54 @@
+#ifndef R_AllocationProfiler_h
+#define R_AllocationProfiler_h
+
+#include "R_Type.h"
+#include "R_MutableString.h"
+
+#ifdef R_OS_ALLOCATOR
+
+/*  R_AllocationProfiler
+    An R_Allocator that forwards to the allocator it replaced and records what passes through it: counts and bytes
+   per call site and per R_Type, live and peak bytes, and a histogram of allocation sizes in power-of-two buckets.
+ */
+typedef struct R_AllocationProfiler R_AllocationProfiler;
+R_Type_Declare(R_AllocationProfiler);
+
+/*  R_AllocationProfiler_start
+    Installs the profiler as the allocator. Memory allocated before this is still freed correctly.
+ */
+R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_start(R_AllocationProfiler* self);
+
+/*  R_AllocationProfiler_stop
+    Puts back the allocator that was replaced by start. The statistics are kept. Deleting a running profiler stops it.
+ */
+R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_stop(R_AllocationProfiler* self);
+
+/*  R_AllocationProfiler_reset
+    Clears the counters. Memory that is still live stays tracked and the peak restarts from the live bytes.
+ */
+R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_reset(R_AllocationProfiler* self);
+
+/*  R_AllocationProfiler_allocations
+    Number of allocations recorded, including reallocations.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_allocations(R_AllocationProfiler* self);
+
+/*  R_AllocationProfiler_liveBytes
+    Bytes allocated while profiling that haven't been freed yet.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_liveBytes(R_AllocationProfiler* self);
+
+/*  R_AllocationProfiler_peakBytes
+    The most live bytes seen at once.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_peakBytes(R_AllocationProfiler* self);
+
+/*  R_AllocationProfiler_toJson
+    Writes the statistics to the given string as json. Sites are listed with the most bytes allocated first.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_toJson(R_AllocationProfiler* self, R_MutableString* buffer);
+
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_stringify(R_AllocationProfiler* self, char* buffer, size_t size);
+
+#endif /* R_OS_ALLOCATOR */
+#endif /* R_AllocationProfiler_h */
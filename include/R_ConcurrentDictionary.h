@@ -0,0 +1,81 @@
+#ifndef R_ConcurrentDictionary_h
+#define R_ConcurrentDictionary_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+#include "R_Type_Builtins.h"
+
+//Built on R_Type_Retain, so only there with R_TYPE_REFCOUNT
+#ifdef R_TYPE_REFCOUNT
+
+/*  R_ConcurrentDictionary
+    A dictionary that any number of threads can read and write at once without an outside lock. Reads take no lock
+   and write nothing shared but a slot of their own, so read-mostly workloads scale with the number of threads.
+   Writes lock one of 64 stripes of the hash table, so writers only wait for each other when their keys share a
+   stripe. Entries a writer replaces or removes are freed once no read that started before the change is still going.
+
+    Values are R_Type objects shared between threads, so they must not be changed once they're added. Replace the
+   value under the key instead. An R_Dictionary value can be read with R_Dictionary_get from any number of threads,
+   since the boxes and parsed values it keeps are published atomically. There's no R_Dictionary_add equivalent, since
+   other threads would see the new object before it was set up. Up to 64 threads can be inside a read at once; more
+   wait for a free slot.
+ */
+typedef struct R_ConcurrentDictionary R_ConcurrentDictionary;
+R_Type_Declare(R_ConcurrentDictionary);
+
+/*  R_ConcurrentDictionary_transferOwnership
+    Adds the object under key, replacing any value it had, and takes over the caller's reference to it. Returns false,
+   and deletes the object, if it can't be added.
+ */
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_transferOwnership(R_ConcurrentDictionary* self, const char* key, void* object);
+
+/*  R_ConcurrentDictionary_addShared
+    Retains the object and adds it under key, replacing any value it had. The caller keeps its own reference.
+ */
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_addShared(R_ConcurrentDictionary* self, const char* key, void* object);
+
+/*  R_ConcurrentDictionary_addCopy
+    Copies the object and adds the copy under key, replacing any value it had. Fails if the object has no R_Type_Copier.
+ */
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_addCopy(R_ConcurrentDictionary* self, const char* key, const void* object);
+
+/*  R_ConcurrentDictionary_setInteger
+    Adds a new R_Integer, R_Float or R_Boolean under key, replacing any value it had.
+ */
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_setInteger(R_ConcurrentDictionary* self, const char* key, int value);
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_setFloat(R_ConcurrentDictionary* self, const char* key, float value);
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_setBoolean(R_ConcurrentDictionary* self, const char* key, bool value);
+
+/*  R_ConcurrentDictionary_remove
+    Removes the value with the given key. Returns false if there wasn't one.
+ */
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_remove(R_ConcurrentDictionary* self, const char* key);
+
+/*  R_ConcurrentDictionary_get
+    Returns a new reference to the value with the given key, or NULL if it doesn't exist. Another thread may remove
+   the value at any time, so the caller owns the reference and must give it back with R_Type_Release.
+ */
+void* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_get(R_ConcurrentDictionary* self, const char* key);
+
+/*  R_ConcurrentDictionary_getInteger
+    Returns the value of an R_Integer, R_Float or R_Boolean under key, or 0 or false if it doesn't exist or holds a
+   different type. These don't touch the value's reference count, so they're the cheapest reads of a shared key.
+ */
+int R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_getInteger(R_ConcurrentDictionary* self, const char* key);
+float R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_getFloat(R_ConcurrentDictionary* self, const char* key);
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_getBoolean(R_ConcurrentDictionary* self, const char* key);
+
+/*  R_ConcurrentDictionary_isPresent
+    Returns true if the key exists.
+ */
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_isPresent(R_ConcurrentDictionary* self, const char* key);
+
+/*  R_ConcurrentDictionary_size
+    Returns the number of keys. Writes on other threads may change it at any time.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_size(R_ConcurrentDictionary* self);
+
+#endif
+
+#endif /* R_ConcurrentDictionary_h */
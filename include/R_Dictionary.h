@@ -2,10 +2,12 @@
 #define R_Dictionary_h
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "R_Type.h"
 #include "R_MutableString.h" 
 #include "R_List.h"
 #include "R_KeyValuePair.h"
+#include "R_NumericArray.h"
 
 typedef struct R_Dictionary R_Dictionary;
 R_Type_Declare(R_Dictionary);
@@ -25,11 +27,31 @@ void* R_FUNCTION_ATTRIBUTES R_Dictionary_addObjectOfType(R_Dictionary* self, con
  */
 void* R_FUNCTION_ATTRIBUTES R_Dictionary_addCopy(R_Dictionary* self, const char* key, const void* object);
 
+#ifdef R_TYPE_REFCOUNT
+/*  R_Dictionary_addShared
+    Retains the object and adds it to the dictionary without copying it, so the same object can be in many
+   dictionaries and lists at once. The caller keeps its own reference. See R_Type_Retain.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Dictionary_addShared(R_Dictionary* self, const char* key, void* object);
+#endif
+
+/*  R_Dictionary_addMove
+    Moves the object's contents into a new object under key with R_Type_Move, leaving the given object empty but still
+   owned by the caller. Types without an R_Type_Mover are copied instead.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Dictionary_addMove(R_Dictionary* self, const char* key, void* object);
+
 /*  R_Dictionary_merge
     Copies the given dictionary into self.
  */
 R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_merge(R_Dictionary* self, R_Dictionary* dictionary_to_copy);
 
+/*  R_Dictionary_mergeMove
+    Moves every pair of the given dictionary into self without copying any values, leaving it empty. Keys that are
+   already in self get the moved value. If self is empty, it takes over the whole list of pairs at once.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_mergeMove(R_Dictionary* self, R_Dictionary* dictionary_to_move);
+
 
 /*  R_Dictionary_transferOwnership
     Adds the pointer to the dictionary without copying the object. This is dangerous. The object must be on the heap.
@@ -42,15 +64,44 @@ void* R_FUNCTION_ATTRIBUTES R_Dictionary_transferOwnership(R_Dictionary* self, c
 void R_FUNCTION_ATTRIBUTES R_Dictionary_remove(R_Dictionary* self, const char* key);
 
 /*  R_Dictionary_get
-    Fetches the object with the given key. Returns NULL if it doesn't exist.
+    Fetches the object with the given key. Returns NULL if it doesn't exist. Inline scalars and lazily parsed values
+   are boxed or parsed the first time and kept in the dictionary, as R_KeyValuePair_value does, which is safe while
+   other threads read the same dictionary.
  */
 void* R_FUNCTION_ATTRIBUTES R_Dictionary_get(R_Dictionary* self, const char* key);
 
+/*  R_Dictionary_read
+    Returns a new reference to the object with the given key without keeping a box or parsed value in the dictionary.
+   See R_KeyValuePair_readValue. The caller deletes the result.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Dictionary_read(R_Dictionary* self, const char* key);
+
 /*  R_Dictionary_getFromString
     Fetches the object with the given key. Returns NULL if it doesn't exist.
  */
 void* R_FUNCTION_ATTRIBUTES R_Dictionary_getFromString(R_Dictionary* self, R_MutableString* key);
 
+/*  R_Dictionary_setInteger
+    Stores the scalar inline in the dictionary, without allocating an R_Type object for it. R_Dictionary_get still
+   works on these keys but has to box the value the first time.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setInteger(R_Dictionary* self, const char* key, int value);
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setFloat(R_Dictionary* self, const char* key, float value);
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setBoolean(R_Dictionary* self, const char* key, bool value);
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setNull(R_Dictionary* self, const char* key);
+
+/*  R_Dictionary_getInteger
+    Fetches a scalar without boxing it. Returns 0 or false if the key doesn't exist or holds a different type.
+ */
+int R_FUNCTION_ATTRIBUTES R_Dictionary_getInteger(R_Dictionary* self, const char* key);
+float R_FUNCTION_ATTRIBUTES R_Dictionary_getFloat(R_Dictionary* self, const char* key);
+bool R_FUNCTION_ATTRIBUTES R_Dictionary_getBoolean(R_Dictionary* self, const char* key);
+
+/*  R_Dictionary_typeOf
+    Returns the R_Type of the value with the given key, without boxing or parsing it. Returns NULL if it doesn't exist.
+ */
+const R_Type* R_FUNCTION_ATTRIBUTES R_Dictionary_typeOf(R_Dictionary* self, const char* key);
+
 /*  R_Dictionary_removeAll
     Removes all objects from the dictionary.
  */
@@ -72,16 +123,121 @@ bool R_FUNCTION_ATTRIBUTES R_Dictionary_isNotPresent(R_Dictionary* self, const c
  */
 size_t R_FUNCTION_ATTRIBUTES R_Dictionary_size(R_Dictionary* self);
 
+/*  R_Dictionary_Mapper
+    Returns a new value made from the given key and value, which the caller takes ownership of, or NULL on failure.
+   Context is passed through untouched. value is only valid during the call; retain it to keep it.
+ */
+typedef void* (*R_Dictionary_Mapper)(const char* key, void* value, void* context);
+
+/*  R_Dictionary_mapValues
+    Returns a new dictionary with the same keys, in the same order, each set to the mapper's result for its value.
+   Values are mapped like R_List_map, on at most threads threads, so the mapper may be called from several threads at
+   once. Values are read with R_KeyValuePair_readValue, so the source dictionary isn't changed, and inline or lazily
+   parsed values reach the mapper as temporary objects. Returns NULL if the mapper fails for any value or memory runs
+   out.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_mapValues(R_Dictionary* self, R_Dictionary_Mapper mapper, void* context, size_t threads);
+
 /*  R_Dictionary_toJson
     Writes the dictionary to the given string, as json. 
  */
 R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_toJson(R_Dictionary* self, R_MutableString* buffer);
 
+/*  R_Dictionary_JsonOutput
+    Flags for R_Dictionary_toJsonWithOptions. Pretty puts each member on its own line, indented by two spaces per level,
+   with a space after each colon. SortedKeys writes every dictionary's keys in order of their UTF-8 bytes instead of
+   insertion order.
+
+    CanonicalNumbers writes each float or double as the shortest text that reads back as the same value. Whole numbers
+   have no fraction, so an R_Float of 2 is written the same as an R_Integer of 2, and NaN and infinity are written as
+   null. Canonical is SortedKeys and CanonicalNumbers together: two dictionaries holding the same values then produce
+   the same bytes, however they were built.
+ */
+enum {
+  R_Dictionary_JsonOutput_Compact = 0,
+  R_Dictionary_JsonOutput_Pretty = 1 << 0,
+  R_Dictionary_JsonOutput_SortedKeys = 1 << 1,
+  R_Dictionary_JsonOutput_CanonicalNumbers = 1 << 2,
+  R_Dictionary_JsonOutput_Canonical = R_Dictionary_JsonOutput_SortedKeys | R_Dictionary_JsonOutput_CanonicalNumbers,
+};
+
+/*  R_Dictionary_toJsonWithOptions
+    Writes the dictionary to the given string, as json, using R_Dictionary_JsonOutput flags. The output is produced in
+   one pass over the tree; sorting keys only needs a list of pointers per dictionary, not a copy.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_toJsonWithOptions(R_Dictionary* self, R_MutableString* buffer, uint32_t options);
+
+/*  R_Dictionary_hash
+    Returns the 64 bit FNV-1a hash of the dictionary's canonical json, without keeping the json in memory. Dictionaries
+   holding the same values hash the same, so a changed hash means a changed value. Values json can't hold, like an
+   R_Events or any type the writer doesn't know, are all written as the string "Unknown Type", so swapping one for
+   another doesn't change the hash. Returns 0 if self isn't a dictionary.
+ */
+uint64_t R_FUNCTION_ATTRIBUTES R_Dictionary_hash(R_Dictionary* self);
+
 /*  R_Dictionary_toJson
     Initializes the dictionary with the given json string.
  */
 R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson(R_Dictionary* self, R_MutableString* buffer);
 
+/*  R_Dictionary_JsonOption
+    Flags for R_Dictionary_fromJsonWithOptions. TypedArrays reads arrays made only of numbers into an R_IntArray,
+   or an R_FloatArray if any of them has a fraction or exponent, instead of an R_List of boxed numbers.
+
+    Lazy only parses the top level. Objects and arrays are skipped and kept as unparsed text, and each one is parsed
+   the first time it's fetched, so reading a few fields from a large document doesn't pay for the rest of it. The
+   text is copied once and shared by every unparsed value, and is freed after the last of them is parsed or deleted.
+   Syntax errors inside an unparsed value only show up when it's fetched, which then returns NULL.
+
+    Parallel splits large arrays of objects or arrays into runs of elements and reads the runs on all CPUs at once,
+   then joins them into one R_List in order. Smaller arrays, arrays of scalars and everything else are read as usual.
+   Lazy takes precedence, since it doesn't read arrays up front.
+ */
+enum {
+  R_Dictionary_JsonOption_None = 0,
+  R_Dictionary_JsonOption_TypedArrays = 1 << 0,
+  R_Dictionary_JsonOption_Lazy = 1 << 1,
+  R_Dictionary_JsonOption_Parallel = 1 << 2,
+};
+
+/*  R_Dictionary_fromJsonWithOptions
+    Initializes the dictionary with the given json string, using R_Dictionary_JsonOption flags.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJsonWithOptions(R_Dictionary* self, R_MutableString* buffer, uint32_t options);
+
+/*  R_Dictionary_fromJsonWithThreads
+    The same as R_Dictionary_fromJsonWithOptions, but R_Dictionary_JsonOption_Parallel uses at most threads threads
+   instead of one per CPU. Passing 0 means one per CPU.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJsonWithThreads(R_Dictionary* self, R_MutableString* buffer, uint32_t options, size_t threads);
+
+/*  R_Dictionary_readJson
+    Reads the json object at the front of buffer and removes it from buffer, leaving anything after it. Unlike
+   R_Dictionary_fromJson, buffer isn't copied first. Returns NULL if the object is malformed.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_readJson(R_Dictionary* self, R_MutableString* buffer, uint32_t options);
+
+/*  R_Dictionary_toCbor
+    Writes the dictionary to the given data array as CBOR (RFC 8949). Strings are text strings, R_MutableData is a
+   byte string and R_Data is a byte string wrapped in R_Dictionary_CborTag_Data. Typed arrays are written as RFC 8746
+   little-endian typed arrays (tags 78, 85 and 86). Types without an encoding are written as undefined.
+ */
+R_MutableData* R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor(R_Dictionary* self, R_MutableData* buffer);
+
+/*  R_Dictionary_fromCbor
+    Initializes the dictionary with the given CBOR map. Arrays and maps are reserved up front from their length
+   prefixes. Integers that don't fit in an int, or an unsigned int for positive ones, are read as the nearest float,
+   and half-precision floats are widened. Unassigned and one-byte simple values are left out, along with their keys.
+   Indefinite-length items aren't supported. Returns NULL if the data is malformed.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor(R_Dictionary* self, const R_MutableData* buffer);
+
+/*  R_Dictionary_CborTag_Data
+    The CBOR tag used to tell an R_Data apart from an R_MutableData. It's in the first-come-first-served range and
+   spells "RDAT".
+ */
+#define R_Dictionary_CborTag_Data 0x52444154
+
 size_t R_FUNCTION_ATTRIBUTES R_Dictionary_stringify(R_Dictionary* self, char* buffer, size_t size);
 
 R_List* R_FUNCTION_ATTRIBUTES R_Dictionary_listOfPairs(R_Dictionary* self);
@@ -0,0 +1,136 @@
+#ifndef R_DictionaryView_h
+#define R_DictionaryView_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+#include "R_MutableData.h"
+#include "R_Dictionary.h"
+
+/*  R_DictionaryView
+    A read-only dictionary tree that is read in place from a flat, offset-based file instead of being parsed. Files are
+   memory-mapped, so opening one costs nothing up front, the pages are loaded on first touch and every process that
+   opens the same file shares them. Lookups, sizes and iteration read straight from the mapped bytes without allocating.
+
+    Dictionary keys are stored sorted so get is a binary search, and iteration visits keys in byte order rather than
+   the order they were added. Files are limited to 4GB and can only be read on a host with the same byte order as the
+   one that wrote them.
+ */
+typedef struct R_DictionaryView R_DictionaryView;
+R_Type_Declare(R_DictionaryView);
+
+/*  R_DictionaryView_Kind
+    What a value holds. R_MutableData and R_Data are both stored as Bytes.
+ */
+typedef enum {
+  R_DictionaryView_Kind_Missing = 0,
+  R_DictionaryView_Kind_Null,
+  R_DictionaryView_Kind_Boolean,
+  R_DictionaryView_Kind_Integer,
+  R_DictionaryView_Kind_Unsigned,
+  R_DictionaryView_Kind_Float,
+  R_DictionaryView_Kind_String,
+  R_DictionaryView_Kind_Bytes,
+  R_DictionaryView_Kind_List,
+  R_DictionaryView_Kind_Dictionary,
+  R_DictionaryView_Kind_IntArray,
+  R_DictionaryView_Kind_FloatArray,
+  R_DictionaryView_Kind_DoubleArray,
+} R_DictionaryView_Kind;
+
+/*  R_DictionaryView_Value
+    A handle to one value in an open view. It's small and passed by value, and stays valid until the view is closed or
+   deleted. Looking up something that doesn't exist gives a value of kind Missing, which every accessor accepts.
+ */
+typedef struct {
+  const R_DictionaryView* view;
+  uint32_t kind;
+  uint32_t payload;
+} R_DictionaryView_Value;
+
+/*  R_DictionaryView_open
+    Maps the file at path and checks its header. Returns NULL if the file can't be mapped or isn't a view file.
+ */
+R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_open(R_DictionaryView* self, const char* path);
+
+/*  R_DictionaryView_openBytes
+    Reads a view from memory that's already loaded. The bytes aren't copied, must stay alive while the view is open and
+   must be 8-byte aligned.
+ */
+R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_openBytes(R_DictionaryView* self, const uint8_t* bytes, size_t size);
+
+/*  R_DictionaryView_close
+    Unmaps the file, if one is open. Deleting the view also closes it.
+ */
+R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_close(R_DictionaryView* self);
+
+/*  R_DictionaryView_root
+    Returns the top-level dictionary, or a Missing value if nothing is open.
+ */
+R_DictionaryView_Value R_FUNCTION_ATTRIBUTES R_DictionaryView_root(R_DictionaryView* self);
+
+/*  R_DictionaryView_get
+    Returns the value with the given key, or a Missing value if the key doesn't exist or dictionary isn't a dictionary.
+ */
+R_DictionaryView_Value R_FUNCTION_ATTRIBUTES R_DictionaryView_get(R_DictionaryView_Value dictionary, const char* key);
+
+/*  R_DictionaryView_size
+    Returns the number of keys in a dictionary, elements in a list or typed array, or bytes in a string or byte array.
+   Returns 0 for anything else.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_DictionaryView_size(R_DictionaryView_Value value);
+
+/*  R_DictionaryView_keyAt
+    Returns the NULL-terminated key at the given index of a dictionary, or NULL if it's out of range.
+ */
+const char* R_FUNCTION_ATTRIBUTES R_DictionaryView_keyAt(R_DictionaryView_Value dictionary, size_t index);
+
+/*  R_DictionaryView_valueAt
+    Returns the value at the given index of a dictionary or list, or a Missing value if it's out of range.
+ */
+R_DictionaryView_Value R_FUNCTION_ATTRIBUTES R_DictionaryView_valueAt(R_DictionaryView_Value container, size_t index);
+
+/*  R_DictionaryView_kind
+    Returns what the value holds.
+ */
+R_DictionaryView_Kind R_FUNCTION_ATTRIBUTES R_DictionaryView_kind(R_DictionaryView_Value value);
+
+/*  R_DictionaryView_getInteger
+    Scalar getters. Return 0 or false if the value holds a different kind.
+ */
+int R_FUNCTION_ATTRIBUTES R_DictionaryView_getInteger(R_DictionaryView_Value value);
+unsigned int R_FUNCTION_ATTRIBUTES R_DictionaryView_getUnsigned(R_DictionaryView_Value value);
+float R_FUNCTION_ATTRIBUTES R_DictionaryView_getFloat(R_DictionaryView_Value value);
+bool R_FUNCTION_ATTRIBUTES R_DictionaryView_getBoolean(R_DictionaryView_Value value);
+
+/*  R_DictionaryView_getString
+    Returns a pointer to the NULL-terminated string in the file. Use R_DictionaryView_size for its length. Returns NULL
+   if the value isn't a string.
+ */
+const char* R_FUNCTION_ATTRIBUTES R_DictionaryView_getString(R_DictionaryView_Value value);
+
+/*  R_DictionaryView_getBytes
+    Returns a pointer to the bytes in the file, or NULL if the value isn't a byte array.
+ */
+const uint8_t* R_FUNCTION_ATTRIBUTES R_DictionaryView_getBytes(R_DictionaryView_Value value);
+
+/*  R_DictionaryView_getInts
+    Returns a pointer to the typed array's values in the file, or NULL if the value is a different kind.
+ */
+const int* R_FUNCTION_ATTRIBUTES R_DictionaryView_getInts(R_DictionaryView_Value value);
+const float* R_FUNCTION_ATTRIBUTES R_DictionaryView_getFloats(R_DictionaryView_Value value);
+const double* R_FUNCTION_ATTRIBUTES R_DictionaryView_getDoubles(R_DictionaryView_Value value);
+
+/*  R_DictionaryView_write
+    Converts the dictionary tree into the view format, replacing the contents of buffer. Values of types that can't be
+   stored are written as null. Returns NULL if the output would be larger than 4GB.
+ */
+R_MutableData* R_FUNCTION_ATTRIBUTES R_DictionaryView_write(R_Dictionary* dictionary, R_MutableData* buffer);
+
+/*  R_DictionaryView_writeFile
+    Converts the dictionary and replaces the file at path with it, using R_OS_writeFile so views that already have the
+   old file open are unaffected. Returns false on error.
+ */
+bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writeFile(R_Dictionary* dictionary, const char* path);
+
+#endif /* R_DictionaryView_h */
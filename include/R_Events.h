@@ -11,6 +11,16 @@ R_Type_Declare(R_Events);
  */
 typedef void (*R_Events_Callback)(void* target, const char* event_key, void* payload);
 
+/* R_Events_BatchCallback
+   The callback format used to register for batches of events. All payloads delivered by one notifyBatch or drain are passed in a single call.
+ */
+typedef void (*R_Events_BatchCallback)(void* target, const char* event_key, void** payloads, size_t count);
+
+/* R_Events_Merger
+   Used by coalescing keys to fold a newly posted payload into the pending one. Returns the payload that should stay pending.
+ */
+typedef void* (*R_Events_Merger)(void* pending_payload, void* new_payload);
+
 /* R_Events_Register
    Register an event handler.
  */
@@ -21,11 +31,21 @@ R_Events* R_FUNCTION_ATTRIBUTES R_Events_register(R_Events* self, const char* ev
  */
 R_Events* R_FUNCTION_ATTRIBUTES R_Events_registerOnce(R_Events* self, const char* event_key, void* target, R_Events_Callback callback);
 
+/* R_Events_RegisterBatch
+   Register an event handler that receives every payload of a batch in one call.
+ */
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_registerBatch(R_Events* self, const char* event_key, void* target, R_Events_BatchCallback callback);
+
 /* R_Events_Remove
    Remove an event handler.
  */
 R_Events* R_FUNCTION_ATTRIBUTES R_Events_remove(R_Events* self, const char* event_key, const void* target, R_Events_Callback callback);
 
+/* R_Events_RemoveBatch
+   Remove a batch event handler.
+ */
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_removeBatch(R_Events* self, const char* event_key, const void* target, R_Events_BatchCallback callback);
+
 /* R_Events_RemoveTarget
    Removes all events registered by the given target. Useful for object destructors.
  */
@@ -36,6 +56,35 @@ R_Events* R_FUNCTION_ATTRIBUTES R_Events_removeTarget(R_Events* self, const void
  */
 R_Events* R_FUNCTION_ATTRIBUTES R_Events_notify(R_Events* self, const char* event_key, void* payload);
 
+/* R_Events_NotifyBatch
+   Send several payloads for one event key. The key is only looked up once. Batch handlers are called once with every
+   payload, regular handlers are called once per payload (run-once handlers only see the first payload).
+ */
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_notifyBatch(R_Events* self, const char* event_key, void** payloads, size_t count);
+
+/* R_Events_SetCoalescing
+   Turns coalescing on or off for the given key. While on, R_Events_post queues payloads for the key instead of
+   delivering them and R_Events_drain delivers everything queued as one batch. If merger isn't NULL, queued payloads
+   are folded into a single payload with it. Turning coalescing off delivers anything still pending.
+ */
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_setCoalescing(R_Events* self, const char* event_key, bool enabled, R_Events_Merger merger);
+
+/* R_Events_Post
+   Queues the payload if the key is coalescing, otherwise it's the same as R_Events_notify. Payloads are not owned by
+   R_Events so they must stay valid until they're drained.
+ */
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_post(R_Events* self, const char* event_key, void* payload);
+
+/* R_Events_Drain
+   Delivers all queued payloads of every coalescing key, one batch per key.
+ */
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_drain(R_Events* self);
+
+/* R_Events_PendingCount
+   Returns the number of payloads queued for the given key.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Events_pendingCount(R_Events* self, const char* event_key);
+
 /* R_Events_IsRegistered
    Returns true if the event handler has been registered or false if not. Returns false on error.
  */
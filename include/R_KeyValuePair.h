@@ -9,8 +9,56 @@ typedef struct R_KeyValuePair R_KeyValuePair;
 R_Type_Declare(R_KeyValuePair);
 
 R_MutableString* R_FUNCTION_ATTRIBUTES R_KeyValuePair_key(R_KeyValuePair* pair);
+
+/*  R_KeyValuePair_value
+    Returns the value as an R_Type object, which the pair keeps owning. Integers, floats, booleans and nulls stored
+   inline are boxed the first time this is called, and the box is kept with the pair and holds the value from then on,
+   so changes made through it are kept. Values that implement R_Materialize, like the unparsed children of a lazily
+   parsed dictionary, are built and kept the same way. The box or built object is published atomically, so any number
+   of threads can call this on the same pair at once; changing what it returns is still a change.
+ */
 void* R_FUNCTION_ATTRIBUTES R_KeyValuePair_value(R_KeyValuePair* pair);
+
+/*  R_KeyValuePair_readValue
+    Returns a new reference to the value that the caller owns, without boxing or building anything into the pair.
+   Inline scalars come back in a new box and unbuilt values are built into a new object each time, neither of which
+   is kept. Other values are retained, or copied when built without R_TYPE_REFCOUNT. The caller deletes the result.
+   NULL if there's no value.
+ */
+void* R_FUNCTION_ATTRIBUTES R_KeyValuePair_readValue(R_KeyValuePair* pair);
 R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setKey(R_KeyValuePair* pair, const char* key);
 R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setValue(R_KeyValuePair* pair, void* value);
 
+/*  R_KeyValuePair_valueType
+    Returns the R_Type of the value without boxing or building it, so it never changes the pair. An inline integer
+   reports R_Integer, etc., and a value that implements R_MaterializedType reports what it would build. NULL if
+   there's no value.
+ */
+const R_Type* R_FUNCTION_ATTRIBUTES R_KeyValuePair_valueType(R_KeyValuePair* pair);
+
+/*  R_KeyValuePair_setInteger
+    Stores the scalar inline in the pair, without allocating an R_Type object. Replaces any previous value.
+ */
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setInteger(R_KeyValuePair* pair, int value);
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setFloat(R_KeyValuePair* pair, float value);
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setBoolean(R_KeyValuePair* pair, bool value);
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setNull(R_KeyValuePair* pair);
+
+/*  R_KeyValuePair_getInteger
+    Returns the scalar whether it's stored inline or boxed. Returns 0 or false if the value is a different type.
+ */
+int R_FUNCTION_ATTRIBUTES R_KeyValuePair_getInteger(R_KeyValuePair* pair);
+float R_FUNCTION_ATTRIBUTES R_KeyValuePair_getFloat(R_KeyValuePair* pair);
+bool R_FUNCTION_ATTRIBUTES R_KeyValuePair_getBoolean(R_KeyValuePair* pair);
+
+/*  R_KeyValuePair_copyValue
+    Deep-copies source's value into self, keeping inline scalars inline. Returns NULL if the value can't be copied.
+ */
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_copyValue(R_KeyValuePair* self, R_KeyValuePair* source);
+
+/*  R_KeyValuePair_moveValue
+    Hands source's value to self without copying it, replacing self's value. source is left without a value.
+ */
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_moveValue(R_KeyValuePair* self, R_KeyValuePair* source);
+
 #endif /* R_KeyValuePair_h */
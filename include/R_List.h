@@ -27,13 +27,28 @@ void* R_FUNCTION_ATTRIBUTES R_List_transferOwnership(R_List* self, void* object)
  */
 void* R_FUNCTION_ATTRIBUTES R_List_addCopy(R_List* self, const void* object);
 
+#ifdef R_TYPE_REFCOUNT
+/*  R_List_addShared
+    Retains the given object and appends it to the list without copying it. The caller keeps its own reference, and the
+   object is freed once the list and every other owner have let go of it. See R_Type_Retain.
+ */
+void* R_FUNCTION_ATTRIBUTES R_List_addShared(R_List* self, void* object);
+#endif
+
 /*  R_List_appendList
     Appends the given list by adding a copy of every element. Returns NULL on the first failed copy.
  */
 void* R_FUNCTION_ATTRIBUTES R_List_appendList(R_List* self, R_List* list);
 
-/*  R_List_appendList
-    Appends the given list by transfering ownership of every element. Returns NULL on the first failed copy.
+/*  R_List_splice
+    Moves every element of list onto the end of self, in order, leaving list empty. Nothing is copied: if self is empty
+   it takes over list's pointer array, otherwise the pointers are appended with one memcpy. Returns NULL if self and
+   list are the same or self couldn't grow, in which case both are left as they were.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_List_splice(R_List* self, R_List* list);
+
+/*  R_List_transferList
+    The same as R_List_splice.
  */
 void* R_FUNCTION_ATTRIBUTES R_List_transferList(R_List* self, R_List* list);
 
@@ -47,11 +62,38 @@ void R_FUNCTION_ATTRIBUTES R_List_removeIndex(R_List* self, size_t index);
  */
 void R_FUNCTION_ATTRIBUTES R_List_removePointer(R_List* self, void* pointer);
 
+/*  R_List_removeRange
+    Removes count objects starting at the given index and destroys them.
+ */
+void R_FUNCTION_ATTRIBUTES R_List_removeRange(R_List* self, size_t index, size_t count);
+
+/*  R_List_swapRemove
+    Removes the object at the given index and destroys it by moving the last object into its place. This doesn't keep the
+   order of the list but doesn't move any other objects.
+ */
+void R_FUNCTION_ATTRIBUTES R_List_swapRemove(R_List* self, size_t index);
+
+/*  R_List_Predicate
+    Used to select objects in a list. Context is passed through untouched.
+ */
+typedef bool (*R_List_Predicate)(void* object, void* context);
+
+/*  R_List_removeIf
+    Removes and destroys every object the predicate returns true for, in a single pass. The order of the remaining objects
+   is kept. Returns the number of objects removed.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_List_removeIf(R_List* self, R_List_Predicate predicate, void* context);
+
 /*  R_List_removeAll
     Empties the list and destroys all objects.
  */
 void R_FUNCTION_ATTRIBUTES R_List_removeAll(R_List* self);
 
+/*  R_List_reserve
+    Makes sure the list can hold at least count objects without allocating again.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_List_reserve(R_List* self, size_t count);
+
 /*  R_List_pointerAtIndex
     Returns the object at the given index or NULL.
  */
@@ -84,7 +126,7 @@ size_t R_FUNCTION_ATTRIBUTES R_List_size(R_List* self);
 void R_FUNCTION_ATTRIBUTES R_List_pop(R_List* self);
 
 /*  R_List_shift
-    Removes the first object in the list and destroys it.
+    Removes the first object in the list and destroys it. This doesn't move the rest of the list.
  */
 void R_FUNCTION_ATTRIBUTES R_List_shift(R_List* self);
 
@@ -93,6 +135,80 @@ void R_FUNCTION_ATTRIBUTES R_List_shift(R_List* self);
  */
 void R_FUNCTION_ATTRIBUTES R_List_swap(R_List* self, int indexA, int indexB);
 
+/*  R_List_pointers
+    Returns the internal array of object pointers. This is not a copy!
+ */
+void** R_FUNCTION_ATTRIBUTES R_List_pointers(R_List* self);
+
+/*  R_List_Comparator
+    Orders two objects in a list. Returns less than, equal to or greater than zero when object_a sorts before, the same as
+   or after object_b.
+ */
+typedef int (*R_List_Comparator)(void* object_a, void* object_b);
+
+/*  R_List_sort
+    Sorts the list in place using an introsort. If comparator is NULL, the objects' R_Compare interface is used. This sort
+   isn't stable.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_List_sort(R_List* self, R_List_Comparator comparator);
+
+/*  R_List_stableSort
+    Sorts the list in place using a merge sort, keeping equal objects in their original order. If comparator is NULL, the
+   objects' R_Compare interface is used. Returns NULL if the temporary buffer couldn't be allocated.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_List_stableSort(R_List* self, R_List_Comparator comparator);
+
+/*  R_List_parallelSort
+    Sorts the list in place by sorting chunks on separate threads then merging them. If threads is 0, R_OS_cpuCount() is
+   used. Small lists, or builds without threads, fall back to R_List_sort. This sort isn't stable.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_List_parallelSort(R_List* self, R_List_Comparator comparator, size_t threads);
+
+/*  R_List_binarySearch
+    Finds an object that compares equal to the given object in a list sorted with the same comparator. Returns the
+   lowest matching index or -1 if there isn't a match. If comparator is NULL, the given object's R_Compare interface is used.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_List_binarySearch(R_List* self, const void* object, R_List_Comparator comparator);
+
+/*  R_List_Mapper
+    Returns a new object made from the given one, which the caller takes ownership of, or NULL on failure. Context is
+   passed through untouched.
+ */
+typedef void* (*R_List_Mapper)(void* object, void* context);
+
+/*  R_List_Reducer, R_List_Combiner
+    A reducer folds one object into the accumulator. A combiner folds partial, an accumulator another thread reduced a
+   slice of the list into, into the accumulator.
+ */
+typedef void (*R_List_Reducer)(void* accumulator, void* object, void* context);
+typedef void (*R_List_Combiner)(void* accumulator, void* partial, void* context);
+
+/*  R_List_map, R_List_filter, R_List_reduce
+    These split the list into contiguous slices and run them with R_OS_parallelRun, on at most threads threads. If threads
+   is 0, R_OS_cpuCount() is used, and 1 runs everything on the calling thread. Small lists aren't split. The functions
+   passed in may be called from several threads at once, so they mustn't change the objects they're given.
+ */
+
+/*  R_List_map
+    Returns a new list holding the mapper's result for every object, in the list's order. Returns NULL if the mapper
+   fails for any object or memory runs out.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_List_map(R_List* self, R_List_Mapper mapper, void* context, size_t threads);
+
+/*  R_List_filter
+    Returns a new list sharing every object the predicate returns true for, in the list's order. See R_List_addShared.
+   Built without R_TYPE_REFCOUNT, the list holds copies instead. Returns NULL if memory runs out.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_List_filter(R_List* self, R_List_Predicate predicate, void* context, size_t threads);
+
+/*  R_List_reduce
+    Folds every object into accumulator, an R_Type object, and returns it. Each slice after the first is reduced into a
+   copy of accumulator as it was passed in, so it should start out empty, like 0 for a sum. The copies are then combined
+   into accumulator in the list's order, so the result only depends on the number of slices. Without a combiner, or if
+   accumulator can't be copied, the list is reduced on the calling thread.
+ */
+void* R_FUNCTION_ATTRIBUTES R_List_reduce(R_List* self, void* accumulator, R_List_Reducer reducer, R_List_Combiner combiner, void* context, size_t threads);
+
 /*  R_List_each
     Sets up a loop to iterate over the list.
  */
@@ -17,6 +17,18 @@ R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_reset(R_MutableData* self);
 
 size_t R_FUNCTION_ATTRIBUTES R_MutableData_stringify(R_MutableData* self, char* buffer, size_t size);
 
+/*  R_MutableData_take
+    Frees self's bytes and takes over source's buffer instead of copying it. source is left empty.
+*/
+R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_take(R_MutableData* self, R_MutableData* source);
+
+/*  R_MutableData_share
+    Frees self's bytes and points it at source's buffer, so both hold the same bytes without copying them. The buffer
+   is copied the first time either array writes into it, and freed with the last array using it. Shifting and popping
+   only move an array's view, so they don't copy. R_Type_Copy of an R_MutableData or R_MutableString shares this way.
+*/
+R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_share(R_MutableData* self, R_MutableData* source);
+
 /*  R_MutableData_setByte
     Empties the array and appends a single byte.
 */
@@ -139,6 +151,11 @@ R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_unshift(R_MutableData* self,
  */
 uint8_t R_FUNCTION_ATTRIBUTES R_MutableData_shift(R_MutableData* self);
 
+/*  R_MutableData_shiftBytes
+    Removes the first count bytes from the array without moving the rest. Removes everything if count is larger than the array.
+ */
+R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_shiftBytes(R_MutableData* self, size_t count);
+
 /*  R_MutableData_moveSubArray
     Removes the given number of bytes from the second param and appends them to the first.
  */
@@ -149,6 +166,11 @@ R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_moveSubArray(R_MutableData* s
  */
 int R_FUNCTION_ATTRIBUTES R_MutableData_compare(const R_MutableData* self, const R_MutableData* comparor);
 
+/*  R_MutableData_order
+    Orders the arrays byte-by-byte like memcmp, with a shorter array sorting before a longer one it's a prefix of.
+ */
+int R_FUNCTION_ATTRIBUTES R_MutableData_order(const R_MutableData* self, const R_MutableData* comparor);
+
 /*  R_MutableData_isSame
     Returns true if the arrays are equal length and have identical contents.
  */
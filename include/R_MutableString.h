@@ -25,6 +25,11 @@ const char* R_FUNCTION_ATTRIBUTES R_MutableString_getString(R_MutableString* sel
 
 size_t R_FUNCTION_ATTRIBUTES R_MutableString_stringify(R_MutableString* self, char* buffer, size_t size);
 
+/*  R_MutableString_take
+    Replaces self's characters with source's by taking over its buffer instead of copying it. source is left empty.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_take(R_MutableString* self, R_MutableString* source);
+
 /*  R_MutableString_first
     Returns the first character of the string.
  */
@@ -35,6 +40,11 @@ char R_FUNCTION_ATTRIBUTES R_MutableString_first(const R_MutableString* self);
  */
 char R_FUNCTION_ATTRIBUTES R_MutableString_shift(R_MutableString* self);
 
+/*  R_MutableString_shiftCharacters
+    Removes the first count characters from the string.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_shiftCharacters(R_MutableString* self, size_t count);
+
 /*  R_MutableString_first
     Returns the last character of the string.
  */
@@ -117,6 +127,11 @@ int R_FUNCTION_ATTRIBUTES R_MutableString_getInt(R_MutableString* self);
  */
 R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendFloat(R_MutableString* self, float value);
 
+/*  R_MutableString_appendDouble
+    Converts the given double to a string with enough digits to read back the same value, and appends it.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendDouble(R_MutableString* self, double value);
+
 /*  R_MutableString_getFloat
     Converts the string to a float and returns it.
  */
@@ -147,8 +162,14 @@ bool R_FUNCTION_ATTRIBUTES R_MutableString_isSame(R_MutableString* self, R_Mutab
  */
 bool R_FUNCTION_ATTRIBUTES R_MutableString_compare(const R_MutableString* self, const char* comparor);
 
+/*  R_MutableString_order
+    Orders the strings byte-by-byte like strcmp. Returns less than, equal to or greater than zero.
+ */
+int R_FUNCTION_ATTRIBUTES R_MutableString_order(const R_MutableString* self, const R_MutableString* comparor);
+
 /*  R_MutableString_appendStringAsJson
-    Formats string as a quoted JSON-formatted string value and appends it to self.
+    Formats string as a quoted JSON-formatted string value and appends it to self. Control characters without a short
+   escape are written as \u00XX.
  */
 R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendStringAsJson(R_MutableString* self, R_MutableString* string);
 
@@ -0,0 +1,68 @@
+#ifndef R_Ndjson_h
+#define R_Ndjson_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+#include "R_MutableData.h"
+#include "R_Dictionary.h"
+
+/*  R_Ndjson
+    Newline-delimited json: one object per line. The readers parse each line into the same R_Dictionary and hand it
+   to a callback, and the writer buffers lines and flushes them to a file descriptor, so memory use stays the same no
+   matter how many records go through.
+
+    Blank lines are ignored and a '\r' before the '\n' is allowed. Lines that aren't a single valid json object are
+   skipped.
+ */
+
+/*  R_Ndjson_Callback
+    Called with each record. The dictionary is reused for the next line, so copy anything that needs to outlive the
+   call. Return false to stop reading.
+ */
+typedef bool (*R_Ndjson_Callback)(R_Dictionary* record, void* context);
+
+/*  R_Ndjson_each
+    Reads every line of the buffer, which may be memory-mapped with R_OS_mapFile. The lines aren't copied out of it
+   beyond the one being parsed. Returns the number of records passed to callback.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Ndjson_each(R_Dictionary* record, const char* bytes, size_t size, uint32_t options, R_Ndjson_Callback callback, void* context);
+
+/*  R_Ndjson_eachFromFd
+    Reads lines from the file descriptor until the end of the file, in blocks of R_Ndjson_BlockSize. The block grows
+   only if a single line is longer than it. Returns the number of records passed to callback.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Ndjson_eachFromFd(R_Dictionary* record, int fd, uint32_t options, R_Ndjson_Callback callback, void* context);
+
+#define R_Ndjson_BlockSize (64*1024)
+
+/*  R_NdjsonWriter
+    Appends records to a buffer as json lines. With a file descriptor set, the buffer is written out whenever it
+   reaches the flush size, and when the writer is deleted. Without one, lines accumulate in the buffer.
+ */
+typedef struct R_NdjsonWriter R_NdjsonWriter;
+R_Type_Declare(R_NdjsonWriter);
+
+/*  R_NdjsonWriter_setFd
+    Flushes to fd once the buffer holds flush_size bytes. Pass -1 to keep everything in the buffer, or a flush_size
+   of 0 for R_Ndjson_BlockSize. Anything already buffered is flushed to the old descriptor first.
+ */
+R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_setFd(R_NdjsonWriter* self, int fd, size_t flush_size);
+
+/*  R_NdjsonWriter_write
+    Appends the record and a newline to the buffer, flushing if it's full. Returns NULL if the flush fails.
+ */
+R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_write(R_NdjsonWriter* self, R_Dictionary* record);
+
+/*  R_NdjsonWriter_flush
+    Writes out and empties the buffer, keeping its allocation. Does nothing without a file descriptor. Returns NULL on
+   a write error, leaving the buffer as it was.
+ */
+R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_flush(R_NdjsonWriter* self);
+
+/*  R_NdjsonWriter_buffer
+    Returns the lines that haven't been flushed yet.
+ */
+R_MutableData* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_buffer(R_NdjsonWriter* self);
+
+#endif /* R_Ndjson_h */
@@ -0,0 +1,107 @@
+#ifndef R_NumericArray_h
+#define R_NumericArray_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+
+/*  R_IntArray, R_FloatArray and R_DoubleArray
+    Contiguous arrays of unboxed numbers. They implement copy, R_Stringify and R_Equals like the other builtins and are
+   written to JSON as plain arrays. Each type has the same set of methods.
+ */
+typedef struct R_IntArray R_IntArray;
+typedef struct R_FloatArray R_FloatArray;
+typedef struct R_DoubleArray R_DoubleArray;
+R_Type_Declare(R_IntArray);
+R_Type_Declare(R_FloatArray);
+R_Type_Declare(R_DoubleArray);
+
+/*  R_IntArray_append
+    Appends the value to the end of the array, allocating more memory if required.
+ */
+R_IntArray* R_FUNCTION_ATTRIBUTES R_IntArray_append(R_IntArray* self, int value);
+R_FloatArray* R_FUNCTION_ATTRIBUTES R_FloatArray_append(R_FloatArray* self, float value);
+R_DoubleArray* R_FUNCTION_ATTRIBUTES R_DoubleArray_append(R_DoubleArray* self, double value);
+
+/*  R_IntArray_appendCArray
+    Appends count values from the given C array. The values are copied.
+ */
+R_IntArray* R_FUNCTION_ATTRIBUTES R_IntArray_appendCArray(R_IntArray* self, const int* values, size_t count);
+R_FloatArray* R_FUNCTION_ATTRIBUTES R_FloatArray_appendCArray(R_FloatArray* self, const float* values, size_t count);
+R_DoubleArray* R_FUNCTION_ATTRIBUTES R_DoubleArray_appendCArray(R_DoubleArray* self, const double* values, size_t count);
+
+/*  R_IntArray_get
+    Returns the value at the given index or 0 if the index is out of range.
+ */
+int R_FUNCTION_ATTRIBUTES R_IntArray_get(R_IntArray* self, size_t index);
+float R_FUNCTION_ATTRIBUTES R_FloatArray_get(R_FloatArray* self, size_t index);
+double R_FUNCTION_ATTRIBUTES R_DoubleArray_get(R_DoubleArray* self, size_t index);
+
+/*  R_IntArray_set
+    Replaces the value at the given index. Returns NULL if the index is out of range.
+ */
+R_IntArray* R_FUNCTION_ATTRIBUTES R_IntArray_set(R_IntArray* self, size_t index, int value);
+R_FloatArray* R_FUNCTION_ATTRIBUTES R_FloatArray_set(R_FloatArray* self, size_t index, float value);
+R_DoubleArray* R_FUNCTION_ATTRIBUTES R_DoubleArray_set(R_DoubleArray* self, size_t index, double value);
+
+/*  R_IntArray_values
+    Returns a C Array pointer to the values. This is not a copy!
+ */
+const int* R_FUNCTION_ATTRIBUTES R_IntArray_values(R_IntArray* self);
+const float* R_FUNCTION_ATTRIBUTES R_FloatArray_values(R_FloatArray* self);
+const double* R_FUNCTION_ATTRIBUTES R_DoubleArray_values(R_DoubleArray* self);
+
+/*  R_IntArray_size
+    Returns the number of values in the array.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_IntArray_size(R_IntArray* self);
+size_t R_FUNCTION_ATTRIBUTES R_FloatArray_size(R_FloatArray* self);
+size_t R_FUNCTION_ATTRIBUTES R_DoubleArray_size(R_DoubleArray* self);
+
+/*  R_IntArray_reserve
+    Makes sure the array can hold at least count values without allocating again.
+ */
+R_IntArray* R_FUNCTION_ATTRIBUTES R_IntArray_reserve(R_IntArray* self, size_t count);
+R_FloatArray* R_FUNCTION_ATTRIBUTES R_FloatArray_reserve(R_FloatArray* self, size_t count);
+R_DoubleArray* R_FUNCTION_ATTRIBUTES R_DoubleArray_reserve(R_DoubleArray* self, size_t count);
+
+/*  R_IntArray_reset
+    Empties the array but does not free any memory.
+ */
+R_IntArray* R_FUNCTION_ATTRIBUTES R_IntArray_reset(R_IntArray* self);
+R_FloatArray* R_FUNCTION_ATTRIBUTES R_FloatArray_reset(R_FloatArray* self);
+R_DoubleArray* R_FUNCTION_ATTRIBUTES R_DoubleArray_reset(R_DoubleArray* self);
+
+/*  R_IntArray_sum
+    Returns the sum of every value. Integers are summed as 64 bits and floats as doubles.
+ */
+int64_t R_FUNCTION_ATTRIBUTES R_IntArray_sum(R_IntArray* self);
+double R_FUNCTION_ATTRIBUTES R_FloatArray_sum(R_FloatArray* self);
+double R_FUNCTION_ATTRIBUTES R_DoubleArray_sum(R_DoubleArray* self);
+
+/*  R_IntArray_min
+    Returns the smallest value or 0 if the array is empty.
+ */
+int R_FUNCTION_ATTRIBUTES R_IntArray_min(R_IntArray* self);
+float R_FUNCTION_ATTRIBUTES R_FloatArray_min(R_FloatArray* self);
+double R_FUNCTION_ATTRIBUTES R_DoubleArray_min(R_DoubleArray* self);
+
+/*  R_IntArray_max
+    Returns the largest value or 0 if the array is empty.
+ */
+int R_FUNCTION_ATTRIBUTES R_IntArray_max(R_IntArray* self);
+float R_FUNCTION_ATTRIBUTES R_FloatArray_max(R_FloatArray* self);
+double R_FUNCTION_ATTRIBUTES R_DoubleArray_max(R_DoubleArray* self);
+
+/*  R_IntArray_isSame
+    Returns true if the arrays are the same length and have identical values.
+ */
+bool R_FUNCTION_ATTRIBUTES R_IntArray_isSame(R_IntArray* self, R_IntArray* comparor);
+bool R_FUNCTION_ATTRIBUTES R_FloatArray_isSame(R_FloatArray* self, R_FloatArray* comparor);
+bool R_FUNCTION_ATTRIBUTES R_DoubleArray_isSame(R_DoubleArray* self, R_DoubleArray* comparor);
+
+size_t R_FUNCTION_ATTRIBUTES R_IntArray_stringify(R_IntArray* self, char* buffer, size_t size);
+size_t R_FUNCTION_ATTRIBUTES R_FloatArray_stringify(R_FloatArray* self, char* buffer, size_t size);
+size_t R_FUNCTION_ATTRIBUTES R_DoubleArray_stringify(R_DoubleArray* self, char* buffer, size_t size);
+
+#endif /* R_NumericArray_h */
@@ -2,15 +2,23 @@
 #define R_OS_h
 
 #include <string.h>
+#include <stdbool.h>
 
-void* os_realloc_alt(void* old_ptr, size_t new_size);
+/*  R_OS_UNKNOWN_SIZE
+    Passed as the old size of a block when the caller doesn't know it.
+ */
+#define R_OS_UNKNOWN_SIZE ((size_t)-1)
+
+void* os_realloc_alt(void* old_ptr, size_t old_size, size_t new_size);
 int os_atoi_alt(const char* string);
 double os_atof_alt(const char* string);
 
 #ifdef ESP8266
   #include "mem.h"
   #include "osapi.h"
-  #define os_realloc os_realloc_alt
+  //The SDK's heap can't tell os_realloc_alt how big a block is, so only the sized form is provided here
+  #define os_realloc_sized(pointer, old_size, size) os_realloc_alt(pointer, old_size, size)
+  #define os_free_sized(pointer, size) os_free(pointer)
   #define os_atoi os_atoi_alt
   #define os_atof os_atof_alt
   #define os_snprintf(s, n, ...) os_printf(s, __VA_ARGS__)
@@ -23,13 +31,18 @@ double os_atof_alt(const char* string);
 #else
   #include <string.h>
   #include <stdio.h>
-  #define os_calloc calloc
-  #define os_zalloc(size) os_calloc(1,size)
-  #define os_free free
-  #define os_malloc malloc
+  #include <stdlib.h>
+  #define R_OS_ALLOCATOR 1
+  #define os_calloc(count, size) R_Allocator_zalloc((count)*(size), __FILE__, __LINE__, NULL)
+  #define os_zalloc(size) R_Allocator_zalloc(size, __FILE__, __LINE__, NULL)
+  #define os_free(pointer) R_Allocator_free(pointer, R_OS_UNKNOWN_SIZE, __FILE__, __LINE__, NULL)
+  #define os_free_sized(pointer, size) R_Allocator_free(pointer, size, __FILE__, __LINE__, NULL)
+  #define os_malloc(size) R_Allocator_malloc(size, __FILE__, __LINE__, NULL)
   #define os_memcmp memcmp
+  #define os_atof atof
   #define os_printf printf
-  #define os_realloc realloc
+  #define os_realloc(pointer, size) R_Allocator_realloc(pointer, R_OS_UNKNOWN_SIZE, size, __FILE__, __LINE__, NULL)
+  #define os_realloc_sized(pointer, old_size, size) R_Allocator_realloc(pointer, old_size, size, __FILE__, __LINE__, NULL)
   #define os_sscanf sscanf
   #define os_strlen strlen
   #define os_strstr strstr
@@ -40,5 +53,135 @@ double os_atof_alt(const char* string);
 
   #define R_FUNCTION_ATTRIBUTES
 #endif
+
+#ifdef R_OS_ALLOCATOR
+/*  R_Allocator_Site
+    Where an allocation was made. tag is the R_Type name for objects and NULL for other buffers.
+ */
+typedef struct {
+  const char* file;
+  int line;
+  const char* tag;
+} R_Allocator_Site;
+
+/*  R_Allocator
+    The memory functions every os_malloc, os_zalloc, os_realloc and os_free call in the library goes through. context
+   is passed back to each function. The site describes the caller, may be NULL and may be ignored. old_size and size are the
+   block's size as the caller knows it, or R_OS_UNKNOWN_SIZE. The library passes them wherever it keeps track.
+ */
+typedef struct {
+  void* (*malloc)(void* context, size_t size, const R_Allocator_Site* site);
+  void* (*zalloc)(void* context, size_t size, const R_Allocator_Site* site);
+  void* (*realloc)(void* context, void* pointer, size_t old_size, size_t size, const R_Allocator_Site* site);
+  void (*free)(void* context, void* pointer, size_t size, const R_Allocator_Site* site);
+  void* context;
+} R_Allocator;
+
+/*  R_Allocator_set
+    Replaces the allocator for every thread that hasn't set its own. NULL restores the system allocator. Memory must
+   be freed by the allocator that made it, so only swap allocators when nothing from the old one is still alive, or
+   when the new one forwards to it.
+ */
+void R_Allocator_set(const R_Allocator* allocator);
+
+/*  R_Allocator_setForThread
+    Replaces the allocator for the calling thread only. NULL goes back to the one given to R_Allocator_set. Blocks
+   from a thread's allocator must not be freed or grown on a thread using a different one.
+ */
+void R_Allocator_setForThread(const R_Allocator* allocator);
+
+/*  R_Allocator_get
+    Returns the allocator the calling thread is using. Never NULL.
+ */
+const R_Allocator* R_Allocator_get(void);
+
+/*  R_Allocator_system
+    The allocator built on malloc, calloc, realloc and free.
+ */
+const R_Allocator* R_Allocator_system(void);
+
+void* R_Allocator_malloc(size_t size, const char* file, int line, const char* tag);
+void* R_Allocator_zalloc(size_t size, const char* file, int line, const char* tag);
+void* R_Allocator_realloc(void* pointer, size_t old_size, size_t size, const char* file, int line, const char* tag);
+void R_Allocator_free(void* pointer, size_t size, const char* file, int line, const char* tag);
+#endif
+
+#if !defined(ESP8266) && !defined(R_OS_NO_THREADS)
+  #define R_OS_THREADS 1
+  #include <pthread.h>
+#elif !defined(ESP8266)
+  typedef int pthread_mutex_t;
+  #define pthread_mutex_lock(mutex_pointer) do {(*(mutex_pointer))++; } while(0)
+  #define pthread_mutex_unlock(mutex_pointer) do {(*(mutex_pointer))--; } while(0)
+  #define pthread_mutex_init(mutex_pointer, options) do {*(mutex_pointer)=0; } while(0)
+  #define pthread_mutex_destroy(mutex_pointer) do {} while(0)
+#endif
+
+/*  R_OS_Task
+    A unit of work for R_OS_parallelRun.
+ */
+typedef void (*R_OS_Task)(void* context);
+
+/*  R_OS_cpuCount
+    Returns the number of online CPUs, or 1 when built without threads.
+ */
+size_t R_OS_cpuCount(void);
+
+/*  R_OS_parallelRun
+    Runs task once for every context and returns when all of them have finished. The calls run concurrently when
+   built with threads and one after the other when not. With a dispatcher installed the calls go to it, and some may
+   run one after the other on the same thread, so they mustn't wait on each other.
+ */
+void R_OS_parallelRun(R_OS_Task task, void** contexts, size_t count);
+
+/*  R_OS_Dispatcher
+    Somewhere else for R_OS_parallelRun to send its calls, such as the workers of an R_ThreadPool. run calls task once
+   for every context and returns when they've all finished, or returns false without calling any, and then
+   R_OS_parallelRun starts threads for them instead.
+ */
+typedef struct {
+  bool (*run)(void* context, R_OS_Task task, void** contexts, size_t count);
+  void* context;
+} R_OS_Dispatcher;
+
+/*  R_OS_setDispatcher
+    Installs the dispatcher R_OS_parallelRun uses, or NULL to go back to starting threads on every call. Any thread may
+   install one while others are running, but a call that has already loaded the old dispatcher still uses it, so the
+   old one must stay valid until those calls have returned.
+ */
+void R_OS_setDispatcher(const R_OS_Dispatcher* dispatcher);
+
+/*  R_OS_dispatcher
+    Returns the installed dispatcher, or NULL.
+ */
+const R_OS_Dispatcher* R_OS_dispatcher(void);
+
+/*  R_OS_mapFile
+    Maps the whole file read-only and sets size to its length. The pages are shared with every other process mapping
+   the same file. Returns NULL if the file is empty, can't be mapped, or the platform has no memory mapping (ESP8266).
+ */
+const void* R_OS_mapFile(const char* path, size_t* size);
+
+/*  R_OS_unmapFile
+    Releases a mapping made by R_OS_mapFile.
+ */
+void R_OS_unmapFile(const void* pointer, size_t size);
+
+/*  R_OS_writeFile
+    Writes the bytes to a temporary file next to path and renames it over path, so processes that have the old file
+   mapped keep seeing the old contents. Returns false on any error.
+ */
+bool R_OS_writeFile(const char* path, const void* bytes, size_t size);
+
+/*  R_OS_read
+    Reads up to size bytes from the file descriptor, retrying if a signal interrupts it. Returns the number of bytes
+   read, 0 at the end of the file, or -1 on error or on platforms without file descriptors (ESP8266).
+ */
+long R_OS_read(int fd, void* buffer, size_t size);
+
+/*  R_OS_write
+    Writes all of the bytes to the file descriptor, retrying short writes. Returns false on error.
+ */
+bool R_OS_write(int fd, const void* bytes, size_t size);
  
 #endif /* R_OS_h */
@@ -0,0 +1,127 @@
+#ifndef R_OrderedDictionary_h
+#define R_OrderedDictionary_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+#include "R_MutableString.h"
+#include "R_KeyValuePair.h"
+#include "R_Dictionary.h"
+
+/*  R_OrderedDictionary
+    A dictionary that keeps its keys sorted by their bytes, the order R_Dictionary_JsonOutput_SortedKeys writes them
+   in. It's a B-tree with up to 31 pairs per node, and each node keeps the first 8 bytes of its keys side by side, so
+   most of a lookup's comparisons are integer compares within one node. Lookups, adds and removes take O(log n), and
+   the pairs between two keys, or under a prefix, are visited without looking at the rest.
+
+    Values are owned by the dictionary, as with R_Dictionary. Visited pairs belong to the dictionary and must not be
+   changed or removed while it's being iterated.
+ */
+typedef struct R_OrderedDictionary R_OrderedDictionary;
+R_Type_Declare(R_OrderedDictionary);
+
+/*  R_OrderedDictionary_Callback
+    Called with each pair in key order. Return false to stop.
+ */
+typedef bool (*R_OrderedDictionary_Callback)(R_KeyValuePair* pair, void* context);
+
+/*  R_OrderedDictionary_addObjectOfType
+    Allocates an instance of the given type, sets it as the value of key and returns it.
+ */
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_addObjectOfType(R_OrderedDictionary* self, const char* key, const R_Type* type);
+#define R_OrderedDictionary_add(self, key, Type) (Type*)R_OrderedDictionary_addObjectOfType(self, key, R_Type_Object(Type))
+
+/*  R_OrderedDictionary_addCopy
+    Sets a copy of object as the value of key and returns the copy.
+ */
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_addCopy(R_OrderedDictionary* self, const char* key, const void* object);
+
+#ifdef R_TYPE_REFCOUNT
+/*  R_OrderedDictionary_addShared
+    Retains object and sets it as the value of key without copying it. See R_Dictionary_addShared.
+ */
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_addShared(R_OrderedDictionary* self, const char* key, void* object);
+#endif
+
+/*  R_OrderedDictionary_transferOwnership
+    Sets object as the value of key without copying it. The dictionary takes over the caller's reference.
+ */
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_transferOwnership(R_OrderedDictionary* self, const char* key, void* object);
+
+/*  R_OrderedDictionary_setInteger
+    Sets key to the value, stored inline in the pair as R_Dictionary does.
+ */
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setInteger(R_OrderedDictionary* self, const char* key, int value);
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setFloat(R_OrderedDictionary* self, const char* key, float value);
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setBoolean(R_OrderedDictionary* self, const char* key, bool value);
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setNull(R_OrderedDictionary* self, const char* key);
+
+/*  R_OrderedDictionary_get
+    Returns the value of key, or NULL if it doesn't exist.
+ */
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_get(R_OrderedDictionary* self, const char* key);
+
+/*  R_OrderedDictionary_getInteger
+    Returns the value of key, as R_KeyValuePair_getInteger does.
+ */
+int R_FUNCTION_ATTRIBUTES R_OrderedDictionary_getInteger(R_OrderedDictionary* self, const char* key);
+float R_FUNCTION_ATTRIBUTES R_OrderedDictionary_getFloat(R_OrderedDictionary* self, const char* key);
+bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_getBoolean(R_OrderedDictionary* self, const char* key);
+
+/*  R_OrderedDictionary_isPresent
+    Returns true if the key exists.
+ */
+bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_isPresent(R_OrderedDictionary* self, const char* key);
+
+/*  R_OrderedDictionary_remove
+    Removes key and deletes its value. Returns false if key doesn't exist.
+ */
+bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_remove(R_OrderedDictionary* self, const char* key);
+
+/*  R_OrderedDictionary_removeAll
+    Removes every key.
+ */
+void R_FUNCTION_ATTRIBUTES R_OrderedDictionary_removeAll(R_OrderedDictionary* self);
+
+/*  R_OrderedDictionary_size
+    Returns the number of keys.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_size(R_OrderedDictionary* self);
+
+/*  R_OrderedDictionary_lowerBound
+    Returns the pair with the first key that isn't less than key, or NULL if every key is less.
+ */
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_lowerBound(R_OrderedDictionary* self, const char* key);
+
+/*  R_OrderedDictionary_each
+    Calls callback with every pair, in key order. Returns the number of pairs visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_each(R_OrderedDictionary* self, R_OrderedDictionary_Callback callback, void* context);
+
+/*  R_OrderedDictionary_range
+    Calls callback with every pair from the key from up to but not including the key to, in key order. A NULL from
+   starts at the first key and a NULL to runs to the last. Returns the number of pairs visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_range(R_OrderedDictionary* self, const char* from, const char* to, R_OrderedDictionary_Callback callback, void* context);
+
+/*  R_OrderedDictionary_eachWithPrefix
+    Calls callback with every pair whose key starts with prefix, in key order. Returns the number of pairs visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_eachWithPrefix(R_OrderedDictionary* self, const char* prefix, R_OrderedDictionary_Callback callback, void* context);
+
+/*  R_OrderedDictionary_fromJson
+    Adds every member of the json object, replacing the values of keys already there. Nested objects become
+   R_Dictionary. Returns NULL if buffer isn't a string.
+ */
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_fromJson(R_OrderedDictionary* self, R_MutableString* buffer);
+
+/*  R_OrderedDictionary_toJson
+    Writes the dictionary to the given string as json, in key order. Takes the same R_Dictionary_JsonOutput flags as
+   R_Dictionary_toJsonWithOptions.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_toJson(R_OrderedDictionary* self, R_MutableString* buffer);
+R_MutableString* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_toJsonWithOptions(R_OrderedDictionary* self, R_MutableString* buffer, uint32_t options);
+
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_stringify(R_OrderedDictionary* self, char* buffer, size_t size);
+
+#endif /* R_OrderedDictionary_h */
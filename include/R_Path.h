@@ -0,0 +1,70 @@
+#ifndef R_Path_h
+#define R_Path_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+#include "R_MutableString.h"
+#include "R_Dictionary.h"
+
+/*  R_Path
+    A compiled path to values inside a dictionary tree or a JSON document. The path string is parsed once into a list
+   of steps, so a path that's evaluated many times only pays for the lookups.
+
+    Two syntaxes are accepted. A path that's empty or starts with '/' is an RFC 6901 JSON Pointer, like
+   "/orders/3/line_items/0/price", where ~0 and ~1 stand for '~' and '/'. Anything else is a dot path, like
+   "orders[3].line_items[*].price", optionally starting with "$". Dot paths use .name or ["name"] for keys, [n] for list
+   indexes and .* or [*] to match every value in a list or dictionary.
+
+    A key step that's a plain number, like "/orders/3" or "orders.3", also indexes into lists. Typed arrays are leaves
+   and can't be indexed.
+ */
+typedef struct R_Path R_Path;
+R_Type_Declare(R_Path);
+
+/*  R_Path_Visitor
+    Called for each value a path matches. Return false to stop.
+ */
+typedef bool (*R_Path_Visitor)(void* value, void* context);
+
+/*  R_Path_JsonVisitor
+    Called for each value a path matches in a JSON document, with the value's text. The text points into the document
+   and isn't NULL-terminated. Return false to stop.
+ */
+typedef bool (*R_Path_JsonVisitor)(const char* json, size_t length, void* context);
+
+/*  R_Path_compile
+    Parses the path, replacing whatever was compiled before. Returns NULL if the path isn't valid.
+ */
+R_Path* R_FUNCTION_ATTRIBUTES R_Path_compile(R_Path* self, const char* path);
+
+/*  R_Path_size
+    Returns the number of steps in the compiled path. An empty path matches the root itself.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Path_size(R_Path* self);
+
+/*  R_Path_get
+    Returns the first value the path matches in root, which may be an R_Dictionary or an R_List, or NULL if nothing
+   matches. Inline scalars are boxed and lazily parsed values are parsed on the way, as with R_Dictionary_get.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Path_get(R_Path* self, void* root);
+
+/*  R_Path_each
+    Calls visitor with every value the path matches in root, in order. Returns the number of values visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Path_each(R_Path* self, void* root, R_Path_Visitor visitor, void* context);
+
+/*  R_Path_getJson
+    Finds the first value the path matches in the JSON document and replaces the contents of result with its text.
+   Only the parts of the document the path passes through are looked at, and nothing is parsed into objects. Returns
+   NULL if nothing matches.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_Path_getJson(R_Path* self, R_MutableString* json, R_MutableString* result);
+
+/*  R_Path_eachJson
+    Calls visitor with the text of every value the path matches in the JSON document. Returns the number of values
+   visited. Stops at the first syntax error it runs into, so the count may be short for malformed documents.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Path_eachJson(R_Path* self, R_MutableString* json, R_Path_JsonVisitor visitor, void* context);
+
+#endif /* R_Path_h */
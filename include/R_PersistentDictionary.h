@@ -0,0 +1,111 @@
+#ifndef R_PersistentDictionary_h
+#define R_PersistentDictionary_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+#include "R_MutableString.h"
+#include "R_KeyValuePair.h"
+#include "R_Dictionary.h"
+#include "R_PersistentList.h"
+
+//Built on R_Type_Retain, so only there with R_TYPE_REFCOUNT
+#ifdef R_TYPE_REFCOUNT
+
+/*  R_PersistentDictionary
+    An immutable dictionary. Every change returns a new version and leaves the one it was made from as it was, so
+   taking a snapshot is free: keep the version. It's a hash array mapped trie, where each node picks one of 32
+   children with 5 bits of the key's hash, so a change only copies the few nodes on the path to its key and shares
+   the rest with the old version. An update costs O(log32 n) time and memory instead of a copy of the whole dictionary.
+
+    Keys are visited in hash order, not the order they were added. Values are R_Type objects shared between versions
+   with R_Type_Retain, so they must not be changed once they're in a dictionary. Put an R_PersistentDictionary or
+   R_PersistentList under a key to nest them, and set a new version of the child under the same key to update it.
+   R_Type_Copy of a version doesn't copy anything, it shares the same tree.
+ */
+typedef struct R_PersistentDictionary R_PersistentDictionary;
+R_Type_Declare(R_PersistentDictionary);
+
+/*  R_PersistentDictionary_Callback
+    Called with each pair. The pair is shared with other versions and must not be changed. Return false to stop.
+ */
+typedef bool (*R_PersistentDictionary_Callback)(R_KeyValuePair* pair, void* context);
+
+/*  R_PersistentDictionary_set
+    Returns a new version with key set to value, replacing any value it had. The new version takes over the caller's
+   reference to value, as with R_Dictionary_transferOwnership. Returns NULL, and deletes value, if the new version
+   can't be made.
+ */
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_set(R_PersistentDictionary* self, const char* key, void* value);
+
+/*  R_PersistentDictionary_setInteger
+    Returns a new version with key set to a new R_Integer, R_Float, R_Boolean or R_Null.
+ */
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setInteger(R_PersistentDictionary* self, const char* key, int value);
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setFloat(R_PersistentDictionary* self, const char* key, float value);
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setBoolean(R_PersistentDictionary* self, const char* key, bool value);
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setNull(R_PersistentDictionary* self, const char* key);
+
+/*  R_PersistentDictionary_remove
+    Returns a new version without key. If key isn't there, the new version shares the whole tree with self.
+ */
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_remove(R_PersistentDictionary* self, const char* key);
+
+/*  R_PersistentDictionary_get
+    Returns the value of key, or NULL if it doesn't exist.
+ */
+void* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_get(R_PersistentDictionary* self, const char* key);
+
+/*  R_PersistentDictionary_getInteger
+    Returns the value of key, or 0 or false if it doesn't exist or holds a different type.
+ */
+int R_FUNCTION_ATTRIBUTES R_PersistentDictionary_getInteger(R_PersistentDictionary* self, const char* key);
+float R_FUNCTION_ATTRIBUTES R_PersistentDictionary_getFloat(R_PersistentDictionary* self, const char* key);
+bool R_FUNCTION_ATTRIBUTES R_PersistentDictionary_getBoolean(R_PersistentDictionary* self, const char* key);
+
+/*  R_PersistentDictionary_isPresent
+    Returns true if the key exists.
+ */
+bool R_FUNCTION_ATTRIBUTES R_PersistentDictionary_isPresent(R_PersistentDictionary* self, const char* key);
+
+/*  R_PersistentDictionary_size
+    Returns the number of keys.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_size(R_PersistentDictionary* self);
+
+/*  R_PersistentDictionary_each
+    Calls callback with every pair, in hash order. Returns the number of pairs visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_each(R_PersistentDictionary* self, R_PersistentDictionary_Callback callback, void* context);
+
+/*  R_PersistentDictionary_fromDictionary
+    Returns a new version with a copy of every pair of dictionary added. Dictionaries and lists in it, at any depth,
+   become R_PersistentDictionary and R_PersistentList. The new nodes are filled in place rather than copied for each
+   key. Returns NULL if a value can't be copied.
+ */
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_fromDictionary(R_PersistentDictionary* self, R_Dictionary* dictionary);
+
+/*  R_PersistentDictionary_toDictionary
+    Adds a copy of every pair to dictionary. R_PersistentDictionary and R_PersistentList values become R_Dictionary
+   and R_List. Returns NULL if a value can't be copied.
+ */
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_toDictionary(R_PersistentDictionary* self, R_Dictionary* dictionary);
+
+/*  R_PersistentDictionary_fromJson
+    Returns a new version with every member of the json object added, as with R_PersistentDictionary_fromDictionary.
+   Returns NULL if buffer isn't a string.
+ */
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_fromJson(R_PersistentDictionary* self, R_MutableString* buffer);
+
+/*  R_PersistentDictionary_toJson
+    Writes the dictionary to the given string as json, in hash order, or sorted with R_Dictionary_JsonOutput_SortedKeys.
+   Takes the same R_Dictionary_JsonOutput flags as R_Dictionary_toJsonWithOptions.
+ */
+R_MutableString* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_toJson(R_PersistentDictionary* self, R_MutableString* buffer);
+R_MutableString* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_toJsonWithOptions(R_PersistentDictionary* self, R_MutableString* buffer, uint32_t options);
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_stringify(R_PersistentDictionary* self, char* buffer, size_t size);
+
+#endif
+
+#endif /* R_PersistentDictionary_h */
@@ -0,0 +1,78 @@
+#ifndef R_PersistentList_h
+#define R_PersistentList_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+#include "R_List.h"
+
+//Built on R_Type_Retain, so only there with R_TYPE_REFCOUNT
+#ifdef R_TYPE_REFCOUNT
+
+/*  R_PersistentList
+    An immutable list. Every change returns a new version and leaves the one it was made from as it was, so a version
+   can be handed to readers while writers keep going. Versions share everything a change didn't touch: the elements
+   live in a tree of 32-wide nodes, and a change only copies the nodes on the path to it, plus a 32-element tail that
+   appends go into. An update costs O(log32 n) time and memory instead of a copy of the whole list.
+
+    Elements are R_Type objects shared between versions with R_Type_Retain, so they must not be changed once they're
+   in a list. R_Type_Copy of a version doesn't copy anything, it shares the same tree.
+ */
+typedef struct R_PersistentList R_PersistentList;
+R_Type_Declare(R_PersistentList);
+
+/*  R_PersistentList_Callback
+    Called with each element in order. Return false to stop.
+ */
+typedef bool (*R_PersistentList_Callback)(void* object, void* context);
+
+/*  R_PersistentList_append
+    Returns a new version with object added to the end. The new version takes over the caller's reference to object,
+   as with R_List_transferOwnership. Returns NULL, and deletes object, if the new version can't be made.
+ */
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_append(R_PersistentList* self, void* object);
+
+/*  R_PersistentList_set
+    Returns a new version with the element at index replaced by object, taking over the caller's reference to it.
+   Returns NULL, and deletes object, if index is past the end.
+ */
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_set(R_PersistentList* self, size_t index, void* object);
+
+/*  R_PersistentList_pop
+    Returns a new version without the last element. Returns NULL if the list is empty.
+ */
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_pop(R_PersistentList* self);
+
+/*  R_PersistentList_get
+    Returns the element at index, or NULL if index is past the end.
+ */
+void* R_FUNCTION_ATTRIBUTES R_PersistentList_get(R_PersistentList* self, size_t index);
+
+/*  R_PersistentList_size
+    Returns the number of elements.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_PersistentList_size(R_PersistentList* self);
+
+/*  R_PersistentList_each
+    Calls callback with every element in order, a node at a time. Returns the number of elements visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_PersistentList_each(R_PersistentList* self, R_PersistentList_Callback callback, void* context);
+
+/*  R_PersistentList_fromList
+    Returns a new version with a copy of every element of list appended. Dictionaries and lists in it, at any depth,
+   become R_PersistentDictionary and R_PersistentList. The new nodes are filled in place rather than copied for each
+   element. Returns NULL if an element can't be copied.
+ */
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_fromList(R_PersistentList* self, R_List* list);
+
+/*  R_PersistentList_toList
+    Appends a copy of every element to list. R_PersistentDictionary and R_PersistentList elements become R_Dictionary
+   and R_List. Returns NULL if an element can't be copied.
+ */
+R_List* R_FUNCTION_ATTRIBUTES R_PersistentList_toList(R_PersistentList* self, R_List* list);
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentList_stringify(R_PersistentList* self, char* buffer, size_t size);
+
+#endif
+
+#endif /* R_PersistentList_h */
@@ -0,0 +1,68 @@
+#ifndef R_Queue_h
+#define R_Queue_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+
+/*  R_Queue
+    A bounded first-in first-out queue of R_Type objects that any number of threads can push to and pop from at once.
+   It's a ring of cells that's allocated once, so it never reallocates, and pushing or popping takes a compare and
+   swap on the queue's head or tail but no lock. The queue owns what's in it: a successful push takes over the
+   caller's reference, and a pop hands it to the caller. Objects still queued are deleted with the queue.
+
+    R_Queue_pushWait and R_Queue_popWait sleep while the queue is full or empty. Close the queue to wake them up when
+   no more objects are coming. Built without threads, they can't wait for anyone and return straight away.
+ */
+typedef struct R_Queue R_Queue;
+R_Type_Declare(R_Queue);
+
+/*  R_Queue_setCapacity
+    Sets how many objects the queue holds, rounded up to a power of two. A new queue holds 256. Only call this while
+   the queue is empty and no other thread is using it. Returns NULL if the queue isn't empty or the ring can't be
+   allocated.
+ */
+R_Queue* R_FUNCTION_ATTRIBUTES R_Queue_setCapacity(R_Queue* self, size_t capacity);
+
+/*  R_Queue_capacity
+    Returns the number of objects the queue holds when it's full.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Queue_capacity(R_Queue* self);
+
+/*  R_Queue_size
+    Returns the number of objects in the queue. Other threads may change it at any time.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Queue_size(R_Queue* self);
+
+/*  R_Queue_push
+    Adds the object to the back of the queue and takes over the caller's reference to it. Returns false if the queue
+   is full or closed, and the caller keeps the object.
+ */
+bool R_FUNCTION_ATTRIBUTES R_Queue_push(R_Queue* self, void* object);
+
+/*  R_Queue_pop
+    Removes the object at the front of the queue and returns it. The caller owns it. Returns NULL if the queue is empty.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Queue_pop(R_Queue* self);
+
+/*  R_Queue_pushWait
+    Like R_Queue_push, but waits for room while the queue is full. Returns false if the queue is closed.
+ */
+bool R_FUNCTION_ATTRIBUTES R_Queue_pushWait(R_Queue* self, void* object);
+
+/*  R_Queue_popWait
+    Like R_Queue_pop, but waits for an object while the queue is empty. Returns NULL once the queue is closed and empty.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Queue_popWait(R_Queue* self);
+
+/*  R_Queue_close
+    Stops any more objects from being pushed and wakes every waiting thread. Objects already queued can still be popped.
+ */
+void R_FUNCTION_ATTRIBUTES R_Queue_close(R_Queue* self);
+
+/*  R_Queue_isClosed
+    Returns true once R_Queue_close has been called.
+ */
+bool R_FUNCTION_ATTRIBUTES R_Queue_isClosed(R_Queue* self);
+
+#endif /* R_Queue_h */
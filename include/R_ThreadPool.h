@@ -0,0 +1,91 @@
+#ifndef R_ThreadPool_h
+#define R_ThreadPool_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_OS.h"
+#include "R_Type.h"
+
+//Built on R_Type_Retain, so only there with R_TYPE_REFCOUNT
+#ifdef R_TYPE_REFCOUNT
+
+/*  R_ThreadPool
+    A fixed set of worker threads that run submitted tasks. Each worker has its own deque of tasks: it takes its newest
+   task first, while it's likely still in cache, and a worker that runs out takes the oldest task from another's deque.
+   A task submitted from a worker goes to that worker's deque, so tasks that split their work keep it close.
+
+    A new pool has a worker for every CPU, or none on a single-core machine. With no workers, or when built without
+   threads, a submitted task runs on the caller before R_ThreadPool_submit returns. Waiting threads run queued tasks
+   instead of blocking, so tasks can submit and wait on other tasks without running out of workers.
+
+    Install a pool with R_ThreadPool_install to have R_OS_parallelRun, and everything built on it, use its workers
+   instead of starting threads on every call.
+ */
+typedef struct R_ThreadPool R_ThreadPool;
+R_Type_Declare(R_ThreadPool);
+
+/*  R_ThreadPool_Task
+    A handle to a submitted task. The caller owns it and deletes it when it's done with it, which doesn't cancel the
+   task: the pool keeps its own reference until the task has run.
+ */
+typedef struct R_ThreadPool_Task R_ThreadPool_Task;
+R_Type_Declare(R_ThreadPool_Task);
+
+/*  R_ThreadPool_RangeTask
+    Called by R_ThreadPool_parallelFor with one slice of the indexes, from begin up to but not including end.
+ */
+typedef void (*R_ThreadPool_RangeTask)(void* context, size_t begin, size_t end);
+
+/*  R_ThreadPool_setThreads
+    Replaces the workers with count new ones, once every task submitted so far has finished. 0 runs every task on the
+   thread that submits it. Returns NULL if a thread can't be started, leaving the workers that did start.
+ */
+R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_setThreads(R_ThreadPool* self, size_t count);
+
+/*  R_ThreadPool_threads
+    Returns the number of worker threads.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_ThreadPool_threads(R_ThreadPool* self);
+
+/*  R_ThreadPool_submit
+    Queues task to be called with context on a worker, and returns its handle. Returns NULL if the handle can't be
+   allocated, in which case the task has already run on the calling thread.
+ */
+R_ThreadPool_Task* R_FUNCTION_ATTRIBUTES R_ThreadPool_submit(R_ThreadPool* self, R_OS_Task task, void* context);
+
+/*  R_ThreadPool_isDone
+    Returns true once the task has finished running.
+ */
+bool R_FUNCTION_ATTRIBUTES R_ThreadPool_isDone(R_ThreadPool_Task* task);
+
+/*  R_ThreadPool_wait
+    Returns when the task has finished. The calling thread runs queued tasks in the meantime.
+ */
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_wait(R_ThreadPool* self, R_ThreadPool_Task* task);
+
+/*  R_ThreadPool_waitAll
+    Returns when every task submitted to the pool has finished, including any they submit. The calling thread runs
+   queued tasks in the meantime. A task must not call this, since it would be waiting for itself.
+ */
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_waitAll(R_ThreadPool* self);
+
+/*  R_ThreadPool_parallelFor
+    Calls task with slices of the indexes 0 to count, spread over the workers and the calling thread, and returns when
+   every slice is done. Slices are smaller than an even share per thread, so workers that finish early steal the rest.
+ */
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_parallelFor(R_ThreadPool* self, R_ThreadPool_RangeTask task, void* context, size_t count);
+
+/*  R_ThreadPool_install
+    Installs the pool as the dispatcher for R_OS_parallelRun, or uninstalls whichever pool is installed when given
+   NULL. The application still owns the pool, and uninstalls it before deleting it.
+ */
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_install(R_ThreadPool* self);
+
+/*  R_ThreadPool_installed
+    Returns the pool R_OS_parallelRun is using, or NULL if none is installed.
+ */
+R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_installed(void);
+
+#endif
+
+#endif /* R_ThreadPool_h */
@@ -0,0 +1,98 @@
+#ifndef R_Trie_h
+#define R_Trie_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "R_Type.h"
+
+/*  R_Trie
+    A map from string keys to objects, kept as an adaptive radix tree: each node branches on one byte of the key, and
+   a run of bytes with no branch in it is stored once, in the node below it, instead of as a chain of nodes. Nodes
+   hold 4, 16, 48 or 256 children and change size as children come and go, so keys that share a prefix share its
+   bytes and most nodes stay small.
+
+    Lookups take time in the length of the key rather than the number of keys, and the keys under a prefix, or the
+   longest key that's a prefix of some string, are found without looking at the rest. Keys are compared byte by byte
+   and come back in that order.
+
+    Values are owned by the trie, as with R_Dictionary. Visited values belong to the trie, and keys must not be added
+   or removed while it's being iterated.
+ */
+typedef struct R_Trie R_Trie;
+R_Type_Declare(R_Trie);
+
+/*  R_Trie_Callback
+    Called with each key and its value, in key order. key is only valid during the call. Return false to stop.
+ */
+typedef bool (*R_Trie_Callback)(const char* key, void* value, void* context);
+
+/*  R_Trie_addObjectOfType
+    Allocates an instance of the given type, sets it as the value of key and returns it.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Trie_addObjectOfType(R_Trie* self, const char* key, const R_Type* type);
+#define R_Trie_add(self, key, Type) (Type*)R_Trie_addObjectOfType(self, key, R_Type_Object(Type))
+
+/*  R_Trie_addCopy
+    Sets a copy of object as the value of key and returns the copy.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Trie_addCopy(R_Trie* self, const char* key, const void* object);
+
+#ifdef R_TYPE_REFCOUNT
+/*  R_Trie_addShared
+    Retains object and sets it as the value of key without copying it. See R_Dictionary_addShared.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Trie_addShared(R_Trie* self, const char* key, void* object);
+#endif
+
+/*  R_Trie_transferOwnership
+    Sets object as the value of key without copying it. The trie takes over the caller's reference.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Trie_transferOwnership(R_Trie* self, const char* key, void* object);
+
+/*  R_Trie_get
+    Returns the value of key, or NULL if it doesn't exist.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Trie_get(R_Trie* self, const char* key);
+
+/*  R_Trie_isPresent
+    Returns true if the key exists.
+ */
+bool R_FUNCTION_ATTRIBUTES R_Trie_isPresent(R_Trie* self, const char* key);
+
+/*  R_Trie_longestPrefix
+    Returns the value of the longest key that string starts with, or NULL if there's none, and sets length to that
+   key's length if it isn't NULL. The empty key matches every string.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Trie_longestPrefix(R_Trie* self, const char* string, size_t* length);
+
+/*  R_Trie_remove
+    Removes key and deletes its value. Returns false if key doesn't exist.
+ */
+bool R_FUNCTION_ATTRIBUTES R_Trie_remove(R_Trie* self, const char* key);
+
+/*  R_Trie_removeAll
+    Removes every key.
+ */
+void R_FUNCTION_ATTRIBUTES R_Trie_removeAll(R_Trie* self);
+
+/*  R_Trie_size
+    Returns the number of keys.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Trie_size(R_Trie* self);
+
+/*  R_Trie_each
+    Calls callback with every key, in key order. Returns the number of keys visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Trie_each(R_Trie* self, R_Trie_Callback callback, void* context);
+
+/*  R_Trie_eachWithPrefix
+    Calls callback with every key that starts with prefix, in key order. Returns the number of keys visited.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Trie_eachWithPrefix(R_Trie* self, const char* prefix, R_Trie_Callback callback, void* context);
+
+/*  R_Trie_bytesUsed
+    Returns the bytes taken by the trie's nodes, not counting the values.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Trie_bytesUsed(R_Trie* self);
+
+#endif /* R_Trie_h */
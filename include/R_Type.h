@@ -7,6 +7,17 @@
 #include <stdint.h>
 #include "R_JumpTable.h"
 
+/*  R_TYPE_REFCOUNT
+    When defined, every object carries its owner count in a header just before it, and R_Type_Retain lets several owners
+   share it. It's on everywhere but ESP8266, where the header's 8 bytes on every object cost too much heap. Define
+   R_TYPE_REFCOUNT to have it there anyway, or R_TYPE_NO_REFCOUNT to leave it out elsewhere. Without it every object
+   has one owner, and the types built on sharing, R_PersistentDictionary, R_PersistentList, R_ConcurrentDictionary and
+   R_ThreadPool, aren't available.
+ */
+#if !defined(ESP8266) && !defined(R_TYPE_NO_REFCOUNT) && !defined(R_TYPE_REFCOUNT)
+  #define R_TYPE_REFCOUNT 1
+#endif
+
 /*  R_Type_Constructor
     Function Pointer for an R_Type constructor. Input is an allocated space of memory. Output
    is an initialized object.
@@ -32,6 +43,13 @@ typedef void* (*R_Type_Destructor)(void* object);
 */
 typedef void* (*R_Type_Copier)(const void* object_input, void* object_output);
 
+/*  R_Type_Mover
+    Function Pointer for an R_Type mover. Used to move an object without copying it. Everything object_input owns is
+   handed to object_output, a newly allocated and inited object of the same type, and object_input is left empty but
+   still usable. Returns object_output, or NULL on failure, in which case R_Type_Move deletes object_output.
+*/
+typedef void* (*R_Type_Mover)(void* object_input, void* object_output);
+
 /*  R_Type
     Struct used to describe an object.
  */
@@ -42,6 +60,8 @@ typedef struct {
   R_Type_Destructor dtor; //May be NULL. If not, free is called on its result during 'delete'.
   R_Type_Copier copy; //If set to NULL, 'copy' will always fail. If not NULL, it's called during 'copy' to do deep copying.
   R_JumpTable* interfaces; //A jump table to define implemented interfaces.
+  const char* name; //Set by R_Type_Def and R_Type_Define. Used to label allocations.
+  R_Type_Mover move; //May be NULL, in which case 'move' falls back to 'copy'. Set with R_Type_Define.
 } R_Type;
 
 #define R_Type_Object(Type) R_Type__ ## Type
@@ -52,10 +72,11 @@ typedef struct {
     (R_Type_Constructor)ctor, \
     (R_Type_Destructor)dtor, \
     (R_Type_Copier)copier, \
-    jump_table \
+    jump_table, \
+    #Type \
   }
 
-#define R_Type_Define(Type, ...) const R_Type* R_Type_Object(Type) = &(R_Type){ .size = sizeof(Type), __VA_ARGS__ }
+#define R_Type_Define(Type, ...) const R_Type* R_Type_Object(Type) = &(R_Type){ .size = sizeof(Type), .name = #Type, __VA_ARGS__ }
 
 #define R_Type_Declare(Type) extern const R_Type* R_Type_Object(Type)
 
@@ -63,14 +84,43 @@ typedef struct {
     Allocates a new object of the given type. Allocates and nulls type->size bytes than calls type->ctor, if it isn't null.
  */
 void* R_FUNCTION_ATTRIBUTES R_Type_NewObjectOfType(const R_Type* type);
-#define R_Type_New(Type) (Type*)R_Type_NewObjectOfType(R_Type_Object(Type))
+
+/*  R_Type_NewObjectOfTypeAt
+    Same as R_Type_NewObjectOfType but tells the allocator which file and line asked for the object.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Type_NewObjectOfTypeAt(const R_Type* type, const char* file, int line);
+#ifdef R_OS_ALLOCATOR
+  #define R_Type_New(Type) (Type*)R_Type_NewObjectOfTypeAt(R_Type_Object(Type), __FILE__, __LINE__)
+#else
+  #define R_Type_New(Type) (Type*)R_Type_NewObjectOfType(R_Type_Object(Type))
+#endif
 
 /*  R_Type_Delete
     Gives the memory allocated to the given object back to the system. If type->dtor isn't null, free is called on the result
-   of it. If type->dtor is null, free is called on the given object.
+   of it. If type->dtor is null, free is called on the given object. If the object has been retained, this only drops one
+   reference and the object is freed along with the last one.
  */
 void R_FUNCTION_ATTRIBUTES R_Type_Delete(void* object);
 
+#ifdef R_TYPE_REFCOUNT
+/*  R_Type_Retain
+    Adds an owner to the object and returns it. Every object made by R_Type_New starts with one owner, and each owner
+   gives its reference back with R_Type_Release (or R_Type_Delete, which is the same thing). Containers free their
+   contents with R_Type_Delete, so a retained object can be held by any number of lists and dictionaries at once, see
+   R_List_addShared and R_Dictionary_addShared. The count is atomic when built with threads.
+
+    Owners share one object, so changing it changes it for all of them. Treat shared objects as read-only.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Type_Retain(void* object);
+#define R_Type_Release(object) R_Type_Delete(object)
+
+/*  R_Type_References
+    Returns the number of owners the object has, or 0 for NULL.
+ */
+size_t R_FUNCTION_ATTRIBUTES R_Type_References(const void* object);
+#define R_Type_IsShared(object) (R_Type_References(object) > 1)
+#endif
+
 /*  R_Type_DeleteAndNull
     Convenience macro that runs R_Type_Delete against the object then sets the object to NULL.
  */
@@ -82,6 +132,13 @@ void R_FUNCTION_ATTRIBUTES R_Type_Delete(void* object);
  */
 void* R_FUNCTION_ATTRIBUTES R_Type_Copy(const void* object);
 
+/*  R_Type_Move
+    Moves the given object's contents into a new object of the same type and returns it, leaving the original empty. No
+   memory is copied if type->move is set, only ownership changes hands. If it isn't, or the object is shared with
+   R_Type_Retain, this is the same as R_Type_Copy and the original is left as it was.
+ */
+void* R_FUNCTION_ATTRIBUTES R_Type_Move(void* object);
+
 /*  R_Type_Type(void* object);
     Returns whether the object is the given type/class. Casts the given object to an R_Type** then dereferences and compares it. Useful as shorthand.
  */
@@ -100,6 +157,18 @@ int R_FUNCTION_ATTRIBUTES R_Type_IsObjectNotOfType(const void* object, const R_T
  */
 extern size_t R_Type_BytesAllocated;
 
+/*  R_Type_addBytesAllocated
+    Adjusts R_Type_BytesAllocated. The update is atomic when built with threads, since objects may be created and
+   deleted on several threads at once.
+ */
+#ifdef R_OS_THREADS
+  #define R_Type_addBytesAllocated(size) ((void)__atomic_add_fetch(&R_Type_BytesAllocated, (size), __ATOMIC_RELAXED))
+  #define R_Type_subtractBytesAllocated(size) ((void)__atomic_sub_fetch(&R_Type_BytesAllocated, (size), __ATOMIC_RELAXED))
+#else
+  #define R_Type_addBytesAllocated(size) ((void)(R_Type_BytesAllocated += (size)))
+  #define R_Type_subtractBytesAllocated(size) ((void)(R_Type_BytesAllocated -= (size)))
+#endif
+
 void R_Puts(void* object);
 #define R_Stringify(object, buffer, size) R_Type_call(object, R_Stringify, object, buffer, size)
 R_JumpTable_DeclareKey(R_Stringify);
@@ -109,6 +178,29 @@ R_JumpTable_DeclareFunction(R_Stringify, size_t, void*, char*, size_t);
 R_JumpTable_DeclareKey(R_Equals);
 R_JumpTable_DeclareFunction(R_Equals, bool, void*, void*);
 
+/*  R_Compare
+    Orders two objects. Returns less than, equal to or greater than zero when object1 sorts before, the same as or after object2.
+ */
+#define R_Compare(object1, object2) R_Type_call(object1, R_Compare, object1, object2)
+R_JumpTable_DeclareKey(R_Compare);
+R_JumpTable_DeclareFunction(R_Compare, int, void*, void*);
+
+/*  R_Materialize
+    Implemented by placeholders that stand in for an object that hasn't been built yet, like the unparsed children of a
+   lazily parsed R_Dictionary. Returns the real object, which the caller owns, or NULL on error.
+ */
+#define R_Materialize(object) R_Type_call(object, R_Materialize, object)
+R_JumpTable_DeclareKey(R_Materialize);
+R_JumpTable_DeclareFunction(R_Materialize, void*, void*);
+
+/*  R_MaterializedType
+    Implemented alongside R_Materialize. Returns the type R_Materialize would build without building it, so asking
+   what a placeholder holds doesn't change it.
+ */
+#define R_MaterializedType(object) R_Type_call(object, R_MaterializedType, object)
+R_JumpTable_DeclareKey(R_MaterializedType);
+R_JumpTable_DeclareFunction(R_MaterializedType, const R_Type*, void*);
+
 
 #include "R_Type_Builtins.h"
 
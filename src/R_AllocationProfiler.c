@@ -0,0 +1,425 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "R_OS.h"
+#include "R_AllocationProfiler.h"
+
+#ifdef R_OS_ALLOCATOR
+
+#define R_AllocationProfiler_BUCKETS 65 //One per bit of size_t, plus zero
+#define R_AllocationProfiler_TOMBSTONE ((void*)1)
+
+typedef struct {
+  const char* file;
+  int line;
+  const char* tag;
+  size_t allocations;
+  size_t frees;
+  size_t bytes;
+  size_t live_bytes;
+  size_t peak_live_bytes;
+} R_AllocationProfiler_Site;
+
+typedef struct {
+  void* pointer;
+  size_t size;
+  size_t site;
+} R_AllocationProfiler_Block;
+
+struct R_AllocationProfiler {
+  R_Type* type;
+  R_Allocator allocator;
+  const R_Allocator* parent;
+  bool running;
+  pthread_mutex_t mutex;
+  R_AllocationProfiler_Site* sites;
+  size_t site_count;
+  size_t* site_table; //Open-addressed indices into sites, plus one. Zero is empty.
+  size_t site_table_size;
+  R_AllocationProfiler_Block* blocks; //Open-addressed by pointer. Freed slots are tombstones.
+  size_t block_table_size;
+  size_t block_slots_used;
+  size_t histogram[R_AllocationProfiler_BUCKETS];
+  size_t allocations;
+  size_t reallocations;
+  size_t frees;
+  size_t total_bytes;
+  size_t live_bytes;
+  size_t peak_bytes;
+};
+
+static R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_Constructor(R_AllocationProfiler* self);
+static R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_Destructor(R_AllocationProfiler* self);
+static R_JumpTable_Entry methods[] = {
+  R_JumpTable_Entry_Make(R_Stringify, R_AllocationProfiler_stringify),
+  R_JumpTable_Entry_NULL
+};
+R_Type_Def(R_AllocationProfiler, R_AllocationProfiler_Constructor, R_AllocationProfiler_Destructor, NULL, methods);
+
+static void* R_AllocationProfiler_malloc(void* context, size_t size, const R_Allocator_Site* site);
+static void* R_AllocationProfiler_zalloc(void* context, size_t size, const R_Allocator_Site* site);
+static void* R_AllocationProfiler_realloc(void* context, void* pointer, size_t old_size, size_t size, const R_Allocator_Site* site);
+static void R_AllocationProfiler_free(void* context, void* pointer, size_t size, const R_Allocator_Site* site);
+
+/*  R_AllocationProfiler_release
+    Frees the profiler's own tables straight through the parent allocator, so they aren't counted.
+ */
+static void R_FUNCTION_ATTRIBUTES R_AllocationProfiler_release(R_AllocationProfiler* self, void* pointer, size_t size) {
+  if (pointer != NULL) self->parent->free(self->parent->context, pointer, size, NULL);
+}
+
+static R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_Constructor(R_AllocationProfiler* self) {
+  self->allocator.malloc = R_AllocationProfiler_malloc;
+  self->allocator.zalloc = R_AllocationProfiler_zalloc;
+  self->allocator.realloc = R_AllocationProfiler_realloc;
+  self->allocator.free = R_AllocationProfiler_free;
+  self->allocator.context = self;
+  self->parent = R_Allocator_get();
+  pthread_mutex_init(&self->mutex, NULL);
+  return self;
+}
+
+static R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_Destructor(R_AllocationProfiler* self) {
+  R_AllocationProfiler_stop(self);
+  R_AllocationProfiler_release(self, self->sites, self->site_table_size/2*sizeof(R_AllocationProfiler_Site));
+  R_AllocationProfiler_release(self, self->site_table, self->site_table_size*sizeof(size_t));
+  R_AllocationProfiler_release(self, self->blocks, self->block_table_size*sizeof(R_AllocationProfiler_Block));
+  pthread_mutex_destroy(&self->mutex);
+  return self;
+}
+
+R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_start(R_AllocationProfiler* self) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler) || self->running) return NULL;
+  self->parent = R_Allocator_get();
+  self->running = true;
+  R_Allocator_set(&self->allocator);
+  return self;
+}
+
+R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_stop(R_AllocationProfiler* self) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler)) return NULL;
+  if (self->running && R_Allocator_get() == &self->allocator) R_Allocator_set(self->parent);
+  self->running = false;
+  return self;
+}
+
+static size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_hash(uintptr_t value) {
+  uint64_t hash = (uint64_t)value * 0x9E3779B97F4A7C15ull;
+  return (size_t)(hash ^ (hash >> 29));
+}
+
+/*  R_AllocationProfiler_siteIndex
+    Finds or adds the site. Sites are told apart by the addresses of their file and tag strings, which are literals.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_siteIndex(R_AllocationProfiler* self, const R_Allocator_Site* site) {
+  const char* file = site ? site->file : NULL;
+  int line = site ? site->line : 0;
+  const char* tag = site ? site->tag : NULL;
+  if ((self->site_count+1)*2 > self->site_table_size) {
+    size_t size = self->site_table_size ? self->site_table_size*2 : 64;
+    size_t* table = self->parent->zalloc(self->parent->context, size*sizeof(size_t), NULL);
+    R_AllocationProfiler_Site* sites = self->parent->realloc(self->parent->context, self->sites, self->site_table_size/2*sizeof(R_AllocationProfiler_Site), size/2*sizeof(R_AllocationProfiler_Site), NULL);
+    if (table == NULL || sites == NULL) {
+      R_AllocationProfiler_release(self, table, size*sizeof(size_t));
+      if (sites) self->sites = sites;
+      return SIZE_MAX;
+    }
+    self->sites = sites;
+    for (size_t i=0; i<self->site_count; i++) {
+      size_t slot = R_AllocationProfiler_hash((uintptr_t)sites[i].file ^ (uintptr_t)sites[i].tag ^ (uintptr_t)sites[i].line) & (size-1);
+      while (table[slot]) slot = (slot+1) & (size-1);
+      table[slot] = i+1;
+    }
+    R_AllocationProfiler_release(self, self->site_table, self->site_table_size*sizeof(size_t));
+    self->site_table = table;
+    self->site_table_size = size;
+  }
+  size_t mask = self->site_table_size-1;
+  size_t slot = R_AllocationProfiler_hash((uintptr_t)file ^ (uintptr_t)tag ^ (uintptr_t)line) & mask;
+  while (self->site_table[slot]) {
+    R_AllocationProfiler_Site* existing = &self->sites[self->site_table[slot]-1];
+    if (existing->file == file && existing->line == line && existing->tag == tag) return self->site_table[slot]-1;
+    slot = (slot+1) & mask;
+  }
+  R_AllocationProfiler_Site* added = &self->sites[self->site_count];
+  memset(added, 0, sizeof(R_AllocationProfiler_Site));
+  added->file = file;
+  added->line = line;
+  added->tag = tag;
+  self->site_table[slot] = ++self->site_count;
+  return self->site_count-1;
+}
+
+static R_AllocationProfiler_Block* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_findBlock(R_AllocationProfiler* self, void* pointer) {
+  if (self->block_table_size == 0) return NULL;
+  size_t mask = self->block_table_size-1;
+  size_t slot = R_AllocationProfiler_hash((uintptr_t)pointer) & mask;
+  while (self->blocks[slot].pointer != NULL) {
+    if (self->blocks[slot].pointer == pointer) return &self->blocks[slot];
+    slot = (slot+1) & mask;
+  }
+  return NULL;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_AllocationProfiler_addBlock(R_AllocationProfiler* self, void* pointer, size_t size, size_t site) {
+  if ((self->block_slots_used+1)*2 > self->block_table_size) {
+    size_t table_size = self->block_table_size ? self->block_table_size : 1024;
+    size_t live = 0;
+    for (size_t i=0; i<self->block_table_size; i++) {
+      if (self->blocks[i].pointer != NULL && self->blocks[i].pointer != R_AllocationProfiler_TOMBSTONE) live++;
+    }
+    while ((live+1)*4 > table_size) table_size *= 2; //Rehashing drops the tombstones, so only grow for live blocks
+    R_AllocationProfiler_Block* blocks = self->parent->zalloc(self->parent->context, table_size*sizeof(R_AllocationProfiler_Block), NULL);
+    if (blocks == NULL) return false;
+    for (size_t i=0; i<self->block_table_size; i++) {
+      R_AllocationProfiler_Block* block = &self->blocks[i];
+      if (block->pointer == NULL || block->pointer == R_AllocationProfiler_TOMBSTONE) continue;
+      size_t slot = R_AllocationProfiler_hash((uintptr_t)block->pointer) & (table_size-1);
+      while (blocks[slot].pointer != NULL) slot = (slot+1) & (table_size-1);
+      blocks[slot] = *block;
+    }
+    R_AllocationProfiler_release(self, self->blocks, self->block_table_size*sizeof(R_AllocationProfiler_Block));
+    self->blocks = blocks;
+    self->block_table_size = table_size;
+    self->block_slots_used = live;
+  }
+  size_t mask = self->block_table_size-1;
+  size_t slot = R_AllocationProfiler_hash((uintptr_t)pointer) & mask;
+  while (self->blocks[slot].pointer != NULL && self->blocks[slot].pointer != R_AllocationProfiler_TOMBSTONE) slot = (slot+1) & mask;
+  if (self->blocks[slot].pointer == NULL) self->block_slots_used++;
+  self->blocks[slot].pointer = pointer;
+  self->blocks[slot].size = size;
+  self->blocks[slot].site = site;
+  return true;
+}
+
+/*  R_AllocationProfiler_bucket
+    Bucket 0 counts empty allocations. Bucket n counts sizes above 2^(n-2) and up to 2^(n-1).
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_bucket(size_t size) {
+  if (size == 0) return 0;
+  size_t bucket = 1;
+  while (bucket < R_AllocationProfiler_BUCKETS-1 && ((size_t)1 << (bucket-1)) < size) bucket++;
+  return bucket;
+}
+
+//Called with the mutex held
+static void R_FUNCTION_ATTRIBUTES R_AllocationProfiler_record(R_AllocationProfiler* self, void* pointer, size_t size, const R_Allocator_Site* site) {
+  size_t index = R_AllocationProfiler_siteIndex(self, site);
+  if (index != SIZE_MAX && R_AllocationProfiler_addBlock(self, pointer, size, index)) {
+    R_AllocationProfiler_Site* record = &self->sites[index];
+    record->allocations++;
+    record->bytes += size;
+    record->live_bytes += size;
+    if (record->live_bytes > record->peak_live_bytes) record->peak_live_bytes = record->live_bytes;
+    self->histogram[R_AllocationProfiler_bucket(size)]++;
+    self->allocations++;
+    self->total_bytes += size;
+    self->live_bytes += size;
+    if (self->live_bytes > self->peak_bytes) self->peak_bytes = self->live_bytes;
+  }
+}
+
+//Called with the mutex held
+static void R_FUNCTION_ATTRIBUTES R_AllocationProfiler_forget(R_AllocationProfiler* self, void* pointer) {
+  R_AllocationProfiler_Block* block = R_AllocationProfiler_findBlock(self, pointer);
+  if (block != NULL) {
+    R_AllocationProfiler_Site* record = &self->sites[block->site];
+    record->frees++;
+    record->live_bytes -= block->size;
+    self->frees++;
+    self->live_bytes -= block->size;
+    block->pointer = R_AllocationProfiler_TOMBSTONE;
+  }
+}
+
+static void* R_AllocationProfiler_malloc(void* context, size_t size, const R_Allocator_Site* site) {
+  R_AllocationProfiler* self = context;
+  void* pointer = self->parent->malloc(self->parent->context, size, site);
+  if (pointer == NULL) return NULL;
+  pthread_mutex_lock(&self->mutex);
+  R_AllocationProfiler_record(self, pointer, size, site);
+  pthread_mutex_unlock(&self->mutex);
+  return pointer;
+}
+
+static void* R_AllocationProfiler_zalloc(void* context, size_t size, const R_Allocator_Site* site) {
+  R_AllocationProfiler* self = context;
+  void* pointer = self->parent->zalloc(self->parent->context, size, site);
+  if (pointer == NULL) return NULL;
+  pthread_mutex_lock(&self->mutex);
+  R_AllocationProfiler_record(self, pointer, size, site);
+  pthread_mutex_unlock(&self->mutex);
+  return pointer;
+}
+
+/*  R_AllocationProfiler_realloc
+    Holds the mutex across the parent's realloc. Once it frees the old block another thread can be handed the same
+   address, and its record must not land before the old block is forgotten.
+ */
+static void* R_AllocationProfiler_realloc(void* context, void* pointer, size_t old_size, size_t size, const R_Allocator_Site* site) {
+  R_AllocationProfiler* self = context;
+  pthread_mutex_lock(&self->mutex);
+  void* new_pointer = self->parent->realloc(self->parent->context, pointer, old_size, size, site);
+  if (new_pointer != NULL || size == 0) { //Otherwise the old block is untouched
+    if (pointer != NULL) R_AllocationProfiler_forget(self, pointer);
+    if (new_pointer != NULL) R_AllocationProfiler_record(self, new_pointer, size, site);
+    if (new_pointer != NULL && pointer != NULL) self->reallocations++;
+  }
+  pthread_mutex_unlock(&self->mutex);
+  return new_pointer;
+}
+
+static void R_AllocationProfiler_free(void* context, void* pointer, size_t size, const R_Allocator_Site* site) {
+  R_AllocationProfiler* self = context;
+  pthread_mutex_lock(&self->mutex);
+  R_AllocationProfiler_forget(self, pointer);
+  pthread_mutex_unlock(&self->mutex);
+  self->parent->free(self->parent->context, pointer, size, site);
+}
+
+R_AllocationProfiler* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_reset(R_AllocationProfiler* self) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler)) return NULL;
+  pthread_mutex_lock(&self->mutex);
+  for (size_t i=0; i<self->site_count; i++) {
+    self->sites[i].allocations = self->sites[i].frees = self->sites[i].bytes = 0;
+    self->sites[i].peak_live_bytes = self->sites[i].live_bytes;
+  }
+  memset(self->histogram, 0, sizeof(self->histogram));
+  self->allocations = self->reallocations = self->frees = self->total_bytes = 0;
+  self->peak_bytes = self->live_bytes;
+  pthread_mutex_unlock(&self->mutex);
+  return self;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_allocations(R_AllocationProfiler* self) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler)) return 0;
+  return self->allocations;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_liveBytes(R_AllocationProfiler* self) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler)) return 0;
+  return self->live_bytes;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_peakBytes(R_AllocationProfiler* self) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler)) return 0;
+  return self->peak_bytes;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_AllocationProfiler_appendFormat(R_MutableString* buffer, const char* format, size_t value) {
+  char characters[32];
+  os_snprintf(characters, sizeof(characters), format, value);
+  R_MutableString_appendCString(buffer, characters);
+}
+
+//Appends text as a quoted json string, or null
+static void R_FUNCTION_ATTRIBUTES R_AllocationProfiler_appendString(R_MutableString* buffer, const char* text) {
+  if (text == NULL) {
+    R_MutableString_appendCString(buffer, "null");
+    return;
+  }
+  R_MutableString* string = R_MutableString_appendCString(R_Type_New(R_MutableString), text);
+  R_MutableString_appendStringAsJson(buffer, string);
+  R_Type_Delete(string);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_AllocationProfiler_appendCounts(R_MutableString* buffer, const R_AllocationProfiler_Site* site) {
+  R_AllocationProfiler_appendFormat(buffer, ",\"allocations\":%zu", site->allocations);
+  R_AllocationProfiler_appendFormat(buffer, ",\"frees\":%zu", site->frees);
+  R_AllocationProfiler_appendFormat(buffer, ",\"bytes\":%zu", site->bytes);
+  R_AllocationProfiler_appendFormat(buffer, ",\"live_bytes\":%zu", site->live_bytes);
+  R_AllocationProfiler_appendFormat(buffer, ",\"peak_live_bytes\":%zu}", site->peak_live_bytes);
+}
+
+R_MutableString* R_FUNCTION_ATTRIBUTES R_AllocationProfiler_toJson(R_AllocationProfiler* self, R_MutableString* buffer) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler) || buffer == NULL || R_MutableString_reset(buffer) == NULL) return NULL;
+
+  //Copy the statistics first so that the string's own allocations can't change them, or deadlock, while writing
+  pthread_mutex_lock(&self->mutex);
+  R_AllocationProfiler copy = *self;
+  size_t count = self->site_count;
+  R_AllocationProfiler_Site* sites = self->parent->malloc(self->parent->context, (count ? count : 1)*2*sizeof(R_AllocationProfiler_Site), NULL);
+  if (sites != NULL && count) memcpy(sites, self->sites, count*sizeof(R_AllocationProfiler_Site));
+  pthread_mutex_unlock(&self->mutex);
+  if (sites == NULL) return NULL;
+
+  //Sort by bytes, largest first
+  for (size_t i=1; i<count; i++) {
+    R_AllocationProfiler_Site site = sites[i];
+    size_t j = i;
+    for (; j>0 && sites[j-1].bytes < site.bytes; j--) sites[j] = sites[j-1];
+    sites[j] = site;
+  }
+
+  //Sum the sites of each type into the second half of the array
+  R_AllocationProfiler_Site* types = sites + count;
+  size_t type_count = 0;
+  for (size_t i=0; i<count; i++) {
+    if (sites[i].tag == NULL) continue;
+    size_t t = 0;
+    while (t < type_count && strcmp(types[t].tag, sites[i].tag) != 0) t++;
+    if (t == type_count) {
+      memset(&types[t], 0, sizeof(R_AllocationProfiler_Site));
+      types[t].tag = sites[i].tag;
+      type_count++;
+    }
+    types[t].allocations += sites[i].allocations;
+    types[t].frees += sites[i].frees;
+    types[t].bytes += sites[i].bytes;
+    types[t].live_bytes += sites[i].live_bytes;
+    types[t].peak_live_bytes += sites[i].peak_live_bytes;
+  }
+
+  R_AllocationProfiler_appendFormat(buffer, "{\"allocations\":%zu", copy.allocations);
+  R_AllocationProfiler_appendFormat(buffer, ",\"reallocations\":%zu", copy.reallocations);
+  R_AllocationProfiler_appendFormat(buffer, ",\"frees\":%zu", copy.frees);
+  R_AllocationProfiler_appendFormat(buffer, ",\"bytes\":%zu", copy.total_bytes);
+  R_AllocationProfiler_appendFormat(buffer, ",\"live_bytes\":%zu", copy.live_bytes);
+  R_AllocationProfiler_appendFormat(buffer, ",\"peak_bytes\":%zu", copy.peak_bytes);
+
+  R_MutableString_appendCString(buffer, ",\"types\":[");
+  for (size_t t=0; t<type_count; t++) {
+    if (t > 0) R_MutableString_appendCString(buffer, ",");
+    R_MutableString_appendCString(buffer, "{\"type\":");
+    R_AllocationProfiler_appendString(buffer, types[t].tag);
+    R_AllocationProfiler_appendCounts(buffer, &types[t]);
+  }
+
+  R_MutableString_appendCString(buffer, "],\"sites\":[");
+  for (size_t i=0; i<count; i++) {
+    if (i > 0) R_MutableString_appendCString(buffer, ",");
+    R_MutableString_appendCString(buffer, "{\"file\":");
+    R_AllocationProfiler_appendString(buffer, sites[i].file);
+    R_AllocationProfiler_appendFormat(buffer, ",\"line\":%zu,\"type\":", (size_t)sites[i].line);
+    R_AllocationProfiler_appendString(buffer, sites[i].tag);
+    R_AllocationProfiler_appendCounts(buffer, &sites[i]);
+  }
+
+  R_MutableString_appendCString(buffer, "],\"histogram\":[");
+  bool first = true;
+  for (size_t bucket=0; bucket<R_AllocationProfiler_BUCKETS; bucket++) {
+    if (copy.histogram[bucket] == 0) continue;
+    if (!first) R_MutableString_appendCString(buffer, ",");
+    first = false;
+    size_t max_size = bucket == 0 ? 0 : (size_t)1 << (bucket-1);
+    R_AllocationProfiler_appendFormat(buffer, "{\"max_size\":%zu", max_size);
+    R_AllocationProfiler_appendFormat(buffer, ",\"count\":%zu}", copy.histogram[bucket]);
+  }
+  R_MutableString_appendCString(buffer, "]}");
+
+  R_AllocationProfiler_release(self, sites, (count ? count : 1)*2*sizeof(R_AllocationProfiler_Site));
+  return buffer;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_AllocationProfiler_stringify(R_AllocationProfiler* self, char* buffer, size_t size) {
+  if (R_Type_IsNotOf(self, R_AllocationProfiler)) return 0;
+  R_MutableString* string = R_Type_New(R_MutableString);
+  R_AllocationProfiler_toJson(self, string);
+  size_t output = R_MutableString_stringify(string, buffer, size);
+  R_Type_Delete(string);
+  return output;
+}
+
+#endif /* R_OS_ALLOCATOR */
@@ -0,0 +1,428 @@
+#include <stdlib.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_ConcurrentDictionary.h"
+
+#ifdef R_TYPE_REFCOUNT
+
+//Write locks. Bucket counts are multiples of this, so every bucket belongs to one stripe whatever the table size
+#define R_ConcurrentDictionary_Stripes 64
+//Threads that can be inside a read at once
+#define R_ConcurrentDictionary_Readers 64
+#define R_ConcurrentDictionary_CacheLine 64
+//Entries per bucket before the table doubles
+#define R_ConcurrentDictionary_LoadFactor 2
+//Retired entries and tables to collect before trying to free them
+#define R_ConcurrentDictionary_ReclaimBatch 64
+
+#ifdef R_OS_THREADS
+  #define R_ConcurrentDictionary_load(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+  #define R_ConcurrentDictionary_store(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+  #define R_ConcurrentDictionary_loadOrdered(pointer) __atomic_load_n(pointer, __ATOMIC_SEQ_CST)
+  #define R_ConcurrentDictionary_storeOrdered(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_SEQ_CST)
+  #define R_ConcurrentDictionary_add(pointer, value) __atomic_add_fetch(pointer, value, __ATOMIC_RELAXED)
+  #define R_ConcurrentDictionary_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+  #define R_ConcurrentDictionary_load(pointer) (*(pointer))
+  #define R_ConcurrentDictionary_store(pointer, value) (*(pointer) = (value))
+  #define R_ConcurrentDictionary_loadOrdered(pointer) (*(pointer))
+  #define R_ConcurrentDictionary_storeOrdered(pointer, value) (*(pointer) = (value))
+  #define R_ConcurrentDictionary_add(pointer, value) (*(pointer) += (value))
+  #define R_ConcurrentDictionary_fence() do {} while(0)
+#endif
+
+/*  R_ConcurrentDictionary_Retired
+    Starts every entry and table, so either can wait on the retired list for the readers that might still see it.
+   epoch is the dictionary's epoch when it was unlinked.
+ */
+typedef struct R_ConcurrentDictionary_Retired {
+  struct R_ConcurrentDictionary_Retired* next;
+  size_t epoch;
+  bool is_table;
+} R_ConcurrentDictionary_Retired;
+
+/*  R_ConcurrentDictionary_Entry
+    Never changes once it's in a table, except for next. A new value for the key goes into a new entry.
+ */
+typedef struct R_ConcurrentDictionary_Entry {
+  R_ConcurrentDictionary_Retired retired;
+  struct R_ConcurrentDictionary_Entry* next;
+  void* value;
+  uint32_t hash;
+  size_t length;
+  char key[];
+} R_ConcurrentDictionary_Entry;
+
+typedef struct {
+  R_ConcurrentDictionary_Retired retired;
+  size_t count;
+  R_ConcurrentDictionary_Entry* buckets[];
+} R_ConcurrentDictionary_Table;
+
+/*  R_ConcurrentDictionary_Reader
+    The epoch a reading thread saw when it started, or 0 when the slot is free. Each slot has its own cache line so
+   readers don't slow each other down.
+ */
+typedef struct {
+  size_t epoch;
+  char padding[R_ConcurrentDictionary_CacheLine - sizeof(size_t)];
+} R_ConcurrentDictionary_Reader;
+
+struct R_ConcurrentDictionary {
+  R_Type* type;
+  //Read by every reader, and only written on a resize or a reclaim
+  R_ConcurrentDictionary_Table* table;
+  size_t epoch;
+  char padding[R_ConcurrentDictionary_CacheLine];
+  size_t size;
+  R_ConcurrentDictionary_Retired* retired;
+  size_t retired_count;
+  size_t reclaim_at;
+  pthread_mutex_t retired_lock;
+  pthread_mutex_t locks[R_ConcurrentDictionary_Stripes];
+  R_ConcurrentDictionary_Reader readers[R_ConcurrentDictionary_Readers];
+};
+
+static R_ConcurrentDictionary* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_Constructor(R_ConcurrentDictionary* self);
+static R_ConcurrentDictionary* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_Destructor(R_ConcurrentDictionary* self);
+static R_ConcurrentDictionary* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_Copier(R_ConcurrentDictionary* self, R_ConcurrentDictionary* new);
+R_Type_Def(R_ConcurrentDictionary, R_ConcurrentDictionary_Constructor, R_ConcurrentDictionary_Destructor, R_ConcurrentDictionary_Copier, NULL);
+
+#ifdef R_OS_THREADS
+static __thread size_t R_ConcurrentDictionary_threadSlot = 0;
+static size_t R_ConcurrentDictionary_threadCount = 0;
+#endif
+
+//32 bit FNV-1a
+static uint32_t R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_hash(const char* key, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i=0; i<length; i++) hash = (hash ^ (uint8_t)key[i]) * 16777619u;
+  return hash;
+}
+
+static R_ConcurrentDictionary_Entry* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_newEntry(const char* key, size_t length, uint32_t hash, void* value) {
+  R_ConcurrentDictionary_Entry* entry = (R_ConcurrentDictionary_Entry*)os_malloc(sizeof(R_ConcurrentDictionary_Entry) + length + 1);
+  if (entry == NULL) return NULL;
+  entry->retired.is_table = false;
+  entry->next = NULL;
+  entry->value = value;
+  entry->hash = hash;
+  entry->length = length;
+  memcpy(entry->key, key, length);
+  entry->key[length] = '\0';
+  return entry;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_freeEntry(R_ConcurrentDictionary_Entry* entry) {
+  R_Type_Release(entry->value);
+  os_free_sized(entry, sizeof(R_ConcurrentDictionary_Entry) + entry->length + 1);
+}
+
+static R_ConcurrentDictionary_Table* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_newTable(size_t count) {
+  R_ConcurrentDictionary_Table* table = (R_ConcurrentDictionary_Table*)os_zalloc(sizeof(R_ConcurrentDictionary_Table) + count*sizeof(R_ConcurrentDictionary_Entry*));
+  if (table == NULL) return NULL;
+  table->retired.is_table = true;
+  table->count = count;
+  return table;
+}
+
+//Frees the table along with every entry still in it
+static void R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_freeTable(R_ConcurrentDictionary_Table* table) {
+  for (size_t i=0; i<table->count; i++) {
+    R_ConcurrentDictionary_Entry* entry = table->buckets[i];
+    while (entry != NULL) {
+      R_ConcurrentDictionary_Entry* next = entry->next;
+      R_ConcurrentDictionary_freeEntry(entry);
+      entry = next;
+    }
+  }
+  os_free_sized(table, sizeof(R_ConcurrentDictionary_Table) + table->count*sizeof(R_ConcurrentDictionary_Entry*));
+}
+
+static void R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_freeRetired(R_ConcurrentDictionary_Retired* retired) {
+  if (retired->is_table) R_ConcurrentDictionary_freeTable((R_ConcurrentDictionary_Table*)retired);
+  else R_ConcurrentDictionary_freeEntry((R_ConcurrentDictionary_Entry*)retired);
+}
+
+static R_ConcurrentDictionary* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_Constructor(R_ConcurrentDictionary* self) {
+  self->table = R_ConcurrentDictionary_newTable(R_ConcurrentDictionary_Stripes);
+  if (self->table == NULL) return NULL;
+  //Reader slots hold 0 when they're free, so epochs start above it
+  self->epoch = 1;
+  self->reclaim_at = R_ConcurrentDictionary_ReclaimBatch;
+  pthread_mutex_init(&self->retired_lock, NULL);
+  for (size_t i=0; i<R_ConcurrentDictionary_Stripes; i++) pthread_mutex_init(&self->locks[i], NULL);
+  return self;
+}
+
+static R_ConcurrentDictionary* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_Destructor(R_ConcurrentDictionary* self) {
+  //Nothing else may use a dictionary that's being deleted, so everything retired can go at once
+  while (self->retired != NULL) {
+    R_ConcurrentDictionary_Retired* next = self->retired->next;
+    R_ConcurrentDictionary_freeRetired(self->retired);
+    self->retired = next;
+  }
+  if (self->table != NULL) R_ConcurrentDictionary_freeTable(self->table);
+  self->table = NULL;
+  pthread_mutex_destroy(&self->retired_lock);
+  for (size_t i=0; i<R_ConcurrentDictionary_Stripes; i++) pthread_mutex_destroy(&self->locks[i]);
+  return self;
+}
+
+//Sets a free reader slot to epoch. Fails if another thread holds the slot
+static bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_claim(size_t* slot, size_t epoch) {
+#ifdef R_OS_THREADS
+  size_t expected = 0;
+  return __atomic_compare_exchange_n(slot, &expected, epoch, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#else
+  if (*slot != 0) return false;
+  *slot = epoch;
+  return true;
+#endif
+}
+
+/*  R_ConcurrentDictionary_enter
+    Starts a read by publishing the current epoch in a free reader slot, and returns the slot. Each thread starts
+   looking at its own slot, so threads only probe further when there are more readers than slots.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_enter(R_ConcurrentDictionary* self) {
+  size_t slot = 0;
+#ifdef R_OS_THREADS
+  if (R_ConcurrentDictionary_threadSlot == 0) R_ConcurrentDictionary_threadSlot = R_ConcurrentDictionary_add(&R_ConcurrentDictionary_threadCount, 1);
+  slot = (R_ConcurrentDictionary_threadSlot - 1) % R_ConcurrentDictionary_Readers;
+#endif
+  while (!R_ConcurrentDictionary_claim(&self->readers[slot].epoch, R_ConcurrentDictionary_loadOrdered(&self->epoch))) slot = (slot + 1) % R_ConcurrentDictionary_Readers;
+  return slot;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_leave(R_ConcurrentDictionary* self, size_t slot) {
+  R_ConcurrentDictionary_store(&self->readers[slot].epoch, (size_t)0);
+}
+
+static R_ConcurrentDictionary_Entry* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_find(R_ConcurrentDictionary_Table* table, const char* key, size_t length, uint32_t hash) {
+  R_ConcurrentDictionary_Entry* entry = R_ConcurrentDictionary_load(&table->buckets[hash & (table->count - 1)]);
+  while (entry != NULL && (entry->hash != hash || entry->length != length || memcmp(entry->key, key, length) != 0)) entry = R_ConcurrentDictionary_load(&entry->next);
+  return entry;
+}
+
+/*  R_ConcurrentDictionary_reclaim
+    Frees what was retired two epochs ago. The epoch only moves on once every reader in a slot has seen the current
+   one, so by the time it has moved twice past an entry's epoch, every read that could have reached the entry has
+   finished. Call with retired_lock held.
+ */
+static void R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_reclaim(R_ConcurrentDictionary* self) {
+  size_t epoch = R_ConcurrentDictionary_loadOrdered(&self->epoch);
+  bool caught_up = true;
+  for (size_t i=0; i<R_ConcurrentDictionary_Readers && caught_up; i++) {
+    size_t reader = R_ConcurrentDictionary_loadOrdered(&self->readers[i].epoch);
+    caught_up = (reader == 0 || reader == epoch);
+  }
+  if (caught_up) R_ConcurrentDictionary_storeOrdered(&self->epoch, ++epoch);
+
+  R_ConcurrentDictionary_Retired** link = &self->retired;
+  while (*link != NULL) {
+    R_ConcurrentDictionary_Retired* retired = *link;
+    if (retired->epoch + 2 > epoch) {
+      link = &retired->next;
+      continue;
+    }
+    *link = retired->next;
+    R_ConcurrentDictionary_freeRetired(retired);
+    self->retired_count--;
+  }
+  self->reclaim_at = self->retired_count + R_ConcurrentDictionary_ReclaimBatch;
+}
+
+//Queues an entry or table that's been unlinked to be freed when no reader can see it
+static void R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_retire(R_ConcurrentDictionary* self, R_ConcurrentDictionary_Retired* retired) {
+  //The unlink has to be visible before the epoch is read, or a reader could start in this epoch and still find it
+  R_ConcurrentDictionary_fence();
+  pthread_mutex_lock(&self->retired_lock);
+  retired->epoch = R_ConcurrentDictionary_loadOrdered(&self->epoch);
+  retired->next = self->retired;
+  self->retired = retired;
+  if (++self->retired_count >= self->reclaim_at) R_ConcurrentDictionary_reclaim(self);
+  pthread_mutex_unlock(&self->retired_lock);
+}
+
+/*  R_ConcurrentDictionary_grow
+    Doubles the bucket count if the table is still too full once every stripe is locked. Entries are linked into
+   chains that readers may be walking, so the new table gets copies of them, and the old table is retired whole.
+ */
+static void R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_grow(R_ConcurrentDictionary* self) {
+  for (size_t i=0; i<R_ConcurrentDictionary_Stripes; i++) pthread_mutex_lock(&self->locks[i]);
+  R_ConcurrentDictionary_Table* table = self->table;
+  R_ConcurrentDictionary_Table* bigger = NULL;
+  if (R_ConcurrentDictionary_load(&self->size) > table->count*R_ConcurrentDictionary_LoadFactor) bigger = R_ConcurrentDictionary_newTable(table->count*2);
+  for (size_t i=0; bigger != NULL && i<table->count; i++) {
+    for (R_ConcurrentDictionary_Entry* entry = table->buckets[i]; entry != NULL; entry = entry->next) {
+      R_ConcurrentDictionary_Entry* copy = R_ConcurrentDictionary_newEntry(entry->key, entry->length, entry->hash, R_Type_Retain(entry->value));
+      if (copy == NULL) {
+        //Stay at the old size
+        R_Type_Release(entry->value);
+        R_ConcurrentDictionary_freeTable(bigger);
+        bigger = NULL;
+        break;
+      }
+      R_ConcurrentDictionary_Entry** bucket = &bigger->buckets[copy->hash & (bigger->count - 1)];
+      copy->next = *bucket;
+      *bucket = copy;
+    }
+  }
+  if (bigger != NULL) R_ConcurrentDictionary_store(&self->table, bigger);
+  for (size_t i=R_ConcurrentDictionary_Stripes; i>0; i--) pthread_mutex_unlock(&self->locks[i-1]);
+  if (bigger != NULL) R_ConcurrentDictionary_retire(self, &table->retired);
+}
+
+/*  R_ConcurrentDictionary_put
+    Links a new entry for key in place of the old one, or at the end of its bucket, so a reader walking the chain
+   sees either the old value or the new one. Takes over the reference to value.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_put(R_ConcurrentDictionary* self, const char* key, void* value) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary) || key == NULL || value == NULL) return R_Type_Release(value), false;
+  size_t length = strlen(key);
+  uint32_t hash = R_ConcurrentDictionary_hash(key, length);
+  R_ConcurrentDictionary_Entry* entry = R_ConcurrentDictionary_newEntry(key, length, hash, value);
+  if (entry == NULL) return R_Type_Release(value), false;
+
+  pthread_mutex_t* lock = &self->locks[hash % R_ConcurrentDictionary_Stripes];
+  pthread_mutex_lock(lock);
+  R_ConcurrentDictionary_Table* table = self->table;
+  R_ConcurrentDictionary_Entry** link = &table->buckets[hash & (table->count - 1)];
+  R_ConcurrentDictionary_Entry* old = *link;
+  while (old != NULL && (old->hash != hash || old->length != length || memcmp(old->key, key, length) != 0)) {
+    link = &old->next;
+    old = *link;
+  }
+  entry->next = old ? old->next : *link;
+  R_ConcurrentDictionary_store(link, entry);
+  //Another writer may grow and retire the table once the lock is gone
+  size_t buckets = table->count;
+  pthread_mutex_unlock(lock);
+
+  if (old != NULL) R_ConcurrentDictionary_retire(self, &old->retired);
+  else if (R_ConcurrentDictionary_add(&self->size, 1) > buckets*R_ConcurrentDictionary_LoadFactor) R_ConcurrentDictionary_grow(self);
+  return true;
+}
+
+static R_ConcurrentDictionary* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_Copier(R_ConcurrentDictionary* self, R_ConcurrentDictionary* new) {
+  size_t slot = R_ConcurrentDictionary_enter(self);
+  R_ConcurrentDictionary_Table* table = R_ConcurrentDictionary_load(&self->table);
+  for (size_t i=0; i<table->count; i++) {
+    for (R_ConcurrentDictionary_Entry* entry = R_ConcurrentDictionary_load(&table->buckets[i]); entry != NULL; entry = R_ConcurrentDictionary_load(&entry->next)) {
+      R_ConcurrentDictionary_put(new, entry->key, R_Type_Retain(entry->value));
+    }
+  }
+  R_ConcurrentDictionary_leave(self, slot);
+  return new;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_transferOwnership(R_ConcurrentDictionary* self, const char* key, void* object) {
+  return R_ConcurrentDictionary_put(self, key, object);
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_addShared(R_ConcurrentDictionary* self, const char* key, void* object) {
+  if (object == NULL) return false;
+  return R_ConcurrentDictionary_put(self, key, R_Type_Retain(object));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_addCopy(R_ConcurrentDictionary* self, const char* key, const void* object) {
+  return R_ConcurrentDictionary_put(self, key, R_Type_Copy(object));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_setInteger(R_ConcurrentDictionary* self, const char* key, int value) {
+  return R_ConcurrentDictionary_put(self, key, R_Integer_set(R_Type_New(R_Integer), value));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_setFloat(R_ConcurrentDictionary* self, const char* key, float value) {
+  return R_ConcurrentDictionary_put(self, key, R_Float_set(R_Type_New(R_Float), value));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_setBoolean(R_ConcurrentDictionary* self, const char* key, bool value) {
+  return R_ConcurrentDictionary_put(self, key, R_Boolean_set(R_Type_New(R_Boolean), value));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_remove(R_ConcurrentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary) || key == NULL) return false;
+  size_t length = strlen(key);
+  uint32_t hash = R_ConcurrentDictionary_hash(key, length);
+
+  pthread_mutex_t* lock = &self->locks[hash % R_ConcurrentDictionary_Stripes];
+  pthread_mutex_lock(lock);
+  R_ConcurrentDictionary_Table* table = self->table;
+  R_ConcurrentDictionary_Entry** link = &table->buckets[hash & (table->count - 1)];
+  R_ConcurrentDictionary_Entry* old = *link;
+  while (old != NULL && (old->hash != hash || old->length != length || memcmp(old->key, key, length) != 0)) {
+    link = &old->next;
+    old = *link;
+  }
+  if (old != NULL) R_ConcurrentDictionary_store(link, old->next);
+  pthread_mutex_unlock(lock);
+
+  if (old == NULL) return false;
+  R_ConcurrentDictionary_add(&self->size, (size_t)-1);
+  R_ConcurrentDictionary_retire(self, &old->retired);
+  return true;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_get(R_ConcurrentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary) || key == NULL) return NULL;
+  size_t length = strlen(key);
+  uint32_t hash = R_ConcurrentDictionary_hash(key, length);
+  size_t slot = R_ConcurrentDictionary_enter(self);
+  R_ConcurrentDictionary_Entry* entry = R_ConcurrentDictionary_find(R_ConcurrentDictionary_load(&self->table), key, length, hash);
+  //The entry holds its reference until after this read ends, so the value can't be freed before it's retained
+  void* value = entry ? R_Type_Retain(entry->value) : NULL;
+  R_ConcurrentDictionary_leave(self, slot);
+  return value;
+}
+
+int R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_getInteger(R_ConcurrentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary) || key == NULL) return 0;
+  size_t length = strlen(key);
+  uint32_t hash = R_ConcurrentDictionary_hash(key, length);
+  size_t slot = R_ConcurrentDictionary_enter(self);
+  R_ConcurrentDictionary_Entry* entry = R_ConcurrentDictionary_find(R_ConcurrentDictionary_load(&self->table), key, length, hash);
+  int value = (entry && R_Type_IsOf(entry->value, R_Integer)) ? R_Integer_get(entry->value) : 0;
+  R_ConcurrentDictionary_leave(self, slot);
+  return value;
+}
+
+float R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_getFloat(R_ConcurrentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary) || key == NULL) return 0;
+  size_t length = strlen(key);
+  uint32_t hash = R_ConcurrentDictionary_hash(key, length);
+  size_t slot = R_ConcurrentDictionary_enter(self);
+  R_ConcurrentDictionary_Entry* entry = R_ConcurrentDictionary_find(R_ConcurrentDictionary_load(&self->table), key, length, hash);
+  float value = (entry && R_Type_IsOf(entry->value, R_Float)) ? R_Float_get(entry->value) : 0;
+  R_ConcurrentDictionary_leave(self, slot);
+  return value;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_getBoolean(R_ConcurrentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary) || key == NULL) return false;
+  size_t length = strlen(key);
+  uint32_t hash = R_ConcurrentDictionary_hash(key, length);
+  size_t slot = R_ConcurrentDictionary_enter(self);
+  R_ConcurrentDictionary_Entry* entry = R_ConcurrentDictionary_find(R_ConcurrentDictionary_load(&self->table), key, length, hash);
+  bool value = (entry && R_Type_IsOf(entry->value, R_Boolean)) ? R_Boolean_get(entry->value) : false;
+  R_ConcurrentDictionary_leave(self, slot);
+  return value;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_isPresent(R_ConcurrentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary) || key == NULL) return false;
+  size_t length = strlen(key);
+  uint32_t hash = R_ConcurrentDictionary_hash(key, length);
+  size_t slot = R_ConcurrentDictionary_enter(self);
+  bool present = R_ConcurrentDictionary_find(R_ConcurrentDictionary_load(&self->table), key, length, hash) != NULL;
+  R_ConcurrentDictionary_leave(self, slot);
+  return present;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_ConcurrentDictionary_size(R_ConcurrentDictionary* self) {
+  if (R_Type_IsNotOf(self, R_ConcurrentDictionary)) return 0;
+  return R_ConcurrentDictionary_load(&self->size);
+}
+
+#endif
@@ -13,11 +13,17 @@ struct R_Dictionary {
 static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_Constructor(R_Dictionary* self);
 static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_Destructor(R_Dictionary* self);
 static R_Dictionary* R_Dictionary_Copier(R_Dictionary* self, R_Dictionary* new);
+static R_Dictionary* R_Dictionary_Mover(R_Dictionary* self, R_Dictionary* new);
 static R_JumpTable_Entry methods[] = {
   R_JumpTable_Entry_Make(R_Stringify, R_Dictionary_stringify), 
   R_JumpTable_Entry_NULL
 };
-R_Type_Def(R_Dictionary, R_Dictionary_Constructor, R_Dictionary_Destructor, R_Dictionary_Copier, methods);
+R_Type_Define(R_Dictionary,
+  .ctor = (R_Type_Constructor)R_Dictionary_Constructor,
+  .dtor = (R_Type_Destructor)R_Dictionary_Destructor,
+  .copy = (R_Type_Copier)R_Dictionary_Copier,
+  .move = (R_Type_Mover)R_Dictionary_Mover,
+  .interfaces = methods);
 
 static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_Constructor(R_Dictionary* self) {
 	self->elements = R_Type_New(R_List);
@@ -32,6 +38,10 @@ static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_Copier(R_Dictionary* sel
 	if (R_List_appendList(new->elements, self->elements) == NULL) return R_Type_Delete(new), NULL;
 	return new;
 }
+static R_Dictionary* R_Dictionary_Mover(R_Dictionary* self, R_Dictionary* new) {
+	if (R_List_splice(new->elements, self->elements) == NULL) return NULL;
+	return new;
+}
 
 R_List* R_FUNCTION_ATTRIBUTES R_Dictionary_listOfPairs(R_Dictionary* self) {
   if (R_Type_IsNotOf(self, R_Dictionary)) return NULL;
@@ -39,49 +49,79 @@ R_List* R_FUNCTION_ATTRIBUTES R_Dictionary_listOfPairs(R_Dictionary* self) {
 }
 
 static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_Dictionary_getElement(R_Dictionary* self, const char* key);
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_Dictionary_getOrAddElement(R_Dictionary* self, const char* key);
 
 void* R_FUNCTION_ATTRIBUTES R_Dictionary_addObjectOfType(R_Dictionary* self, const char* key, const R_Type* type) {
 	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL || type == NULL) return NULL;
-	R_KeyValuePair* element = R_Dictionary_getElement(self, key);
-	if (element == NULL) {
-		element = R_List_add(self->elements, R_KeyValuePair);
-		if (element == NULL) return NULL;
-    R_KeyValuePair_setKey(element, key);
-	}
+	R_KeyValuePair* element = R_Dictionary_getOrAddElement(self, key);
+	if (element == NULL) return NULL;
   R_KeyValuePair_setValue(element, R_Type_NewObjectOfType(type));
 	return R_KeyValuePair_value(element);
 }
 
 void* R_FUNCTION_ATTRIBUTES R_Dictionary_addCopy(R_Dictionary* self, const char* key, const void* object) {
 	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL || object == NULL) return NULL;
-	R_KeyValuePair* element = R_Dictionary_getElement(self, key);
-	if (element == NULL) {
-		element = R_List_add(self->elements, R_KeyValuePair);
-		if (element == NULL) return NULL;
-    R_KeyValuePair_setKey(element, key);
-	}
+	R_KeyValuePair* element = R_Dictionary_getOrAddElement(self, key);
+	if (element == NULL) return NULL;
   R_KeyValuePair_setValue(element, R_Type_Copy(object));
   return R_KeyValuePair_value(element);
 }
 
+#ifdef R_TYPE_REFCOUNT
+void* R_FUNCTION_ATTRIBUTES R_Dictionary_addShared(R_Dictionary* self, const char* key, void* object) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL || object == NULL) return NULL;
+	R_KeyValuePair* element = R_Dictionary_getOrAddElement(self, key);
+	if (element == NULL) return NULL;
+	if (R_KeyValuePair_setValue(element, R_Type_Retain(object)) == NULL) return R_Type_Release(object), NULL;
+	return object;
+}
+#endif
+
+void* R_FUNCTION_ATTRIBUTES R_Dictionary_addMove(R_Dictionary* self, const char* key, void* object) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL || object == NULL) return NULL;
+	R_KeyValuePair* element = R_Dictionary_getOrAddElement(self, key);
+	if (element == NULL) return NULL;
+	R_KeyValuePair_setValue(element, R_Type_Move(object));
+	return R_KeyValuePair_value(element);
+}
+
 R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_merge(R_Dictionary* self, R_Dictionary* dictionary_to_copy) {
 	if (R_Type_IsNotOf(self, R_Dictionary) || R_Type_IsNotOf(dictionary_to_copy, R_Dictionary)) return NULL;
 	R_List_each(dictionary_to_copy->elements, R_KeyValuePair, element) {
-		if (R_Dictionary_addCopy(self, R_MutableString_cstring(R_KeyValuePair_key(element)), R_KeyValuePair_value(element)) == NULL) return NULL;
+		R_KeyValuePair* destination = R_Dictionary_getOrAddElement(self, R_MutableString_cstring(R_KeyValuePair_key(element)));
+		if (R_KeyValuePair_copyValue(destination, element) == NULL) return NULL;
+	}
+	return self;
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_mergeMove(R_Dictionary* self, R_Dictionary* dictionary_to_move) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || R_Type_IsNotOf(dictionary_to_move, R_Dictionary)) return NULL;
+	if (self == dictionary_to_move) return self;
+	if (R_List_size(self->elements) == 0) return R_List_splice(self->elements, dictionary_to_move->elements) ? self : NULL;
+	size_t count = R_List_size(dictionary_to_move->elements);
+	if (R_List_reserve(self->elements, R_List_size(self->elements) + count) == NULL) return NULL;
+	//Pairs for new keys change lists as they are. Their slots are nulled so removeAll only deletes the emptied pairs.
+	void** pairs = R_List_pointers(dictionary_to_move->elements);
+	size_t original_size = R_List_size(self->elements);
+	for (size_t i=0; i<count; i++) {
+		R_KeyValuePair* destination = NULL;
+		for (size_t j=0; j<original_size && destination == NULL; j++) {
+			R_KeyValuePair* element = R_List_pointerAtIndex(self->elements, j);
+			if (R_MutableString_isSame(R_KeyValuePair_key(element), R_KeyValuePair_key(pairs[i]))) destination = element;
+		}
+		if (destination != NULL) R_KeyValuePair_moveValue(destination, pairs[i]);
+		else if (R_List_transferOwnership(self->elements, pairs[i]) != NULL) pairs[i] = NULL;
 	}
+	R_List_removeAll(dictionary_to_move->elements);
 	return self;
 }
 
 void* R_FUNCTION_ATTRIBUTES R_Dictionary_transferOwnership(R_Dictionary* self, const char* key, void* object) {
 	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL) return NULL;
-	R_KeyValuePair* element = R_Dictionary_getElement(self, key);
-	if (element == NULL) {
-		element = R_List_add(self->elements, R_KeyValuePair);
-		if (element == NULL) return NULL;
-    R_KeyValuePair_setKey(element, key);
-	}
-  R_KeyValuePair_setValue(element, object);
-  return R_KeyValuePair_value(element);
+	R_KeyValuePair* element = R_Dictionary_getOrAddElement(self, key);
+	if (element == NULL) return NULL;
+	if (R_KeyValuePair_setValue(element, object) == NULL) return NULL;
+	return object;
 }
 
 void R_FUNCTION_ATTRIBUTES R_Dictionary_remove(R_Dictionary* self, const char* key) {
@@ -96,6 +136,11 @@ void* R_FUNCTION_ATTRIBUTES R_Dictionary_get(R_Dictionary* self, const char* key
 	return R_KeyValuePair_value(element);
 }
 
+void* R_FUNCTION_ATTRIBUTES R_Dictionary_read(R_Dictionary* self, const char* key) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL) return NULL;
+	return R_KeyValuePair_readValue(R_Dictionary_getElement(self, key));
+}
+
 void* R_FUNCTION_ATTRIBUTES R_Dictionary_getFromString(R_Dictionary* self, R_MutableString* key) {
 	return R_Dictionary_get(self, R_MutableString_cstring(key));
 }
@@ -108,6 +153,53 @@ static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_Dictionary_getElement(R_Dictionar
 	return NULL;
 }
 
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_Dictionary_getOrAddElement(R_Dictionary* self, const char* key) {
+	R_KeyValuePair* element = R_Dictionary_getElement(self, key);
+	if (element != NULL) return element;
+	element = R_List_add(self->elements, R_KeyValuePair);
+	return R_KeyValuePair_setKey(element, key);
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setInteger(R_Dictionary* self, const char* key, int value) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL) return NULL;
+	if (R_KeyValuePair_setInteger(R_Dictionary_getOrAddElement(self, key), value) == NULL) return NULL;
+	return self;
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setFloat(R_Dictionary* self, const char* key, float value) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL) return NULL;
+	if (R_KeyValuePair_setFloat(R_Dictionary_getOrAddElement(self, key), value) == NULL) return NULL;
+	return self;
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setBoolean(R_Dictionary* self, const char* key, bool value) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL) return NULL;
+	if (R_KeyValuePair_setBoolean(R_Dictionary_getOrAddElement(self, key), value) == NULL) return NULL;
+	return self;
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_setNull(R_Dictionary* self, const char* key) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || key == NULL) return NULL;
+	if (R_KeyValuePair_setNull(R_Dictionary_getOrAddElement(self, key)) == NULL) return NULL;
+	return self;
+}
+
+int R_FUNCTION_ATTRIBUTES R_Dictionary_getInteger(R_Dictionary* self, const char* key) {
+	return R_KeyValuePair_getInteger(R_Dictionary_getElement(self, key));
+}
+
+float R_FUNCTION_ATTRIBUTES R_Dictionary_getFloat(R_Dictionary* self, const char* key) {
+	return R_KeyValuePair_getFloat(R_Dictionary_getElement(self, key));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_Dictionary_getBoolean(R_Dictionary* self, const char* key) {
+	return R_KeyValuePair_getBoolean(R_Dictionary_getElement(self, key));
+}
+
+const R_Type* R_FUNCTION_ATTRIBUTES R_Dictionary_typeOf(R_Dictionary* self, const char* key) {
+	return R_KeyValuePair_valueType(R_Dictionary_getElement(self, key));
+}
+
 void R_FUNCTION_ATTRIBUTES R_Dictionary_removeAll(R_Dictionary* self) {
   if (R_Type_IsNotOf(self, R_Dictionary)) return;
 	R_List_removeAll(self->elements);
@@ -124,6 +216,40 @@ size_t R_FUNCTION_ATTRIBUTES R_Dictionary_size(R_Dictionary* self) {
 	return R_List_size(self->elements);
 }
 
+typedef struct {
+	R_Dictionary_Mapper mapper;
+	void* context;
+} R_Dictionary_MapContext;
+
+//Makes the new pair for a pair, so R_List_map can build the new dictionary's elements directly. Runs on several
+//threads at once, so the value is read without boxing or materializing it into the shared pair
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_mapPair(void* object, void* context) {
+	R_Dictionary_MapContext* map = (R_Dictionary_MapContext*)context;
+	const char* key = R_MutableString_cstring(R_KeyValuePair_key(object));
+	void* read = R_KeyValuePair_readValue(object);
+	void* value = map->mapper(key, read, map->context);
+	R_Type_Delete(read);
+	if (value == NULL) return NULL;
+	R_KeyValuePair* pair = R_KeyValuePair_setKey(R_Type_New(R_KeyValuePair), key);
+	if (pair == NULL) return R_Type_Delete(value), NULL;
+	return R_KeyValuePair_setValue(pair, value);
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_mapValues(R_Dictionary* self, R_Dictionary_Mapper mapper, void* context, size_t threads) {
+	if (R_Type_IsNotOf(self, R_Dictionary) || mapper == NULL) return NULL;
+	R_Dictionary_MapContext map = {mapper, context};
+	R_List* elements = R_List_map(self->elements, R_Dictionary_mapPair, &map, threads);
+	R_Dictionary* dictionary = R_Type_New(R_Dictionary);
+	if (elements == NULL || dictionary == NULL) {
+		R_Type_Delete(elements);
+		R_Type_Delete(dictionary);
+		return NULL;
+	}
+	R_Type_Delete(dictionary->elements);
+	dictionary->elements = elements;
+	return dictionary;
+}
+
 size_t R_FUNCTION_ATTRIBUTES R_Dictionary_stringify(R_Dictionary* self, char* buffer, size_t size) {
   if (R_Type_IsNotOf(self, R_Dictionary)) return 0;
   R_MutableString* string = R_Type_New(R_MutableString);
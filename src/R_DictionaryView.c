@@ -0,0 +1,441 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "R_OS.h"
+#include "R_DictionaryView.h"
+#include "R_NumericArray.h"
+
+/*  File layout
+    Everything is in the writer's byte order and every body starts on an 8-byte boundary.
+
+    header:     "RDV1", uint32 byte order mark
+    bodies:     uint32 count, uint32 zero, then count items:
+                  String and Bytes: the bytes, then a zero byte
+                  List: 8-byte slots
+                  Dictionary: 16-byte entries sorted by key, each uint32 key offset, uint32 key length and a slot
+                  IntArray, FloatArray and DoubleArray: the values
+    footer:     the root slot
+
+    A slot is uint32 kind and uint32 payload. The payload holds Null, Boolean, Integer, Unsigned and Float values
+   directly and is the offset of the body for everything else. Keys are stored with a trailing zero byte.
+ */
+#define R_DictionaryView_Magic "RDV1"
+#define R_DictionaryView_ByteOrderMark 0x01020304
+#define R_DictionaryView_HeaderSize 8
+#define R_DictionaryView_BodyHeaderSize 8
+#define R_DictionaryView_SlotSize 8
+#define R_DictionaryView_EntrySize 16
+
+struct R_DictionaryView {
+  R_Type* type;
+  const uint8_t* bytes;
+  size_t size;
+  bool mapped; //bytes came from R_OS_mapFile and have to be unmapped
+};
+
+static R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_Destructor(R_DictionaryView* self) {
+  R_DictionaryView_close(self);
+  return self;
+}
+R_Type_Def(R_DictionaryView, NULL, R_DictionaryView_Destructor, NULL, NULL);
+
+static const R_DictionaryView_Value R_DictionaryView_missing = {NULL, R_DictionaryView_Kind_Missing, 0};
+
+static uint32_t R_FUNCTION_ATTRIBUTES R_DictionaryView_word(const R_DictionaryView* view, size_t offset) {
+  uint32_t word = 0;
+  os_memcpy(&word, view->bytes + offset, sizeof(word));
+  return word;
+}
+
+static R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_validate(R_DictionaryView* self) {
+  if (self->size < R_DictionaryView_HeaderSize + R_DictionaryView_SlotSize || self->size % 8 != 0 || self->size > UINT32_MAX) return NULL;
+  if (os_memcmp(self->bytes, R_DictionaryView_Magic, 4) != 0) return NULL;
+  if (R_DictionaryView_word(self, 4) != R_DictionaryView_ByteOrderMark) return NULL;
+  if (R_DictionaryView_root(self).kind != R_DictionaryView_Kind_Dictionary) return NULL;
+  return self;
+}
+
+R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_open(R_DictionaryView* self, const char* path) {
+  if (R_Type_IsNotOf(self, R_DictionaryView) || path == NULL) return NULL;
+  R_DictionaryView_close(self);
+  self->bytes = (const uint8_t*)R_OS_mapFile(path, &self->size);
+  if (self->bytes == NULL) return NULL;
+  self->mapped = true;
+  if (R_DictionaryView_validate(self) == NULL) return R_DictionaryView_close(self), NULL;
+  return self;
+}
+
+R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_openBytes(R_DictionaryView* self, const uint8_t* bytes, size_t size) {
+  if (R_Type_IsNotOf(self, R_DictionaryView) || bytes == NULL || (uintptr_t)bytes % 8 != 0) return NULL;
+  R_DictionaryView_close(self);
+  self->bytes = bytes;
+  self->size = size;
+  if (R_DictionaryView_validate(self) == NULL) return R_DictionaryView_close(self), NULL;
+  return self;
+}
+
+R_DictionaryView* R_FUNCTION_ATTRIBUTES R_DictionaryView_close(R_DictionaryView* self) {
+  if (R_Type_IsNotOf(self, R_DictionaryView)) return NULL;
+  if (self->mapped) R_OS_unmapFile(self->bytes, self->size);
+  self->bytes = NULL;
+  self->size = 0;
+  self->mapped = false;
+  return self;
+}
+
+R_DictionaryView_Value R_FUNCTION_ATTRIBUTES R_DictionaryView_root(R_DictionaryView* self) {
+  if (R_Type_IsNotOf(self, R_DictionaryView) || self->bytes == NULL) return R_DictionaryView_missing;
+  R_DictionaryView_Value root = {self, R_DictionaryView_word(self, self->size - 8), R_DictionaryView_word(self, self->size - 4)};
+  return root;
+}
+
+/*  R_DictionaryView_body
+    Checks that the value's whole body is inside the file and sets count to its number of items. Corrupt offsets
+   fail here instead of running off the end of the mapping.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_DictionaryView_body(R_DictionaryView_Value value, size_t item_size, size_t trailer, size_t* count) {
+  const R_DictionaryView* view = value.view;
+  *count = 0;
+  if (view == NULL || value.payload % 8 != 0 || value.payload < R_DictionaryView_HeaderSize) return false;
+  if (value.payload > view->size - R_DictionaryView_SlotSize - R_DictionaryView_BodyHeaderSize) return false;
+  size_t items = R_DictionaryView_word(view, value.payload);
+  size_t available = view->size - R_DictionaryView_SlotSize - value.payload - R_DictionaryView_BodyHeaderSize;
+  if (available < trailer || items > (available - trailer) / item_size) return false;
+  *count = items;
+  return true;
+}
+
+static size_t R_FUNCTION_ATTRIBUTES R_DictionaryView_count(R_DictionaryView_Value value, size_t item_size, size_t trailer) {
+  size_t count = 0;
+  R_DictionaryView_body(value, item_size, trailer, &count);
+  return count;
+}
+
+static size_t R_FUNCTION_ATTRIBUTES R_DictionaryView_itemSize(uint32_t kind) {
+  switch (kind) {
+    case R_DictionaryView_Kind_String: return 1;
+    case R_DictionaryView_Kind_Bytes: return 1;
+    case R_DictionaryView_Kind_List: return R_DictionaryView_SlotSize;
+    case R_DictionaryView_Kind_Dictionary: return R_DictionaryView_EntrySize;
+    case R_DictionaryView_Kind_IntArray: return sizeof(int);
+    case R_DictionaryView_Kind_FloatArray: return sizeof(float);
+    case R_DictionaryView_Kind_DoubleArray: return sizeof(double);
+  }
+  return 0;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_DictionaryView_size(R_DictionaryView_Value value) {
+  size_t item_size = R_DictionaryView_itemSize(value.kind);
+  if (item_size == 0) return 0;
+  return R_DictionaryView_count(value, item_size, value.kind == R_DictionaryView_Kind_String || value.kind == R_DictionaryView_Kind_Bytes ? 1 : 0);
+}
+
+/*  R_DictionaryView_items
+    Returns a pointer to the items of a value of the given kind, or NULL if it's a different kind or corrupt.
+ */
+static const uint8_t* R_FUNCTION_ATTRIBUTES R_DictionaryView_items(R_DictionaryView_Value value, R_DictionaryView_Kind kind) {
+  size_t count = 0;
+  if (value.kind != kind) return NULL;
+  bool trailer = kind == R_DictionaryView_Kind_String || kind == R_DictionaryView_Kind_Bytes;
+  if (!R_DictionaryView_body(value, R_DictionaryView_itemSize(kind), trailer ? 1 : 0, &count)) return NULL;
+  const uint8_t* items = value.view->bytes + value.payload + R_DictionaryView_BodyHeaderSize;
+  if (trailer && items[count] != 0) return NULL;
+  return items;
+}
+
+/*  R_DictionaryView_entryKey
+    Returns the key of a dictionary entry and its length, or NULL if the key runs outside the file.
+ */
+static const char* R_FUNCTION_ATTRIBUTES R_DictionaryView_entryKey(R_DictionaryView_Value dictionary, size_t index, size_t* length) {
+  size_t entry = dictionary.payload + R_DictionaryView_BodyHeaderSize + index*R_DictionaryView_EntrySize;
+  size_t offset = R_DictionaryView_word(dictionary.view, entry);
+  *length = R_DictionaryView_word(dictionary.view, entry + 4);
+  if (offset > dictionary.view->size || *length >= dictionary.view->size - offset) return NULL;
+  if (dictionary.view->bytes[offset + *length] != 0) return NULL;
+  return (const char*)dictionary.view->bytes + offset;
+}
+
+static R_DictionaryView_Value R_FUNCTION_ATTRIBUTES R_DictionaryView_slot(const R_DictionaryView* view, size_t offset) {
+  R_DictionaryView_Value value = {view, R_DictionaryView_word(view, offset), R_DictionaryView_word(view, offset + 4)};
+  return value;
+}
+
+R_DictionaryView_Value R_FUNCTION_ATTRIBUTES R_DictionaryView_get(R_DictionaryView_Value dictionary, const char* key) {
+  if (dictionary.kind != R_DictionaryView_Kind_Dictionary || key == NULL) return R_DictionaryView_missing;
+  size_t key_length = os_strlen(key);
+  size_t low = 0;
+  size_t high = R_DictionaryView_count(dictionary, R_DictionaryView_EntrySize, 0);
+  while (low < high) {
+    size_t middle = low + (high - low)/2;
+    size_t length = 0;
+    const char* candidate = R_DictionaryView_entryKey(dictionary, middle, &length);
+    if (candidate == NULL) return R_DictionaryView_missing;
+    int order = os_memcmp(candidate, key, length < key_length ? length : key_length);
+    if (order == 0) order = (length > key_length) - (length < key_length);
+    if (order == 0) return R_DictionaryView_slot(dictionary.view, dictionary.payload + R_DictionaryView_BodyHeaderSize + middle*R_DictionaryView_EntrySize + 8);
+    if (order < 0) low = middle + 1;
+    else high = middle;
+  }
+  return R_DictionaryView_missing;
+}
+
+const char* R_FUNCTION_ATTRIBUTES R_DictionaryView_keyAt(R_DictionaryView_Value dictionary, size_t index) {
+  if (dictionary.kind != R_DictionaryView_Kind_Dictionary || index >= R_DictionaryView_size(dictionary)) return NULL;
+  size_t length = 0;
+  return R_DictionaryView_entryKey(dictionary, index, &length);
+}
+
+R_DictionaryView_Value R_FUNCTION_ATTRIBUTES R_DictionaryView_valueAt(R_DictionaryView_Value container, size_t index) {
+  if (index >= R_DictionaryView_size(container)) return R_DictionaryView_missing;
+  size_t items = container.payload + R_DictionaryView_BodyHeaderSize;
+  if (container.kind == R_DictionaryView_Kind_List) return R_DictionaryView_slot(container.view, items + index*R_DictionaryView_SlotSize);
+  if (container.kind == R_DictionaryView_Kind_Dictionary) return R_DictionaryView_slot(container.view, items + index*R_DictionaryView_EntrySize + 8);
+  return R_DictionaryView_missing;
+}
+
+R_DictionaryView_Kind R_FUNCTION_ATTRIBUTES R_DictionaryView_kind(R_DictionaryView_Value value) {
+  if (value.kind > R_DictionaryView_Kind_DoubleArray) return R_DictionaryView_Kind_Missing;
+  return (R_DictionaryView_Kind)value.kind;
+}
+
+int R_FUNCTION_ATTRIBUTES R_DictionaryView_getInteger(R_DictionaryView_Value value) {
+  if (value.kind != R_DictionaryView_Kind_Integer) return 0;
+  return (int)(int32_t)value.payload;
+}
+
+unsigned int R_FUNCTION_ATTRIBUTES R_DictionaryView_getUnsigned(R_DictionaryView_Value value) {
+  if (value.kind != R_DictionaryView_Kind_Unsigned) return 0;
+  return value.payload;
+}
+
+float R_FUNCTION_ATTRIBUTES R_DictionaryView_getFloat(R_DictionaryView_Value value) {
+  if (value.kind != R_DictionaryView_Kind_Float) return 0;
+  float floater = 0;
+  os_memcpy(&floater, &value.payload, sizeof(floater));
+  return floater;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_DictionaryView_getBoolean(R_DictionaryView_Value value) {
+  if (value.kind != R_DictionaryView_Kind_Boolean) return false;
+  return value.payload != 0;
+}
+
+const char* R_FUNCTION_ATTRIBUTES R_DictionaryView_getString(R_DictionaryView_Value value) {
+  return (const char*)R_DictionaryView_items(value, R_DictionaryView_Kind_String);
+}
+
+const uint8_t* R_FUNCTION_ATTRIBUTES R_DictionaryView_getBytes(R_DictionaryView_Value value) {
+  return (const uint8_t*)R_DictionaryView_items(value, R_DictionaryView_Kind_Bytes);
+}
+
+const int* R_FUNCTION_ATTRIBUTES R_DictionaryView_getInts(R_DictionaryView_Value value) {
+  return (const int*)R_DictionaryView_items(value, R_DictionaryView_Kind_IntArray);
+}
+
+const float* R_FUNCTION_ATTRIBUTES R_DictionaryView_getFloats(R_DictionaryView_Value value) {
+  return (const float*)R_DictionaryView_items(value, R_DictionaryView_Kind_FloatArray);
+}
+
+const double* R_FUNCTION_ATTRIBUTES R_DictionaryView_getDoubles(R_DictionaryView_Value value) {
+  return (const double*)R_DictionaryView_items(value, R_DictionaryView_Kind_DoubleArray);
+}
+
+
+typedef struct {
+  uint32_t kind;
+  uint32_t payload;
+} R_DictionaryView_Slot;
+
+static void R_FUNCTION_ATTRIBUTES R_DictionaryView_writeWord(R_MutableData* buffer, uint32_t word) {
+  R_MutableData_appendCArray(buffer, (const uint8_t*)&word, sizeof(word));
+}
+
+static void R_FUNCTION_ATTRIBUTES R_DictionaryView_writeSlot(R_MutableData* buffer, R_DictionaryView_Slot slot) {
+  R_DictionaryView_writeWord(buffer, slot.kind);
+  R_DictionaryView_writeWord(buffer, slot.payload);
+}
+
+/*  R_DictionaryView_writeBodyHeader
+    Pads to the next 8-byte boundary, writes the count and returns the body's offset. Returns false once the file no
+   longer fits in 32-bit offsets.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writeBodyHeader(R_MutableData* buffer, size_t count, R_DictionaryView_Slot* slot) {
+  while (R_MutableData_size(buffer) % 8 != 0) R_MutableData_appendByte(buffer, 0);
+  if (R_MutableData_size(buffer) > UINT32_MAX || count > UINT32_MAX) return false;
+  slot->payload = (uint32_t)R_MutableData_size(buffer);
+  R_DictionaryView_writeWord(buffer, (uint32_t)count);
+  R_DictionaryView_writeWord(buffer, 0);
+  return true;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writeBytes(R_MutableData* buffer, const uint8_t* bytes, size_t count, R_DictionaryView_Slot* slot) {
+  if (!R_DictionaryView_writeBodyHeader(buffer, count, slot)) return false;
+  if (count > 0) R_MutableData_appendCArray(buffer, bytes, count);
+  R_MutableData_appendByte(buffer, 0);
+  return true;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writeDictionary(R_MutableData* buffer, R_Dictionary* dictionary, R_DictionaryView_Slot* slot);
+
+static bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writeValue(R_MutableData* buffer, void* value, R_DictionaryView_Slot* slot) {
+  slot->kind = R_DictionaryView_Kind_Null;
+  slot->payload = 0;
+  if (R_Type_IsOf(value, R_Integer)) {
+    slot->kind = R_DictionaryView_Kind_Integer;
+    slot->payload = (uint32_t)R_Integer_get(value);
+  }
+  else if (R_Type_IsOf(value, R_Unsigned)) {
+    slot->kind = R_DictionaryView_Kind_Unsigned;
+    slot->payload = R_Unsigned_get(value);
+  }
+  else if (R_Type_IsOf(value, R_Float)) {
+    float floater = R_Float_get(value);
+    slot->kind = R_DictionaryView_Kind_Float;
+    os_memcpy(&slot->payload, &floater, sizeof(floater));
+  }
+  else if (R_Type_IsOf(value, R_Boolean)) {
+    slot->kind = R_DictionaryView_Kind_Boolean;
+    slot->payload = R_Boolean_get(value);
+  }
+  else if (R_Type_IsOf(value, R_MutableString)) {
+    slot->kind = R_DictionaryView_Kind_String;
+    return R_DictionaryView_writeBytes(buffer, (const uint8_t*)R_MutableString_cstring(value), R_MutableString_length(value), slot);
+  }
+  else if (R_Type_IsOf(value, R_String)) {
+    const char* string = R_String_get(value);
+    slot->kind = R_DictionaryView_Kind_String;
+    return R_DictionaryView_writeBytes(buffer, (const uint8_t*)string, string ? os_strlen(string) : 0, slot);
+  }
+  else if (R_Type_IsOf(value, R_MutableData)) {
+    slot->kind = R_DictionaryView_Kind_Bytes;
+    return R_DictionaryView_writeBytes(buffer, R_MutableData_bytes(value), R_MutableData_size(value), slot);
+  }
+  else if (R_Type_IsOf(value, R_Data)) {
+    slot->kind = R_DictionaryView_Kind_Bytes;
+    return R_DictionaryView_writeBytes(buffer, R_Data_bytes(value), R_Data_size(value), slot);
+  }
+  else if (R_Type_IsOf(value, R_IntArray)) {
+    slot->kind = R_DictionaryView_Kind_IntArray;
+    if (!R_DictionaryView_writeBodyHeader(buffer, R_IntArray_size(value), slot)) return false;
+    R_MutableData_appendCArray(buffer, (const uint8_t*)R_IntArray_values(value), R_IntArray_size(value)*sizeof(int));
+  }
+  else if (R_Type_IsOf(value, R_FloatArray)) {
+    slot->kind = R_DictionaryView_Kind_FloatArray;
+    if (!R_DictionaryView_writeBodyHeader(buffer, R_FloatArray_size(value), slot)) return false;
+    R_MutableData_appendCArray(buffer, (const uint8_t*)R_FloatArray_values(value), R_FloatArray_size(value)*sizeof(float));
+  }
+  else if (R_Type_IsOf(value, R_DoubleArray)) {
+    slot->kind = R_DictionaryView_Kind_DoubleArray;
+    if (!R_DictionaryView_writeBodyHeader(buffer, R_DoubleArray_size(value), slot)) return false;
+    R_MutableData_appendCArray(buffer, (const uint8_t*)R_DoubleArray_values(value), R_DoubleArray_size(value)*sizeof(double));
+  }
+  else if (R_Type_IsOf(value, R_Dictionary)) return R_DictionaryView_writeDictionary(buffer, value, slot);
+  else if (R_Type_IsOf(value, R_List)) {
+    //Children are written first so their offsets are known when the list's slots are written
+    size_t count = R_List_size(value);
+    size_t slots_size = (count ? count : 1)*sizeof(R_DictionaryView_Slot);
+    R_DictionaryView_Slot* slots = (R_DictionaryView_Slot*)os_malloc(slots_size);
+    if (slots == NULL) return false;
+    for (size_t i=0; i<count; i++) {
+      if (!R_DictionaryView_writeValue(buffer, R_List_pointerAtIndex(value, i), &slots[i])) return os_free_sized(slots, slots_size), false;
+    }
+    slot->kind = R_DictionaryView_Kind_List;
+    bool success = R_DictionaryView_writeBodyHeader(buffer, count, slot);
+    for (size_t i=0; success && i<count; i++) R_DictionaryView_writeSlot(buffer, slots[i]);
+    os_free_sized(slots, slots_size);
+    return success;
+  }
+  return true;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writePair(R_MutableData* buffer, R_KeyValuePair* pair, R_DictionaryView_Slot* slot) {
+  const R_Type* type = R_KeyValuePair_valueType(pair);
+  slot->payload = 0;
+  if (type == R_Type_Object(R_Integer)) {
+    slot->kind = R_DictionaryView_Kind_Integer;
+    slot->payload = (uint32_t)R_KeyValuePair_getInteger(pair);
+  }
+  else if (type == R_Type_Object(R_Float)) {
+    float floater = R_KeyValuePair_getFloat(pair);
+    slot->kind = R_DictionaryView_Kind_Float;
+    os_memcpy(&slot->payload, &floater, sizeof(floater));
+  }
+  else if (type == R_Type_Object(R_Boolean)) {
+    slot->kind = R_DictionaryView_Kind_Boolean;
+    slot->payload = R_KeyValuePair_getBoolean(pair);
+  }
+  else if (type == R_Type_Object(R_Null)) slot->kind = R_DictionaryView_Kind_Null;
+  else return R_DictionaryView_writeValue(buffer, R_KeyValuePair_value(pair), slot);
+  return true;
+}
+
+/*  R_DictionaryView_sortPairs
+    Merge sorts the pairs by key, using scratch as the other half of each merge.
+ */
+static void R_FUNCTION_ATTRIBUTES R_DictionaryView_sortPairs(R_KeyValuePair** pairs, R_KeyValuePair** scratch, size_t count) {
+  if (count < 2) return;
+  size_t middle = count/2;
+  R_DictionaryView_sortPairs(pairs, scratch, middle);
+  R_DictionaryView_sortPairs(pairs + middle, scratch, count - middle);
+  size_t left = 0;
+  size_t right = middle;
+  for (size_t i=0; i<count; i++) {
+    if (right >= count || (left < middle && R_MutableString_order(R_KeyValuePair_key(pairs[left]), R_KeyValuePair_key(pairs[right])) <= 0)) scratch[i] = pairs[left++];
+    else scratch[i] = pairs[right++];
+  }
+  os_memcpy(pairs, scratch, count*sizeof(R_KeyValuePair*));
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writeDictionary(R_MutableData* buffer, R_Dictionary* dictionary, R_DictionaryView_Slot* slot) {
+  R_List* elements = R_Dictionary_listOfPairs(dictionary);
+  size_t count = R_List_size(elements);
+  size_t allocation = (count ? count : 1);
+  R_KeyValuePair** pairs = (R_KeyValuePair**)os_malloc(2*allocation*sizeof(R_KeyValuePair*));
+  R_DictionaryView_Slot* slots = (R_DictionaryView_Slot*)os_malloc(allocation*sizeof(R_DictionaryView_Slot));
+  uint32_t* keys = (uint32_t*)os_malloc(allocation*sizeof(uint32_t));
+  bool success = pairs != NULL && slots != NULL && keys != NULL;
+  if (success) {
+    if (count > 0) os_memcpy(pairs, R_List_pointers(elements), count*sizeof(R_KeyValuePair*));
+    R_DictionaryView_sortPairs(pairs, pairs + allocation, count);
+  }
+  for (size_t i=0; success && i<count; i++) success = R_DictionaryView_writePair(buffer, pairs[i], &slots[i]);
+  for (size_t i=0; success && i<count; i++) {
+    R_MutableString* key = R_KeyValuePair_key(pairs[i]);
+    if (R_MutableData_size(buffer) > UINT32_MAX) success = false;
+    keys[i] = (uint32_t)R_MutableData_size(buffer);
+    R_MutableData_appendCArray(buffer, (const uint8_t*)R_MutableString_cstring(key), R_MutableString_length(key));
+    R_MutableData_appendByte(buffer, 0);
+  }
+  slot->kind = R_DictionaryView_Kind_Dictionary;
+  if (success) success = R_DictionaryView_writeBodyHeader(buffer, count, slot);
+  for (size_t i=0; success && i<count; i++) {
+    R_DictionaryView_writeWord(buffer, keys[i]);
+    R_DictionaryView_writeWord(buffer, (uint32_t)R_MutableString_length(R_KeyValuePair_key(pairs[i])));
+    R_DictionaryView_writeSlot(buffer, slots[i]);
+  }
+  os_free_sized(pairs, 2*allocation*sizeof(R_KeyValuePair*));
+  os_free_sized(slots, allocation*sizeof(R_DictionaryView_Slot));
+  os_free_sized(keys, allocation*sizeof(uint32_t));
+  return success;
+}
+
+R_MutableData* R_FUNCTION_ATTRIBUTES R_DictionaryView_write(R_Dictionary* dictionary, R_MutableData* buffer) {
+  if (R_Type_IsNotOf(dictionary, R_Dictionary) || R_MutableData_reset(buffer) == NULL) return NULL;
+  R_MutableData_appendCArray(buffer, (const uint8_t*)R_DictionaryView_Magic, 4);
+  R_DictionaryView_writeWord(buffer, R_DictionaryView_ByteOrderMark);
+  R_DictionaryView_Slot root;
+  if (!R_DictionaryView_writeDictionary(buffer, dictionary, &root)) return NULL;
+  while (R_MutableData_size(buffer) % 8 != 0) R_MutableData_appendByte(buffer, 0);
+  R_DictionaryView_writeSlot(buffer, root);
+  if (R_MutableData_size(buffer) > UINT32_MAX) return NULL;
+  return buffer;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_DictionaryView_writeFile(R_Dictionary* dictionary, const char* path) {
+  if (path == NULL) return false;
+  R_MutableData* buffer = R_Type_New(R_MutableData);
+  bool success = R_DictionaryView_write(dictionary, buffer) != NULL && R_OS_writeFile(path, R_MutableData_bytes(buffer), R_MutableData_size(buffer));
+  R_Type_Delete(buffer);
+  return success;
+}
@@ -0,0 +1,474 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "R_Dictionary.h"
+#include "R_List.h"
+#include "R_MutableString.h"
+#include "R_MutableData.h"
+#include "R_NumericArray.h"
+
+enum {
+  R_Dictionary_Cbor_Unsigned = 0,
+  R_Dictionary_Cbor_Negative = 1,
+  R_Dictionary_Cbor_Bytes = 2,
+  R_Dictionary_Cbor_Text = 3,
+  R_Dictionary_Cbor_Array = 4,
+  R_Dictionary_Cbor_Map = 5,
+  R_Dictionary_Cbor_Tag = 6,
+  R_Dictionary_Cbor_Simple = 7,
+};
+
+enum {
+  R_Dictionary_Cbor_False = 20,
+  R_Dictionary_Cbor_True = 21,
+  R_Dictionary_Cbor_Null = 22,
+  R_Dictionary_Cbor_Undefined = 23,
+  R_Dictionary_Cbor_SimpleByte = 24,
+  R_Dictionary_Cbor_Float16 = 25,
+  R_Dictionary_Cbor_Float32 = 26,
+  R_Dictionary_Cbor_Float64 = 27,
+};
+
+//RFC 8746 typed array tags
+enum {
+  R_Dictionary_Cbor_TagInt32LE = 78,
+  R_Dictionary_Cbor_TagFloat32LE = 85,
+  R_Dictionary_Cbor_TagFloat64LE = 86,
+};
+
+//Nesting limit, so malformed input can't recurse forever
+#define R_Dictionary_Cbor_MaxDepth 256
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeHead(R_MutableData* buffer, uint8_t major, uint64_t value);
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeDictionary(R_MutableData* buffer, R_Dictionary* dictionary);
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writePair(R_MutableData* buffer, R_KeyValuePair* element);
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeValue(R_MutableData* buffer, void* value);
+R_MutableData* R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor(R_Dictionary* self, R_MutableData* buffer) {
+  if (R_Type_IsNotOf(self, R_Dictionary) || buffer == NULL || R_MutableData_reset(buffer) == NULL) return NULL;
+  R_Dictionary_toCbor_writeDictionary(buffer, self);
+  return buffer;
+}
+
+/*  R_Dictionary_toCbor_writeHead
+    Writes the major type and its argument, using the shortest encoding.
+ */
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeHead(R_MutableData* buffer, uint8_t major, uint64_t value) {
+  uint8_t head[9];
+  size_t length = 0;
+  size_t bytes = 0;
+  major <<= 5;
+  if (value < 24) head[length++] = major | (uint8_t)value;
+  else if (value <= 0xFF) head[length++] = major | 24, bytes = 1;
+  else if (value <= 0xFFFF) head[length++] = major | 25, bytes = 2;
+  else if (value <= 0xFFFFFFFF) head[length++] = major | 26, bytes = 4;
+  else head[length++] = major | 27, bytes = 8;
+  while (bytes-- > 0) head[length++] = (uint8_t)(value >> (bytes*8));
+  R_MutableData_appendCArray(buffer, head, length);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeInteger(R_MutableData* buffer, int value) {
+  if (value >= 0) R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Unsigned, (uint64_t)value);
+  else R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Negative, (uint64_t)(-1 - (int64_t)value));
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeFloat(R_MutableData* buffer, float value) {
+  uint32_t bits = 0;
+  os_memcpy(&bits, &value, sizeof(bits));
+  uint8_t bytes[5] = {(R_Dictionary_Cbor_Simple << 5) | R_Dictionary_Cbor_Float32, bits >> 24, bits >> 16, bits >> 8, bits};
+  R_MutableData_appendCArray(buffer, bytes, sizeof(bytes));
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeSimple(R_MutableData* buffer, uint8_t value) {
+  R_MutableData_appendByte(buffer, (R_Dictionary_Cbor_Simple << 5) | value);
+}
+
+/*  R_Dictionary_toCbor_writeLittleEndian
+    Appends count values of the given width in little-endian order, whatever the host's byte order is.
+ */
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeLittleEndian(R_MutableData* buffer, const void* values, size_t count, size_t width) {
+  R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Bytes, count*width);
+  const uint8_t* bytes = (const uint8_t*)values;
+  const uint16_t probe = 1;
+  if (*(const uint8_t*)&probe == 1) {
+    R_MutableData_appendCArray(buffer, bytes, count*width);
+    return;
+  }
+  for (size_t i=0; i<count; i++) {
+    uint8_t value[8];
+    if (width == 4) {
+      uint32_t word = 0;
+      os_memcpy(&word, bytes + i*width, width);
+      for (size_t b=0; b<width; b++) value[b] = (uint8_t)(word >> (b*8));
+    }
+    else {
+      uint64_t word = 0;
+      os_memcpy(&word, bytes + i*width, width);
+      for (size_t b=0; b<width; b++) value[b] = (uint8_t)(word >> (b*8));
+    }
+    R_MutableData_appendCArray(buffer, value, width);
+  }
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeDictionary(R_MutableData* buffer, R_Dictionary* dictionary) {
+  R_List* elements = R_Dictionary_listOfPairs(dictionary);
+  R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Map, R_List_size(elements));
+  R_List_each(elements, R_KeyValuePair, element) {
+    R_MutableString* key = R_KeyValuePair_key(element);
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Text, R_MutableString_length(key));
+    R_MutableData_appendCArray(buffer, (const uint8_t*)R_MutableString_cstring(key), R_MutableString_length(key));
+    R_Dictionary_toCbor_writePair(buffer, element);
+  }
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writePair(R_MutableData* buffer, R_KeyValuePair* element) {
+  const R_Type* type = R_KeyValuePair_valueType(element);
+  if (type == R_Type_Object(R_Integer)) R_Dictionary_toCbor_writeInteger(buffer, R_KeyValuePair_getInteger(element));
+  else if (type == R_Type_Object(R_Float)) R_Dictionary_toCbor_writeFloat(buffer, R_KeyValuePair_getFloat(element));
+  else if (type == R_Type_Object(R_Boolean)) R_Dictionary_toCbor_writeSimple(buffer, R_KeyValuePair_getBoolean(element) ? R_Dictionary_Cbor_True : R_Dictionary_Cbor_False);
+  else if (type == R_Type_Object(R_Null)) R_Dictionary_toCbor_writeSimple(buffer, R_Dictionary_Cbor_Null);
+  else R_Dictionary_toCbor_writeValue(buffer, R_KeyValuePair_value(element));
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toCbor_writeValue(R_MutableData* buffer, void* value) {
+  if (R_Type_IsOf(value, R_MutableString)) {
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Text, R_MutableString_length(value));
+    R_MutableData_appendCArray(buffer, (const uint8_t*)R_MutableString_cstring(value), R_MutableString_length(value));
+  }
+  else if (R_Type_IsOf(value, R_String)) {
+    const char* string = R_String_get(value);
+    size_t length = string ? os_strlen(string) : 0;
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Text, length);
+    R_MutableData_appendCArray(buffer, (const uint8_t*)string, length);
+  }
+  else if (R_Type_IsOf(value, R_Integer)) R_Dictionary_toCbor_writeInteger(buffer, R_Integer_get(value));
+  else if (R_Type_IsOf(value, R_Unsigned)) R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Unsigned, R_Unsigned_get(value));
+  else if (R_Type_IsOf(value, R_Float)) R_Dictionary_toCbor_writeFloat(buffer, R_Float_get(value));
+  else if (R_Type_IsOf(value, R_Boolean)) R_Dictionary_toCbor_writeSimple(buffer, R_Boolean_get(value) ? R_Dictionary_Cbor_True : R_Dictionary_Cbor_False);
+  else if (R_Type_IsOf(value, R_Null)) R_Dictionary_toCbor_writeSimple(buffer, R_Dictionary_Cbor_Null);
+  else if (R_Type_IsOf(value, R_MutableData)) {
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Bytes, R_MutableData_size(value));
+    R_MutableData_appendArray(buffer, value);
+  }
+  else if (R_Type_IsOf(value, R_Data)) {
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Tag, R_Dictionary_CborTag_Data);
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Bytes, R_Data_size(value));
+    R_MutableData_appendCArray(buffer, R_Data_bytes(value), R_Data_size(value));
+  }
+  else if (R_Type_IsOf(value, R_Dictionary)) R_Dictionary_toCbor_writeDictionary(buffer, value);
+  else if (R_Type_IsOf(value, R_List)) {
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Array, R_List_size(value));
+    R_List_each(value, void, element) R_Dictionary_toCbor_writeValue(buffer, element);
+  }
+  else if (R_Type_IsOf(value, R_IntArray)) {
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Tag, R_Dictionary_Cbor_TagInt32LE);
+    R_Dictionary_toCbor_writeLittleEndian(buffer, R_IntArray_values(value), R_IntArray_size(value), sizeof(int32_t));
+  }
+  else if (R_Type_IsOf(value, R_FloatArray)) {
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Tag, R_Dictionary_Cbor_TagFloat32LE);
+    R_Dictionary_toCbor_writeLittleEndian(buffer, R_FloatArray_values(value), R_FloatArray_size(value), sizeof(float));
+  }
+  else if (R_Type_IsOf(value, R_DoubleArray)) {
+    R_Dictionary_toCbor_writeHead(buffer, R_Dictionary_Cbor_Tag, R_Dictionary_Cbor_TagFloat64LE);
+    R_Dictionary_toCbor_writeLittleEndian(buffer, R_DoubleArray_values(value), R_DoubleArray_size(value), sizeof(double));
+  }
+  else R_Dictionary_toCbor_writeSimple(buffer, R_Dictionary_Cbor_Undefined);
+}
+
+
+/*  R_Dictionary_Cbor_Reader
+    A cursor over the encoded bytes. Nothing is copied until a value is built.
+ */
+typedef struct {
+  const uint8_t* bytes;
+  size_t size;
+  size_t offset;
+  size_t depth;
+} R_Dictionary_Cbor_Reader;
+
+typedef struct {
+  uint8_t major;
+  uint8_t info;
+  uint64_t value;
+  size_t length; //Bytes used by the head itself
+} R_Dictionary_Cbor_Head;
+
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_peekHead(R_Dictionary_Cbor_Reader* reader, R_Dictionary_Cbor_Head* head);
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readObject(R_Dictionary_Cbor_Reader* reader, R_Dictionary* object);
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readValue(R_Dictionary_Cbor_Reader* reader);
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor(R_Dictionary* self, const R_MutableData* buffer) {
+  if (R_Type_IsNotOf(self, R_Dictionary) || buffer == NULL) return NULL;
+  R_Dictionary_removeAll(self);
+  R_Dictionary_Cbor_Reader reader = {R_MutableData_bytes(buffer), R_MutableData_size(buffer), 0, 0};
+  if (!R_Dictionary_fromCbor_readObject(&reader, self)) return NULL;
+  if (reader.offset != reader.size) return NULL;
+  return self;
+}
+
+/*  R_Dictionary_fromCbor_peekHead
+    Decodes the head at the cursor without consuming it. Returns false if it's truncated or indefinite-length.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_peekHead(R_Dictionary_Cbor_Reader* reader, R_Dictionary_Cbor_Head* head) {
+  if (reader->offset >= reader->size) return false;
+  const uint8_t* bytes = reader->bytes + reader->offset;
+  size_t available = reader->size - reader->offset;
+  head->major = bytes[0] >> 5;
+  head->info = bytes[0] & 0x1F;
+  head->value = 0;
+  head->length = 1;
+  size_t extra = 0;
+  if (head->info < 24) head->value = head->info;
+  else if (head->info == 24) extra = 1;
+  else if (head->info == 25) extra = 2;
+  else if (head->info == 26) extra = 4;
+  else if (head->info == 27) extra = 8;
+  else return false;
+  if (available < 1 + extra) return false;
+  for (size_t i=1; i<=extra; i++) head->value = (head->value << 8) | bytes[i];
+  head->length += extra;
+  return true;
+}
+
+/*  R_Dictionary_fromCbor_readPayload
+    Consumes the head and returns a pointer to the byte or text string payload that follows it.
+ */
+static const uint8_t* R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readPayload(R_Dictionary_Cbor_Reader* reader, const R_Dictionary_Cbor_Head* head) {
+  size_t available = reader->size - reader->offset - head->length;
+  if (head->value > available) return NULL;
+  const uint8_t* payload = reader->bytes + reader->offset + head->length;
+  reader->offset += head->length + (size_t)head->value;
+  return payload;
+}
+
+/*  R_Dictionary_fromCbor_reserveCount
+    Clamps a length prefix to what the remaining bytes could hold, so a corrupt prefix can't reserve gigabytes.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_reserveCount(R_Dictionary_Cbor_Reader* reader, uint64_t count) {
+  size_t available = reader->size - reader->offset;
+  return count < available ? (size_t)count : available;
+}
+
+/*  R_Dictionary_fromCbor_halfBits
+    Widens the bits of a half-precision float to single precision. Every half is exactly representable as a float;
+   subnormal halves come out as normal floats.
+ */
+static uint32_t R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_halfBits(uint16_t half) {
+  uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+  int32_t exponent = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+  if (exponent == 0x1F) return sign | 0x7F800000 | mantissa << 13; //infinity and NaN
+  if (exponent == 0) {
+    if (mantissa == 0) return sign;
+    //Shift the subnormal up until it has a leading 1, like a normal half with a smaller exponent
+    exponent = 1;
+    while (!(mantissa & 0x400)) mantissa <<= 1, exponent--;
+    mantissa &= 0x3FF;
+  }
+  return sign | (uint32_t)(exponent + 127 - 15) << 23 | mantissa << 13;
+}
+
+static float R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_float(const R_Dictionary_Cbor_Head* head) {
+  if (head->info == R_Dictionary_Cbor_Float64) {
+    double value = 0;
+    os_memcpy(&value, &head->value, sizeof(value));
+    return (float)value;
+  }
+  uint32_t bits = head->info == R_Dictionary_Cbor_Float16 ? R_Dictionary_fromCbor_halfBits((uint16_t)head->value) : (uint32_t)head->value;
+  float value = 0;
+  os_memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_isFloat(const R_Dictionary_Cbor_Head* head) {
+  return head->major == R_Dictionary_Cbor_Simple && (head->info == R_Dictionary_Cbor_Float16 || head->info == R_Dictionary_Cbor_Float32 || head->info == R_Dictionary_Cbor_Float64);
+}
+
+/*  R_Dictionary_fromCbor_skipSimple
+    Consumes a simple value with no meaning here, either unassigned or from the one-byte range, and returns true.
+   Returns false, without consuming anything, for everything else.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_skipSimple(R_Dictionary_Cbor_Reader* reader) {
+  R_Dictionary_Cbor_Head head;
+  if (!R_Dictionary_fromCbor_peekHead(reader, &head) || head.major != R_Dictionary_Cbor_Simple) return false;
+  if (head.info >= R_Dictionary_Cbor_False && head.info != R_Dictionary_Cbor_SimpleByte) return false;
+  reader->offset += head.length;
+  return true;
+}
+
+/*  R_Dictionary_fromCbor_wideInteger
+    Integers beyond what an int holds come back as the nearest float.
+ */
+static float R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_wideInteger(const R_Dictionary_Cbor_Head* head) {
+  if (head->major == R_Dictionary_Cbor_Negative) return -1.0f - (float)head->value;
+  return (float)head->value;
+}
+
+/*  R_Dictionary_fromCbor_readScalar
+    Reads an int, float, boolean or null straight into the dictionary without boxing it. Returns false, without
+   consuming anything, if the next value is something else.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readScalar(R_Dictionary_Cbor_Reader* reader, R_Dictionary* object, const char* key) {
+  R_Dictionary_Cbor_Head head;
+  if (!R_Dictionary_fromCbor_peekHead(reader, &head)) return false;
+  R_Dictionary* result = NULL;
+  if (head.major == R_Dictionary_Cbor_Unsigned && head.value <= INT_MAX) result = R_Dictionary_setInteger(object, key, (int)head.value);
+  else if (head.major == R_Dictionary_Cbor_Unsigned && head.value > UINT_MAX) result = R_Dictionary_setFloat(object, key, R_Dictionary_fromCbor_wideInteger(&head));
+  else if (head.major == R_Dictionary_Cbor_Negative && head.value <= INT_MAX) result = R_Dictionary_setInteger(object, key, (int)(-1 - (int64_t)head.value));
+  else if (head.major == R_Dictionary_Cbor_Negative) result = R_Dictionary_setFloat(object, key, R_Dictionary_fromCbor_wideInteger(&head));
+  else if (head.major == R_Dictionary_Cbor_Simple) {
+    if (head.info == R_Dictionary_Cbor_False || head.info == R_Dictionary_Cbor_True) result = R_Dictionary_setBoolean(object, key, head.info == R_Dictionary_Cbor_True);
+    else if (head.info == R_Dictionary_Cbor_Null || head.info == R_Dictionary_Cbor_Undefined) result = R_Dictionary_setNull(object, key);
+    else if (R_Dictionary_fromCbor_isFloat(&head)) result = R_Dictionary_setFloat(object, key, R_Dictionary_fromCbor_float(&head));
+    else return false;
+  }
+  else return false;
+  if (result == NULL) return false;
+  reader->offset += head.length;
+  return true;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readObject(R_Dictionary_Cbor_Reader* reader, R_Dictionary* object) {
+  R_Dictionary_Cbor_Head head;
+  if (!R_Dictionary_fromCbor_peekHead(reader, &head) || head.major != R_Dictionary_Cbor_Map) return false;
+  if (++reader->depth > R_Dictionary_Cbor_MaxDepth) return false;
+  reader->offset += head.length;
+  uint64_t count = head.value;
+  R_List_reserve(R_Dictionary_listOfPairs(object), R_Dictionary_fromCbor_reserveCount(reader, count));
+  R_MutableString* key = R_Type_New(R_MutableString);
+  for (uint64_t i=0; i<count; i++) {
+    //keys have to be text strings
+    R_Dictionary_Cbor_Head key_head;
+    if (!R_Dictionary_fromCbor_peekHead(reader, &key_head) || key_head.major != R_Dictionary_Cbor_Text) return R_Type_Delete(key), false;
+    const uint8_t* key_bytes = R_Dictionary_fromCbor_readPayload(reader, &key_head);
+    if (key_bytes == NULL) return R_Type_Delete(key), false;
+    R_MutableString_appendBytes(R_MutableString_reset(key), (const char*)key_bytes, (size_t)key_head.value);
+    //read value, storing numbers, booleans and nulls inline and leaving out keys with unknown simple values
+    if (R_Dictionary_fromCbor_skipSimple(reader)) continue;
+    if (!R_Dictionary_fromCbor_readScalar(reader, object, R_MutableString_cstring(key))) {
+      void* value = R_Dictionary_fromCbor_readValue(reader);
+      if (value == NULL || R_Dictionary_transferOwnership(object, R_MutableString_cstring(key), value) == NULL) return R_Type_Delete(value), R_Type_Delete(key), false;
+    }
+  }
+  R_Type_Delete(key);
+  reader->depth--;
+  return true;
+}
+
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readArray(R_Dictionary_Cbor_Reader* reader, const R_Dictionary_Cbor_Head* head) {
+  if (++reader->depth > R_Dictionary_Cbor_MaxDepth) return NULL;
+  reader->offset += head->length;
+  R_List* array = R_Type_New(R_List);
+  R_List_reserve(array, R_Dictionary_fromCbor_reserveCount(reader, head->value));
+  for (uint64_t i=0; i<head->value; i++) {
+    if (R_Dictionary_fromCbor_skipSimple(reader)) continue;
+    void* value = R_Dictionary_fromCbor_readValue(reader);
+    if (value == NULL || R_List_transferOwnership(array, value) == NULL) return R_Type_Delete(value), R_Type_Delete(array), NULL;
+  }
+  reader->depth--;
+  return array;
+}
+
+/*  R_Dictionary_fromCbor_readTypedArray
+    Reads the byte string following an RFC 8746 tag into the matching typed array.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readTypedArray(R_Dictionary_Cbor_Reader* reader, uint64_t tag) {
+  R_Dictionary_Cbor_Head head;
+  if (!R_Dictionary_fromCbor_peekHead(reader, &head) || head.major != R_Dictionary_Cbor_Bytes) return NULL;
+  size_t width = tag == R_Dictionary_Cbor_TagFloat64LE ? 8 : 4;
+  if (head.value % width != 0) return NULL;
+  const uint8_t* bytes = R_Dictionary_fromCbor_readPayload(reader, &head);
+  if (bytes == NULL) return NULL;
+  size_t count = (size_t)head.value / width;
+  if (tag == R_Dictionary_Cbor_TagInt32LE) {
+    R_IntArray* array = R_IntArray_reserve(R_Type_New(R_IntArray), count);
+    for (size_t i=0; i<count; i++, bytes += 4) {
+      uint32_t word = (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+      R_IntArray_append(array, (int32_t)word);
+    }
+    return array;
+  }
+  else if (tag == R_Dictionary_Cbor_TagFloat32LE) {
+    R_FloatArray* array = R_FloatArray_reserve(R_Type_New(R_FloatArray), count);
+    for (size_t i=0; i<count; i++, bytes += 4) {
+      uint32_t word = (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+      float value = 0;
+      os_memcpy(&value, &word, sizeof(value));
+      R_FloatArray_append(array, value);
+    }
+    return array;
+  }
+  R_DoubleArray* array = R_DoubleArray_reserve(R_Type_New(R_DoubleArray), count);
+  for (size_t i=0; i<count; i++, bytes += 8) {
+    uint64_t word = 0;
+    for (int b=7; b>=0; b--) word = (word << 8) | bytes[b];
+    double value = 0;
+    os_memcpy(&value, &word, sizeof(value));
+    R_DoubleArray_append(array, value);
+  }
+  return array;
+}
+
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromCbor_readValue(R_Dictionary_Cbor_Reader* reader) {
+  R_Dictionary_Cbor_Head head;
+  if (!R_Dictionary_fromCbor_peekHead(reader, &head)) return NULL;
+  switch (head.major) {
+    case R_Dictionary_Cbor_Unsigned:
+      reader->offset += head.length;
+      if (head.value <= INT_MAX) return R_Integer_set(R_Type_New(R_Integer), (int)head.value);
+      if (head.value <= UINT_MAX) return R_Unsigned_set(R_Type_New(R_Unsigned), (unsigned int)head.value);
+      return R_Float_set(R_Type_New(R_Float), R_Dictionary_fromCbor_wideInteger(&head));
+    case R_Dictionary_Cbor_Negative:
+      reader->offset += head.length;
+      if (head.value <= INT_MAX) return R_Integer_set(R_Type_New(R_Integer), (int)(-1 - (int64_t)head.value));
+      return R_Float_set(R_Type_New(R_Float), R_Dictionary_fromCbor_wideInteger(&head));
+    case R_Dictionary_Cbor_Bytes: {
+      const uint8_t* bytes = R_Dictionary_fromCbor_readPayload(reader, &head);
+      if (bytes == NULL) return NULL;
+      //Appending nothing returns NULL, so an empty string is just the new object
+      R_MutableData* data = R_Type_New(R_MutableData);
+      if (data != NULL && head.value > 0 && R_MutableData_appendCArray(data, bytes, (size_t)head.value) == NULL) R_Type_DeleteAndNull(data);
+      return data;
+    }
+    case R_Dictionary_Cbor_Text: {
+      const uint8_t* bytes = R_Dictionary_fromCbor_readPayload(reader, &head);
+      if (bytes == NULL) return NULL;
+      R_MutableString* string = R_Type_New(R_MutableString);
+      if (string != NULL && head.value > 0 && R_MutableString_appendBytes(string, (const char*)bytes, (size_t)head.value) == NULL) R_Type_DeleteAndNull(string);
+      return string;
+    }
+    case R_Dictionary_Cbor_Array:
+      return R_Dictionary_fromCbor_readArray(reader, &head);
+    case R_Dictionary_Cbor_Map: {
+      R_Dictionary* child = R_Type_New(R_Dictionary);
+      if (!R_Dictionary_fromCbor_readObject(reader, child)) return R_Type_Delete(child), NULL;
+      return child;
+    }
+    case R_Dictionary_Cbor_Tag:
+      reader->offset += head.length;
+      if (head.value == R_Dictionary_Cbor_TagInt32LE || head.value == R_Dictionary_Cbor_TagFloat32LE || head.value == R_Dictionary_Cbor_TagFloat64LE) {
+        return R_Dictionary_fromCbor_readTypedArray(reader, head.value);
+      }
+      else if (head.value == R_Dictionary_CborTag_Data) {
+        R_Dictionary_Cbor_Head data_head;
+        if (!R_Dictionary_fromCbor_peekHead(reader, &data_head) || data_head.major != R_Dictionary_Cbor_Bytes) return NULL;
+        const uint8_t* bytes = R_Dictionary_fromCbor_readPayload(reader, &data_head);
+        if (bytes == NULL) return NULL;
+        return R_Data_New((uint8_t*)bytes, (size_t)data_head.value);
+      }
+      //Unknown tags are ignored and the tagged item is read as-is
+      else {
+        if (++reader->depth > R_Dictionary_Cbor_MaxDepth) return NULL;
+        void* value = R_Dictionary_fromCbor_readValue(reader);
+        reader->depth--;
+        return value;
+      }
+    case R_Dictionary_Cbor_Simple:
+      reader->offset += head.length;
+      if (head.info == R_Dictionary_Cbor_False || head.info == R_Dictionary_Cbor_True) return R_Boolean_set(R_Type_New(R_Boolean), head.info == R_Dictionary_Cbor_True);
+      if (head.info == R_Dictionary_Cbor_Null || head.info == R_Dictionary_Cbor_Undefined) return R_Type_New(R_Null);
+      if (R_Dictionary_fromCbor_isFloat(&head)) return R_Float_set(R_Type_New(R_Float), R_Dictionary_fromCbor_float(&head));
+      //An unknown simple value that's been tagged has no pair or element of its own to leave out
+      return R_Type_New(R_Null);
+  }
+  return NULL;
+}
@@ -4,69 +4,574 @@
 #include "R_Dictionary.h"
 #include "R_List.h"
 #include "R_MutableString.h"
+#include "R_NumericArray.h"
+#include "R_PersistentDictionary.h"
+#include "R_OrderedDictionary.h"
 
-static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeValue(R_MutableString* buffer, void* value);
+/*  R_Dictionary_JsonWriter
+    State for one call to R_Dictionary_toJsonWithOptions. order is a stack of pair pointers for sorting keys, shared by
+   every level of nesting so sorting doesn't allocate per dictionary. When hashing, the buffer is folded into hash and
+   emptied every R_Dictionary_JsonWriter_HashChunk bytes instead of growing with the output.
+ */
+typedef struct {
+  R_MutableString* buffer;
+  uint32_t options;
+  size_t depth;
+  R_KeyValuePair** order;
+  size_t order_size;
+  size_t order_capacity;
+  bool hashing;
+  uint64_t hash;
+} R_Dictionary_JsonWriter;
+
+#define R_Dictionary_JsonWriter_HashChunk 4096
+#define R_Dictionary_Hash_Offset 14695981039346656037ULL
+#define R_Dictionary_Hash_Prime 1099511628211ULL
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeValue(R_Dictionary_JsonWriter* writer, void* value);
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writePair(R_Dictionary_JsonWriter* writer, R_KeyValuePair* element);
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeDictionary(R_Dictionary_JsonWriter* writer, R_Dictionary* dictionary);
 R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_toJson(R_Dictionary* self, R_MutableString* buffer) {
+  return R_Dictionary_toJsonWithOptions(self, buffer, R_Dictionary_JsonOutput_Compact);
+}
+
+R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_toJsonWithOptions(R_Dictionary* self, R_MutableString* buffer, uint32_t options) {
   if (R_Type_IsNotOf(self, R_Dictionary) || buffer == NULL || R_MutableString_reset(buffer) == NULL) return NULL;
-  R_MutableString_appendCString(buffer, "{");
+  R_Dictionary_JsonWriter writer = {buffer, options, 0, NULL, 0, 0, false, 0};
+  R_Dictionary_toJson_writeDictionary(&writer, self);
+  os_free_sized(writer.order, writer.order_capacity*sizeof(R_KeyValuePair*));
+  return buffer;
+}
 
-  R_List* elements = R_Dictionary_listOfPairs(self);
-  for (int i=0; i<R_List_size(elements); i++) {
-    R_KeyValuePair* element = R_List_pointerAtIndex(elements, i);
-    R_MutableString_appendStringAsJson(buffer, R_KeyValuePair_key(element));
-    R_MutableString_appendCString(buffer, ":");
-    R_Dictionary_toJson_writeValue(buffer, R_KeyValuePair_value(element));
-    if (i < R_List_size(elements) - 1) {
-      R_MutableString_appendCString(buffer, ",");
-    }
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_foldHash(R_Dictionary_JsonWriter* writer) {
+  const uint8_t* bytes = R_MutableData_bytes(R_MutableString_bytes(writer->buffer));
+  size_t length = R_MutableString_length(writer->buffer);
+  uint64_t hash = writer->hash;
+  for (size_t i=0; i<length; i++) hash = (hash ^ bytes[i]) * R_Dictionary_Hash_Prime;
+  writer->hash = hash;
+  R_MutableString_shiftCharacters(writer->buffer, length);
+}
+
+uint64_t R_FUNCTION_ATTRIBUTES R_Dictionary_hash(R_Dictionary* self) {
+  if (R_Type_IsNotOf(self, R_Dictionary)) return 0;
+  R_Dictionary_JsonWriter writer = {R_Type_New(R_MutableString), R_Dictionary_JsonOutput_Canonical, 0, NULL, 0, 0, true, R_Dictionary_Hash_Offset};
+  if (writer.buffer == NULL) return 0;
+  R_Dictionary_toJson_writeDictionary(&writer, self);
+  R_Dictionary_toJson_foldHash(&writer);
+  os_free_sized(writer.order, writer.order_capacity*sizeof(R_KeyValuePair*));
+  R_Type_Delete(writer.buffer);
+  return writer.hash;
+}
+
+//Starts the index'th member of a container: the comma, then with Pretty a newline and the indentation
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeSeparator(R_Dictionary_JsonWriter* writer, size_t index) {
+  if (writer->hashing && R_MutableString_length(writer->buffer) >= R_Dictionary_JsonWriter_HashChunk) R_Dictionary_toJson_foldHash(writer);
+  if (index > 0) R_MutableString_push(writer->buffer, ',');
+  if (!(writer->options & R_Dictionary_JsonOutput_Pretty)) return;
+  R_MutableString_push(writer->buffer, '\n');
+  for (size_t i=0; i<writer->depth; i++) R_MutableString_appendCString(writer->buffer, "  ");
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_openContainer(R_Dictionary_JsonWriter* writer, char opening) {
+  R_MutableString_push(writer->buffer, opening);
+  writer->depth++;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_closeContainer(R_Dictionary_JsonWriter* writer, char closing, size_t count) {
+  writer->depth--;
+  if (count > 0 && (writer->options & R_Dictionary_JsonOutput_Pretty)) {
+    R_MutableString_push(writer->buffer, '\n');
+    for (size_t i=0; i<writer->depth; i++) R_MutableString_appendCString(writer->buffer, "  ");
+  }
+  R_MutableString_push(writer->buffer, closing);
+}
+
+/*  R_Dictionary_toJson_writeCanonicalNumber
+    Writes the shortest text that reads back as the same value, at float or double precision. Whole numbers are written
+   without a fraction, so 2, 2.0 and 2e0 all come out as "2", -0 is "0", and exponents drop the '+' and leading zeros.
+   NaN and infinity have no json form and are written as null.
+ */
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeCanonicalNumber(R_MutableString* buffer, double value, bool single) {
+  char characters[32];
+  if (value != value || value - value != 0) {
+    R_MutableString_appendCString(buffer, "null");
+    return;
   }
+  double magnitude = value < 0 ? -value : value;
+  if (value == 0) {
+    R_MutableString_push(buffer, '0');
+    return;
+  }
+  if (magnitude < 1e15 && (double)(long long)value == value) {
+    os_sprintf(characters, "%.0f", value);
+    R_MutableString_appendCString(buffer, characters);
+    return;
+  }
+  for (int precision=1; precision<=(single ? 9 : 17); precision++) {
+    os_sprintf(characters, "%.*g", precision, value);
+    double parsed = os_atof(characters);
+    if (single ? (float)parsed == (float)value : parsed == value) break;
+  }
+  char* exponent = strchr(characters, 'e');
+  if (exponent == NULL) {
+    R_MutableString_appendCString(buffer, characters);
+    return;
+  }
+  R_MutableString_appendBytes(buffer, characters, exponent - characters + 1);
+  exponent++;
+  if (*exponent == '-') R_MutableString_push(buffer, *exponent++);
+  else if (*exponent == '+') exponent++;
+  while (*exponent == '0' && exponent[1] != '\0') exponent++;
+  R_MutableString_appendCString(buffer, exponent);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeFloat(R_Dictionary_JsonWriter* writer, float value) {
+  if (writer->options & R_Dictionary_JsonOutput_CanonicalNumbers) R_Dictionary_toJson_writeCanonicalNumber(writer->buffer, value, true);
+  else R_MutableString_appendFloat(writer->buffer, value);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeDouble(R_Dictionary_JsonWriter* writer, double value) {
+  if (writer->options & R_Dictionary_JsonOutput_CanonicalNumbers) R_Dictionary_toJson_writeCanonicalNumber(writer->buffer, value, false);
+  else R_MutableString_appendDouble(writer->buffer, value);
+}
+
+//Orders keys by their UTF-8 bytes, which is the same as ordering by code point
+static int R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_compareKeys(const void* a, const void* b) {
+  return R_MutableString_order(R_KeyValuePair_key(*(R_KeyValuePair* const*)a), R_KeyValuePair_key(*(R_KeyValuePair* const*)b));
+}
+
+//Makes room for count more pairs on the order stack. Returns false if it couldn't grow.
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_reserveOrder(R_Dictionary_JsonWriter* writer, size_t count) {
+  if (writer->order_size + count <= writer->order_capacity) return true;
+  size_t capacity = writer->order_capacity ? writer->order_capacity : 16;
+  while (capacity < writer->order_size + count) capacity *= 2;
+  R_KeyValuePair** order = os_realloc_sized(writer->order, writer->order_capacity*sizeof(R_KeyValuePair*), capacity*sizeof(R_KeyValuePair*));
+  if (order == NULL) return false;
+  writer->order = order;
+  writer->order_capacity = capacity;
+  return true;
+}
+
+//Pushes the dictionary's pairs onto the order stack, sorted by key. Returns false if the stack couldn't grow.
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_pushSorted(R_Dictionary_JsonWriter* writer, R_List* elements) {
+  size_t count = R_List_size(elements);
+  if (!R_Dictionary_toJson_reserveOrder(writer, count)) return false;
+  os_memcpy(writer->order + writer->order_size, R_List_pointers(elements), count*sizeof(R_KeyValuePair*));
+  qsort(writer->order + writer->order_size, count, sizeof(R_KeyValuePair*), R_Dictionary_toJson_compareKeys);
+  writer->order_size += count;
+  return true;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeMember(R_Dictionary_JsonWriter* writer, R_KeyValuePair* element, size_t index) {
+  R_Dictionary_toJson_writeSeparator(writer, index);
+  R_MutableString_appendStringAsJson(writer->buffer, R_KeyValuePair_key(element));
+  R_MutableString_appendCString(writer->buffer, (writer->options & R_Dictionary_JsonOutput_Pretty) ? ": " : ":");
+  R_Dictionary_toJson_writePair(writer, element);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeDictionary(R_Dictionary_JsonWriter* writer, R_Dictionary* dictionary) {
+  R_List* elements = R_Dictionary_listOfPairs(dictionary);
+  size_t count = R_List_size(elements);
+  size_t base = writer->order_size;
+  bool sorted = (writer->options & R_Dictionary_JsonOutput_SortedKeys) && count > 1 && R_Dictionary_toJson_pushSorted(writer, elements);
+  R_Dictionary_toJson_openContainer(writer, '{');
+  for (size_t i=0; i<count; i++) {
+    //Nested dictionaries can move the order stack, so look the pair up again each time
+    R_KeyValuePair* element = sorted ? writer->order[base + i] : R_List_pointerAtIndex(elements, i);
+    R_Dictionary_toJson_writeMember(writer, element, i);
+  }
+  R_Dictionary_toJson_closeContainer(writer, '}', count);
+  writer->order_size = base;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_pushPair(R_KeyValuePair* pair, void* context) {
+  R_Dictionary_JsonWriter* writer = context;
+  writer->order[writer->order_size++] = pair;
+  return true;
+}
+
+#ifdef R_TYPE_REFCOUNT
+//Persistent dictionaries have no list of pairs, so theirs always go through the order stack
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writePersistentDictionary(R_Dictionary_JsonWriter* writer, R_PersistentDictionary* dictionary) {
+  size_t base = writer->order_size;
+  size_t count = R_PersistentDictionary_size(dictionary);
+  if (!R_Dictionary_toJson_reserveOrder(writer, count)) count = 0;
+  else R_PersistentDictionary_each(dictionary, R_Dictionary_toJson_pushPair, writer);
+  if ((writer->options & R_Dictionary_JsonOutput_SortedKeys) && count > 1) qsort(writer->order + base, count, sizeof(R_KeyValuePair*), R_Dictionary_toJson_compareKeys);
+  R_Dictionary_toJson_openContainer(writer, '{');
+  for (size_t i=0; i<count; i++) R_Dictionary_toJson_writeMember(writer, writer->order[base + i], i);
+  R_Dictionary_toJson_closeContainer(writer, '}', count);
+  writer->order_size = base;
+}
+
+R_MutableString* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_toJson(R_PersistentDictionary* self, R_MutableString* buffer) {
+  return R_PersistentDictionary_toJsonWithOptions(self, buffer, R_Dictionary_JsonOutput_Compact);
+}
+
+R_MutableString* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_toJsonWithOptions(R_PersistentDictionary* self, R_MutableString* buffer, uint32_t options) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary) || buffer == NULL || R_MutableString_reset(buffer) == NULL) return NULL;
+  R_Dictionary_JsonWriter writer = {buffer, options, 0, NULL, 0, 0, false, 0};
+  R_Dictionary_toJson_writePersistentDictionary(&writer, self);
+  os_free_sized(writer.order, writer.order_capacity*sizeof(R_KeyValuePair*));
+  return buffer;
+}
+#endif
+
+//Ordered dictionaries visit their pairs already sorted, so R_Dictionary_JsonOutput_SortedKeys has nothing to do
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeOrderedDictionary(R_Dictionary_JsonWriter* writer, R_OrderedDictionary* dictionary) {
+  size_t base = writer->order_size;
+  size_t count = R_OrderedDictionary_size(dictionary);
+  if (!R_Dictionary_toJson_reserveOrder(writer, count)) count = 0;
+  else R_OrderedDictionary_each(dictionary, R_Dictionary_toJson_pushPair, writer);
+  R_Dictionary_toJson_openContainer(writer, '{');
+  for (size_t i=0; i<count; i++) R_Dictionary_toJson_writeMember(writer, writer->order[base + i], i);
+  R_Dictionary_toJson_closeContainer(writer, '}', count);
+  writer->order_size = base;
+}
+
+R_MutableString* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_toJson(R_OrderedDictionary* self, R_MutableString* buffer) {
+  return R_OrderedDictionary_toJsonWithOptions(self, buffer, R_Dictionary_JsonOutput_Compact);
+}
 
-  R_MutableString_appendCString(buffer, "}");
+R_MutableString* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_toJsonWithOptions(R_OrderedDictionary* self, R_MutableString* buffer, uint32_t options) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || buffer == NULL || R_MutableString_reset(buffer) == NULL) return NULL;
+  R_Dictionary_JsonWriter writer = {buffer, options, 0, NULL, 0, 0, false, 0};
+  R_Dictionary_toJson_writeOrderedDictionary(&writer, self);
+  os_free_sized(writer.order, writer.order_capacity*sizeof(R_KeyValuePair*));
   return buffer;
 }
 
-static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeValue(R_MutableString* buffer, void* value) {
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writePair(R_Dictionary_JsonWriter* writer, R_KeyValuePair* element) {
+  const R_Type* type = R_KeyValuePair_valueType(element);
+  if (type == R_Type_Object(R_Integer)) R_MutableString_appendInt(writer->buffer, R_KeyValuePair_getInteger(element));
+  else if (type == R_Type_Object(R_Float)) R_Dictionary_toJson_writeFloat(writer, R_KeyValuePair_getFloat(element));
+  else if (type == R_Type_Object(R_Boolean)) R_MutableString_appendCString(writer->buffer, R_KeyValuePair_getBoolean(element) ? "true" : "false");
+  else if (type == R_Type_Object(R_Null)) R_MutableString_appendCString(writer->buffer, "null");
+  else R_Dictionary_toJson_writeValue(writer, R_KeyValuePair_value(element));
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_toJson_writeValue(R_Dictionary_JsonWriter* writer, void* value) {
+  R_MutableString* buffer = writer->buffer;
   if (R_Type_IsOf(value, R_MutableString)) R_MutableString_appendStringAsJson(buffer, value);
   else if (R_Type_IsOf(value, R_Integer)) R_MutableString_appendInt(buffer, R_Integer_get(value));
-  else if (R_Type_IsOf(value, R_Float)) R_MutableString_appendFloat(buffer, R_Float_get(value));
+  else if (R_Type_IsOf(value, R_Float)) R_Dictionary_toJson_writeFloat(writer, R_Float_get(value));
   else if (R_Type_IsOf(value, R_Boolean)) {
     if (R_Boolean_get(value)) R_MutableString_appendCString(buffer, "true");
     else R_MutableString_appendCString(buffer, "false");
   }
-  else if (R_Type_IsOf(value, R_Dictionary)) {
-    R_MutableString* sub_buffer = R_Type_New(R_MutableString);
-    R_MutableString_appendString(buffer, R_Dictionary_toJson(value, sub_buffer));
-    R_Type_Delete(sub_buffer);
-  }
+  else if (R_Type_IsOf(value, R_Dictionary)) R_Dictionary_toJson_writeDictionary(writer, value);
   else if (R_Type_IsOf(value, R_List)) {
-    R_MutableString_appendCString(buffer, "[");
-    R_List_each(value, void, element) {
-      R_Dictionary_toJson_writeValue(buffer, element);
-      if (element != R_List_last(value)) R_MutableString_appendCString(buffer, ",");
+    R_Dictionary_toJson_openContainer(writer, '[');
+    for (size_t i=0; i<R_List_size(value); i++) {
+      R_Dictionary_toJson_writeSeparator(writer, i);
+      R_Dictionary_toJson_writeValue(writer, R_List_pointerAtIndex(value, i));
     }
-    R_MutableString_appendCString(buffer, "]");
+    R_Dictionary_toJson_closeContainer(writer, ']', R_List_size(value));
   }
+  else if (R_Type_IsOf(value, R_IntArray)) {
+    R_Dictionary_toJson_openContainer(writer, '[');
+    for (size_t i=0; i<R_IntArray_size(value); i++) {
+      R_Dictionary_toJson_writeSeparator(writer, i);
+      R_MutableString_appendInt(buffer, R_IntArray_get(value, i));
+    }
+    R_Dictionary_toJson_closeContainer(writer, ']', R_IntArray_size(value));
+  }
+  else if (R_Type_IsOf(value, R_FloatArray)) {
+    R_Dictionary_toJson_openContainer(writer, '[');
+    for (size_t i=0; i<R_FloatArray_size(value); i++) {
+      R_Dictionary_toJson_writeSeparator(writer, i);
+      R_Dictionary_toJson_writeFloat(writer, R_FloatArray_get(value, i));
+    }
+    R_Dictionary_toJson_closeContainer(writer, ']', R_FloatArray_size(value));
+  }
+  else if (R_Type_IsOf(value, R_DoubleArray)) {
+    R_Dictionary_toJson_openContainer(writer, '[');
+    for (size_t i=0; i<R_DoubleArray_size(value); i++) {
+      R_Dictionary_toJson_writeSeparator(writer, i);
+      R_Dictionary_toJson_writeDouble(writer, R_DoubleArray_get(value, i));
+    }
+    R_Dictionary_toJson_closeContainer(writer, ']', R_DoubleArray_size(value));
+  }
+  else if (R_Type_IsOf(value, R_OrderedDictionary)) R_Dictionary_toJson_writeOrderedDictionary(writer, value);
+#ifdef R_TYPE_REFCOUNT
+  else if (R_Type_IsOf(value, R_PersistentDictionary)) R_Dictionary_toJson_writePersistentDictionary(writer, value);
+  else if (R_Type_IsOf(value, R_PersistentList)) {
+    R_Dictionary_toJson_openContainer(writer, '[');
+    for (size_t i=0; i<R_PersistentList_size(value); i++) {
+      R_Dictionary_toJson_writeSeparator(writer, i);
+      R_Dictionary_toJson_writeValue(writer, R_PersistentList_get(value, i));
+    }
+    R_Dictionary_toJson_closeContainer(writer, ']', R_PersistentList_size(value));
+  }
+#endif
   else if (R_Type_IsOf(value, R_Null)) R_MutableString_appendCString(buffer, "null");
   else R_MutableString_appendCString(buffer, "\"Unknown Type\"");
 }
 
+/*  R_Dictionary_JsonSource
+    A shared, reference counted copy of the text being parsed lazily. Every unparsed child points into it, so the
+   text lives until the last of them is materialized or deleted.
+ */
+typedef struct {
+  char* text;
+  size_t size;
+  size_t references;
+} R_Dictionary_JsonSource;
+
+/*  R_Dictionary_JsonContext
+    What the readers need besides the text. start is the front of the string being read and base is its offset in
+   the source, so the offset of anything in it is base + (head - start). source is NULL unless parsing lazily.
+ */
+typedef struct {
+  uint32_t options;
+  R_Dictionary_JsonSource* source;
+  const char* start;
+  size_t base;
+  size_t threads; //used by R_Dictionary_JsonOption_Parallel
+} R_Dictionary_JsonContext;
+
+static R_Dictionary_JsonSource* R_FUNCTION_ATTRIBUTES R_Dictionary_JsonSource_new(const char* text, size_t size) {
+  R_Dictionary_JsonSource* source = os_malloc(sizeof(R_Dictionary_JsonSource));
+  if (source == NULL) return NULL;
+  source->text = os_malloc(size + 1);
+  if (source->text == NULL) return os_free_sized(source, sizeof(R_Dictionary_JsonSource)), NULL;
+  os_memcpy(source->text, text, size);
+  source->text[size] = '\0';
+  source->size = size;
+  source->references = 1;
+  return source;
+}
+
+//Slices of the same source can be copied and deleted on different threads, so the count changes like R_Type's does
+#ifdef R_OS_THREADS
+  #define R_Dictionary_JsonSource_retainReferences(source) ((void)__atomic_add_fetch(&(source)->references, 1, __ATOMIC_RELAXED))
+  #define R_Dictionary_JsonSource_releaseReferences(source) __atomic_sub_fetch(&(source)->references, 1, __ATOMIC_ACQ_REL)
+#else
+  #define R_Dictionary_JsonSource_retainReferences(source) ((void)++(source)->references)
+  #define R_Dictionary_JsonSource_releaseReferences(source) (--(source)->references)
+#endif
+
+static R_Dictionary_JsonSource* R_FUNCTION_ATTRIBUTES R_Dictionary_JsonSource_retain(R_Dictionary_JsonSource* source) {
+  if (source != NULL) R_Dictionary_JsonSource_retainReferences(source);
+  return source;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_JsonSource_release(R_Dictionary_JsonSource* source) {
+  if (source == NULL || R_Dictionary_JsonSource_releaseReferences(source) > 0) return;
+  os_free_sized(source->text, source->size + 1);
+  os_free_sized(source, sizeof(R_Dictionary_JsonSource));
+}
+
+/*  R_JsonSlice
+    The unparsed text of an object or array, stored in place of the value until it's first asked for. It implements
+   R_Materialize, so R_KeyValuePair_value parses it and keeps the result alongside it, and R_MaterializedType, which
+   tells what it holds from the text without parsing it.
+ */
+typedef struct {
+  R_Type* type;
+  R_Dictionary_JsonSource* source;
+  size_t offset;
+  size_t length;
+  uint32_t options;
+} R_JsonSlice;
+
+static void* R_FUNCTION_ATTRIBUTES R_JsonSlice_materialize(void* object);
+static const R_Type* R_FUNCTION_ATTRIBUTES R_JsonSlice_materializedType(void* object);
+static R_JsonSlice* R_FUNCTION_ATTRIBUTES R_JsonSlice_Destructor(R_JsonSlice* self) {
+  R_Dictionary_JsonSource_release(self->source);
+  return self;
+}
+static R_JsonSlice* R_FUNCTION_ATTRIBUTES R_JsonSlice_Copier(R_JsonSlice* self, R_JsonSlice* new) {
+  new->source = R_Dictionary_JsonSource_retain(self->source);
+  new->offset = self->offset;
+  new->length = self->length;
+  new->options = self->options;
+  return new;
+}
+static R_JumpTable_Entry R_JsonSlice_methods[] = {
+  R_JumpTable_Entry_Make(R_Materialize, R_JsonSlice_materialize),
+  R_JumpTable_Entry_Make(R_MaterializedType, R_JsonSlice_materializedType),
+  R_JumpTable_Entry_NULL
+};
+R_Type_Def(R_JsonSlice, NULL, R_JsonSlice_Destructor, R_JsonSlice_Copier, R_JsonSlice_methods);
+
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_moveQuotedString(R_MutableString* source, R_MutableString* dest);
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_scanNumber(R_MutableString* source, int* integer, float* floater);
 static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readNumber(R_MutableString* source);
-static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readValue(R_MutableString* string);
-static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readObject(R_Dictionary* object, R_MutableString* string);
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readValue(R_MutableString* string, R_Dictionary_JsonContext* context);
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readScalar(R_Dictionary* object, const char* key, R_MutableString* string);
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_startsWith(R_MutableString* string, const char* literal);
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_isNumber(R_MutableString* string);
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readSlice(R_MutableString* string, R_Dictionary_JsonContext* context);
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readParallelArray(R_MutableString* string, R_Dictionary_JsonContext* context);
+static size_t R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_containerLength(const char* text, size_t length);
+static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_read(R_Dictionary* self, R_MutableString* string, uint32_t options, size_t threads);
+static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readObject(R_Dictionary* object, R_MutableString* string, R_Dictionary_JsonContext* context);
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_advanceToNextNonWhitespace(R_MutableString* string);
-static R_List* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readArray(R_MutableString* string);
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readArray(R_MutableString* string, R_Dictionary_JsonContext* context);
 R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson(R_Dictionary* self, R_MutableString* buffer) {
+  return R_Dictionary_fromJsonWithOptions(self, buffer, R_Dictionary_JsonOption_None);
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJsonWithOptions(R_Dictionary* self, R_MutableString* buffer, uint32_t options) {
+  return R_Dictionary_fromJsonWithThreads(self, buffer, options, 0);
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJsonWithThreads(R_Dictionary* self, R_MutableString* buffer, uint32_t options, size_t threads) {
   if (self == NULL || buffer == NULL) return NULL;
   R_Dictionary_removeAll(self);
   R_MutableString* string = R_Type_Copy(buffer);
   if (string == NULL) return NULL;
   R_MutableString_trim(string);
+  R_Dictionary_fromJson_read(self, string, options, threads);
+  R_Type_Delete(string);
+  return self;
+}
 
-  R_Dictionary_fromJson_readObject(self, string);
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_readJson(R_Dictionary* self, R_MutableString* buffer, uint32_t options) {
+  if (R_Type_IsNotOf(self, R_Dictionary) || R_Type_IsNotOf(buffer, R_MutableString)) return NULL;
+  R_Dictionary_removeAll(self);
+  R_MutableString_trim(buffer);
+  return R_Dictionary_fromJson_read(self, buffer, options, 0);
+}
 
+/*  R_Dictionary_fromJson_read
+    Reads the object at the front of string, consuming it. With R_Dictionary_JsonOption_Lazy the source only holds
+   the object's own text, not whatever follows it.
+ */
+static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_read(R_Dictionary* self, R_MutableString* string, uint32_t options, size_t threads) {
+  const char* head = (const char*)R_MutableData_bytes(R_MutableString_bytes(string));
+  if (threads == 0) threads = (options & R_Dictionary_JsonOption_Parallel) ? R_OS_cpuCount() : 1;
+  R_Dictionary_JsonContext context = {options, NULL, head, 0, threads};
+  if (options & R_Dictionary_JsonOption_Lazy) {
+    size_t length = R_Dictionary_fromJson_containerLength(head, R_MutableString_length(string));
+    if (length == 0) return NULL;
+    context.source = R_Dictionary_JsonSource_new(head, length);
+    if (context.source == NULL) return NULL;
+  }
+  R_Dictionary* result = R_Dictionary_fromJson_readObject(self, string, &context);
+  R_Dictionary_JsonSource_release(context.source);
+  return result;
+}
+
+static void* R_FUNCTION_ATTRIBUTES R_JsonSlice_materialize(void* object) {
+  R_JsonSlice* self = object;
+  R_MutableString* string = R_Type_New(R_MutableString);
+  if (string == NULL) return NULL;
+  R_MutableString_appendBytes(string, self->source->text + self->offset, self->length);
+  const char* head = (const char*)R_MutableData_bytes(R_MutableString_bytes(string));
+  R_Dictionary_JsonContext context = {self->options, self->source, head, self->offset, 1};
+  void* value = R_Dictionary_fromJson_readValue(string, &context);
   R_Type_Delete(string);
-  return self;
+  return value;
+}
+
+/*  R_JsonSlice_materializedType
+    An object becomes an R_Dictionary and an array an R_List, unless typed arrays were asked for. Then the top level
+   of the array is scanned the way R_Dictionary_fromJson_readArray reads it: all numbers make an R_IntArray, or an
+   R_FloatArray if any of them has a fraction or exponent, and anything else makes an R_List.
+ */
+static const R_Type* R_FUNCTION_ATTRIBUTES R_JsonSlice_materializedType(void* object) {
+  R_JsonSlice* self = object;
+  const char* text = self->source->text + self->offset;
+  if (text[0] == '{') return R_Type_Object(R_Dictionary);
+  if (!(self->options & R_Dictionary_JsonOption_TypedArrays)) return R_Type_Object(R_List);
+  bool numbers = false;
+  bool floats = false;
+  for (size_t index=1; index<self->length; index++) {
+    char character = text[index];
+    if (character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == ',' || character == ']') continue;
+    if (character == '.' || character == 'e' || character == 'E') floats = true;
+    else if (!(character >= '0' && character <= '9') && character != '-' && character != '+') return R_Type_Object(R_List);
+    numbers = true;
+  }
+  if (!numbers) return R_Type_Object(R_List);
+  return floats ? R_Type_Object(R_FloatArray) : R_Type_Object(R_IntArray);
+}
+
+/*  R_Dictionary_fromJson_containerLength
+    Returns the length of the object or array at the front of text, by counting brackets outside of strings, or 0 if
+   it isn't closed.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_containerLength(const char* text, size_t length) {
+  size_t depth = 0;
+  bool quoted = false;
+  for (size_t index=0; index<length; index++) {
+    char character = text[index];
+    if (quoted) {
+      if (character == '\\') index++;
+      else if (character == '"') quoted = false;
+    }
+    else if (character == '"') quoted = true;
+    else if (character == '{' || character == '[') depth++;
+    else if ((character == '}' || character == ']') && --depth == 0) return index + 1;
+  }
+  return 0;
+}
+
+/*  R_Dictionary_fromJson_readSlice
+    Skips over the object or array at the front of string without parsing it and returns an R_JsonSlice pointing at
+   its text. Only brackets outside of strings are counted, so nothing is checked until it's materialized.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readSlice(R_MutableString* string, R_Dictionary_JsonContext* context) {
+  const char* head = (const char*)R_MutableData_bytes(R_MutableString_bytes(string));
+  size_t length = R_Dictionary_fromJson_containerLength(head, R_MutableString_length(string));
+  if (length == 0) return NULL;
+  R_JsonSlice* slice = R_Type_New(R_JsonSlice);
+  if (slice == NULL) return NULL;
+  slice->source = R_Dictionary_JsonSource_retain(context->source);
+  slice->offset = context->base + (size_t)(head - context->start);
+  slice->length = length;
+  slice->options = context->options;
+  R_MutableString_shiftCharacters(string, length);
+  return slice;
+}
+
+/*  R_Dictionary_fromJson_readHex
+    Reads the four hex digits after a \u escape. Returns false, consuming nothing, if they aren't there.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readHex(R_MutableString* source, uint32_t* value) {
+  if (R_MutableString_length(source) < 4) return false;
+  const char* digits = (const char*)R_MutableData_bytes(R_MutableString_bytes(source));
+  *value = 0;
+  for (int i=0; i<4; i++) {
+    char digit = digits[i];
+    if (digit >= '0' && digit <= '9') *value = *value << 4 | (uint32_t)(digit - '0');
+    else if (digit >= 'a' && digit <= 'f') *value = *value << 4 | (uint32_t)(digit - 'a' + 10);
+    else if (digit >= 'A' && digit <= 'F') *value = *value << 4 | (uint32_t)(digit - 'A' + 10);
+    else return false;
+  }
+  R_MutableString_shiftCharacters(source, 4);
+  return true;
+}
+
+/*  R_Dictionary_fromJson_appendEscapedCodePoint
+    Decodes a \u escape, joining a surrogate pair written as two escapes, and appends it to dest as UTF-8.
+ */
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_appendEscapedCodePoint(R_MutableString* source, R_MutableString* dest) {
+  uint32_t code = 0;
+  if (!R_Dictionary_fromJson_readHex(source, &code)) return;
+  if (code >= 0xD800 && code <= 0xDBFF && R_Dictionary_fromJson_startsWith(source, "\\u")) {
+    R_MutableString_shiftCharacters(source, 2);
+    uint32_t low = 0;
+    if (R_Dictionary_fromJson_readHex(source, &low) && low >= 0xDC00 && low <= 0xDFFF) code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+  }
+  if (code < 0x80) R_MutableString_push(dest, (char)code);
+  else if (code < 0x800) {
+    R_MutableString_push(dest, (char)(0xC0 | code >> 6));
+    R_MutableString_push(dest, (char)(0x80 | (code & 0x3F)));
+  }
+  else if (code < 0x10000) {
+    R_MutableString_push(dest, (char)(0xE0 | code >> 12));
+    R_MutableString_push(dest, (char)(0x80 | ((code >> 6) & 0x3F)));
+    R_MutableString_push(dest, (char)(0x80 | (code & 0x3F)));
+  }
+  else {
+    R_MutableString_push(dest, (char)(0xF0 | code >> 18));
+    R_MutableString_push(dest, (char)(0x80 | ((code >> 12) & 0x3F)));
+    R_MutableString_push(dest, (char)(0x80 | ((code >> 6) & 0x3F)));
+    R_MutableString_push(dest, (char)(0x80 | (code & 0x3F)));
+  }
 }
 
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_moveQuotedString(R_MutableString* source, R_MutableString* dest) {
@@ -77,13 +582,15 @@ static R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_moveQuotedSt
     char character = R_MutableString_shift(source);
     if (character == '\\' && R_MutableString_length(source) > 0) {
       char escaped = R_MutableString_shift(source);
-      if (escaped == '\\') R_MutableString_appendCString(dest, "\\");
+      if (escaped == '"') R_MutableString_push(dest, '"');
+      else if (escaped == '\\') R_MutableString_appendCString(dest, "\\");
       else if (escaped == '/') R_MutableString_appendCString(dest, "/");
       else if (escaped == 'b') R_MutableString_appendCString(dest, "\b");
       else if (escaped == 'f') R_MutableString_appendCString(dest, "\f");
       else if (escaped == 'n') R_MutableString_appendCString(dest, "\n");
       else if (escaped == 'r') R_MutableString_appendCString(dest, "\r");
       else if (escaped == 't') R_MutableString_appendCString(dest, "\t");
+      else if (escaped == 'u') R_Dictionary_fromJson_appendEscapedCodePoint(source, dest);
     }
     else if (character == '"') {
       R_MutableString_trim(source);
@@ -94,7 +601,7 @@ static R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_moveQuotedSt
   return NULL;
 }
 
-static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readObject(R_Dictionary* object, R_MutableString* string) {
+static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readObject(R_Dictionary* object, R_MutableString* string, R_Dictionary_JsonContext* context) {
   if (R_MutableString_first(string) != '{') return NULL;
   R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
   while (R_MutableString_length(string) > 0) {
@@ -105,10 +612,15 @@ static R_Dictionary* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readObject(R_Di
     //ignore the separator
     if (R_MutableString_first(string) != ':') return R_Type_Delete(key), NULL;
     R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
-    //read value
-    void* value = R_Dictionary_fromJson_readValue(string);
-    //add kay/value to dictionary
-    if (value == NULL || R_Dictionary_transferOwnership(object, R_MutableString_cstring(key), value) == NULL) return R_Type_Delete(key), NULL;
+    //read value, storing numbers, booleans and nulls inline
+    if (!R_Dictionary_fromJson_readScalar(object, R_MutableString_cstring(key), string)) {
+      void* value = NULL;
+      if (context->source != NULL && (R_MutableString_first(string) == '{' || R_MutableString_first(string) == '[')) value = R_Dictionary_fromJson_readSlice(string, context);
+      else if ((context->options & R_Dictionary_JsonOption_Parallel) && R_MutableString_first(string) == '[') value = R_Dictionary_fromJson_readParallelArray(string, context);
+      else value = R_Dictionary_fromJson_readValue(string, context);
+      //add kay/value to dictionary
+      if (value == NULL || R_Dictionary_transferOwnership(object, R_MutableString_cstring(key), value) == NULL) return R_Type_Delete(key), NULL;
+    }
     //cleanup
     R_Type_Delete(key);
     //decide whether there are more objects to read
@@ -132,7 +644,7 @@ static R_MutableString* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_advanceToNex
   return string;
 }
 
-static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readValue(R_MutableString* string) {
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readValue(R_MutableString* string, R_Dictionary_JsonContext* context) {
   if (R_MutableString_first(string) == '"') {//value is a string
     R_MutableString* value = R_Type_New(R_MutableString);
     if (R_Dictionary_fromJson_moveQuotedString(string, value) == NULL) return R_Type_Delete(value), NULL;
@@ -141,64 +653,189 @@ static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readValue(R_MutableStri
   else if ((R_MutableString_first(string) >= '0' && R_MutableString_first(string) <= '9') || R_MutableString_first(string) == '-') {//value is a number
     return R_Dictionary_fromJson_readNumber(string);
   }
-  else if (R_MutableString_first(string) == 't' || R_MutableString_first(string) == 'f') {//value is a boolean (true)
-    const char* characters = R_MutableString_cstring(string);
-    if ((char*)os_strstr(characters, "true") == characters) {
-      R_MutableString_getSubstring(string, string, 4, 0);
-      return R_Boolean_set(R_Type_New(R_Boolean), true);
-    }
-    else if ((char*)os_strstr(characters, "false") == characters) {
-      R_MutableString_getSubstring(string, string, 5, 0);
-      return R_Boolean_set(R_Type_New(R_Boolean), false);
-    }
+  else if (R_Dictionary_fromJson_startsWith(string, "true")) {
+    R_MutableString_shiftCharacters(string, 4);
+    return R_Boolean_set(R_Type_New(R_Boolean), true);
   }
-  else if (R_MutableString_first(string) == 'n') {//value is a null
-    const char* characters = R_MutableString_cstring(string);
-    if ((char*)os_strstr(characters, "null") == characters) {
-      R_MutableString_getSubstring(string, string, 4, 0);
-      return R_Type_New(R_Null);
-    }
+  else if (R_Dictionary_fromJson_startsWith(string, "false")) {
+    R_MutableString_shiftCharacters(string, 5);
+    return R_Boolean_set(R_Type_New(R_Boolean), false);
+  }
+  else if (R_Dictionary_fromJson_startsWith(string, "null")) {
+    R_MutableString_shiftCharacters(string, 4);
+    return R_Type_New(R_Null);
   }
   else if (R_MutableString_first(string) == '{') {
     R_Dictionary* child = R_Type_New(R_Dictionary);
-    if (R_Dictionary_fromJson_readObject(child, string) == NULL) {
+    if (R_Dictionary_fromJson_readObject(child, string, context) == NULL) {
       R_Type_Delete(child);
     }
     else return child;
   }
   else if (R_MutableString_first(string) == '[') {
-    return R_Dictionary_fromJson_readArray(string);
+    return R_Dictionary_fromJson_readArray(string, context);
   }
   return NULL;
 }
 
-static R_List* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readArray(R_MutableString* string) {
-  if (R_MutableString_first(string) != '[') return NULL;
+/*  R_Dictionary_fromJson_readScalar
+    Reads a number, boolean or null straight into the dictionary without boxing it. Returns false, without consuming
+   anything, if the next value is something else.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_startsWith(R_MutableString* string, const char* literal) {
+  size_t length = os_strlen(literal);
+  return R_MutableString_length(string) >= length && os_memcmp(R_MutableData_bytes(R_MutableString_bytes(string)), literal, length) == 0;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readScalar(R_Dictionary* object, const char* key, R_MutableString* string) {
+  if (R_Dictionary_fromJson_isNumber(string)) {
+    int integer = 0;
+    float floater = 0;
+    if (R_Dictionary_fromJson_scanNumber(string, &integer, &floater)) return R_Dictionary_setFloat(object, key, floater) != NULL;
+    return R_Dictionary_setInteger(object, key, integer) != NULL;
+  }
+  else if (R_Dictionary_fromJson_startsWith(string, "true")) {
+    R_MutableString_shiftCharacters(string, 4);
+    return R_Dictionary_setBoolean(object, key, true) != NULL;
+  }
+  else if (R_Dictionary_fromJson_startsWith(string, "false")) {
+    R_MutableString_shiftCharacters(string, 5);
+    return R_Dictionary_setBoolean(object, key, false) != NULL;
+  }
+  else if (R_Dictionary_fromJson_startsWith(string, "null")) {
+    R_MutableString_shiftCharacters(string, 4);
+    return R_Dictionary_setNull(object, key) != NULL;
+  }
+  return false;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_isNumber(R_MutableString* string) {
+  return (R_MutableString_first(string) >= '0' && R_MutableString_first(string) <= '9') || R_MutableString_first(string) == '-';
+}
+
+/*  R_Dictionary_fromJson_TypedNumbers
+    The numbers at the front of an array being read with R_Dictionary_JsonOption_TypedArrays. Integers and floats are
+   kept apart, each exactly as read, so boxing them later gives every element its own type back. kinds is only made
+   once both have shown up, and holds one byte per number, true for a float, to put them back in order.
+ */
+typedef struct {
+  R_IntArray* integers;
+  R_FloatArray* floats;
+  R_MutableData* kinds;
+} R_Dictionary_fromJson_TypedNumbers;
+
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_appendNumber(R_Dictionary_fromJson_TypedNumbers* numbers, bool isFloat, int integer, float floater) {
+  if (numbers->kinds == NULL && (isFloat ? numbers->integers != NULL : numbers->floats != NULL)) {
+    numbers->kinds = R_Type_New(R_MutableData);
+    if (numbers->kinds == NULL) return false;
+    for (size_t i=0; i<R_IntArray_size(numbers->integers); i++) R_MutableData_appendByte(numbers->kinds, false);
+    for (size_t i=0; i<R_FloatArray_size(numbers->floats); i++) R_MutableData_appendByte(numbers->kinds, true);
+  }
+  if (numbers->kinds != NULL && R_MutableData_appendByte(numbers->kinds, isFloat) == NULL) return false;
+  if (isFloat) {
+    if (numbers->floats == NULL) numbers->floats = R_Type_New(R_FloatArray);
+    return R_FloatArray_append(numbers->floats, floater) != NULL;
+  }
+  if (numbers->integers == NULL) numbers->integers = R_Type_New(R_IntArray);
+  return R_IntArray_append(numbers->integers, integer) != NULL;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_deleteNumbers(R_Dictionary_fromJson_TypedNumbers* numbers) {
+  R_Type_DeleteAndNull(numbers->integers);
+  R_Type_DeleteAndNull(numbers->floats);
+  R_Type_DeleteAndNull(numbers->kinds);
+}
+
+/*  R_Dictionary_fromJson_boxNumbers
+    Moves the values read so far into a new R_List once an array turns out not to be all numbers.
+ */
+static R_List* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_boxNumbers(R_Dictionary_fromJson_TypedNumbers* numbers) {
   R_List* array = R_Type_New(R_List);
+  size_t count = R_IntArray_size(numbers->integers) + R_FloatArray_size(numbers->floats);
+  if (array == NULL || R_List_reserve(array, count) == NULL) return R_Type_Delete(array), NULL;
+  size_t integer = 0, floater = 0;
+  for (size_t i=0; i<count; i++) {
+    bool isFloat = numbers->kinds ? R_MutableData_byte(numbers->kinds, i) : numbers->floats != NULL;
+    if (isFloat) R_Float_set(R_List_add(array, R_Float), R_FloatArray_get(numbers->floats, floater++));
+    else R_Integer_set(R_List_add(array, R_Integer), R_IntArray_get(numbers->integers, integer++));
+  }
+  return array;
+}
+
+/*  R_Dictionary_fromJson_typedArray
+    Returns the typed array for an array that turned out to be all numbers: an R_IntArray if they're all integers,
+   otherwise an R_FloatArray with the integers converted in place.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_typedArray(R_Dictionary_fromJson_TypedNumbers* numbers) {
+  void* array = NULL;
+  if (numbers->kinds == NULL) {
+    array = numbers->integers ? (void*)numbers->integers : (void*)numbers->floats;
+    numbers->integers = NULL;
+    numbers->floats = NULL;
+    return array;
+  }
+  R_FloatArray* floats = R_FloatArray_reserve(R_Type_New(R_FloatArray), R_MutableData_size(numbers->kinds));
+  size_t integer = 0, floater = 0;
+  for (size_t i=0; floats != NULL && i<R_MutableData_size(numbers->kinds); i++) {
+    if (R_MutableData_byte(numbers->kinds, i)) R_FloatArray_append(floats, R_FloatArray_get(numbers->floats, floater++));
+    else R_FloatArray_append(floats, R_IntArray_get(numbers->integers, integer++));
+  }
+  return floats;
+}
+
+/*  R_Dictionary_fromJson_readArray
+    Returns an R_List, or with R_Dictionary_JsonOption_TypedArrays set, an R_IntArray or R_FloatArray if every
+   element is a number. Numbers are read straight into typed arrays and only boxed if a non-number shows up, in which
+   case each keeps the type it was written as.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readArray(R_MutableString* string, R_Dictionary_JsonContext* context) {
+  if (R_MutableString_first(string) != '[') return NULL;
+  bool typed = (context->options & R_Dictionary_JsonOption_TypedArrays) != 0;
+  R_List* array = typed ? NULL : R_Type_New(R_List);
+  R_Dictionary_fromJson_TypedNumbers numbers = {NULL, NULL, NULL};
   R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
   while (R_MutableString_length(string) > 0) {
-    if (R_MutableString_first(string) == ']') {
-      R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
-      return array;
+    if (R_MutableString_first(string) == ']') break;
+    if (typed && R_Dictionary_fromJson_isNumber(string)) {
+      int integer = 0;
+      float floater = 0;
+      bool isFloat = R_Dictionary_fromJson_scanNumber(string, &integer, &floater);
+      if (!R_Dictionary_fromJson_appendNumber(&numbers, isFloat, integer, floater)) return R_Dictionary_fromJson_deleteNumbers(&numbers), NULL;
+    }
+    else {
+      if (typed) {
+        array = R_Dictionary_fromJson_boxNumbers(&numbers);
+        R_Dictionary_fromJson_deleteNumbers(&numbers);
+        if (array == NULL) return NULL;
+        typed = false;
+      }
+      void* value = R_Dictionary_fromJson_readValue(string, context);
+      if (value == NULL || R_List_transferOwnership(array, value) == NULL) return R_Type_Delete(array), NULL;
     }
-    void* value = R_Dictionary_fromJson_readValue(string);
-    if (value == NULL || R_List_transferOwnership(array, value) == NULL) return R_Type_Delete(array), NULL;
     R_MutableString_trim(string);
     if (R_MutableString_first(string) == ',') {
       R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
       continue;
     }
-    else if (R_MutableString_first(string) == ']') {
-      R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
-      return array;
-    }
-    else return R_Type_Delete(array), NULL;
+    else if (R_MutableString_first(string) == ']') break;
+    else return R_Type_Delete(array), R_Dictionary_fromJson_deleteNumbers(&numbers), NULL;
+  }
+  if (R_MutableString_first(string) != ']') return R_Type_Delete(array), R_Dictionary_fromJson_deleteNumbers(&numbers), NULL;
+  R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
+  if (typed && (numbers.integers != NULL || numbers.floats != NULL)) {
+    void* numeric = R_Dictionary_fromJson_typedArray(&numbers);
+    R_Dictionary_fromJson_deleteNumbers(&numbers);
+    return numeric;
   }
-  return R_Type_Delete(array), NULL;
+  if (array == NULL) array = R_Type_New(R_List);
+  return array;
 }
 
-static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readNumber(R_MutableString* source) {
-  if (source == NULL) return NULL;
+/*  R_Dictionary_fromJson_scanNumber
+    Reads a number from the front of source. Returns true and sets floater if it had a fraction or exponent,
+   otherwise returns false and sets integer.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_scanNumber(R_MutableString* source, int* integer, float* floater) {
   R_MutableString* value = R_Type_New(R_MutableString);
   bool isFloat = false;
   bool isExponent = false;
@@ -229,19 +866,142 @@ static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readNumber(R_MutableStr
     else break;
   }
 
-  if (isFloat) {
-    float floater = R_MutableString_getFloat(value);
-    R_Type_Delete(value);
-    R_Float* number = R_Type_New(R_Float);
-    R_Float_set(number, floater);
-    return number;
-  }
-  else { //is integer
-    int integer = R_MutableString_getInt(value);
-    R_Type_Delete(value);
-    R_Integer* number = R_Type_New(R_Integer);
-    R_Integer_set(number, integer);
-    return number;
-  }
-  return R_Type_Delete(value), NULL;
+  if (isFloat) *floater = R_MutableString_getFloat(value);
+  else *integer = R_MutableString_getInt(value);
+  R_Type_Delete(value);
+  return isFloat;
+}
+
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readNumber(R_MutableString* source) {
+  if (source == NULL) return NULL;
+  int integer = 0;
+  float floater = 0;
+  if (R_Dictionary_fromJson_scanNumber(source, &integer, &floater)) return R_Float_set(R_Type_New(R_Float), floater);
+  return R_Integer_set(R_Type_New(R_Integer), integer);
+}
+
+/*  R_Dictionary_fromJson_ParallelMinimum
+    Arrays with less text than this are read on the calling thread, where starting threads would cost more than it
+   saves.
+ */
+#define R_Dictionary_fromJson_ParallelMinimum (64*1024)
+
+/*  R_Dictionary_fromJson_Run
+    A run of consecutive array elements read by one thread. The text starts at an element and ends at the start of
+   the next run, or at the closing bracket for the last one.
+ */
+typedef struct {
+  const char* text;
+  size_t length;
+  uint32_t options;
+  void** values;
+  size_t count;
+  size_t capacity;
+  bool failed;
+} R_Dictionary_fromJson_Run;
+
+static void R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readRun(void* argument) {
+  R_Dictionary_fromJson_Run* run = argument;
+  R_MutableString* string = R_MutableString_appendBytes(R_Type_New(R_MutableString), run->text, run->length);
+  if (string == NULL) {
+    run->failed = true;
+    return;
+  }
+  R_Dictionary_JsonContext context = {run->options, NULL, (const char*)R_MutableData_bytes(R_MutableString_bytes(string)), 0, 1};
+  while (R_MutableString_length(string) > 0) {
+    if (run->count == run->capacity) {
+      size_t capacity = run->capacity ? run->capacity * 2 : 64;
+      void** values = os_realloc_sized(run->values, run->capacity * sizeof(void*), capacity * sizeof(void*));
+      if (values == NULL) break;
+      run->values = values;
+      run->capacity = capacity;
+    }
+    void* value = R_Dictionary_fromJson_readValue(string, &context);
+    if (value == NULL) break;
+    run->values[run->count++] = value;
+    R_MutableString_trim(string);
+    if (R_MutableString_first(string) == ',') R_Dictionary_fromJson_advanceToNextNonWhitespace(string);
+    else if (R_MutableString_length(string) > 0) break;
+  }
+  run->failed = R_MutableString_length(string) > 0;
+  R_Type_Delete(string);
+}
+
+/*  R_Dictionary_fromJson_indexRuns
+    The structural pass. Finds the closing bracket of the array at the front of text, and splits the elements into at
+   most count runs of about the same amount of text. Fills starts with the offset of each run's first element and
+   returns the number of runs, or 0 if the array isn't closed.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_indexRuns(const char* text, size_t length, size_t* starts, size_t count, size_t* close) {
+  size_t runs = 0;
+  size_t depth = 0;
+  bool quoted = false;
+  bool element = true; //the next non-whitespace character at depth 1 starts an element
+  for (size_t index=0; index<length; index++) {
+    char character = text[index];
+    if (quoted) {
+      if (character == '\\') index++;
+      else if (character == '"') quoted = false;
+      continue;
+    }
+    if (depth == 1 && element && character != ' ' && character != '\t' && character != '\n' && character != '\r' && character != ']') {
+      element = false;
+      if (runs < count && index >= (length / count) * runs) starts[runs++] = index;
+    }
+    if (character == '"') quoted = true;
+    else if (character == '{' || character == '[') depth++;
+    else if (character == '}' || character == ']') {
+      if (--depth == 0) return *close = index, runs;
+    }
+    else if (character == ',' && depth == 1) element = true;
+  }
+  return 0;
+}
+
+/*  R_Dictionary_fromJson_readParallelArray
+    Reads a large array of objects or arrays on every CPU. Anything else goes to R_Dictionary_fromJson_readArray.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_Dictionary_fromJson_readParallelArray(R_MutableString* string, R_Dictionary_JsonContext* context) {
+  const char* head = (const char*)R_MutableData_bytes(R_MutableString_bytes(string));
+  size_t length = R_MutableString_length(string);
+  size_t threads = context->threads;
+  size_t first = 1;
+  while (first < length && (head[first] == ' ' || head[first] == '\t' || head[first] == '\n' || head[first] == '\r')) first++;
+  if (threads < 2 || length < R_Dictionary_fromJson_ParallelMinimum || first >= length || (head[first] != '{' && head[first] != '[')) {
+    return R_Dictionary_fromJson_readArray(string, context);
+  }
+
+  size_t* starts = os_malloc(threads * sizeof(size_t));
+  R_Dictionary_fromJson_Run* runs = os_zalloc(threads * sizeof(R_Dictionary_fromJson_Run));
+  void** arguments = os_malloc(threads * sizeof(void*));
+  size_t close = 0;
+  size_t count = (starts && runs && arguments) ? R_Dictionary_fromJson_indexRuns(head, length, starts, threads, &close) : 0;
+  R_List* array = NULL;
+  if (count > 0) {
+    for (size_t i=0; i<count; i++) {
+      runs[i].text = head + starts[i];
+      runs[i].length = (i + 1 < count ? starts[i + 1] : close) - starts[i];
+      runs[i].options = context->options & ~R_Dictionary_JsonOption_Parallel;
+      arguments[i] = &runs[i];
+    }
+    R_OS_parallelRun(R_Dictionary_fromJson_readRun, arguments, count);
+
+    size_t total = 0;
+    bool failed = false;
+    for (size_t i=0; i<count; i++) total += runs[i].count, failed |= runs[i].failed;
+    if (!failed) array = R_Type_New(R_List);
+    if (R_List_reserve(array, total) == NULL) failed = true;
+    for (size_t i=0; i<count; i++) {
+      for (size_t j=0; j<runs[i].count; j++) {
+        if (failed || R_List_transferOwnership(array, runs[i].values[j]) == NULL) R_Type_Delete(runs[i].values[j]), failed = true;
+      }
+      os_free_sized(runs[i].values, runs[i].capacity * sizeof(void*));
+    }
+    if (failed) R_Type_DeleteAndNull(array);
+    else R_MutableString_shiftCharacters(string, close + 1);
+  }
+  os_free_sized(starts, threads * sizeof(size_t));
+  os_free_sized(runs, threads * sizeof(R_Dictionary_fromJson_Run));
+  os_free_sized(arguments, threads * sizeof(void*));
+  return array;
 }
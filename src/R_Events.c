@@ -10,6 +10,7 @@
 struct R_Events {
 	R_Type* type;
 	R_Dictionary* events;
+	R_Dictionary* pending; //R_Events_PendingPayloads for every coalescing key
 };
 static R_Events* R_FUNCTION_ATTRIBUTES R_Events_Constructor(R_Events* self);
 static R_Events* R_FUNCTION_ATTRIBUTES R_Events_Destructor(R_Events* self);
@@ -19,18 +20,39 @@ typedef struct {
 	R_Type* type;
 	void* target;
 	R_Events_Callback callback;
+	R_Events_BatchCallback batch_callback;
 	bool run_once;
 } R_Events_NotificationDefinition;
 R_Type_Def(R_Events_NotificationDefinition, NULL, NULL, NULL, NULL);
 
+typedef struct {
+	R_Type* type;
+	void** payloads;
+	size_t count;
+	size_t allocated;
+	R_Events_Merger merger;
+} R_Events_PendingPayloads;
+static R_Events_PendingPayloads* R_FUNCTION_ATTRIBUTES R_Events_PendingPayloads_Destructor(R_Events_PendingPayloads* self);
+R_Type_Def(R_Events_PendingPayloads, NULL, R_Events_PendingPayloads_Destructor, NULL, NULL);
+
+static R_Events_PendingPayloads* R_FUNCTION_ATTRIBUTES R_Events_PendingPayloads_Destructor(R_Events_PendingPayloads* self) {
+	os_free_sized(self->payloads, self->allocated*sizeof(void*));
+	self->payloads = NULL;
+	self->count = self->allocated = 0;
+	return self;
+}
+
 static R_Events* R_FUNCTION_ATTRIBUTES R_Events_Constructor(R_Events* self) {
 	self->events = R_Type_New(R_Dictionary);
 	if (self->events == NULL) return NULL;
+	self->pending = R_Type_New(R_Dictionary);
+	if (self->pending == NULL) return NULL;
 	return self;
 }
 
 static R_Events* R_FUNCTION_ATTRIBUTES R_Events_Destructor(R_Events* self) {
 	R_Type_Delete(self->events);
+	R_Type_Delete(self->pending);
 	return self;
 }
 
@@ -55,6 +77,16 @@ R_Events* R_FUNCTION_ATTRIBUTES R_Events_registerOnce(R_Events* self, const char
 	return self;
 }
 
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_registerBatch(R_Events* self, const char* event_key, void* target, R_Events_BatchCallback callback) {
+	if (self == NULL || event_key == NULL || callback == NULL) return NULL; //target can be NULL!
+	R_Events_NotificationDefinition* def = R_Events_newDefinition(self, event_key);
+	if (def == NULL) return NULL;
+	def->batch_callback = callback;
+	def->target = target;
+	def->run_once = false;
+	return self;
+}
+
 static R_FUNCTION_ATTRIBUTES R_Events_NotificationDefinition* R_Events_newDefinition(R_Events* self, const char* event_key) {
 	if (self == NULL || event_key == NULL) return NULL;
 
@@ -69,52 +101,156 @@ static R_FUNCTION_ATTRIBUTES R_Events_NotificationDefinition* R_Events_newDefini
 	return def;
 }
 
+typedef struct {
+	const void* target;
+	R_Events_Callback callback;
+	R_Events_BatchCallback batch_callback;
+} R_Events_Match;
+
+static bool R_FUNCTION_ATTRIBUTES R_Events_matchesCallback(void* notification, void* match) {
+	R_Events_NotificationDefinition* definition = notification;
+	R_Events_Match* criteria = match;
+	if (definition->target != criteria->target) return false;
+	if (criteria->callback) return definition->callback == criteria->callback;
+	return definition->batch_callback == criteria->batch_callback;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Events_matchesTarget(void* notification, void* match) {
+	return ((R_Events_NotificationDefinition*)notification)->target == ((R_Events_Match*)match)->target;
+}
+
 R_Events* R_FUNCTION_ATTRIBUTES R_Events_remove(R_Events* self, const char* event_key, const void* target, R_Events_Callback callback) {
 	if (R_Type_IsNotOf(self, R_Events) || event_key == NULL || callback == NULL) return NULL; //target can be NULL!
 	R_List* events_for_key = R_Dictionary_get(self->events, event_key);
 	if (events_for_key == NULL) return NULL;
 
-	for (int i=R_List_size(events_for_key)-1; i>=0; i--) {
-		R_Events_NotificationDefinition* notification = R_List_pointerAtIndex(events_for_key, i);
-		if (notification == NULL) return NULL;
-		if (notification->target == target && notification->callback == callback) R_List_removePointer(events_for_key, notification);
-	}
+	R_Events_Match match = {target, callback, NULL};
+	R_List_removeIf(events_for_key, R_Events_matchesCallback, &match);
+	return self;
+}
 
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_removeBatch(R_Events* self, const char* event_key, const void* target, R_Events_BatchCallback callback) {
+	if (R_Type_IsNotOf(self, R_Events) || event_key == NULL || callback == NULL) return NULL; //target can be NULL!
+	R_List* events_for_key = R_Dictionary_get(self->events, event_key);
+	if (events_for_key == NULL) return NULL;
+
+	R_Events_Match match = {target, NULL, callback};
+	R_List_removeIf(events_for_key, R_Events_matchesCallback, &match);
 	return self;
 }
 
 R_Events* R_FUNCTION_ATTRIBUTES R_Events_removeTarget(R_Events* self, const void* target) {
 	if (self == NULL) return NULL; //target can be NULL!
 
+	R_Events_Match match = {target, NULL, NULL};
 	R_List* event_pairs = R_Dictionary_listOfPairs(self->events);
 	for (int i=0; i<R_List_size(event_pairs); i++) {
 		R_List* event = R_KeyValuePair_value(R_List_pointerAtIndex(event_pairs, i));
 		if (event == NULL) return NULL;
-		for (int j=R_List_size(event)-1; j>=0; j--) {
-			R_Events_NotificationDefinition* notification = R_List_pointerAtIndex(event, j);
-			if (notification == NULL) return NULL;
-			if (notification->target == target) R_List_removePointer(event, notification);
-		}
+		R_List_removeIf(event, R_Events_matchesTarget, &match);
 	}
 
 	return self;
 }
 
 R_Events* R_FUNCTION_ATTRIBUTES R_Events_notify(R_Events* self, const char* event_key, void* payload) {
-	if (self == NULL || event_key == NULL) return NULL; //payload can be NULL!
+	return R_Events_notifyBatch(self, event_key, &payload, 1); //payload can be NULL!
+}
+
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_notifyBatch(R_Events* self, const char* event_key, void** payloads, size_t count) {
+	if (self == NULL || event_key == NULL || payloads == NULL) return NULL;
 	R_List* events_for_key = R_Dictionary_get(self->events, event_key);
 	if (events_for_key == NULL) return NULL;
+	if (count == 0) return self;
 
 	for (int i=R_List_size(events_for_key)-1; i>=0; i--) {
 		R_Events_NotificationDefinition* notification = R_List_pointerAtIndex(events_for_key, i);
 		if (notification == NULL) return NULL;
-		if (notification->callback) notification->callback(notification->target, event_key, payload);
+		if (notification->batch_callback) notification->batch_callback(notification->target, event_key, payloads, count);
+		else if (notification->callback) {
+			size_t deliveries = notification->run_once ? 1 : count;
+			for (size_t j=0; j<deliveries; j++) notification->callback(notification->target, event_key, payloads[j]);
+		}
 		if (notification->run_once) R_List_removePointer(events_for_key, notification);
 	}
 
 	return self;
 }
 
+static R_Events* R_FUNCTION_ATTRIBUTES R_Events_deliverPending(R_Events* self, const char* event_key, R_Events_PendingPayloads* pending);
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_setCoalescing(R_Events* self, const char* event_key, bool enabled, R_Events_Merger merger) {
+	if (R_Type_IsNotOf(self, R_Events) || event_key == NULL) return NULL;
+	R_Events_PendingPayloads* pending = R_Dictionary_get(self->pending, event_key);
+	if (enabled) {
+		if (pending == NULL) pending = R_Dictionary_add(self->pending, event_key, R_Events_PendingPayloads);
+		if (pending == NULL) return NULL;
+		pending->merger = merger;
+		return self;
+	}
+	if (pending == NULL) return self;
+	R_Events_deliverPending(self, event_key, pending);
+	R_Dictionary_remove(self->pending, event_key);
+	return self;
+}
+
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_post(R_Events* self, const char* event_key, void* payload) {
+	if (R_Type_IsNotOf(self, R_Events) || event_key == NULL) return NULL; //payload can be NULL!
+	R_Events_PendingPayloads* pending = R_Dictionary_get(self->pending, event_key);
+	if (pending == NULL) return R_Events_notify(self, event_key, payload);
+
+	if (pending->merger && pending->count > 0) {
+		pending->payloads[0] = pending->merger(pending->payloads[0], payload);
+		return self;
+	}
+	if (pending->count >= pending->allocated) {
+		size_t allocated = pending->allocated ? pending->allocated*2 : 8;
+		void** payloads = (void**)os_realloc_sized(pending->payloads, pending->allocated*sizeof(void*), allocated*sizeof(void*));
+		if (payloads == NULL) return NULL;
+		pending->payloads = payloads;
+		pending->allocated = allocated;
+	}
+	pending->payloads[pending->count++] = payload;
+	return self;
+}
+
+static R_Events* R_FUNCTION_ATTRIBUTES R_Events_deliverPending(R_Events* self, const char* event_key, R_Events_PendingPayloads* pending) {
+	if (pending->count == 0) return self;
+	//Detach the queue first so callbacks can post to this key while it's being delivered
+	void** payloads = pending->payloads;
+	size_t count = pending->count;
+	size_t allocated = pending->allocated;
+	pending->payloads = NULL;
+	pending->count = pending->allocated = 0;
+	R_Events_notifyBatch(self, event_key, payloads, count);
+	os_free_sized(payloads, allocated*sizeof(void*));
+	return self;
+}
+
+R_Events* R_FUNCTION_ATTRIBUTES R_Events_drain(R_Events* self) {
+	if (R_Type_IsNotOf(self, R_Events)) return NULL;
+	//Callbacks can turn coalescing off, which removes pairs, so work from a copy of the keys and look each one up again
+	R_List* keys = R_Type_New(R_List);
+	if (keys == NULL) return NULL;
+	R_List* pending_pairs = R_Dictionary_listOfPairs(self->pending);
+	for (size_t i=0; i<R_List_size(pending_pairs); i++) {
+		if (R_List_addCopy(keys, R_KeyValuePair_key(R_List_pointerAtIndex(pending_pairs, i))) == NULL) return R_Type_Delete(keys), NULL;
+	}
+	for (size_t i=0; i<R_List_size(keys); i++) {
+		const char* event_key = R_MutableString_cstring(R_List_pointerAtIndex(keys, i));
+		R_Events_PendingPayloads* pending = R_Dictionary_get(self->pending, event_key);
+		if (pending != NULL) R_Events_deliverPending(self, event_key, pending);
+	}
+	R_Type_Delete(keys);
+	return self;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Events_pendingCount(R_Events* self, const char* event_key) {
+	if (R_Type_IsNotOf(self, R_Events) || event_key == NULL) return 0;
+	R_Events_PendingPayloads* pending = R_Dictionary_get(self->pending, event_key);
+	if (pending == NULL) return 0;
+	return pending->count;
+}
+
 bool R_FUNCTION_ATTRIBUTES R_Events_isRegistered(R_Events* self, const char* event_key, void* target, R_Events_Callback callback) {
 	if (self == NULL || event_key == NULL || callback == NULL) return false;
 	R_List* events_for_key = R_Dictionary_get(self->events, event_key);
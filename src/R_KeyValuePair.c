@@ -5,44 +5,126 @@
 #include "R_List.h"
 #include "R_MutableString.h"
 
+typedef enum {
+  R_KeyValuePair_Tag_Object = 0, //value holds the R_Type object, if any
+  R_KeyValuePair_Tag_Integer,
+  R_KeyValuePair_Tag_Float,
+  R_KeyValuePair_Tag_Boolean,
+  R_KeyValuePair_Tag_Null,
+} R_KeyValuePair_Tag;
 
+/*  R_KeyValuePair
+    With R_KeyValuePair_Tag_Object, value is the object and scalar.built is what R_KeyValuePair_value built from it,
+   if it implements R_Materialize. With any other tag the scalar is inline and value is the box R_KeyValuePair_value
+   made for it, if any. A box or a built object is published once with a compare-and-swap and is the value from then
+   on, so reading never changes what the pair holds and threads can read a pair at the same time.
+ */
 struct R_KeyValuePair {
   R_Type* type;
   R_MutableString* key;
-  void* value; //May be a string, integer, float, array of values or a dictionary
+  void* value;
+  R_KeyValuePair_Tag tag;
+  union {
+    int integer;
+    float floater;
+    bool boolean;
+    void* built;
+  } scalar;
 };
+
+#ifdef R_OS_THREADS
+  #define R_KeyValuePair_load(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+  #define R_KeyValuePair_compareExchange(pointer, expected, value) __atomic_compare_exchange_n(pointer, expected, value, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+  #define R_KeyValuePair_load(pointer) (*(pointer))
+  #define R_KeyValuePair_compareExchange(pointer, expected, value) (*(pointer) == *(expected) ? (*(pointer) = (value), true) : (*(expected) = *(pointer), false))
+#endif
 static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Constructor(R_KeyValuePair* self);
 static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Destructor(R_KeyValuePair* self);
 static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Copier(R_KeyValuePair* self, R_KeyValuePair* new);
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Mover(R_KeyValuePair* self, R_KeyValuePair* new);
 
 static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Constructor(R_KeyValuePair* self) {
   self->key = R_Type_New(R_MutableString);
+  self->tag = R_KeyValuePair_Tag_Object;
   return self;
 }
 
+//Deletes the value, along with anything built from it
+static void R_FUNCTION_ATTRIBUTES R_KeyValuePair_clearValue(R_KeyValuePair* self) {
+  if (self->tag == R_KeyValuePair_Tag_Object) R_Type_DeleteAndNull(self->scalar.built);
+  R_Type_DeleteAndNull(self->value);
+}
+
 static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Destructor(R_KeyValuePair* self) {
   R_Type_DeleteAndNull(self->key);
-  R_Type_DeleteAndNull(self->value);
+  R_KeyValuePair_clearValue(self);
   return self;
 }
 
 static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Copier(R_KeyValuePair* self, R_KeyValuePair* new) {
-  new->value = R_Type_Copy(self->value);
-  if (new->value == NULL) return R_Type_Delete(new), NULL;
+  if (R_KeyValuePair_copyValue(new, self) == NULL) return R_Type_Delete(new), NULL;
   R_MutableString_appendString(new->key, self->key);
   return new;
 }
 
-R_Type_Def(R_KeyValuePair, R_KeyValuePair_Constructor, R_KeyValuePair_Destructor, R_KeyValuePair_Copier, NULL);
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_Mover(R_KeyValuePair* self, R_KeyValuePair* new) {
+  R_MutableString_take(new->key, self->key);
+  return R_KeyValuePair_moveValue(new, self);
+}
+
+R_Type_Define(R_KeyValuePair,
+  .ctor = (R_Type_Constructor)R_KeyValuePair_Constructor,
+  .dtor = (R_Type_Destructor)R_KeyValuePair_Destructor,
+  .copy = (R_Type_Copier)R_KeyValuePair_Copier,
+  .move = (R_Type_Mover)R_KeyValuePair_Mover);
 
 R_MutableString* R_FUNCTION_ATTRIBUTES R_KeyValuePair_key(R_KeyValuePair* self) {
   if (R_Type_IsNotOf(self, R_KeyValuePair)) return NULL;
   return self->key;
 }
 
+//Stores object in an empty slot and returns it. If another thread filled the slot first, deletes object and returns theirs.
+static void* R_FUNCTION_ATTRIBUTES R_KeyValuePair_publish(void** slot, void* object) {
+  void* expected = NULL;
+  if (object == NULL || R_KeyValuePair_compareExchange(slot, &expected, object)) return object;
+  R_Type_Delete(object);
+  return expected;
+}
+
+static void* R_FUNCTION_ATTRIBUTES R_KeyValuePair_box(R_KeyValuePair* self) {
+  switch (self->tag) {
+    case R_KeyValuePair_Tag_Integer: return R_Integer_set(R_Type_New(R_Integer), self->scalar.integer);
+    case R_KeyValuePair_Tag_Float: return R_Float_set(R_Type_New(R_Float), self->scalar.floater);
+    case R_KeyValuePair_Tag_Boolean: return R_Boolean_set(R_Type_New(R_Boolean), self->scalar.boolean);
+    case R_KeyValuePair_Tag_Null: return R_Type_New(R_Null);
+    default: return NULL;
+  }
+}
+
 void* R_FUNCTION_ATTRIBUTES R_KeyValuePair_value(R_KeyValuePair* self) {
   if (R_Type_IsNotOf(self, R_KeyValuePair)) return NULL;
-  return self->value;
+  void* value = R_KeyValuePair_load(&self->value);
+  if (self->tag != R_KeyValuePair_Tag_Object) return value ? value : R_KeyValuePair_publish(&self->value, R_KeyValuePair_box(self));
+  if (value == NULL || R_Type_hasNoMethod(value, R_Materialize)) return value;
+  void* built = R_KeyValuePair_load(&self->scalar.built);
+  return built ? built : R_KeyValuePair_publish(&self->scalar.built, R_Materialize(value));
+}
+
+void* R_FUNCTION_ATTRIBUTES R_KeyValuePair_readValue(R_KeyValuePair* self) {
+  if (R_Type_IsNotOf(self, R_KeyValuePair)) return NULL;
+  void* value = R_KeyValuePair_load(&self->value);
+  if (self->tag != R_KeyValuePair_Tag_Object && value == NULL) return R_KeyValuePair_box(self);
+  if (self->tag == R_KeyValuePair_Tag_Object && value != NULL && R_Type_hasMethod(value, R_Materialize)) {
+    void* built = R_KeyValuePair_load(&self->scalar.built);
+    if (built == NULL) return R_Materialize(value);
+    value = built;
+  }
+#ifdef R_TYPE_REFCOUNT
+  return R_Type_Retain(value);
+#else
+  return R_Type_Copy(value);
+#endif
 }
 
 R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setKey(R_KeyValuePair* self, const char* key) {
@@ -51,9 +133,110 @@ R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setKey(R_KeyValuePair* self
   return self;
 }
 
-R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setValue(R_KeyValuePair* self, void* value) {
+
+const R_Type* R_FUNCTION_ATTRIBUTES R_KeyValuePair_valueType(R_KeyValuePair* self) {
   if (R_Type_IsNotOf(self, R_KeyValuePair)) return NULL;
-  R_Type_Delete(self->value);
+  switch (self->tag) {
+    case R_KeyValuePair_Tag_Integer: return R_Type_Object(R_Integer);
+    case R_KeyValuePair_Tag_Float: return R_Type_Object(R_Float);
+    case R_KeyValuePair_Tag_Boolean: return R_Type_Object(R_Boolean);
+    case R_KeyValuePair_Tag_Null: return R_Type_Object(R_Null);
+    case R_KeyValuePair_Tag_Object: break;
+  }
+  if (self->value == NULL) return NULL;
+  if (R_Type_hasMethod(self->value, R_MaterializedType)) return R_MaterializedType(self->value);
+  return R_Type_Of(self->value);
+}
+
+//Also clears the scalar, so an old integer is never taken for a built object
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setTag(R_KeyValuePair* self, R_KeyValuePair_Tag tag) {
+  if (R_Type_IsNotOf(self, R_KeyValuePair)) return NULL;
+  R_KeyValuePair_clearValue(self);
+  self->tag = tag;
+  self->scalar.built = NULL;
+  return self;
+}
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setValue(R_KeyValuePair* self, void* value) {
+  if (R_KeyValuePair_setTag(self, R_KeyValuePair_Tag_Object) == NULL) return NULL;
   self->value = value;
   return self;
 }
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setInteger(R_KeyValuePair* self, int value) {
+  if (R_KeyValuePair_setTag(self, R_KeyValuePair_Tag_Integer) == NULL) return NULL;
+  self->scalar.integer = value;
+  return self;
+}
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setFloat(R_KeyValuePair* self, float value) {
+  if (R_KeyValuePair_setTag(self, R_KeyValuePair_Tag_Float) == NULL) return NULL;
+  self->scalar.floater = value;
+  return self;
+}
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setBoolean(R_KeyValuePair* self, bool value) {
+  if (R_KeyValuePair_setTag(self, R_KeyValuePair_Tag_Boolean) == NULL) return NULL;
+  self->scalar.boolean = value;
+  return self;
+}
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_setNull(R_KeyValuePair* self) {
+  return R_KeyValuePair_setTag(self, R_KeyValuePair_Tag_Null);
+}
+
+int R_FUNCTION_ATTRIBUTES R_KeyValuePair_getInteger(R_KeyValuePair* self) {
+  if (R_Type_IsNotOf(self, R_KeyValuePair)) return 0;
+  //Once there's a box it holds the value, since it may have been changed
+  void* value = R_KeyValuePair_load(&self->value);
+  if (self->tag == R_KeyValuePair_Tag_Integer && value == NULL) return self->scalar.integer;
+  if (R_Type_IsOf(value, R_Integer)) return R_Integer_get(value);
+  return 0;
+}
+
+float R_FUNCTION_ATTRIBUTES R_KeyValuePair_getFloat(R_KeyValuePair* self) {
+  if (R_Type_IsNotOf(self, R_KeyValuePair)) return 0;
+  //Once there's a box it holds the value, since it may have been changed
+  void* value = R_KeyValuePair_load(&self->value);
+  if (self->tag == R_KeyValuePair_Tag_Float && value == NULL) return self->scalar.floater;
+  if (R_Type_IsOf(value, R_Float)) return R_Float_get(value);
+  return 0;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_KeyValuePair_getBoolean(R_KeyValuePair* self) {
+  if (R_Type_IsNotOf(self, R_KeyValuePair)) return false;
+  //Once there's a box it holds the value, since it may have been changed
+  void* value = R_KeyValuePair_load(&self->value);
+  if (self->tag == R_KeyValuePair_Tag_Boolean && value == NULL) return self->scalar.boolean;
+  if (R_Type_IsOf(value, R_Boolean)) return R_Boolean_get(value);
+  return false;
+}
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_copyValue(R_KeyValuePair* self, R_KeyValuePair* source) {
+  if (R_Type_IsNotOf(self, R_KeyValuePair) || R_Type_IsNotOf(source, R_KeyValuePair)) return NULL;
+  if (self == source) return self;
+  switch (source->tag) {
+    case R_KeyValuePair_Tag_Integer: return R_KeyValuePair_setInteger(self, R_KeyValuePair_getInteger(source));
+    case R_KeyValuePair_Tag_Float: return R_KeyValuePair_setFloat(self, R_KeyValuePair_getFloat(source));
+    case R_KeyValuePair_Tag_Boolean: return R_KeyValuePair_setBoolean(self, R_KeyValuePair_getBoolean(source));
+    case R_KeyValuePair_Tag_Null: return R_KeyValuePair_setNull(self);
+    case R_KeyValuePair_Tag_Object: break;
+  }
+  void* built = R_KeyValuePair_load(&source->scalar.built);
+  void* value = R_Type_Copy(built ? built : source->value);
+  if (value == NULL) return NULL;
+  return R_KeyValuePair_setValue(self, value);
+}
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_KeyValuePair_moveValue(R_KeyValuePair* self, R_KeyValuePair* source) {
+  if (R_Type_IsNotOf(self, R_KeyValuePair) || R_Type_IsNotOf(source, R_KeyValuePair)) return NULL;
+  if (self == source) return self;
+  R_KeyValuePair_clearValue(self);
+  self->value = source->value;
+  self->tag = source->tag;
+  self->scalar = source->scalar;
+  source->value = NULL;
+  source->tag = R_KeyValuePair_Tag_Object;
+  source->scalar.built = NULL;
+  return self;
+}
@@ -7,8 +7,9 @@
 
 struct R_List {
     R_Type* type;
-    void ** array;          //The actual array
-    size_t arrayAllocationSize;//How large the internal array is. This is always as-large or larger than ArraySize.
+    void ** array;          //The first object of the list. Shifting moves this forward instead of moving every object.
+    void ** allocation;     //The start of the allocated block, array is somewhere inside it
+    size_t arrayAllocationSize;//How many pointers fit in the allocation. This is always as-large or larger than ArraySize.
     size_t arraySize;          //How many objects the user has added to the array.
     size_t last_index_of_pointer_at_index; //Optimization for the 'each' operator
 };
@@ -16,16 +17,22 @@ struct R_List {
 static R_List* R_FUNCTION_ATTRIBUTES R_List_Constructor(R_List* self);
 static R_List* R_FUNCTION_ATTRIBUTES R_List_Destructor(R_List* self);
 static R_List* R_FUNCTION_ATTRIBUTES R_List_Copier(R_List* self, R_List* new);
+static R_List* R_FUNCTION_ATTRIBUTES R_List_Mover(R_List* self, R_List* new);
 static R_JumpTable_Entry methods[] = {
   R_JumpTable_Entry_Make(R_Stringify, R_List_stringify), 
   R_JumpTable_Entry_NULL
 };
-R_Type_Def(R_List, R_List_Constructor, R_List_Destructor, R_List_Copier, methods);
+R_Type_Define(R_List,
+  .ctor = (R_Type_Constructor)R_List_Constructor,
+  .dtor = (R_Type_Destructor)R_List_Destructor,
+  .copy = (R_Type_Copier)R_List_Copier,
+  .move = (R_Type_Mover)R_List_Mover,
+  .interfaces = methods);
 
-static void R_FUNCTION_ATTRIBUTES R_List_increaseAllocationIfRequired(R_List* self);
+static bool R_FUNCTION_ATTRIBUTES R_List_increaseAllocationIfRequired(R_List* self);
 
 static R_List* R_FUNCTION_ATTRIBUTES R_List_Constructor(R_List* self) {
-    self->array = NULL;
+    self->array = self->allocation = NULL;
     self->arrayAllocationSize = 0;
     self->arraySize = 0;
 
@@ -34,7 +41,7 @@ static R_List* R_FUNCTION_ATTRIBUTES R_List_Constructor(R_List* self) {
 
 static R_List* R_FUNCTION_ATTRIBUTES R_List_Destructor(R_List* self) {
     R_List_removeAll(self);
-    os_free(self->array);
+    os_free_sized(self->allocation, self->arrayAllocationSize*sizeof(void*));
 
     return self;
 }
@@ -43,15 +50,47 @@ static R_List* R_FUNCTION_ATTRIBUTES R_List_Copier(R_List* self, R_List* new) {
     return R_List_appendList(new, self);
 }
 
+static R_List* R_FUNCTION_ATTRIBUTES R_List_Mover(R_List* self, R_List* new) {
+    return R_List_splice(new, self);
+}
+
 inline size_t R_FUNCTION_ATTRIBUTES R_List_size(R_List* self) {
     return self->arraySize;
 }
 
-static void R_FUNCTION_ATTRIBUTES R_List_increaseAllocationIfRequired(R_List* self) { //increase by 1 void**
-    if (self->arrayAllocationSize > self->arraySize) return;
-    self->arrayAllocationSize += 1;
-    self->array = (void**)os_realloc(self->array, self->arrayAllocationSize*sizeof(void*));
-    self->array[self->arrayAllocationSize - 1] = NULL;
+static bool R_FUNCTION_ATTRIBUTES R_List_reallocate(R_List* self, size_t allocation_size) {
+    size_t head_offset = self->array - self->allocation;
+    void** allocation = (void**)os_realloc_sized(self->allocation, self->arrayAllocationSize*sizeof(void*), allocation_size*sizeof(void*));
+    if (allocation == NULL) return false;
+    self->allocation = allocation;
+    self->array = allocation + head_offset;
+    self->arrayAllocationSize = allocation_size;
+    return true;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_List_increaseAllocationIfRequired(R_List* self) { //make room for 1 more void* at the tail
+    size_t head_offset = self->array - self->allocation;
+    if (self->arrayAllocationSize > head_offset + self->arraySize) return true;
+    //If shifts have left at least half the block unused, slide the objects back instead of growing
+    if (head_offset > 0 && head_offset >= self->arraySize) {
+        memmove(self->allocation, self->array, self->arraySize*sizeof(void*));
+        self->array = self->allocation;
+        return true;
+    }
+    return R_List_reallocate(self, self->arrayAllocationSize ? self->arrayAllocationSize*2 : 4);
+}
+
+R_List* R_FUNCTION_ATTRIBUTES R_List_reserve(R_List* self, size_t count) {
+    if (R_Type_IsNotOf(self, R_List)) return NULL;
+    size_t head_offset = self->array - self->allocation;
+    if (self->arrayAllocationSize >= head_offset + count) return self;
+    if (head_offset > 0) {
+        memmove(self->allocation, self->array, self->arraySize*sizeof(void*));
+        self->array = self->allocation;
+        if (self->arrayAllocationSize >= count) return self;
+    }
+    if (R_List_reallocate(self, count) == false) return NULL;
+    return self;
 }
 
 inline void* R_FUNCTION_ATTRIBUTES R_List_pointerAtIndex(R_List* self, size_t index) {
@@ -60,6 +99,11 @@ inline void* R_FUNCTION_ATTRIBUTES R_List_pointerAtIndex(R_List* self, size_t in
     return self->array[index];
 }
 
+void** R_FUNCTION_ATTRIBUTES R_List_pointers(R_List* self) {
+    if (R_Type_IsNotOf(self, R_List)) return NULL;
+    return self->array;
+}
+
 void* R_FUNCTION_ATTRIBUTES R_List_last(R_List* self) {
     return R_List_pointerAtIndex(self, R_List_size(self)-1);
 }
@@ -71,7 +115,7 @@ void* R_FUNCTION_ATTRIBUTES R_List_first(R_List* self) {
 size_t R_FUNCTION_ATTRIBUTES R_List_indexOfPointer(R_List* self, void* pointer) {
     if (self == NULL || pointer == NULL) return -1;
     //last_index_of_pointer_at_index is an optimization for the 'each' operator
-    if (pointer == self->array[self->last_index_of_pointer_at_index]) return self->last_index_of_pointer_at_index;
+    if (self->last_index_of_pointer_at_index < self->arraySize && pointer == self->array[self->last_index_of_pointer_at_index]) return self->last_index_of_pointer_at_index;
     for (int i=0; i<self->arraySize; i++) {
         if (self->array[i] == pointer)
             return i;
@@ -84,7 +128,11 @@ void R_FUNCTION_ATTRIBUTES R_List_pop(R_List* self) {
 }
 
 void R_FUNCTION_ATTRIBUTES R_List_shift(R_List* self) {
-    R_List_removeIndex(self, 0);
+    if (self == NULL || self->arraySize == 0) return;
+    R_Type_Delete(self->array[0]);
+    self->array++;
+    self->arraySize--;
+    if (self->arraySize == 0) self->array = self->allocation;
 }
 
 void R_FUNCTION_ATTRIBUTES R_List_swap(R_List* self, int indexA, int indexB) {
@@ -97,7 +145,7 @@ void R_FUNCTION_ATTRIBUTES R_List_swap(R_List* self, int indexA, int indexB) {
 
 void* R_FUNCTION_ATTRIBUTES R_List_addObjectOfType(R_List* self, const R_Type* type) {
     if (type == NULL || self == NULL) return NULL;
-    R_List_increaseAllocationIfRequired(self);
+    if (R_List_increaseAllocationIfRequired(self) == false) return NULL;
 
     void* newPointer = R_Type_NewObjectOfType(type);
     if (newPointer == NULL) return NULL;
@@ -111,6 +159,7 @@ void* R_FUNCTION_ATTRIBUTES R_List_addObjectOfType(R_List* self, const R_Type* t
 void* R_FUNCTION_ATTRIBUTES R_List_appendList(R_List* self, R_List* list) {
   if (R_Type_IsNotOf(self, R_List) || R_Type_IsNotOf(list, R_List)) return NULL;
   int original_size = R_List_size(list); //Buffer because self and list may be the same object
+  if (R_List_reserve(self, R_List_size(self) + original_size) == NULL) return NULL;
   for (int i=0; i<original_size; i++) {
     void* object = R_List_pointerAtIndex(list, i);
     if (R_List_addCopy(self, object) == NULL) return NULL;
@@ -118,19 +167,31 @@ void* R_FUNCTION_ATTRIBUTES R_List_appendList(R_List* self, R_List* list) {
   return self;
 }
 
-void* R_FUNCTION_ATTRIBUTES R_List_transferList(R_List* self, R_List* list) {
-  if (R_Type_IsNotOf(self, R_List) || R_Type_IsNotOf(list, R_List)) return NULL;
-  for (int i=R_List_size(list)-1; i>=0; i--) {
-    void* object = R_List_pointerAtIndex(list, i);
-    if (R_List_transferOwnership(self, object) == NULL) return NULL;
+R_List* R_FUNCTION_ATTRIBUTES R_List_splice(R_List* self, R_List* list) {
+  if (R_Type_IsNotOf(self, R_List) || R_Type_IsNotOf(list, R_List) || self == list) return NULL;
+  if (list->arraySize == 0) return self;
+  if (self->arraySize == 0) {
+    //Nothing to keep, so swap in the other list's block instead of copying pointers into ours
+    os_free_sized(self->allocation, self->arrayAllocationSize*sizeof(void*));
+    *self = (R_List){self->type, list->array, list->allocation, list->arrayAllocationSize, list->arraySize, 0};
+    R_List_Constructor(list);
+    return self;
   }
+  if (R_List_reserve(self, self->arraySize + list->arraySize) == NULL) return NULL;
+  memcpy(self->array + self->arraySize, list->array, list->arraySize*sizeof(void*));
+  self->arraySize += list->arraySize;
+  list->arraySize = 0;
+  list->array = list->allocation;
   return self;
+}
 
+void* R_FUNCTION_ATTRIBUTES R_List_transferList(R_List* self, R_List* list) {
+  return R_List_splice(self, list);
 }
 
 void* R_FUNCTION_ATTRIBUTES R_List_transferOwnership(R_List* self, void* object) {
     if (self == NULL || object == NULL) return NULL;
-    R_List_increaseAllocationIfRequired(self);
+    if (R_List_increaseAllocationIfRequired(self) == false) return NULL;
 
     self->array[self->arraySize] = object;
     self->arraySize++;
@@ -138,9 +199,21 @@ void* R_FUNCTION_ATTRIBUTES R_List_transferOwnership(R_List* self, void* object)
     return object;
 }
 
+#ifdef R_TYPE_REFCOUNT
+void* R_FUNCTION_ATTRIBUTES R_List_addShared(R_List* self, void* object) {
+    if (R_Type_IsNotOf(self, R_List) || object == NULL) return NULL;
+    if (R_List_increaseAllocationIfRequired(self) == false) return NULL;
+
+    self->array[self->arraySize] = R_Type_Retain(object);
+    self->arraySize++;
+
+    return object;
+}
+#endif
+
 void* R_FUNCTION_ATTRIBUTES R_List_addCopy(R_List* self, const void* object) {
     if (object == NULL || self == NULL) return NULL;
-    R_List_increaseAllocationIfRequired(self);
+    if (R_List_increaseAllocationIfRequired(self) == false) return NULL;
 
     void* copy = R_Type_Copy(object);
     if (copy == NULL) return NULL;
@@ -153,32 +226,60 @@ void* R_FUNCTION_ATTRIBUTES R_List_addCopy(R_List* self, const void* object) {
 
 void R_FUNCTION_ATTRIBUTES R_List_removeIndex(R_List* self, size_t index) {
     if (self == NULL || index>=self->arraySize) return;
+    if (index == 0) R_List_shift(self);
+    else R_List_removeRange(self, index, 1);
+}
+
+void R_FUNCTION_ATTRIBUTES R_List_removeRange(R_List* self, size_t index, size_t count) {
+    if (self == NULL || index>=self->arraySize) return;
+    if (count > self->arraySize - index) count = self->arraySize - index;
 
-    void* pointerToDelete = R_List_pointerAtIndex(self, index);
-    R_Type_Delete(pointerToDelete);
+    for (size_t i=index; i<index+count; i++) R_Type_Delete(self->array[i]);
+    memmove(self->array+index, self->array+index+count, (self->arraySize-index-count)*sizeof(void*));
+    self->arraySize -= count;
+    if (self->arraySize == 0) self->array = self->allocation;
+}
 
-    for (size_t i=index; i<self->arraySize-1; i++) {
-        self->array[i] = self->array[i+1];
-    }
+void R_FUNCTION_ATTRIBUTES R_List_swapRemove(R_List* self, size_t index) {
+    if (self == NULL || index>=self->arraySize) return;
+    R_Type_Delete(self->array[index]);
+    self->array[index] = self->array[self->arraySize-1];
     self->arraySize--;
-    self->array[self->arraySize] = 0;
+    if (self->arraySize == 0) self->array = self->allocation;
 }
+
+size_t R_FUNCTION_ATTRIBUTES R_List_removeIf(R_List* self, R_List_Predicate predicate, void* context) {
+    if (self == NULL || predicate == NULL) return 0;
+    size_t kept = 0;
+    for (size_t i=0; i<self->arraySize; i++) {
+        void* object = self->array[i];
+        if (predicate(object, context)) R_Type_Delete(object);
+        else self->array[kept++] = object;
+    }
+    size_t removed = self->arraySize - kept;
+    self->arraySize = kept;
+    if (self->arraySize == 0) self->array = self->allocation;
+    return removed;
+}
+
 void R_FUNCTION_ATTRIBUTES R_List_removePointer(R_List* self, void* pointer) {
     if (self == NULL || pointer == NULL) return;
-
-    int i;
-    for (i=0; i<self->arraySize; i++) if (self->array[i] == pointer) break;
-    if (i >= self->arraySize) return; //No pointer found
-    
-    R_List_removeIndex(self, i);
-    
-    //Recurse incase there are more copies
-    R_List_removePointer(self, pointer);
+    //Every copy of the pointer is dropped in one pass, but the object is only destroyed once
+    size_t kept = 0;
+    for (size_t i=0; i<self->arraySize; i++) {
+        if (self->array[i] != pointer) self->array[kept++] = self->array[i];
+    }
+    if (kept == self->arraySize) return; //No pointer found
+    self->arraySize = kept;
+    if (self->arraySize == 0) self->array = self->allocation;
+    R_Type_Delete(pointer);
 }
+
 void R_FUNCTION_ATTRIBUTES R_List_removeAll(R_List* self) {
     if (self == NULL) return;
     for (int i=0; i<self->arraySize; i++) R_Type_Delete(self->array[i]);
     self->arraySize = 0;
+    self->array = self->allocation;
 }
 
 size_t R_FUNCTION_ATTRIBUTES R_List_stringify(R_List* self, char* buffer, size_t size) {
@@ -0,0 +1,152 @@
+#include <stdlib.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_List.h"
+
+//Lists shorter than this per thread aren't worth handing to another thread
+#define R_List_Functional_MinimumParallelChunk 1024
+
+typedef struct {
+  void** objects;
+  size_t start;
+  size_t end;
+  R_List_Mapper mapper;
+  R_List_Predicate predicate;
+  R_List_Reducer reducer;
+  void* context;
+  void** results;
+  bool* keep;
+  void* accumulator;
+  bool failed;
+} R_List_Functional_Chunk;
+
+/*  R_List_Functional_split
+    Returns count objects cut into at most threads contiguous chunks, each starting as a copy of prototype, and sets
+   chunk_count. Returns NULL if the chunks can't be allocated.
+ */
+static R_List_Functional_Chunk* R_FUNCTION_ATTRIBUTES R_List_Functional_split(R_List_Functional_Chunk prototype, size_t count, size_t threads, size_t* chunk_count) {
+  if (threads == 0) threads = R_OS_cpuCount();
+  size_t chunks_wanted = count / R_List_Functional_MinimumParallelChunk;
+  if (chunks_wanted > threads) chunks_wanted = threads;
+  if (chunks_wanted < 1) chunks_wanted = 1;
+  R_List_Functional_Chunk* chunks = (R_List_Functional_Chunk*)os_malloc(chunks_wanted*sizeof(R_List_Functional_Chunk));
+  if (chunks == NULL) return NULL;
+  for (size_t i=0; i<chunks_wanted; i++) {
+    chunks[i] = prototype;
+    chunks[i].start = count*i/chunks_wanted;
+    chunks[i].end = count*(i+1)/chunks_wanted;
+  }
+  *chunk_count = chunks_wanted;
+  return chunks;
+}
+
+//Returns true if any chunk failed
+static bool R_FUNCTION_ATTRIBUTES R_List_Functional_run(R_OS_Task task, R_List_Functional_Chunk* chunks, size_t chunk_count) {
+  void** contexts = (void**)os_malloc(chunk_count*sizeof(void*));
+  if (contexts != NULL) {
+    for (size_t i=0; i<chunk_count; i++) contexts[i] = &chunks[i];
+    R_OS_parallelRun(task, contexts, chunk_count);
+    os_free_sized(contexts, chunk_count*sizeof(void*));
+  }
+  else {
+    for (size_t i=0; i<chunk_count; i++) task(&chunks[i]);
+  }
+  bool failed = false;
+  for (size_t i=0; i<chunk_count; i++) failed = failed || chunks[i].failed;
+  return failed;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Functional_mapChunk(void* context) {
+  R_List_Functional_Chunk* chunk = (R_List_Functional_Chunk*)context;
+  for (size_t i=chunk->start; i<chunk->end && !chunk->failed; i++) {
+    chunk->results[i] = chunk->mapper(chunk->objects[i], chunk->context);
+    chunk->failed = (chunk->results[i] == NULL);
+  }
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Functional_filterChunk(void* context) {
+  R_List_Functional_Chunk* chunk = (R_List_Functional_Chunk*)context;
+  for (size_t i=chunk->start; i<chunk->end; i++) chunk->keep[i] = chunk->predicate(chunk->objects[i], chunk->context);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Functional_reduceChunk(void* context) {
+  R_List_Functional_Chunk* chunk = (R_List_Functional_Chunk*)context;
+  for (size_t i=chunk->start; i<chunk->end; i++) chunk->reducer(chunk->accumulator, chunk->objects[i], chunk->context);
+}
+
+R_List* R_FUNCTION_ATTRIBUTES R_List_map(R_List* self, R_List_Mapper mapper, void* context, size_t threads) {
+  if (R_Type_IsNotOf(self, R_List) || mapper == NULL) return NULL;
+  size_t count = R_List_size(self);
+  R_List* list = R_Type_New(R_List);
+  if (count == 0 || list == NULL) return list;
+
+  size_t chunk_count = 0;
+  void** results = (void**)os_zalloc(count*sizeof(void*));
+  R_List_Functional_Chunk prototype = {.objects = R_List_pointers(self), .mapper = mapper, .context = context, .results = results};
+  R_List_Functional_Chunk* chunks = results ? R_List_Functional_split(prototype, count, threads, &chunk_count) : NULL;
+  if (chunks == NULL || R_List_Functional_run(R_List_Functional_mapChunk, chunks, chunk_count) || R_List_reserve(list, count) == NULL) {
+    //Chunks stop at their first failure, leaving the rest of their results NULL
+    for (size_t i=0; results && i<count; i++) R_Type_Delete(results[i]);
+    R_Type_DeleteAndNull(list);
+  }
+  else {
+    for (size_t i=0; i<count; i++) R_List_transferOwnership(list, results[i]);
+  }
+  os_free_sized(chunks, chunk_count*sizeof(R_List_Functional_Chunk));
+  os_free_sized(results, count*sizeof(void*));
+  return list;
+}
+
+R_List* R_FUNCTION_ATTRIBUTES R_List_filter(R_List* self, R_List_Predicate predicate, void* context, size_t threads) {
+  if (R_Type_IsNotOf(self, R_List) || predicate == NULL) return NULL;
+  size_t count = R_List_size(self);
+  R_List* list = R_Type_New(R_List);
+  if (count == 0 || list == NULL) return list;
+
+  size_t chunk_count = 0;
+  bool* keep = (bool*)os_zalloc(count*sizeof(bool));
+  R_List_Functional_Chunk prototype = {.objects = R_List_pointers(self), .predicate = predicate, .context = context, .keep = keep};
+  R_List_Functional_Chunk* chunks = keep ? R_List_Functional_split(prototype, count, threads, &chunk_count) : NULL;
+  if (chunks == NULL) R_Type_DeleteAndNull(list);
+  else R_List_Functional_run(R_List_Functional_filterChunk, chunks, chunk_count);
+
+  void** objects = R_List_pointers(self);
+  for (size_t i=0; list && i<count; i++) {
+#ifdef R_TYPE_REFCOUNT
+    if (keep[i] && R_List_addShared(list, objects[i]) == NULL) R_Type_DeleteAndNull(list);
+#else
+    if (keep[i] && R_List_addCopy(list, objects[i]) == NULL) R_Type_DeleteAndNull(list);
+#endif
+  }
+  os_free_sized(chunks, chunk_count*sizeof(R_List_Functional_Chunk));
+  os_free_sized(keep, count*sizeof(bool));
+  return list;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_List_reduce(R_List* self, void* accumulator, R_List_Reducer reducer, R_List_Combiner combiner, void* context, size_t threads) {
+  if (R_Type_IsNotOf(self, R_List) || accumulator == NULL || reducer == NULL) return NULL;
+  size_t count = R_List_size(self);
+  size_t chunk_count = 1;
+  R_List_Functional_Chunk prototype = {.objects = R_List_pointers(self), .end = count, .reducer = reducer, .context = context, .accumulator = accumulator};
+  R_List_Functional_Chunk* chunks = combiner ? R_List_Functional_split(prototype, count, threads, &chunk_count) : NULL;
+  //The copies are made before any slice starts, while accumulator still holds the starting value
+  for (size_t i=1; chunks && i<chunk_count; i++) {
+    chunks[i].accumulator = R_Type_Copy(accumulator);
+    if (chunks[i].accumulator != NULL) continue;
+    for (size_t j=1; j<i; j++) R_Type_Delete(chunks[j].accumulator);
+    os_free_sized(chunks, chunk_count*sizeof(R_List_Functional_Chunk));
+    chunks = NULL;
+  }
+  if (chunks == NULL) {
+    R_List_Functional_reduceChunk(&prototype);
+    return accumulator;
+  }
+
+  R_List_Functional_run(R_List_Functional_reduceChunk, chunks, chunk_count);
+  for (size_t i=1; i<chunk_count; i++) {
+    combiner(accumulator, chunks[i].accumulator, context);
+    R_Type_Delete(chunks[i].accumulator);
+  }
+  os_free_sized(chunks, chunk_count*sizeof(R_List_Functional_Chunk));
+  return accumulator;
+}
@@ -0,0 +1,261 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_List.h"
+
+#define R_List_Sort_InsertionThreshold 16
+#define R_List_Sort_MinimumParallelChunk 1024
+
+static int R_FUNCTION_ATTRIBUTES R_List_Sort_dynamicCompare(void* object_a, void* object_b) {
+  if (R_Type_hasMethod(object_a, R_Compare)) return R_Compare(object_a, object_b);
+  return (object_a > object_b) - (object_a < object_b);
+}
+
+//Looks the R_Compare method up once if every object shares a type, instead of once per comparison
+static R_List_Comparator R_FUNCTION_ATTRIBUTES R_List_Sort_resolveComparator(R_List* self, R_List_Comparator comparator) {
+  if (comparator != NULL) return comparator;
+  void** objects = R_List_pointers(self);
+  size_t count = R_List_size(self);
+  if (count == 0) return R_List_Sort_dynamicCompare;
+  const R_Type* type = R_Type_Of(objects[0]);
+  for (size_t i=1; i<count; i++) {
+    if (R_Type_Of(objects[i]) != type) return R_List_Sort_dynamicCompare;
+  }
+  if (R_Type_hasMethod(objects[0], R_Compare)) return (R_List_Comparator)R_JumpTable_get(type->interfaces, R_JumpTable_Key(R_Compare));
+  return R_List_Sort_dynamicCompare;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_insertion(void** objects, size_t count, R_List_Comparator comparator) {
+  for (size_t i=1; i<count; i++) {
+    void* object = objects[i];
+    size_t j = i;
+    while (j > 0 && comparator(objects[j-1], object) > 0) {
+      objects[j] = objects[j-1];
+      j--;
+    }
+    objects[j] = object;
+  }
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_siftDown(void** objects, size_t root, size_t count, R_List_Comparator comparator) {
+  void* object = objects[root];
+  while (root*2+1 < count) {
+    size_t child = root*2+1;
+    if (child+1 < count && comparator(objects[child], objects[child+1]) < 0) child++;
+    if (comparator(object, objects[child]) >= 0) break;
+    objects[root] = objects[child];
+    root = child;
+  }
+  objects[root] = object;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_heap(void** objects, size_t count, R_List_Comparator comparator) {
+  for (size_t i=count/2; i>0; i--) R_List_Sort_siftDown(objects, i-1, count, comparator);
+  for (size_t end=count-1; end>0; end--) {
+    void* temp = objects[0];
+    objects[0] = objects[end];
+    objects[end] = temp;
+    R_List_Sort_siftDown(objects, 0, end, comparator);
+  }
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_orderPair(void** objects, size_t a, size_t b, R_List_Comparator comparator) {
+  if (comparator(objects[b], objects[a]) >= 0) return;
+  void* temp = objects[a];
+  objects[a] = objects[b];
+  objects[b] = temp;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_intro(void** objects, size_t count, size_t depth_limit, R_List_Comparator comparator) {
+  while (count > R_List_Sort_InsertionThreshold) {
+    if (depth_limit == 0) {
+      R_List_Sort_heap(objects, count, comparator);
+      return;
+    }
+    depth_limit--;
+
+    //Median-of-three keeps sorted and reverse-sorted input from going quadratic and bounds the partition loops
+    size_t middle = count/2;
+    R_List_Sort_orderPair(objects, 0, middle, comparator);
+    R_List_Sort_orderPair(objects, middle, count-1, comparator);
+    R_List_Sort_orderPair(objects, 0, middle, comparator);
+    void* pivot = objects[middle];
+
+    ptrdiff_t i = -1;
+    ptrdiff_t j = (ptrdiff_t)count;
+    while (true) {
+      do i++; while (comparator(objects[i], pivot) < 0);
+      do j--; while (comparator(objects[j], pivot) > 0);
+      if (i >= j) break;
+      void* temp = objects[i];
+      objects[i] = objects[j];
+      objects[j] = temp;
+    }
+
+    //Recurse into the smaller half and loop on the larger one to bound the stack depth
+    size_t left_count = (size_t)j + 1;
+    size_t right_count = count - left_count;
+    if (left_count < right_count) {
+      R_List_Sort_intro(objects, left_count, depth_limit, comparator);
+      objects += left_count;
+      count = right_count;
+    }
+    else {
+      R_List_Sort_intro(objects + left_count, right_count, depth_limit, comparator);
+      count = left_count;
+    }
+  }
+  R_List_Sort_insertion(objects, count, comparator);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_introsort(void** objects, size_t count, R_List_Comparator comparator) {
+  size_t depth_limit = 0;
+  for (size_t remaining = count; remaining > 1; remaining >>= 1) depth_limit += 2;
+  R_List_Sort_intro(objects, count, depth_limit, comparator);
+}
+
+R_List* R_FUNCTION_ATTRIBUTES R_List_sort(R_List* self, R_List_Comparator comparator) {
+  if (R_Type_IsNotOf(self, R_List)) return NULL;
+  comparator = R_List_Sort_resolveComparator(self, comparator);
+  R_List_Sort_introsort(R_List_pointers(self), R_List_size(self), comparator);
+  return self;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_merge(void** source, void** destination, size_t start, size_t middle, size_t end, R_List_Comparator comparator) {
+  size_t left = start;
+  size_t right = middle;
+  size_t output = start;
+  //Taking from the left run on ties is what keeps the merge stable
+  while (left < middle && right < end) destination[output++] = (comparator(source[right], source[left]) < 0) ? source[right++] : source[left++];
+  while (left < middle) destination[output++] = source[left++];
+  while (right < end) destination[output++] = source[right++];
+}
+
+R_List* R_FUNCTION_ATTRIBUTES R_List_stableSort(R_List* self, R_List_Comparator comparator) {
+  if (R_Type_IsNotOf(self, R_List)) return NULL;
+  comparator = R_List_Sort_resolveComparator(self, comparator);
+  void** objects = R_List_pointers(self);
+  size_t count = R_List_size(self);
+
+  for (size_t start=0; start<count; start+=R_List_Sort_InsertionThreshold) {
+    size_t run = count - start < R_List_Sort_InsertionThreshold ? count - start : R_List_Sort_InsertionThreshold;
+    R_List_Sort_insertion(objects + start, run, comparator);
+  }
+  if (count <= R_List_Sort_InsertionThreshold) return self;
+
+  void** buffer = (void**)os_malloc(count*sizeof(void*));
+  if (buffer == NULL) return NULL;
+  void** source = objects;
+  void** destination = buffer;
+  for (size_t width=R_List_Sort_InsertionThreshold; width<count; width*=2) {
+    for (size_t start=0; start<count; start+=2*width) {
+      size_t middle = start+width < count ? start+width : count;
+      size_t end = start+2*width < count ? start+2*width : count;
+      R_List_Sort_merge(source, destination, start, middle, end, comparator);
+    }
+    void** temp = source;
+    source = destination;
+    destination = temp;
+  }
+  if (source != objects) os_memcpy(objects, source, count*sizeof(void*));
+  os_free_sized(buffer, count*sizeof(void*));
+  return self;
+}
+
+typedef struct {
+  void** source;
+  void** destination;
+  size_t start;
+  size_t middle;
+  size_t end;
+  R_List_Comparator comparator;
+} R_List_Sort_Chunk;
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_sortChunk(void* context) {
+  R_List_Sort_Chunk* chunk = (R_List_Sort_Chunk*)context;
+  R_List_Sort_introsort(chunk->source + chunk->start, chunk->end - chunk->start, chunk->comparator);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_mergeChunk(void* context) {
+  R_List_Sort_Chunk* chunk = (R_List_Sort_Chunk*)context;
+  R_List_Sort_merge(chunk->source, chunk->destination, chunk->start, chunk->middle, chunk->end, chunk->comparator);
+}
+
+static void R_FUNCTION_ATTRIBUTES R_List_Sort_freeParallel(void** buffer, size_t* bounds, R_List_Sort_Chunk* chunks, void** contexts, size_t count, size_t chunk_count) {
+  os_free_sized(buffer, count*sizeof(void*));
+  os_free_sized(bounds, (chunk_count+1)*sizeof(size_t));
+  os_free_sized(chunks, chunk_count*sizeof(R_List_Sort_Chunk));
+  os_free_sized(contexts, chunk_count*sizeof(void*));
+}
+
+R_List* R_FUNCTION_ATTRIBUTES R_List_parallelSort(R_List* self, R_List_Comparator comparator, size_t threads) {
+  if (R_Type_IsNotOf(self, R_List)) return NULL;
+  size_t count = R_List_size(self);
+  if (threads == 0) threads = R_OS_cpuCount();
+  size_t chunk_count = count / R_List_Sort_MinimumParallelChunk;
+  if (chunk_count > threads) chunk_count = threads;
+  if (chunk_count < 2) return R_List_sort(self, comparator);
+
+  comparator = R_List_Sort_resolveComparator(self, comparator);
+  void** objects = R_List_pointers(self);
+  void** buffer = (void**)os_malloc(count*sizeof(void*));
+  size_t* bounds = (size_t*)os_malloc((chunk_count+1)*sizeof(size_t));
+  R_List_Sort_Chunk* chunks = (R_List_Sort_Chunk*)os_malloc(chunk_count*sizeof(R_List_Sort_Chunk));
+  void** contexts = (void**)os_malloc(chunk_count*sizeof(void*));
+  if (buffer == NULL || bounds == NULL || chunks == NULL || contexts == NULL) {
+    R_List_Sort_freeParallel(buffer, bounds, chunks, contexts, count, chunk_count);
+    return R_List_sort(self, comparator);
+  }
+
+  for (size_t i=0; i<=chunk_count; i++) bounds[i] = count*i/chunk_count;
+  for (size_t i=0; i<chunk_count; i++) {
+    chunks[i] = (R_List_Sort_Chunk){objects, NULL, bounds[i], bounds[i], bounds[i+1], comparator};
+    contexts[i] = &chunks[i];
+  }
+  R_OS_parallelRun(R_List_Sort_sortChunk, contexts, chunk_count);
+
+  //Merge neighbouring runs pairwise, halving the number of runs every round
+  void** source = objects;
+  void** destination = buffer;
+  size_t runs = chunk_count;
+  while (runs > 1) {
+    size_t merges = 0;
+    for (size_t i=0; i<runs; i+=2) {
+      size_t end = (i+2 <= runs) ? bounds[i+2] : bounds[i+1];
+      chunks[merges] = (R_List_Sort_Chunk){source, destination, bounds[i], bounds[i+1], end, comparator};
+      contexts[merges] = &chunks[merges];
+      merges++;
+    }
+    R_OS_parallelRun(R_List_Sort_mergeChunk, contexts, merges);
+    for (size_t i=0; i<merges; i++) bounds[i] = chunks[i].start;
+    bounds[merges] = count;
+    runs = merges;
+    void** temp = source;
+    source = destination;
+    destination = temp;
+  }
+  if (source != objects) os_memcpy(objects, source, count*sizeof(void*));
+
+  R_List_Sort_freeParallel(buffer, bounds, chunks, contexts, count, chunk_count);
+  return self;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_List_binarySearch(R_List* self, const void* object, R_List_Comparator comparator) {
+  if (R_Type_IsNotOf(self, R_List) || object == NULL) return -1;
+  if (comparator == NULL) {
+    const R_Type* type = R_Type_Of(object);
+    if (R_Type_hasMethod(object, R_Compare)) comparator = (R_List_Comparator)R_JumpTable_get(type->interfaces, R_JumpTable_Key(R_Compare));
+    else comparator = R_List_Sort_dynamicCompare;
+  }
+  void** objects = R_List_pointers(self);
+  size_t low = 0;
+  size_t high = R_List_size(self);
+  while (low < high) {
+    size_t middle = low + (high - low)/2;
+    if (comparator(objects[middle], (void*)object) < 0) low = middle + 1;
+    else high = middle;
+  }
+  if (low < R_List_size(self) && comparator(objects[low], (void*)object) == 0) return low;
+  return -1;
+}
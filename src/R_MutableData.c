@@ -10,66 +10,172 @@ struct R_MutableData {
 	R_Data data;
 	uint8_t* allocated_buffer;
 	size_t allocated_size;
+	size_t* references; //How many arrays share allocated_buffer, or NULL if this is the only one
 };
 
+#ifdef R_OS_THREADS
+  #define R_MutableData_retain(references) ((void)__atomic_add_fetch(references, 1, __ATOMIC_RELAXED))
+  #define R_MutableData_releaseLast(references) (__atomic_sub_fetch(references, 1, __ATOMIC_ACQ_REL) == 0)
+  #define R_MutableData_isLastReference(references) (__atomic_load_n(references, __ATOMIC_ACQUIRE) == 1)
+  #define R_MutableData_loadReferences(slot) __atomic_load_n(slot, __ATOMIC_ACQUIRE)
+  #define R_MutableData_installReferences(slot, expected, references) __atomic_compare_exchange_n(slot, expected, references, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+  #define R_MutableData_retain(references) ((void)++*(references))
+  #define R_MutableData_releaseLast(references) (--*(references) == 0)
+  #define R_MutableData_isLastReference(references) (*(references) == 1)
+  #define R_MutableData_loadReferences(slot) (*(slot))
+  #define R_MutableData_installReferences(slot, expected, references) (*(slot) = (references), true)
+#endif
+
 static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Constructor(R_MutableData* self);
 static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Destructor(R_MutableData* self);
 static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Copier(R_MutableData* self, R_MutableData* new);
+static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Mover(R_MutableData* self, R_MutableData* new);
 static R_JumpTable_Entry methods[] = {
   R_JumpTable_Entry_Make(R_Stringify, R_MutableData_stringify),
   R_JumpTable_Entry_Make(R_Equals, R_MutableData_isSame),
+  R_JumpTable_Entry_Make(R_Compare, R_MutableData_order),
   R_JumpTable_Entry_NULL
 };
-R_Type_Def(R_MutableData, R_MutableData_Constructor, R_MutableData_Destructor, R_MutableData_Copier, methods);
+R_Type_Define(R_MutableData,
+  .ctor = (R_Type_Constructor)R_MutableData_Constructor,
+  .dtor = (R_Type_Destructor)R_MutableData_Destructor,
+  .copy = (R_Type_Copier)R_MutableData_Copier,
+  .move = (R_Type_Mover)R_MutableData_Mover,
+  .interfaces = methods);
 
-static void R_FUNCTION_ATTRIBUTES R_MutableData_increaseAllocationIfNeeded(R_MutableData* self, size_t spaceNeeded);
+static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_increaseAllocationIfNeeded(R_MutableData* self, size_t spaceNeeded);
+static bool R_FUNCTION_ATTRIBUTES R_MutableData_detach(R_MutableData* self, size_t space_needed);
 
 static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Constructor(R_MutableData* self) {
 	self->data.type = R_Type_Object(R_Data);
 	self->data.bytes = self->allocated_buffer = NULL;
 	self->data.size = self->allocated_size = 0;
+	self->references = NULL;
 	return self;
 }
 static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Destructor(R_MutableData* self) {
-	os_free(self->allocated_buffer);
+	if (self->references == NULL) os_free_sized(self->allocated_buffer, self->allocated_size);
+	else if (R_MutableData_releaseLast(self->references)) {
+		os_free_sized(self->allocated_buffer, self->allocated_size);
+		os_free_sized(self->references, sizeof(size_t));
+	}
 	self->data.bytes = self->allocated_buffer = NULL;
 	self->data.size = self->allocated_size = 0;
+	self->references = NULL;
 	return self;
 }
 static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Copier(R_MutableData* self, R_MutableData* new) {
-	R_MutableData_appendArray(new, self);
-	return new;
+	return R_MutableData_share(new, self);
+}
+
+/*  R_MutableData_shareCount
+    Returns the count source's buffer is shared with, giving it one if it's the only owner so far. Copying is a read
+   of source, and several threads may copy it at once, so the first count installed wins and the others are freed.
+ */
+static size_t* R_FUNCTION_ATTRIBUTES R_MutableData_shareCount(R_MutableData* source) {
+	size_t* references = R_MutableData_loadReferences(&source->references);
+	if (references != NULL) return references;
+	size_t* count = (size_t*)os_malloc(sizeof(size_t));
+	if (count == NULL) return NULL;
+	*count = 1;
+	if (R_MutableData_installReferences(&source->references, &references, count)) return count;
+	os_free_sized(count, sizeof(size_t));
+	return references;
+}
+
+R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_share(R_MutableData* self, R_MutableData* source) {
+	if (R_Type_IsNotOf(self, R_MutableData) || R_Type_IsNotOf(source, R_MutableData)) return NULL;
+	if (self == source) return self;
+	if (source->data.size == 0) {
+		R_MutableData_Destructor(self);
+		return self;
+	}
+	size_t* references = R_MutableData_shareCount(source);
+	if (references == NULL) return NULL;
+	if (self->references == references) return self;
+	R_MutableData_retain(references);
+	R_MutableData_Destructor(self);
+	self->data = source->data;
+	self->allocated_buffer = source->allocated_buffer;
+	self->allocated_size = source->allocated_size;
+	self->references = references;
+	return self;
+}
+
+/*  R_MutableData_detach
+    Called before anything is written into the buffer. If it's shared, this array gets its own copy of its bytes, with
+   room for space_needed more, and lets go of the shared one. Returns false if the copy couldn't be allocated.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_MutableData_detach(R_MutableData* self, size_t space_needed) {
+	if (self->references == NULL) return true;
+	if (R_MutableData_isLastReference(self->references)) {
+		//Everyone else let go, so the buffer is ours again
+		os_free_sized(self->references, sizeof(size_t));
+		self->references = NULL;
+		return true;
+	}
+	size_t size = self->data.size;
+	size_t allocated_size = (size + space_needed > 0) ? size + space_needed : 1;
+	uint8_t* buffer = (uint8_t*)os_malloc(allocated_size);
+	if (buffer == NULL) return false;
+	if (size) os_memcpy(buffer, self->data.bytes, size);
+	R_MutableData_Destructor(self);
+	self->data.bytes = self->allocated_buffer = buffer;
+	self->data.size = size;
+	self->allocated_size = allocated_size;
+	return true;
+}
+
+static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_Mover(R_MutableData* self, R_MutableData* new) {
+	return R_MutableData_take(new, self);
+}
+
+R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_take(R_MutableData* self, R_MutableData* source) {
+	if (R_Type_IsNotOf(self, R_MutableData) || R_Type_IsNotOf(source, R_MutableData)) return NULL;
+	if (self == source) return self;
+	R_MutableData_Destructor(self);
+	self->data = source->data;
+	self->allocated_buffer = source->allocated_buffer;
+	self->allocated_size = source->allocated_size;
+	self->references = source->references;
+	R_MutableData_Constructor(source);
+	return self;
 }
 
 R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_reset(R_MutableData* self) {
 	if (R_Type_IsNotOf(self, R_MutableData)) return NULL;
-	self->data.bytes = self->allocated_buffer = (uint8_t*)os_realloc(self->allocated_buffer, 128*sizeof(uint8_t));
+	if (self->references != NULL) R_MutableData_Destructor(self);
+	self->data.bytes = self->allocated_buffer = (uint8_t*)os_realloc_sized(self->allocated_buffer, self->allocated_size, 128*sizeof(uint8_t));
 	self->allocated_size = 128;
 	self->data.size = 0;
 	return self;
 }
 
-static void R_FUNCTION_ATTRIBUTES R_MutableData_increaseAllocationIfNeeded(R_MutableData* self, size_t space_needed) {
-	if (R_Type_IsNotOf(self, R_MutableData)) return;
+//Returns NULL, leaving the array as it was, if the buffer can't be detached or grown
+static R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_increaseAllocationIfNeeded(R_MutableData* self, size_t space_needed) {
+	if (R_Type_IsNotOf(self, R_MutableData) || R_MutableData_detach(self, space_needed) == false) return NULL;
 	size_t bytes_used_in_buffer = (size_t)(self->data.bytes - self->allocated_buffer) + self->data.size;
 	if (self->allocated_size < bytes_used_in_buffer + space_needed) {
-		self->allocated_size = bytes_used_in_buffer + space_needed;
 		size_t head_offset = self->data.bytes - self->allocated_buffer;
-		self->allocated_buffer = (uint8_t*)os_realloc(self->allocated_buffer, self->allocated_size);
+		uint8_t* buffer = (uint8_t*)os_realloc_sized(self->allocated_buffer, self->allocated_size, bytes_used_in_buffer + space_needed);
+		if (buffer == NULL) return NULL;
+		self->allocated_buffer = buffer;
+		self->allocated_size = bytes_used_in_buffer + space_needed;
 		self->data.bytes = self->allocated_buffer + head_offset;
 	}
+	return self;
 }
 
 R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_appendByte(R_MutableData* self, uint8_t byte) {
-	if (R_Type_IsNotOf(self, R_MutableData)) return NULL;
-	R_MutableData_increaseAllocationIfNeeded(self, sizeof(uint8_t));
+	if (R_MutableData_increaseAllocationIfNeeded(self, sizeof(uint8_t)) == NULL) return NULL;
 	self->data.bytes[self->data.size++] = byte;
 	return self;
 }
 
 R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_appendCArray(R_MutableData* self, const uint8_t* bytes, size_t count) {
 	if (R_Type_IsNotOf(self, R_MutableData) || bytes == NULL || count == 0) return NULL;
-	R_MutableData_increaseAllocationIfNeeded(self, count*sizeof(uint8_t));
+	if (R_MutableData_increaseAllocationIfNeeded(self, count*sizeof(uint8_t)) == NULL) return NULL;
 	os_memcpy(self->data.bytes+self->data.size, bytes, count*sizeof(uint8_t));
 	self->data.size+=count*sizeof(uint8_t);
 	return self;
@@ -95,13 +201,13 @@ uint8_t R_FUNCTION_ATTRIBUTES R_MutableData_pop(R_MutableData* self) {
 }
 
 R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_unshift(R_MutableData* self, uint8_t byte) {
-	if (R_Type_IsNotOf(self, R_MutableData)) return NULL;
+	if (R_Type_IsNotOf(self, R_MutableData) || R_MutableData_detach(self, sizeof(uint8_t)) == false) return NULL;
 	if (self->data.bytes > self->allocated_buffer) {
 		self->data.bytes--;
 		*self->data.bytes = byte;
 	}
 	else {
-		R_MutableData_increaseAllocationIfNeeded(self, sizeof(uint8_t));
+		if (R_MutableData_increaseAllocationIfNeeded(self, sizeof(uint8_t)) == NULL) return NULL;
 		for (size_t i=self->data.size; i>0; i--) {
 			self->data.bytes[i] = self->data.bytes[i-1];
 		}
@@ -119,11 +225,21 @@ uint8_t R_FUNCTION_ATTRIBUTES R_MutableData_shift(R_MutableData* self) {
 	return byte;
 }
 
+R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_shiftBytes(R_MutableData* self, size_t count) {
+	if (R_Type_IsNotOf(self, R_MutableData)) return NULL;
+	if (count > self->data.size) count = self->data.size;
+	self->data.bytes += count;
+	self->data.size -= count;
+	if (self->data.size == 0) self->data.bytes = self->allocated_buffer;
+	return self;
+}
+
 R_MutableData* R_FUNCTION_ATTRIBUTES R_MutableData_moveSubArray(R_MutableData* self, R_MutableData* array, size_t start, size_t length) {
 	if (R_Type_IsNotOf(self, R_MutableData) || R_Type_IsNotOf(array, R_MutableData)) return NULL;
 	if (start+length > R_MutableData_size(array)) return NULL;
 	if (length == 0) length = R_MutableData_size(array) - start;
-	R_MutableData_appendCArray(self, R_MutableData_bytes(array)+start, length);
+	if (length > 0 && R_MutableData_appendCArray(self, R_MutableData_bytes(array)+start, length) == NULL) return NULL;
+	if (R_MutableData_detach(array, 0) == false) return NULL;
 
 	size_t remainingBytes = R_MutableData_size(array) - (start + length);
 	for (int i=0; i<remainingBytes; i++) {
@@ -141,3 +141,12 @@ int R_FUNCTION_ATTRIBUTES R_MutableData_compareWithCArray(const R_MutableData* s
   if (R_MutableData_size(self) > bytes) return -1;
   return os_memcmp(R_MutableData_bytes(self), comparor, bytes);
 }
+
+int R_FUNCTION_ATTRIBUTES R_MutableData_order(const R_MutableData* self, const R_MutableData* comparor) {
+  size_t self_size = R_MutableData_size(self);
+  size_t comparor_size = R_MutableData_size(comparor);
+  size_t shortest = self_size < comparor_size ? self_size : comparor_size;
+  int order = shortest ? os_memcmp(R_MutableData_bytes(self), R_MutableData_bytes(comparor), shortest) : 0;
+  if (order != 0) return order;
+  return (self_size > comparor_size) - (self_size < comparor_size);
+}
@@ -6,20 +6,34 @@
 struct R_MutableString {
 	R_Type* type;
 	char* cstring;              //A buffer to store a cstring conversion, if it's needed
+	size_t cstring_size;        //Bytes allocated for cstring, so it can be freed with its size
 	R_MutableData* array;         //Array of characters
 };
 
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Constructor(R_MutableString* self);
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Destructor(R_MutableString* self);
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Copier(R_MutableString* self, R_MutableString* new);
+static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Mover(R_MutableString* self, R_MutableString* new);
 static R_JumpTable_Entry methods[] = {
   R_JumpTable_Entry_Make(R_Stringify, R_MutableString_stringify), 
   R_JumpTable_Entry_Make(R_Equals, R_MutableString_isSame),
+  R_JumpTable_Entry_Make(R_Compare, R_MutableString_order),
   R_JumpTable_Entry_NULL
 };
-R_Type_Def(R_MutableString, R_MutableString_Constructor, R_MutableString_Destructor, R_MutableString_Copier, methods);
+R_Type_Define(R_MutableString,
+  .ctor = (R_Type_Constructor)R_MutableString_Constructor,
+  .dtor = (R_Type_Destructor)R_MutableString_Destructor,
+  .copy = (R_Type_Copier)R_MutableString_Copier,
+  .move = (R_Type_Mover)R_MutableString_Mover,
+  .interfaces = methods);
 
 
+static void R_FUNCTION_ATTRIBUTES R_MutableString_freeCString(R_MutableString* self) {
+	os_free_sized(self->cstring, self->cstring_size);
+	self->cstring = NULL;
+	self->cstring_size = 0;
+}
+
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Constructor(R_MutableString* self) {
 	self->cstring = NULL;
 	self->array = R_Type_New(R_MutableData);
@@ -27,20 +41,30 @@ static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Constructor(R_Muta
 	return self;
 }
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Destructor(R_MutableString* self) {
-	os_free(self->cstring);
+	R_MutableString_freeCString(self);
 	R_Type_Delete(self->array);
 	return self;
 }
 static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Copier(R_MutableString* self, R_MutableString* new) {
-	R_MutableString_appendString(new, self);
+	if (R_MutableData_share(new->array, self->array) == NULL) return NULL;
 	return new;
 }
+static R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_Mover(R_MutableString* self, R_MutableString* new) {
+	return R_MutableString_take(new, self);
+}
+
+R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_take(R_MutableString* self, R_MutableString* source) {
+	if (R_Type_IsNotOf(self, R_MutableString) || R_Type_IsNotOf(source, R_MutableString)) return NULL;
+	if (self == source) return self;
+	R_MutableString_freeCString(self);
+	if (R_MutableData_take(self->array, source->array) == NULL) return NULL;
+	return self;
+}
 
 
 R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_reset(R_MutableString* self) {
 	if (self == NULL) return NULL;
-	os_free(self->cstring);
-	self->cstring = NULL;
+	R_MutableString_freeCString(self);
 	R_MutableData_reset(self->array);
 
 	return self;
@@ -48,8 +72,10 @@ R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_reset(R_MutableString* se
 
 const char* R_FUNCTION_ATTRIBUTES R_MutableString_getString(R_MutableString* self) {
 	if (R_Type_IsNotOf(self, R_MutableString)) return NULL;
-	if (self->cstring != NULL) os_free(self->cstring);
+	R_MutableString_freeCString(self);
 	self->cstring = (char*)os_malloc((R_MutableData_size(self->array)+1)*sizeof(char));
+	if (self->cstring == NULL) return NULL;
+	self->cstring_size = (R_MutableData_size(self->array)+1)*sizeof(char);
 	os_memcpy(self->cstring, R_MutableData_bytes(self->array), R_MutableData_size(self->array));
 	self->cstring[R_MutableData_size(self->array)] = '\0';
 	return self->cstring;
@@ -115,6 +141,11 @@ bool R_FUNCTION_ATTRIBUTES R_MutableString_compare(const R_MutableString* self,
 	return (R_MutableData_compareWithCArray(self->array, (uint8_t*)comparor, os_strlen(comparor)) == 0);
 }
 
+int R_FUNCTION_ATTRIBUTES R_MutableString_order(const R_MutableString* self, const R_MutableString* comparor) {
+	if (self == NULL || comparor == NULL) return (self != NULL) - (comparor != NULL);
+	return R_MutableData_order(self->array, comparor->array);
+}
+
 R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendString(R_MutableString* self, R_MutableString* string) {
   if (self == NULL || string == NULL) return NULL;
   if (R_MutableData_appendArray(self->array, string->array) == NULL) return NULL;
@@ -129,6 +160,10 @@ char R_FUNCTION_ATTRIBUTES R_MutableString_shift(R_MutableString* self) {
 	if (self == NULL) return '\0';
 	return R_MutableData_shift(self->array);
 }
+R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_shiftCharacters(R_MutableString* self, size_t count) {
+	if (self == NULL || R_MutableData_shiftBytes(self->array, count) == NULL) return NULL;
+	return self;
+}
 char R_FUNCTION_ATTRIBUTES R_MutableString_last(const R_MutableString* self) {
 	if (self == NULL) return '\0';
 	return R_MutableData_last(self->array);
@@ -30,7 +30,7 @@ R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendInt(R_MutableString
 #ifdef ESP8266
   char characters[10]; //because max value of int32 is 213748364
 #else
-  char characters[os_snprintf(NULL, 0, "%d", value)];
+  char characters[os_snprintf(NULL, 0, "%d", value) + 1];
 #endif
   os_sprintf(characters, "%d", value);
   return R_MutableString_appendCString(self, characters);
@@ -40,12 +40,22 @@ R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendFloat(R_MutableStri
 #ifdef ESP8266
   char characters[14]; //because most digits I've seen from %g is 4.94066e-324
 #else
-  char characters[os_snprintf(NULL, 0, "%g", value)];
+  char characters[os_snprintf(NULL, 0, "%g", value) + 1];
 #endif
   os_sprintf(characters, "%g", value);
   return R_MutableString_appendCString(self, characters);
 }
 
+R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendDouble(R_MutableString* self, double value) {
+#ifdef ESP8266
+  char characters[25]; //because %.17g needs 17 digits plus sign, point and a 4 character exponent
+#else
+  char characters[os_snprintf(NULL, 0, "%.17g", value) + 1];
+#endif
+  os_sprintf(characters, "%.17g", value);
+  return R_MutableString_appendCString(self, characters);
+}
+
 int R_FUNCTION_ATTRIBUTES R_MutableString_getInt(R_MutableString* self) {
   if (R_Type_IsNotOf(self, R_MutableString)) return 0;
   int output = 0;
@@ -74,8 +84,15 @@ bool R_FUNCTION_ATTRIBUTES R_MutableString_isEmpty(R_MutableString* self) {
 R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendStringAsJson(R_MutableString* self, R_MutableString* string) {
   R_MutableString_appendCString(self, "\"");
 
-  for (int i=0; i<R_MutableString_length(string); i++) {
-    char character = R_MutableString_getString(string)[i];
+  //Runs of characters that don't need escaping are appended in one go. This used to copy the whole string per character.
+  const unsigned char* characters = R_MutableData_bytes(R_MutableString_bytes(string));
+  size_t length = R_MutableString_length(string);
+  size_t start = 0;
+  for (size_t i=0; i<length; i++) {
+    unsigned char character = characters[i];
+    if (character >= 0x20 && character != '"' && character != '\\' && character != '/') continue;
+    if (i > start) R_MutableString_appendBytes(self, (const char*)characters + start, i - start);
+    start = i + 1;
     if (character == '"')  {R_MutableString_appendCString(self, "\\\""); continue;}
     if (character == '\\') {R_MutableString_appendCString(self, "\\\\"); continue;}
     if (character == '/')  {R_MutableString_appendCString(self, "\\/");  continue;}
@@ -84,9 +101,12 @@ R_MutableString* R_FUNCTION_ATTRIBUTES R_MutableString_appendStringAsJson(R_Muta
     if (character == '\n') {R_MutableString_appendCString(self, "\\n");  continue;}
     if (character == '\r') {R_MutableString_appendCString(self, "\\r");  continue;}
     if (character == '\t') {R_MutableString_appendCString(self, "\\t");  continue;}
-    if (character < 0x1f) continue;
-    R_MutableString_appendBytes(self, &character, 1);
+    //Every other control character has no short escape
+    char escaped[7];
+    os_snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+    R_MutableString_appendCString(self, escaped);
   }
+  if (length > start) R_MutableString_appendBytes(self, (const char*)characters + start, length - start);
 
   R_MutableString_appendCString(self, "\"");
   return self;
@@ -123,21 +143,19 @@ R_List* R_FUNCTION_ATTRIBUTES R_MutableString_split(R_MutableString* self, const
   if (R_MutableString_length(self) == 0) return NULL;
   if (seperator == NULL) seperator = "\n";
 
-  R_MutableString* copy = R_Type_Copy(self);
-
-  while (R_MutableString_length(copy) > 0) {
+  //Walks the bytes once instead of searching and removing from a copy, which was quadratic in the number of lines
+  const char* bytes = (const char*)R_MutableData_bytes(R_MutableString_bytes(self));
+  size_t length = R_MutableString_length(self);
+  size_t seperator_length = os_strlen(seperator);
+  size_t start = 0;
+  while (start < length) {
+    size_t end = start;
+    while (end < length && (seperator_length == 0 || end + seperator_length > length || os_memcmp(bytes + end, seperator, seperator_length) != 0)) end++;
     R_MutableString* this_splice = R_List_add(output, R_MutableString);
-    int splice_length = R_MutableString_find(copy, seperator);
-    if (splice_length < 0) {
-      R_MutableString_appendString(this_splice, copy);
-      R_Type_Delete(copy);
-      return output;
-    }
-    if (splice_length > 0) R_MutableString_moveSubstring(copy, this_splice, 0, splice_length);
-    for (int i=0; i<os_strlen(seperator); i++) R_MutableString_shift(copy);
+    if (this_splice == NULL) return NULL;
+    if (end > start) R_MutableString_appendBytes(this_splice, bytes + start, end - start);
+    start = end + seperator_length;
   }
-
-  R_Type_Delete(copy);
   return output;
 }
 
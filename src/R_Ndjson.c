@@ -0,0 +1,148 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_Ndjson.h"
+
+/*  R_Ndjson_Reader
+    State shared by both readers. line is reused for every record, so it only grows to the longest line.
+ */
+typedef struct {
+  R_Dictionary* record;
+  R_MutableString* line;
+  uint32_t options;
+  R_Ndjson_Callback callback;
+  void* context;
+  size_t count;
+  bool stopped;
+} R_Ndjson_Reader;
+
+static bool R_FUNCTION_ATTRIBUTES R_Ndjson_isWhitespace(char character) {
+  return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Ndjson_readLine(R_Ndjson_Reader* reader, const char* bytes, size_t length) {
+  while (length > 0 && R_Ndjson_isWhitespace(bytes[length - 1])) length--;
+  while (length > 0 && R_Ndjson_isWhitespace(*bytes)) bytes++, length--;
+  if (length == 0) return;
+  R_MutableString_shiftCharacters(reader->line, R_MutableString_length(reader->line));
+  if (R_MutableString_appendBytes(reader->line, bytes, length) == NULL) return;
+  if (R_Dictionary_readJson(reader->record, reader->line, reader->options) == NULL || R_MutableString_length(reader->line) > 0) return;
+  reader->count++;
+  if (!reader->callback(reader->record, reader->context)) reader->stopped = true;
+}
+
+/*  R_Ndjson_readLines
+    Reads every complete line in bytes and returns the length of what's left after the last newline.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_Ndjson_readLines(R_Ndjson_Reader* reader, const char* bytes, size_t size) {
+  size_t start = 0;
+  for (size_t index=0; index<size && !reader->stopped; index++) {
+    if (bytes[index] != '\n') continue;
+    R_Ndjson_readLine(reader, bytes + start, index - start);
+    start = index + 1;
+  }
+  return size - start;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Ndjson_each(R_Dictionary* record, const char* bytes, size_t size, uint32_t options, R_Ndjson_Callback callback, void* context) {
+  if (R_Type_IsNotOf(record, R_Dictionary) || (bytes == NULL && size > 0) || callback == NULL) return 0;
+  R_Ndjson_Reader reader = {record, R_Type_New(R_MutableString), options, callback, context, 0, false};
+  if (reader.line == NULL) return 0;
+  size_t remaining = R_Ndjson_readLines(&reader, bytes, size);
+  if (!reader.stopped) R_Ndjson_readLine(&reader, bytes + size - remaining, remaining);
+  R_Type_Delete(reader.line);
+  return reader.count;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Ndjson_eachFromFd(R_Dictionary* record, int fd, uint32_t options, R_Ndjson_Callback callback, void* context) {
+  if (R_Type_IsNotOf(record, R_Dictionary) || callback == NULL) return 0;
+  R_Ndjson_Reader reader = {record, R_Type_New(R_MutableString), options, callback, context, 0, false};
+  size_t capacity = R_Ndjson_BlockSize;
+  char* block = os_malloc(capacity);
+  size_t used = 0;
+  while (reader.line != NULL && block != NULL && !reader.stopped) {
+    if (used == capacity) {
+      //A single line fills the whole block
+      char* bigger = os_realloc_sized(block, capacity, capacity * 2);
+      if (bigger == NULL) break;
+      block = bigger;
+      capacity *= 2;
+    }
+    long count = R_OS_read(fd, block + used, capacity - used);
+    if (count <= 0) {
+      if (count == 0) R_Ndjson_readLine(&reader, block, used);
+      break;
+    }
+    size_t scanned = used;
+    used += (size_t)count;
+    //Only the new bytes can hold a newline, so finish the partial line if one arrived
+    size_t newline = scanned;
+    while (newline < used && block[newline] != '\n') newline++;
+    if (newline == used) continue;
+    size_t remaining = R_Ndjson_readLines(&reader, block, used);
+    memmove(block, block + used - remaining, remaining);
+    used = remaining;
+  }
+  os_free_sized(block, capacity);
+  R_Type_Delete(reader.line);
+  return reader.count;
+}
+
+struct R_NdjsonWriter {
+  R_Type* type;
+  R_MutableString* line;
+  R_MutableData* buffer;
+  int fd;
+  size_t flush_size;
+};
+
+static R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_Constructor(R_NdjsonWriter* self);
+static R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_Destructor(R_NdjsonWriter* self);
+R_Type_Def(R_NdjsonWriter, R_NdjsonWriter_Constructor, R_NdjsonWriter_Destructor, NULL, NULL);
+
+static R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_Constructor(R_NdjsonWriter* self) {
+  self->line = R_Type_New(R_MutableString);
+  self->buffer = R_Type_New(R_MutableData);
+  self->fd = -1;
+  self->flush_size = R_Ndjson_BlockSize;
+  if (self->line == NULL || self->buffer == NULL) return R_NdjsonWriter_Destructor(self), NULL;
+  return self;
+}
+
+static R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_Destructor(R_NdjsonWriter* self) {
+  R_NdjsonWriter_flush(self);
+  R_Type_DeleteAndNull(self->line);
+  R_Type_DeleteAndNull(self->buffer);
+  return self;
+}
+
+R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_setFd(R_NdjsonWriter* self, int fd, size_t flush_size) {
+  if (R_Type_IsNotOf(self, R_NdjsonWriter)) return NULL;
+  R_NdjsonWriter_flush(self);
+  self->fd = fd;
+  self->flush_size = flush_size ? flush_size : R_Ndjson_BlockSize;
+  return self;
+}
+
+R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_write(R_NdjsonWriter* self, R_Dictionary* record) {
+  if (R_Type_IsNotOf(self, R_NdjsonWriter) || R_Type_IsNotOf(record, R_Dictionary)) return NULL;
+  if (R_Dictionary_toJson(record, self->line) == NULL) return NULL;
+  R_MutableData_appendArray(self->buffer, R_MutableString_bytes(self->line));
+  R_MutableData_appendByte(self->buffer, '\n');
+  if (self->fd >= 0 && R_MutableData_size(self->buffer) >= self->flush_size) return R_NdjsonWriter_flush(self);
+  return self;
+}
+
+R_NdjsonWriter* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_flush(R_NdjsonWriter* self) {
+  if (R_Type_IsNotOf(self, R_NdjsonWriter)) return NULL;
+  if (self->fd < 0 || R_MutableData_size(self->buffer) == 0) return self;
+  if (!R_OS_write(self->fd, R_MutableData_bytes(self->buffer), R_MutableData_size(self->buffer))) return NULL;
+  R_MutableData_shiftBytes(self->buffer, R_MutableData_size(self->buffer));
+  return self;
+}
+
+R_MutableData* R_FUNCTION_ATTRIBUTES R_NdjsonWriter_buffer(R_NdjsonWriter* self) {
+  if (R_Type_IsNotOf(self, R_NdjsonWriter)) return NULL;
+  return self->buffer;
+}
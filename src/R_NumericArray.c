@@ -0,0 +1,164 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_NumericArray.h"
+
+/*  R_NumericArray_Define
+    Generates the struct, R_Type definition and methods for one numeric array type. The reductions keep four
+   independent accumulators so the compiler can keep them in vector registers instead of waiting on one long
+   dependency chain.
+ */
+#define R_NumericArray_Define(Name, value_t, sum_t, format) \
+struct Name { \
+  R_Type* type; \
+  value_t* values; \
+  size_t size; \
+  size_t allocated; \
+}; \
+static Name* R_FUNCTION_ATTRIBUTES Name##_Constructor(Name* self) { \
+  self->values = NULL; \
+  self->size = self->allocated = 0; \
+  return self; \
+} \
+static Name* R_FUNCTION_ATTRIBUTES Name##_Destructor(Name* self) { \
+  os_free_sized(self->values, self->allocated*sizeof(value_t)); \
+  self->values = NULL; \
+  self->size = self->allocated = 0; \
+  return self; \
+} \
+static Name* R_FUNCTION_ATTRIBUTES Name##_Copier(Name* self, Name* new) { \
+  if (self->size > 0 && Name##_appendCArray(new, self->values, self->size) == NULL) return R_Type_Delete(new), NULL; \
+  return new; \
+} \
+static R_JumpTable_Entry Name##_methods[] = { \
+  R_JumpTable_Entry_Make(R_Stringify, Name##_stringify), \
+  R_JumpTable_Entry_Make(R_Equals, Name##_isSame), \
+  R_JumpTable_Entry_NULL \
+}; \
+R_Type_Def(Name, Name##_Constructor, Name##_Destructor, Name##_Copier, Name##_methods); \
+\
+Name* R_FUNCTION_ATTRIBUTES Name##_reserve(Name* self, size_t count) { \
+  if (R_Type_IsNotOf(self, Name)) return NULL; \
+  if (count <= self->allocated) return self; \
+  value_t* values = (value_t*)os_realloc_sized(self->values, self->allocated*sizeof(value_t), count*sizeof(value_t)); \
+  if (values == NULL) return NULL; \
+  self->values = values; \
+  self->allocated = count; \
+  return self; \
+} \
+static Name* R_FUNCTION_ATTRIBUTES Name##_increaseAllocationIfNeeded(Name* self, size_t space_needed) { \
+  if (self->size + space_needed <= self->allocated) return self; \
+  size_t allocated = self->allocated ? self->allocated*2 : 8; \
+  while (allocated < self->size + space_needed) allocated *= 2; \
+  return Name##_reserve(self, allocated); \
+} \
+Name* R_FUNCTION_ATTRIBUTES Name##_append(Name* self, value_t value) { \
+  if (R_Type_IsNotOf(self, Name)) return NULL; \
+  if (Name##_increaseAllocationIfNeeded(self, 1) == NULL) return NULL; \
+  self->values[self->size++] = value; \
+  return self; \
+} \
+Name* R_FUNCTION_ATTRIBUTES Name##_appendCArray(Name* self, const value_t* values, size_t count) { \
+  if (R_Type_IsNotOf(self, Name) || values == NULL) return NULL; \
+  if (Name##_increaseAllocationIfNeeded(self, count) == NULL) return NULL; \
+  os_memcpy(self->values + self->size, values, count*sizeof(value_t)); \
+  self->size += count; \
+  return self; \
+} \
+value_t R_FUNCTION_ATTRIBUTES Name##_get(Name* self, size_t index) { \
+  if (R_Type_IsNotOf(self, Name) || index >= self->size) return 0; \
+  return self->values[index]; \
+} \
+Name* R_FUNCTION_ATTRIBUTES Name##_set(Name* self, size_t index, value_t value) { \
+  if (R_Type_IsNotOf(self, Name) || index >= self->size) return NULL; \
+  self->values[index] = value; \
+  return self; \
+} \
+const value_t* R_FUNCTION_ATTRIBUTES Name##_values(Name* self) { \
+  if (R_Type_IsNotOf(self, Name)) return NULL; \
+  return self->values; \
+} \
+size_t R_FUNCTION_ATTRIBUTES Name##_size(Name* self) { \
+  if (R_Type_IsNotOf(self, Name)) return 0; \
+  return self->size; \
+} \
+Name* R_FUNCTION_ATTRIBUTES Name##_reset(Name* self) { \
+  if (R_Type_IsNotOf(self, Name)) return NULL; \
+  self->size = 0; \
+  return self; \
+} \
+sum_t R_FUNCTION_ATTRIBUTES Name##_sum(Name* self) { \
+  if (R_Type_IsNotOf(self, Name)) return 0; \
+  const value_t* values = self->values; \
+  size_t size = self->size; \
+  sum_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0; \
+  size_t index = 0; \
+  for (; index+4 <= size; index += 4) { \
+    sum0 += values[index]; \
+    sum1 += values[index+1]; \
+    sum2 += values[index+2]; \
+    sum3 += values[index+3]; \
+  } \
+  for (; index < size; index++) sum0 += values[index]; \
+  return (sum0 + sum1) + (sum2 + sum3); \
+} \
+value_t R_FUNCTION_ATTRIBUTES Name##_min(Name* self) { \
+  if (R_Type_IsNotOf(self, Name) || self->size == 0) return 0; \
+  const value_t* values = self->values; \
+  size_t size = self->size; \
+  value_t min0 = values[0], min1 = values[0], min2 = values[0], min3 = values[0]; \
+  size_t index = 0; \
+  for (; index+4 <= size; index += 4) { \
+    min0 = values[index] < min0 ? values[index] : min0; \
+    min1 = values[index+1] < min1 ? values[index+1] : min1; \
+    min2 = values[index+2] < min2 ? values[index+2] : min2; \
+    min3 = values[index+3] < min3 ? values[index+3] : min3; \
+  } \
+  for (; index < size; index++) min0 = values[index] < min0 ? values[index] : min0; \
+  min0 = min1 < min0 ? min1 : min0; \
+  min2 = min3 < min2 ? min3 : min2; \
+  return min2 < min0 ? min2 : min0; \
+} \
+value_t R_FUNCTION_ATTRIBUTES Name##_max(Name* self) { \
+  if (R_Type_IsNotOf(self, Name) || self->size == 0) return 0; \
+  const value_t* values = self->values; \
+  size_t size = self->size; \
+  value_t max0 = values[0], max1 = values[0], max2 = values[0], max3 = values[0]; \
+  size_t index = 0; \
+  for (; index+4 <= size; index += 4) { \
+    max0 = values[index] > max0 ? values[index] : max0; \
+    max1 = values[index+1] > max1 ? values[index+1] : max1; \
+    max2 = values[index+2] > max2 ? values[index+2] : max2; \
+    max3 = values[index+3] > max3 ? values[index+3] : max3; \
+  } \
+  for (; index < size; index++) max0 = values[index] > max0 ? values[index] : max0; \
+  max0 = max1 > max0 ? max1 : max0; \
+  max2 = max3 > max2 ? max3 : max2; \
+  return max2 > max0 ? max2 : max0; \
+} \
+bool R_FUNCTION_ATTRIBUTES Name##_isSame(Name* self, Name* comparor) { \
+  if (R_Type_IsNotOf(self, Name) || R_Type_IsNotOf(comparor, Name)) return false; \
+  if (self->size != comparor->size) return false; \
+  for (size_t index = 0; index < self->size; index++) { \
+    if (self->values[index] != comparor->values[index]) return false; \
+  } \
+  return true; \
+} \
+size_t R_FUNCTION_ATTRIBUTES Name##_stringify(Name* self, char* buffer, size_t size) { \
+  if (R_Type_IsNotOf(self, Name)) return 0; \
+  char* buffer_head = buffer; \
+  for (size_t index = 0; index <= self->size; index++) { \
+    size_t this_size; \
+    if (index == self->size) this_size = os_snprintf(buffer, size, self->size == 0 ? "[]" : "]"); \
+    else this_size = os_snprintf(buffer, size, index == 0 ? "[" format : "," format, self->values[index]); \
+    if (this_size >= size) return buffer - buffer_head; \
+    size -= this_size; \
+    buffer += this_size; \
+  } \
+  return buffer - buffer_head; \
+}
+
+R_NumericArray_Define(R_IntArray, int, int64_t, "%d")
+R_NumericArray_Define(R_FloatArray, float, double, "%g")
+R_NumericArray_Define(R_DoubleArray, double, double, "%g")
@@ -1,16 +1,100 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
 #include "R_OS.h"
+#ifdef R_OS_THREADS
+  #include <unistd.h>
+#endif
+#ifndef ESP8266
+  #include <errno.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
 
-void* R_FUNCTION_ATTRIBUTES os_realloc_alt(void* old_ptr, size_t new_size) {
+void* R_FUNCTION_ATTRIBUTES os_realloc_alt(void* old_ptr, size_t old_size, size_t new_size) {
   void* new_ptr = (void*)os_malloc(new_size);
+  if (new_ptr == NULL) return NULL;
   if (old_ptr) {
-    os_memcpy(new_ptr, old_ptr, new_size); //this should be old_size but we don't have access to it
-    os_free(old_ptr);
+    //Only os_realloc_sized reaches this, so old_size is the real size of the block
+    os_memcpy(new_ptr, old_ptr, old_size < new_size ? old_size : new_size);
+    os_free_sized(old_ptr, old_size);
   }
   return new_ptr;
 }
 
+#ifdef R_OS_ALLOCATOR
+static void* R_Allocator_systemMalloc(void* context, size_t size, const R_Allocator_Site* site) {
+  return malloc(size);
+}
+static void* R_Allocator_systemZalloc(void* context, size_t size, const R_Allocator_Site* site) {
+  return calloc(1, size);
+}
+static void* R_Allocator_systemRealloc(void* context, void* pointer, size_t old_size, size_t size, const R_Allocator_Site* site) {
+  return realloc(pointer, size);
+}
+static void R_Allocator_systemFree(void* context, void* pointer, size_t size, const R_Allocator_Site* site) {
+  free(pointer);
+}
+static const R_Allocator R_Allocator_systemAllocator = {
+  R_Allocator_systemMalloc,
+  R_Allocator_systemZalloc,
+  R_Allocator_systemRealloc,
+  R_Allocator_systemFree,
+  NULL
+};
+static const R_Allocator* R_Allocator_global = &R_Allocator_systemAllocator;
+#ifdef R_OS_THREADS
+static __thread const R_Allocator* R_Allocator_thread = NULL;
+#else
+static const R_Allocator* R_Allocator_thread = NULL;
+#endif
+
+void R_Allocator_set(const R_Allocator* allocator) {
+  R_Allocator_global = allocator ? allocator : &R_Allocator_systemAllocator;
+}
+
+void R_Allocator_setForThread(const R_Allocator* allocator) {
+  R_Allocator_thread = allocator;
+}
+
+const R_Allocator* R_Allocator_get(void) {
+  return R_Allocator_thread ? R_Allocator_thread : R_Allocator_global;
+}
+
+const R_Allocator* R_Allocator_system(void) {
+  return &R_Allocator_systemAllocator;
+}
+
+void* R_Allocator_malloc(size_t size, const char* file, int line, const char* tag) {
+  const R_Allocator* allocator = R_Allocator_get();
+  const R_Allocator_Site site = {file, line, tag};
+  return allocator->malloc(allocator->context, size, &site);
+}
+
+void* R_Allocator_zalloc(size_t size, const char* file, int line, const char* tag) {
+  const R_Allocator* allocator = R_Allocator_get();
+  const R_Allocator_Site site = {file, line, tag};
+  return allocator->zalloc(allocator->context, size, &site);
+}
+
+void* R_Allocator_realloc(void* pointer, size_t old_size, size_t size, const char* file, int line, const char* tag) {
+  const R_Allocator* allocator = R_Allocator_get();
+  const R_Allocator_Site site = {file, line, tag};
+  if (pointer == NULL) old_size = 0;
+  return allocator->realloc(allocator->context, pointer, old_size, size, &site);
+}
+
+void R_Allocator_free(void* pointer, size_t size, const char* file, int line, const char* tag) {
+  if (pointer == NULL) return;
+  const R_Allocator* allocator = R_Allocator_get();
+  const R_Allocator_Site site = {file, line, tag};
+  allocator->free(allocator->context, pointer, size, &site);
+}
+#endif
+
 int R_FUNCTION_ATTRIBUTES os_atoi_alt(const char* string) {
   int index = 0;
   int sign = +1;
@@ -74,3 +158,149 @@ double R_FUNCTION_ATTRIBUTES os_atof_alt(const char *s)
   return output;
 }
 
+size_t R_FUNCTION_ATTRIBUTES R_OS_cpuCount(void) {
+#ifdef R_OS_THREADS
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  if (count > 0) return (size_t)count;
+#endif
+  return 1;
+}
+
+#ifdef R_OS_THREADS
+typedef struct {
+  R_OS_Task task;
+  void* context;
+} R_OS_parallelRun_Thread;
+static void* R_OS_parallelRun_start(void* argument) {
+  R_OS_parallelRun_Thread* thread = (R_OS_parallelRun_Thread*)argument;
+  thread->task(thread->context);
+  return NULL;
+}
+static void R_OS_parallelRun_free(pthread_t* threads, bool* started, R_OS_parallelRun_Thread* arguments, size_t count) {
+  os_free_sized(threads, count*sizeof(pthread_t));
+  os_free_sized(started, count*sizeof(bool));
+  os_free_sized(arguments, count*sizeof(R_OS_parallelRun_Thread));
+}
+#endif
+
+#ifdef R_OS_THREADS
+  #define R_OS_loadDispatcher(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+  #define R_OS_storeDispatcher(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+#else
+  #define R_OS_loadDispatcher(pointer) (*(pointer))
+  #define R_OS_storeDispatcher(pointer, value) (*(pointer) = (value))
+#endif
+
+static const R_OS_Dispatcher* R_OS_installedDispatcher = NULL;
+
+void R_FUNCTION_ATTRIBUTES R_OS_setDispatcher(const R_OS_Dispatcher* dispatcher) {
+  R_OS_storeDispatcher(&R_OS_installedDispatcher, dispatcher);
+}
+
+const R_OS_Dispatcher* R_FUNCTION_ATTRIBUTES R_OS_dispatcher(void) {
+  return R_OS_loadDispatcher(&R_OS_installedDispatcher);
+}
+
+void R_FUNCTION_ATTRIBUTES R_OS_parallelRun(R_OS_Task task, void** contexts, size_t count) {
+  if (task == NULL || contexts == NULL) return;
+  const R_OS_Dispatcher* dispatcher = R_OS_loadDispatcher(&R_OS_installedDispatcher);
+  if (dispatcher != NULL && count > 1 && dispatcher->run(dispatcher->context, task, contexts, count)) return;
+#ifdef R_OS_THREADS
+  if (count > 1) {
+    pthread_t* threads = (pthread_t*)os_malloc(count*sizeof(pthread_t));
+    bool* started = (bool*)os_zalloc(count*sizeof(bool));
+    R_OS_parallelRun_Thread* arguments = (R_OS_parallelRun_Thread*)os_malloc(count*sizeof(R_OS_parallelRun_Thread));
+    if (threads && started && arguments) {
+      //The calling thread takes the first task itself
+      for (size_t i=1; i<count; i++) {
+        arguments[i].task = task;
+        arguments[i].context = contexts[i];
+        started[i] = (pthread_create(&threads[i], NULL, R_OS_parallelRun_start, &arguments[i]) == 0);
+      }
+      task(contexts[0]);
+      for (size_t i=1; i<count; i++) {
+        if (started[i]) pthread_join(threads[i], NULL);
+        else task(contexts[i]);
+      }
+      R_OS_parallelRun_free(threads, started, arguments, count);
+      return;
+    }
+    R_OS_parallelRun_free(threads, started, arguments, count);
+  }
+#endif
+  for (size_t i=0; i<count; i++) task(contexts[i]);
+}
+
+const void* R_FUNCTION_ATTRIBUTES R_OS_mapFile(const char* path, size_t* size) {
+  if (path == NULL || size == NULL) return NULL;
+  *size = 0;
+#ifndef ESP8266
+  int file = open(path, O_RDONLY);
+  if (file < 0) return NULL;
+  struct stat status;
+  if (fstat(file, &status) != 0 || status.st_size <= 0) return close(file), NULL;
+  void* pointer = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+  close(file); //The mapping keeps its own reference to the file
+  if (pointer == MAP_FAILED) return NULL;
+  *size = (size_t)status.st_size;
+  return pointer;
+#else
+  return NULL;
+#endif
+}
+
+void R_FUNCTION_ATTRIBUTES R_OS_unmapFile(const void* pointer, size_t size) {
+#ifndef ESP8266
+  if (pointer != NULL) munmap((void*)pointer, size);
+#endif
+}
+
+bool R_FUNCTION_ATTRIBUTES R_OS_writeFile(const char* path, const void* bytes, size_t size) {
+  if (path == NULL || (bytes == NULL && size > 0)) return false;
+#ifndef ESP8266
+  size_t path_length = os_strlen(path);
+  char* temporary = (char*)os_malloc(path_length + 5);
+  if (temporary == NULL) return false;
+  os_memcpy(temporary, path, path_length);
+  os_memcpy(temporary + path_length, ".tmp", 5);
+  FILE* file = fopen(temporary, "wb");
+  bool success = file != NULL;
+  if (success) success = fwrite(bytes, 1, size, file) == size;
+  if (file != NULL && fclose(file) != 0) success = false;
+  if (success) success = rename(temporary, path) == 0;
+  if (!success) remove(temporary);
+  os_free_sized(temporary, path_length + 5);
+  return success;
+#else
+  return false;
+#endif
+}
+
+long R_FUNCTION_ATTRIBUTES R_OS_read(int fd, void* buffer, size_t size) {
+  if (buffer == NULL) return -1;
+#ifndef ESP8266
+  ssize_t count = 0;
+  do count = read(fd, buffer, size);
+  while (count < 0 && errno == EINTR);
+  return (long)count;
+#else
+  return -1;
+#endif
+}
+
+bool R_FUNCTION_ATTRIBUTES R_OS_write(int fd, const void* bytes, size_t size) {
+  if (bytes == NULL && size > 0) return false;
+#ifndef ESP8266
+  const char* next = (const char*)bytes;
+  while (size > 0) {
+    ssize_t count = write(fd, next, size);
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) return false;
+    next += count;
+    size -= (size_t)count;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,530 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_OrderedDictionary.h"
+
+//Every node but the root holds between Degree - 1 and 2*Degree - 1 pairs
+#define R_OrderedDictionary_Degree 16
+#define R_OrderedDictionary_MaxPairs (2*R_OrderedDictionary_Degree - 1)
+
+/*  R_OrderedDictionary_Node
+    heads[i] is the first 8 bytes of pairs[i]'s key, big-endian and padded with zeros, so comparing heads as integers
+   orders keys the same way their bytes do until two heads tie. Leaves are allocated without the children array.
+ */
+typedef struct R_OrderedDictionary_Node R_OrderedDictionary_Node;
+struct R_OrderedDictionary_Node {
+  size_t count;
+  bool leaf;
+  uint64_t heads[R_OrderedDictionary_MaxPairs];
+  R_KeyValuePair* pairs[R_OrderedDictionary_MaxPairs];
+  R_OrderedDictionary_Node* children[R_OrderedDictionary_MaxPairs + 1];
+};
+
+//A key being looked up. string is only set for keys given by the caller, and is what a new pair's key is set to.
+typedef struct {
+  const uint8_t* bytes;
+  size_t length;
+  uint64_t head;
+  const char* string;
+} R_OrderedDictionary_Key;
+
+typedef struct {
+  const R_OrderedDictionary_Key* to;
+  const R_OrderedDictionary_Key* prefix;
+  R_OrderedDictionary_Callback callback;
+  void* context;
+  size_t count;
+} R_OrderedDictionary_Visit;
+
+struct R_OrderedDictionary {
+  R_Type* type;
+  R_OrderedDictionary_Node* root;
+  size_t size;
+};
+
+static R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_Destructor(R_OrderedDictionary* self);
+static R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_Copier(R_OrderedDictionary* self, R_OrderedDictionary* new);
+static R_JumpTable_Entry methods[] = {
+  R_JumpTable_Entry_Make(R_Stringify, R_OrderedDictionary_stringify),
+  R_JumpTable_Entry_NULL
+};
+R_Type_Define(R_OrderedDictionary,
+  .dtor = (R_Type_Destructor)R_OrderedDictionary_Destructor,
+  .copy = (R_Type_Copier)R_OrderedDictionary_Copier,
+  .interfaces = methods);
+
+static size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_nodeSize(bool leaf) {
+  return leaf ? offsetof(R_OrderedDictionary_Node, children) : sizeof(R_OrderedDictionary_Node);
+}
+
+static R_OrderedDictionary_Node* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_newNode(bool leaf) {
+  R_OrderedDictionary_Node* node = (R_OrderedDictionary_Node*)os_malloc(R_OrderedDictionary_nodeSize(leaf));
+  if (node == NULL) return NULL;
+  node->count = 0;
+  node->leaf = leaf;
+  return node;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_OrderedDictionary_freeNode(R_OrderedDictionary_Node* node) {
+  os_free_sized(node, R_OrderedDictionary_nodeSize(node->leaf));
+}
+
+//Deletes the node, its subtree and every pair in them
+static void R_FUNCTION_ATTRIBUTES R_OrderedDictionary_deleteNode(R_OrderedDictionary_Node* node) {
+  if (node == NULL) return;
+  for (size_t i=0; i<node->count; i++) R_Type_Delete(node->pairs[i]);
+  for (size_t i=0; !node->leaf && i<=node->count; i++) R_OrderedDictionary_deleteNode(node->children[i]);
+  R_OrderedDictionary_freeNode(node);
+}
+
+static R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_Destructor(R_OrderedDictionary* self) {
+  R_OrderedDictionary_deleteNode(self->root);
+  self->root = NULL;
+  return self;
+}
+
+//Returns a deep copy of the node and its subtree, or NULL if anything in it can't be copied
+static R_OrderedDictionary_Node* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_copyNode(R_OrderedDictionary_Node* node) {
+  R_OrderedDictionary_Node* copy = R_OrderedDictionary_newNode(node->leaf);
+  if (copy == NULL) return NULL;
+  bool failed = false;
+  for (size_t i=0; i<node->count; i++) {
+    copy->heads[i] = node->heads[i];
+    copy->pairs[i] = R_Type_Copy(node->pairs[i]);
+    failed = failed || copy->pairs[i] == NULL;
+  }
+  for (size_t i=0; !node->leaf && i<=node->count; i++) {
+    copy->children[i] = failed ? NULL : R_OrderedDictionary_copyNode(node->children[i]);
+    failed = failed || copy->children[i] == NULL;
+  }
+  //deleteNode skips the slots left NULL
+  copy->count = node->count;
+  if (failed) return R_OrderedDictionary_deleteNode(copy), NULL;
+  return copy;
+}
+
+static R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_Copier(R_OrderedDictionary* self, R_OrderedDictionary* new) {
+  if (self->root == NULL) return new;
+  new->root = R_OrderedDictionary_copyNode(self->root);
+  if (new->root == NULL) return R_Type_Delete(new), NULL;
+  new->size = self->size;
+  return new;
+}
+
+static R_OrderedDictionary_Key R_FUNCTION_ATTRIBUTES R_OrderedDictionary_makeKey(const uint8_t* bytes, size_t length, const char* string) {
+  R_OrderedDictionary_Key key = {bytes, length, 0, string};
+  for (size_t i=0; i<8; i++) key.head = (key.head << 8) | (i < length ? bytes[i] : 0);
+  return key;
+}
+
+static R_OrderedDictionary_Key R_FUNCTION_ATTRIBUTES R_OrderedDictionary_stringKey(const char* string) {
+  return R_OrderedDictionary_makeKey((const uint8_t*)string, strlen(string), string);
+}
+
+static R_OrderedDictionary_Key R_FUNCTION_ATTRIBUTES R_OrderedDictionary_pairKey(R_KeyValuePair* pair) {
+  const R_MutableData* bytes = R_MutableString_bytes(R_KeyValuePair_key(pair));
+  return R_OrderedDictionary_makeKey(R_MutableData_bytes(bytes), R_MutableData_size(bytes), NULL);
+}
+
+//Orders the key in slot index of node against key, looking past the heads only when they tie
+static int R_FUNCTION_ATTRIBUTES R_OrderedDictionary_compare(R_OrderedDictionary_Node* node, size_t index, const R_OrderedDictionary_Key* key) {
+  if (node->heads[index] != key->head) return node->heads[index] < key->head ? -1 : 1;
+  R_OrderedDictionary_Key slot = R_OrderedDictionary_pairKey(node->pairs[index]);
+  int order = memcmp(slot.bytes, key->bytes, slot.length < key->length ? slot.length : key->length);
+  if (order != 0) return order;
+  return (slot.length > key->length) - (slot.length < key->length);
+}
+
+//Returns the first slot whose key isn't less than key, and sets found if it's equal
+static size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_search(R_OrderedDictionary_Node* node, const R_OrderedDictionary_Key* key, bool* found) {
+  size_t low = 0;
+  size_t high = node->count;
+  while (low < high) {
+    size_t middle = low + (high - low)/2;
+    if (R_OrderedDictionary_compare(node, middle, key) < 0) low = middle + 1;
+    else high = middle;
+  }
+  *found = (low < node->count && R_OrderedDictionary_compare(node, low, key) == 0);
+  return low;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_OrderedDictionary_movePairs(R_OrderedDictionary_Node* to, size_t to_index, R_OrderedDictionary_Node* from, size_t from_index, size_t count) {
+  memmove(to->heads + to_index, from->heads + from_index, count*sizeof(uint64_t));
+  memmove(to->pairs + to_index, from->pairs + from_index, count*sizeof(R_KeyValuePair*));
+}
+
+static void R_FUNCTION_ATTRIBUTES R_OrderedDictionary_moveChildren(R_OrderedDictionary_Node* to, size_t to_index, R_OrderedDictionary_Node* from, size_t from_index, size_t count) {
+  memmove(to->children + to_index, from->children + from_index, count*sizeof(R_OrderedDictionary_Node*));
+}
+
+/*  R_OrderedDictionary_split
+    Splits the full child at index in two around its middle pair, which moves up into parent. parent mustn't be full.
+   Returns false if the new node can't be allocated.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_split(R_OrderedDictionary_Node* parent, size_t index) {
+  const size_t half = R_OrderedDictionary_Degree;
+  R_OrderedDictionary_Node* child = parent->children[index];
+  R_OrderedDictionary_Node* right = R_OrderedDictionary_newNode(child->leaf);
+  if (right == NULL) return false;
+  R_OrderedDictionary_movePairs(right, 0, child, half, half - 1);
+  if (!child->leaf) R_OrderedDictionary_moveChildren(right, 0, child, half, half);
+  right->count = half - 1;
+  child->count = half - 1;
+  R_OrderedDictionary_movePairs(parent, index + 1, parent, index, parent->count - index);
+  R_OrderedDictionary_moveChildren(parent, index + 2, parent, index + 1, parent->count - index);
+  R_OrderedDictionary_movePairs(parent, index, child, half - 1, 1);
+  parent->children[index + 1] = right;
+  parent->count++;
+  return true;
+}
+
+/*  R_OrderedDictionary_getOrAdd
+    Returns the pair for key, adding it if it's missing. Full nodes are split on the way down, so there's always room
+   for the new pair where it lands. If pair is given it becomes the new pair, or hands its value to the one already
+   there and is deleted. Returns NULL if memory runs out.
+ */
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_getOrAdd(R_OrderedDictionary* self, const R_OrderedDictionary_Key* key, R_KeyValuePair* pair) {
+  if (self->root == NULL && (self->root = R_OrderedDictionary_newNode(true)) == NULL) return R_Type_Delete(pair), NULL;
+  if (self->root->count == R_OrderedDictionary_MaxPairs) {
+    R_OrderedDictionary_Node* root = R_OrderedDictionary_newNode(false);
+    if (root == NULL) return R_Type_Delete(pair), NULL;
+    root->children[0] = self->root;
+    if (!R_OrderedDictionary_split(root, 0)) return R_OrderedDictionary_freeNode(root), R_Type_Delete(pair), NULL;
+    self->root = root;
+  }
+  R_OrderedDictionary_Node* node = self->root;
+  for (;;) {
+    bool found = false;
+    size_t index = R_OrderedDictionary_search(node, key, &found);
+    if (found) {
+      if (pair == NULL) return node->pairs[index];
+      R_KeyValuePair_moveValue(node->pairs[index], pair);
+      R_Type_Delete(pair);
+      return node->pairs[index];
+    }
+    if (node->leaf) {
+      if (pair == NULL) pair = R_KeyValuePair_setKey(R_Type_New(R_KeyValuePair), key->string);
+      if (pair == NULL) return NULL;
+      R_OrderedDictionary_movePairs(node, index + 1, node, index, node->count - index);
+      node->heads[index] = key->head;
+      node->pairs[index] = pair;
+      node->count++;
+      self->size++;
+      return pair;
+    }
+    if (node->children[index]->count < R_OrderedDictionary_MaxPairs) node = node->children[index];
+    //The child's middle pair moves up into this node, so look through it again
+    else if (!R_OrderedDictionary_split(node, index)) return R_Type_Delete(pair), NULL;
+  }
+}
+
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_find(R_OrderedDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || key == NULL) return NULL;
+  R_OrderedDictionary_Key search = R_OrderedDictionary_stringKey(key);
+  R_OrderedDictionary_Node* node = self->root;
+  while (node != NULL) {
+    bool found = false;
+    size_t index = R_OrderedDictionary_search(node, &search, &found);
+    if (found) return node->pairs[index];
+    node = node->leaf ? NULL : node->children[index];
+  }
+  return NULL;
+}
+
+/*  R_OrderedDictionary_merge
+    Merges the child at index, the pair at index and the child after it into the child at index. Both children hold
+   Degree - 1 pairs, so the merged one is full.
+ */
+static void R_FUNCTION_ATTRIBUTES R_OrderedDictionary_merge(R_OrderedDictionary_Node* node, size_t index) {
+  R_OrderedDictionary_Node* left = node->children[index];
+  R_OrderedDictionary_Node* right = node->children[index + 1];
+  R_OrderedDictionary_movePairs(left, left->count, node, index, 1);
+  R_OrderedDictionary_movePairs(left, left->count + 1, right, 0, right->count);
+  if (!left->leaf) R_OrderedDictionary_moveChildren(left, left->count + 1, right, 0, right->count + 1);
+  left->count += right->count + 1;
+  R_OrderedDictionary_movePairs(node, index, node, index + 1, node->count - index - 1);
+  R_OrderedDictionary_moveChildren(node, index + 1, node, index + 2, node->count - index - 1);
+  node->count--;
+  R_OrderedDictionary_freeNode(right);
+}
+
+/*  R_OrderedDictionary_fill
+    Makes sure the child at index has a pair to spare before a remove goes down into it, by borrowing one through
+   this node from a neighbour or merging with one. Returns the index the child ends up at.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_fill(R_OrderedDictionary_Node* node, size_t index) {
+  R_OrderedDictionary_Node* child = node->children[index];
+  if (child->count >= R_OrderedDictionary_Degree) return index;
+  R_OrderedDictionary_Node* left = index > 0 ? node->children[index - 1] : NULL;
+  R_OrderedDictionary_Node* right = index < node->count ? node->children[index + 1] : NULL;
+  if (left != NULL && left->count >= R_OrderedDictionary_Degree) {
+    R_OrderedDictionary_movePairs(child, 1, child, 0, child->count);
+    R_OrderedDictionary_movePairs(child, 0, node, index - 1, 1);
+    if (!child->leaf) {
+      R_OrderedDictionary_moveChildren(child, 1, child, 0, child->count + 1);
+      child->children[0] = left->children[left->count];
+    }
+    R_OrderedDictionary_movePairs(node, index - 1, left, left->count - 1, 1);
+    left->count--;
+    child->count++;
+    return index;
+  }
+  if (right != NULL && right->count >= R_OrderedDictionary_Degree) {
+    R_OrderedDictionary_movePairs(child, child->count, node, index, 1);
+    if (!child->leaf) child->children[child->count + 1] = right->children[0];
+    R_OrderedDictionary_movePairs(node, index, right, 0, 1);
+    R_OrderedDictionary_movePairs(right, 0, right, 1, right->count - 1);
+    if (!right->leaf) R_OrderedDictionary_moveChildren(right, 0, right, 1, right->count);
+    right->count--;
+    child->count++;
+    return index;
+  }
+  if (right != NULL) {
+    R_OrderedDictionary_merge(node, index);
+    return index;
+  }
+  R_OrderedDictionary_merge(node, index - 1);
+  return index - 1;
+}
+
+//Takes the first or last pair out of the subtree, and sets head to its head
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_detachEdge(R_OrderedDictionary_Node* node, bool last, uint64_t* head) {
+  while (!node->leaf) node = node->children[R_OrderedDictionary_fill(node, last ? node->count : 0)];
+  size_t index = last ? node->count - 1 : 0;
+  R_KeyValuePair* pair = node->pairs[index];
+  *head = node->heads[index];
+  R_OrderedDictionary_movePairs(node, index, node, index + 1, node->count - index - 1);
+  node->count--;
+  return pair;
+}
+
+/*  R_OrderedDictionary_detach
+    Takes the pair for key out of the tree without deleting it, or returns NULL if it isn't there. Every node it goes
+   down into is filled first, so taking a pair out of a leaf never leaves it short.
+ */
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_detach(R_OrderedDictionary_Node* node, const R_OrderedDictionary_Key* key) {
+  for (;;) {
+    bool found = false;
+    size_t index = R_OrderedDictionary_search(node, key, &found);
+    if (!found) {
+      if (node->leaf) return NULL;
+      node = node->children[R_OrderedDictionary_fill(node, index)];
+      continue;
+    }
+    R_KeyValuePair* pair = node->pairs[index];
+    if (node->leaf) {
+      R_OrderedDictionary_movePairs(node, index, node, index + 1, node->count - index - 1);
+      node->count--;
+      return pair;
+    }
+    //An inner pair is replaced by its neighbour in key order, from whichever side can spare one
+    if (node->children[index]->count >= R_OrderedDictionary_Degree) {
+      node->pairs[index] = R_OrderedDictionary_detachEdge(node->children[index], true, &node->heads[index]);
+      return pair;
+    }
+    if (node->children[index + 1]->count >= R_OrderedDictionary_Degree) {
+      node->pairs[index] = R_OrderedDictionary_detachEdge(node->children[index + 1], false, &node->heads[index]);
+      return pair;
+    }
+    R_OrderedDictionary_merge(node, index);
+    node = node->children[index];
+  }
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_isBeyond(R_OrderedDictionary_Node* node, size_t index, const R_OrderedDictionary_Visit* visit) {
+  if (visit->to != NULL && R_OrderedDictionary_compare(node, index, visit->to) >= 0) return true;
+  if (visit->prefix == NULL) return false;
+  R_OrderedDictionary_Key key = R_OrderedDictionary_pairKey(node->pairs[index]);
+  return key.length < visit->prefix->length || memcmp(key.bytes, visit->prefix->bytes, visit->prefix->length) != 0;
+}
+
+/*  R_OrderedDictionary_visitNode
+    Visits the subtree in key order, starting at from if it's given. Only the first child looked at can hold keys
+   before from, so the rest are visited from their start. Returns false once the visit should stop.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_visitNode(R_OrderedDictionary_Node* node, const R_OrderedDictionary_Key* from, R_OrderedDictionary_Visit* visit) {
+  bool found = false;
+  size_t index = from ? R_OrderedDictionary_search(node, from, &found) : 0;
+  for (;; index++) {
+    if (!node->leaf && !found && !R_OrderedDictionary_visitNode(node->children[index], from, visit)) return false;
+    from = NULL;
+    found = false;
+    if (index == node->count) return true;
+    if (R_OrderedDictionary_isBeyond(node, index, visit)) return false;
+    visit->count++;
+    if (!visit->callback(node->pairs[index], visit->context)) return false;
+  }
+}
+
+static size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_visit(R_OrderedDictionary* self, const R_OrderedDictionary_Key* from, R_OrderedDictionary_Visit* visit) {
+  if (self->root != NULL && visit->callback != NULL) R_OrderedDictionary_visitNode(self->root, from, visit);
+  return visit->count;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_addObjectOfType(R_OrderedDictionary* self, const char* key, const R_Type* type) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || key == NULL || type == NULL) return NULL;
+  R_OrderedDictionary_Key search = R_OrderedDictionary_stringKey(key);
+  R_KeyValuePair* pair = R_OrderedDictionary_getOrAdd(self, &search, NULL);
+  if (pair == NULL) return NULL;
+  R_KeyValuePair_setValue(pair, R_Type_NewObjectOfType(type));
+  return R_KeyValuePair_value(pair);
+}
+
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_addCopy(R_OrderedDictionary* self, const char* key, const void* object) {
+  if (object == NULL) return NULL;
+  return R_OrderedDictionary_transferOwnership(self, key, R_Type_Copy(object));
+}
+
+#ifdef R_TYPE_REFCOUNT
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_addShared(R_OrderedDictionary* self, const char* key, void* object) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || key == NULL || object == NULL) return NULL;
+  if (R_OrderedDictionary_transferOwnership(self, key, R_Type_Retain(object)) == NULL) return R_Type_Release(object), NULL;
+  return object;
+}
+#endif
+
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_transferOwnership(R_OrderedDictionary* self, const char* key, void* object) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || key == NULL || object == NULL) return NULL;
+  R_OrderedDictionary_Key search = R_OrderedDictionary_stringKey(key);
+  R_KeyValuePair* pair = R_OrderedDictionary_getOrAdd(self, &search, NULL);
+  if (pair == NULL || R_KeyValuePair_setValue(pair, object) == NULL) return NULL;
+  return object;
+}
+
+//Returns the pair for key, adding it if it's missing, for the setters
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_pairFor(R_OrderedDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || key == NULL) return NULL;
+  R_OrderedDictionary_Key search = R_OrderedDictionary_stringKey(key);
+  return R_OrderedDictionary_getOrAdd(self, &search, NULL);
+}
+
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setInteger(R_OrderedDictionary* self, const char* key, int value) {
+  return R_KeyValuePair_setInteger(R_OrderedDictionary_pairFor(self, key), value) ? self : NULL;
+}
+
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setFloat(R_OrderedDictionary* self, const char* key, float value) {
+  return R_KeyValuePair_setFloat(R_OrderedDictionary_pairFor(self, key), value) ? self : NULL;
+}
+
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setBoolean(R_OrderedDictionary* self, const char* key, bool value) {
+  return R_KeyValuePair_setBoolean(R_OrderedDictionary_pairFor(self, key), value) ? self : NULL;
+}
+
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_setNull(R_OrderedDictionary* self, const char* key) {
+  return R_KeyValuePair_setNull(R_OrderedDictionary_pairFor(self, key)) ? self : NULL;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_get(R_OrderedDictionary* self, const char* key) {
+  R_KeyValuePair* pair = R_OrderedDictionary_find(self, key);
+  if (pair == NULL) return NULL;
+  return R_KeyValuePair_value(pair);
+}
+
+int R_FUNCTION_ATTRIBUTES R_OrderedDictionary_getInteger(R_OrderedDictionary* self, const char* key) {
+  return R_KeyValuePair_getInteger(R_OrderedDictionary_find(self, key));
+}
+
+float R_FUNCTION_ATTRIBUTES R_OrderedDictionary_getFloat(R_OrderedDictionary* self, const char* key) {
+  return R_KeyValuePair_getFloat(R_OrderedDictionary_find(self, key));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_getBoolean(R_OrderedDictionary* self, const char* key) {
+  return R_KeyValuePair_getBoolean(R_OrderedDictionary_find(self, key));
+}
+
+bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_isPresent(R_OrderedDictionary* self, const char* key) {
+  return R_OrderedDictionary_find(self, key) != NULL;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_OrderedDictionary_remove(R_OrderedDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || key == NULL || self->root == NULL) return false;
+  R_OrderedDictionary_Key search = R_OrderedDictionary_stringKey(key);
+  R_KeyValuePair* pair = R_OrderedDictionary_detach(self->root, &search);
+  //Merging the root's last two children leaves it empty, and the tree a level shorter
+  if (self->root->count == 0) {
+    R_OrderedDictionary_Node* root = self->root;
+    self->root = root->leaf ? NULL : root->children[0];
+    R_OrderedDictionary_freeNode(root);
+  }
+  if (pair == NULL) return false;
+  R_Type_Delete(pair);
+  self->size--;
+  return true;
+}
+
+void R_FUNCTION_ATTRIBUTES R_OrderedDictionary_removeAll(R_OrderedDictionary* self) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary)) return;
+  R_OrderedDictionary_deleteNode(self->root);
+  self->root = NULL;
+  self->size = 0;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_size(R_OrderedDictionary* self) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary)) return 0;
+  return self->size;
+}
+
+R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_lowerBound(R_OrderedDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || key == NULL) return NULL;
+  R_OrderedDictionary_Key search = R_OrderedDictionary_stringKey(key);
+  R_KeyValuePair* bound = NULL;
+  R_OrderedDictionary_Node* node = self->root;
+  while (node != NULL) {
+    bool found = false;
+    size_t index = R_OrderedDictionary_search(node, &search, &found);
+    if (found) return node->pairs[index];
+    //Anything in the child below is between the key and this pair, so closer
+    if (index < node->count) bound = node->pairs[index];
+    node = node->leaf ? NULL : node->children[index];
+  }
+  return bound;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_each(R_OrderedDictionary* self, R_OrderedDictionary_Callback callback, void* context) {
+  return R_OrderedDictionary_range(self, NULL, NULL, callback, context);
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_range(R_OrderedDictionary* self, const char* from, const char* to, R_OrderedDictionary_Callback callback, void* context) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary)) return 0;
+  R_OrderedDictionary_Key start = R_OrderedDictionary_stringKey(from ? from : "");
+  R_OrderedDictionary_Key end = R_OrderedDictionary_stringKey(to ? to : "");
+  R_OrderedDictionary_Visit visit = {to ? &end : NULL, NULL, callback, context, 0};
+  return R_OrderedDictionary_visit(self, from ? &start : NULL, &visit);
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_eachWithPrefix(R_OrderedDictionary* self, const char* prefix, R_OrderedDictionary_Callback callback, void* context) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || prefix == NULL) return 0;
+  //Keys with the prefix sort together, starting at the prefix itself
+  R_OrderedDictionary_Key start = R_OrderedDictionary_stringKey(prefix);
+  R_OrderedDictionary_Visit visit = {NULL, &start, callback, context, 0};
+  return R_OrderedDictionary_visit(self, &start, &visit);
+}
+
+R_OrderedDictionary* R_FUNCTION_ATTRIBUTES R_OrderedDictionary_fromJson(R_OrderedDictionary* self, R_MutableString* buffer) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary) || R_Type_IsNotOf(buffer, R_MutableString)) return NULL;
+  R_Dictionary* dictionary = R_Type_New(R_Dictionary);
+  if (R_Dictionary_fromJson(dictionary, buffer) == NULL) return R_Type_Delete(dictionary), NULL;
+  //The parsed pairs move over as they are. Their slots are nulled so deleting the dictionary leaves them alone.
+  R_List* pairs = R_Dictionary_listOfPairs(dictionary);
+  void** pointers = R_List_pointers(pairs);
+  R_OrderedDictionary* result = self;
+  for (size_t i=0; i<R_List_size(pairs); i++) {
+    R_OrderedDictionary_Key key = R_OrderedDictionary_pairKey(pointers[i]);
+    R_KeyValuePair* pair = pointers[i];
+    pointers[i] = NULL;
+    if (R_OrderedDictionary_getOrAdd(self, &key, pair) == NULL) result = NULL;
+  }
+  R_Type_Delete(dictionary);
+  return result;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_OrderedDictionary_stringify(R_OrderedDictionary* self, char* buffer, size_t size) {
+  if (R_Type_IsNotOf(self, R_OrderedDictionary)) return 0;
+  R_MutableString* string = R_Type_New(R_MutableString);
+  R_OrderedDictionary_toJson(self, string);
+  size_t output = R_MutableString_stringify(string, buffer, size);
+  R_Type_Delete(string);
+  return output;
+}
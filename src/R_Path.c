@@ -0,0 +1,429 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "R_OS.h"
+#include "R_Path.h"
+#include "R_List.h"
+#include "R_MutableData.h"
+
+typedef enum {
+  R_Path_Kind_Member = 0, //a key, or a list index if the key is a number
+  R_Path_Kind_Index,
+  R_Path_Kind_Wildcard,
+} R_Path_Kind;
+
+typedef struct {
+  uint32_t kind;
+  uint32_t key; //offset of the NULL-terminated key in keys
+  uint32_t key_length;
+  size_t index; //SIZE_MAX if the step can't index a list
+} R_Path_Step;
+
+struct R_Path {
+  R_Type* type;
+  R_MutableData* steps;
+  R_MutableData* keys;
+};
+
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_Constructor(R_Path* self);
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_Destructor(R_Path* self);
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_Copier(R_Path* self, R_Path* new);
+R_Type_Def(R_Path, R_Path_Constructor, R_Path_Destructor, R_Path_Copier, NULL);
+
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_Constructor(R_Path* self) {
+  self->steps = R_Type_New(R_MutableData);
+  self->keys = R_Type_New(R_MutableData);
+  if (self->steps == NULL || self->keys == NULL) return R_Path_Destructor(self), NULL;
+  return self;
+}
+
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_Destructor(R_Path* self) {
+  R_Type_DeleteAndNull(self->steps);
+  R_Type_DeleteAndNull(self->keys);
+  return self;
+}
+
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_Copier(R_Path* self, R_Path* new) {
+  R_MutableData_appendArray(new->steps, self->steps);
+  R_MutableData_appendArray(new->keys, self->keys);
+  return new;
+}
+
+static const R_Path_Step* R_FUNCTION_ATTRIBUTES R_Path_step(R_Path* self, size_t index) {
+  return (const R_Path_Step*)R_MutableData_bytes(self->steps) + index;
+}
+
+static const char* R_FUNCTION_ATTRIBUTES R_Path_key(R_Path* self, const R_Path_Step* step) {
+  return (const char*)R_MutableData_bytes(self->keys) + step->key;
+}
+
+/*  R_Path_number
+    Returns the value of a canonical decimal index, with no sign or leading zeros, or SIZE_MAX if it isn't one.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_Path_number(const char* text, size_t length) {
+  if (length == 0 || length > 9 || (text[0] == '0' && length > 1)) return SIZE_MAX;
+  size_t number = 0;
+  for (size_t i=0; i<length; i++) {
+    if (text[i] < '0' || text[i] > '9') return SIZE_MAX;
+    number = number * 10 + (size_t)(text[i] - '0');
+  }
+  return number;
+}
+
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_addStep(R_Path* self, R_Path_Kind kind, const R_MutableString* key, size_t index) {
+  R_Path_Step step = {kind, (uint32_t)R_MutableData_size(self->keys), 0, index};
+  if (key != NULL) {
+    const R_MutableData* bytes = R_MutableString_bytes((R_MutableString*)key);
+    step.key_length = (uint32_t)R_MutableData_size(bytes);
+    R_MutableData_appendArray(self->keys, bytes);
+    if (kind == R_Path_Kind_Member) step.index = R_Path_number((const char*)R_MutableData_bytes(bytes), step.key_length);
+  }
+  R_MutableData_appendByte(self->keys, 0);
+  if (R_MutableData_appendCArray(self->steps, (const uint8_t*)&step, sizeof(step)) == NULL) return NULL;
+  return self;
+}
+
+/*  R_Path_compilePointer
+    Splits an RFC 6901 JSON Pointer on '/', unescaping ~0 and ~1 in each reference token.
+ */
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_compilePointer(R_Path* self, const char* path, R_MutableString* key) {
+  while (*path == '/') {
+    path++;
+    R_MutableString_reset(key);
+    for (; *path != '\0' && *path != '/'; path++) {
+      if (*path != '~') R_MutableString_push(key, *path);
+      else if (path[1] == '0') R_MutableString_push(key, '~'), path++;
+      else if (path[1] == '1') R_MutableString_push(key, '/'), path++;
+      else return NULL;
+    }
+    if (R_Path_addStep(self, R_Path_Kind_Member, key, SIZE_MAX) == NULL) return NULL;
+  }
+  return self;
+}
+
+/*  R_Path_compileBracket
+    Reads what's between '[' and ']': a number, '*' or a quoted key. Returns the character after the ']', or NULL.
+ */
+static const char* R_FUNCTION_ATTRIBUTES R_Path_compileBracket(R_Path* self, const char* path, R_MutableString* key) {
+  if (*path == '*' && path[1] == ']') return R_Path_addStep(self, R_Path_Kind_Wildcard, NULL, SIZE_MAX) ? path + 2 : NULL;
+  if (*path == '"' || *path == '\'') {
+    char quote = *path++;
+    R_MutableString_reset(key);
+    for (; *path != '\0' && *path != quote; path++) {
+      if (*path == '\\' && path[1] != '\0') path++;
+      R_MutableString_push(key, *path);
+    }
+    if (*path != quote || path[1] != ']') return NULL;
+    return R_Path_addStep(self, R_Path_Kind_Member, key, SIZE_MAX) ? path + 2 : NULL;
+  }
+  const char* end = path;
+  while (*end >= '0' && *end <= '9') end++;
+  size_t index = R_Path_number(path, (size_t)(end - path));
+  if (*end != ']' || index == SIZE_MAX) return NULL;
+  return R_Path_addStep(self, R_Path_Kind_Index, NULL, index) ? end + 1 : NULL;
+}
+
+static R_Path* R_FUNCTION_ATTRIBUTES R_Path_compileDots(R_Path* self, const char* path, R_MutableString* key) {
+  if (*path == '$') path++;
+  bool first = true;
+  while (*path != '\0') {
+    if (*path == '[') {
+      if ((path = R_Path_compileBracket(self, path + 1, key)) == NULL) return NULL;
+    }
+    else {
+      if (*path == '.') path++;
+      else if (!first) return NULL;
+      if (*path == '*' && (path[1] == '\0' || path[1] == '.' || path[1] == '[')) {
+        if (R_Path_addStep(self, R_Path_Kind_Wildcard, NULL, SIZE_MAX) == NULL) return NULL;
+        path++;
+      }
+      else {
+        R_MutableString_reset(key);
+        for (; *path != '\0' && *path != '.' && *path != '['; path++) R_MutableString_push(key, *path);
+        if (R_MutableString_length(key) == 0) return NULL;
+        if (R_Path_addStep(self, R_Path_Kind_Member, key, SIZE_MAX) == NULL) return NULL;
+      }
+    }
+    first = false;
+  }
+  return self;
+}
+
+R_Path* R_FUNCTION_ATTRIBUTES R_Path_compile(R_Path* self, const char* path) {
+  if (R_Type_IsNotOf(self, R_Path) || path == NULL) return NULL;
+  R_MutableData_reset(self->steps);
+  R_MutableData_reset(self->keys);
+  R_MutableString* key = R_Type_New(R_MutableString);
+  R_Path* result = NULL;
+  if (*path == '\0' || *path == '/') result = R_Path_compilePointer(self, path, key);
+  else result = R_Path_compileDots(self, path, key);
+  R_Type_Delete(key);
+  if (result == NULL) {
+    R_MutableData_reset(self->steps);
+    R_MutableData_reset(self->keys);
+  }
+  return result;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Path_size(R_Path* self) {
+  if (R_Type_IsNotOf(self, R_Path)) return 0;
+  return R_MutableData_size(self->steps) / sizeof(R_Path_Step);
+}
+
+/*  R_Path_walk
+    Follows the steps from index onward. Returns false once the visitor asks to stop.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Path_walk(R_Path* self, size_t index, void* value, R_Path_Visitor visitor, void* context, size_t* count) {
+  if (value == NULL) return true;
+  if (index == R_Path_size(self)) {
+    (*count)++;
+    return visitor(value, context);
+  }
+  const R_Path_Step* step = R_Path_step(self, index);
+  if (step->kind == R_Path_Kind_Wildcard) {
+    if (R_Type_IsOf(value, R_Dictionary)) {
+      R_List* pairs = R_Dictionary_listOfPairs(value);
+      for (size_t i=0; i<R_List_size(pairs); i++) {
+        if (!R_Path_walk(self, index + 1, R_KeyValuePair_value(R_List_pointerAtIndex(pairs, i)), visitor, context, count)) return false;
+      }
+    }
+    else if (R_Type_IsOf(value, R_List)) {
+      for (size_t i=0; i<R_List_size(value); i++) {
+        if (!R_Path_walk(self, index + 1, R_List_pointerAtIndex(value, i), visitor, context, count)) return false;
+      }
+    }
+    return true;
+  }
+  void* child = NULL;
+  if (R_Type_IsOf(value, R_List)) {
+    if (step->index < R_List_size(value)) child = R_List_pointerAtIndex(value, step->index);
+  }
+  else if (step->kind == R_Path_Kind_Member && R_Type_IsOf(value, R_Dictionary)) child = R_Dictionary_get(value, R_Path_key(self, step));
+  return R_Path_walk(self, index + 1, child, visitor, context, count);
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Path_each(R_Path* self, void* root, R_Path_Visitor visitor, void* context) {
+  if (R_Type_IsNotOf(self, R_Path) || visitor == NULL) return 0;
+  size_t count = 0;
+  R_Path_walk(self, 0, root, visitor, context, &count);
+  return count;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Path_get_visitor(void* value, void* context) {
+  *(void**)context = value;
+  return false;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Path_get(R_Path* self, void* root) {
+  void* value = NULL;
+  R_Path_each(self, root, R_Path_get_visitor, &value);
+  return value;
+}
+
+/*  R_Path_Json
+    The document being searched. Every scanner takes the position of the next character and returns the position
+   after what it read, or NULL if the text is malformed.
+ */
+typedef struct {
+  const char* end;
+  R_Path_JsonVisitor visitor;
+  void* context;
+  size_t count;
+  bool stopped;
+} R_Path_Json;
+
+static const char* R_FUNCTION_ATTRIBUTES R_Path_Json_skipWhitespace(R_Path_Json* json, const char* text) {
+  while (text < json->end && (*text == ' ' || *text == '\t' || *text == '\n' || *text == '\r')) text++;
+  return text;
+}
+
+static const char* R_FUNCTION_ATTRIBUTES R_Path_Json_skipString(R_Path_Json* json, const char* text) {
+  for (text++; text < json->end; text++) {
+    if (*text == '\\') text++;
+    else if (*text == '"') return text + 1;
+  }
+  return NULL;
+}
+
+/*  R_Path_Json_skipValue
+    Skips one value. Containers are skipped by counting brackets outside of strings, so their contents aren't checked.
+ */
+static const char* R_FUNCTION_ATTRIBUTES R_Path_Json_skipValue(R_Path_Json* json, const char* text) {
+  if (text >= json->end) return NULL;
+  if (*text == '"') return R_Path_Json_skipString(json, text);
+  if (*text == '{' || *text == '[') {
+    size_t depth = 0;
+    for (; text < json->end; text++) {
+      if (*text == '"') {
+        if ((text = R_Path_Json_skipString(json, text)) == NULL) return NULL;
+        text--;
+      }
+      else if (*text == '{' || *text == '[') depth++;
+      else if ((*text == '}' || *text == ']') && --depth == 0) return text + 1;
+    }
+    return NULL;
+  }
+  const char* start = text;
+  while (text < json->end && *text != ',' && *text != '}' && *text != ']' && *text != ' ' && *text != '\t' && *text != '\n' && *text != '\r') text++;
+  return text > start ? text : NULL;
+}
+
+/*  R_Path_Json_readHex
+    Reads the four hex digits at text, if they're all there before end.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Path_Json_readHex(const char* text, const char* end, uint32_t* value) {
+  if (end - text < 4) return false;
+  *value = 0;
+  for (int i=0; i<4; i++) {
+    char digit = text[i];
+    if (digit >= '0' && digit <= '9') *value = *value << 4 | (uint32_t)(digit - '0');
+    else if (digit >= 'a' && digit <= 'f') *value = *value << 4 | (uint32_t)(digit - 'a' + 10);
+    else if (digit >= 'A' && digit <= 'F') *value = *value << 4 | (uint32_t)(digit - 'A' + 10);
+    else return false;
+  }
+  return true;
+}
+
+/*  R_Path_Json_decodeEscapedCodePoint
+    Decodes the \u escape whose u is at *text into bytes as UTF-8, joining a surrogate pair written as two escapes, and
+   returns how many bytes it wrote. Leaves *text on the last character it used. Consumes the same characters as
+   R_Dictionary_fromJson, so a bad escape decodes to nothing, as it does there.
+ */
+static size_t R_FUNCTION_ATTRIBUTES R_Path_Json_decodeEscapedCodePoint(const char** text, const char* end, char* bytes) {
+  uint32_t code = 0;
+  if (!R_Path_Json_readHex(*text + 1, end, &code)) return 0;
+  *text += 4;
+  if (code >= 0xD800 && code <= 0xDBFF && end - *text > 2 && (*text)[1] == '\\' && (*text)[2] == 'u') {
+    *text += 2;
+    uint32_t low = 0;
+    if (R_Path_Json_readHex(*text + 1, end, &low)) {
+      *text += 4;
+      if (low >= 0xDC00 && low <= 0xDFFF) code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+  }
+  if (code < 0x80) {
+    bytes[0] = (char)code;
+    return 1;
+  }
+  if (code < 0x800) {
+    bytes[0] = (char)(0xC0 | code >> 6);
+    bytes[1] = (char)(0x80 | (code & 0x3F));
+    return 2;
+  }
+  if (code < 0x10000) {
+    bytes[0] = (char)(0xE0 | code >> 12);
+    bytes[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+    bytes[2] = (char)(0x80 | (code & 0x3F));
+    return 3;
+  }
+  bytes[0] = (char)(0xF0 | code >> 18);
+  bytes[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+  bytes[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+  bytes[3] = (char)(0x80 | (code & 0x3F));
+  return 4;
+}
+
+/*  R_Path_Json_keyEquals
+    Compares the quoted key at text, without its quotes, to key. Handles the same escapes as R_Dictionary_fromJson.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Path_Json_keyEquals(const char* text, const char* end, const char* key, size_t key_length) {
+  size_t matched = 0;
+  for (text++; text < end - 1; text++) {
+    char bytes[4] = {*text};
+    size_t length = 1;
+    if (*text == '\\') {
+      switch (*++text) {
+        case 'b': bytes[0] = '\b'; break;
+        case 'f': bytes[0] = '\f'; break;
+        case 'n': bytes[0] = '\n'; break;
+        case 'r': bytes[0] = '\r'; break;
+        case 't': bytes[0] = '\t'; break;
+        case 'u': length = R_Path_Json_decodeEscapedCodePoint(&text, end - 1, bytes); break;
+        default: bytes[0] = *text; break;
+      }
+    }
+    if (key_length - matched < length || memcmp(key + matched, bytes, length) != 0) return false;
+    matched += length;
+  }
+  return matched == key_length;
+}
+
+static const char* R_FUNCTION_ATTRIBUTES R_Path_Json_walk(R_Path* self, R_Path_Json* json, size_t index, const char* text);
+
+static const char* R_FUNCTION_ATTRIBUTES R_Path_Json_walkObject(R_Path* self, R_Path_Json* json, size_t index, const char* text) {
+  const R_Path_Step* step = R_Path_step(self, index);
+  bool matched = false;
+  text = R_Path_Json_skipWhitespace(json, text + 1);
+  if (text < json->end && *text == '}') return text + 1;
+  while (text < json->end && !json->stopped) {
+    const char* key = text;
+    const char* key_end = R_Path_Json_skipString(json, key);
+    if (*key != '"' || key_end == NULL) return NULL;
+    text = R_Path_Json_skipWhitespace(json, key_end);
+    if (text >= json->end || *text != ':') return NULL;
+    text = R_Path_Json_skipWhitespace(json, text + 1);
+    bool match = step->kind == R_Path_Kind_Wildcard;
+    if (step->kind == R_Path_Kind_Member && !matched) match = matched = R_Path_Json_keyEquals(key, key_end, R_Path_key(self, step), step->key_length);
+    if (match) text = R_Path_Json_walk(self, json, index + 1, text);
+    else text = R_Path_Json_skipValue(json, text);
+    if (text == NULL) return NULL;
+    text = R_Path_Json_skipWhitespace(json, text);
+    if (text < json->end && *text == '}') return text + 1;
+    if (text >= json->end || *text != ',') return NULL;
+    text = R_Path_Json_skipWhitespace(json, text + 1);
+  }
+  return json->stopped ? text : NULL;
+}
+
+static const char* R_FUNCTION_ATTRIBUTES R_Path_Json_walkArray(R_Path* self, R_Path_Json* json, size_t index, const char* text) {
+  const R_Path_Step* step = R_Path_step(self, index);
+  text = R_Path_Json_skipWhitespace(json, text + 1);
+  if (text < json->end && *text == ']') return text + 1;
+  for (size_t position=0; text < json->end && !json->stopped; position++) {
+    if (step->kind == R_Path_Kind_Wildcard || position == step->index) text = R_Path_Json_walk(self, json, index + 1, text);
+    else text = R_Path_Json_skipValue(json, text);
+    if (text == NULL) return NULL;
+    text = R_Path_Json_skipWhitespace(json, text);
+    if (text < json->end && *text == ']') return text + 1;
+    if (text >= json->end || *text != ',') return NULL;
+    text = R_Path_Json_skipWhitespace(json, text + 1);
+  }
+  return json->stopped ? text : NULL;
+}
+
+/*  R_Path_Json_walk
+    Follows the steps from index onward through the value at text, and returns the position after the value.
+ */
+static const char* R_FUNCTION_ATTRIBUTES R_Path_Json_walk(R_Path* self, R_Path_Json* json, size_t index, const char* text) {
+  if (json->stopped) return text;
+  if (index == R_Path_size(self)) {
+    const char* end = R_Path_Json_skipValue(json, text);
+    if (end == NULL) return NULL;
+    json->count++;
+    if (!json->visitor(text, (size_t)(end - text), json->context)) json->stopped = true;
+    return end;
+  }
+  if (text < json->end && *text == '{' && R_Path_step(self, index)->kind != R_Path_Kind_Index) return R_Path_Json_walkObject(self, json, index, text);
+  if (text < json->end && *text == '[') return R_Path_Json_walkArray(self, json, index, text);
+  return R_Path_Json_skipValue(json, text);
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Path_eachJson(R_Path* self, R_MutableString* json, R_Path_JsonVisitor visitor, void* context) {
+  if (R_Type_IsNotOf(self, R_Path) || R_Type_IsNotOf(json, R_MutableString) || visitor == NULL) return 0;
+  const char* text = (const char*)R_MutableData_bytes(R_MutableString_bytes(json));
+  R_Path_Json document = {text + R_MutableString_length(json), visitor, context, 0, false};
+  R_Path_Json_walk(self, &document, 0, R_Path_Json_skipWhitespace(&document, text));
+  return document.count;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Path_getJson_visitor(const char* json, size_t length, void* context) {
+  R_MutableString_appendBytes(R_MutableString_reset(context), json, length);
+  return false;
+}
+
+R_MutableString* R_FUNCTION_ATTRIBUTES R_Path_getJson(R_Path* self, R_MutableString* json, R_MutableString* result) {
+  if (R_Type_IsNotOf(result, R_MutableString)) return NULL;
+  if (R_Path_eachJson(self, json, R_Path_getJson_visitor, result) == 0) return NULL;
+  return result;
+}
@@ -0,0 +1,519 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_PersistentDictionary.h"
+
+#ifdef R_TYPE_REFCOUNT
+
+#define R_PersistentDictionary_Bits 5
+#define R_PersistentDictionary_Mask ((1 << R_PersistentDictionary_Bits) - 1)
+//Past this shift the 32 bit hash is used up, and nodes hold keys whose hashes are all the same
+#define R_PersistentDictionary_MaxShift 30
+
+/*  R_PersistentDictionary_Node
+    Each slot is an R_KeyValuePair or a child node, in the order of their bits in bitmap. A collision node, below
+   R_PersistentDictionary_MaxShift, has no bitmap and only holds pairs. Pairs and nodes are both R_Type objects, so
+   they're shared between versions with R_Type_Retain.
+ */
+typedef struct {
+  R_Type* type;
+  uint32_t bitmap;
+  uint32_t count;
+  void** slots;
+} R_PersistentDictionary_Node;
+
+static R_PersistentDictionary_Node* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_Node_Destructor(R_PersistentDictionary_Node* self) {
+  for (size_t i=0; i<self->count; i++) R_Type_Delete(self->slots[i]);
+  os_free_sized(self->slots, self->count*sizeof(void*));
+  self->slots = NULL;
+  self->count = 0;
+  return self;
+}
+R_Type_Def(R_PersistentDictionary_Node, NULL, R_PersistentDictionary_Node_Destructor, NULL, NULL);
+
+struct R_PersistentDictionary {
+  R_Type* type;
+  R_PersistentDictionary_Node* root;
+  size_t size;
+};
+
+static R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_Destructor(R_PersistentDictionary* self);
+static R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_Copier(R_PersistentDictionary* self, R_PersistentDictionary* new);
+static R_JumpTable_Entry methods[] = {
+  R_JumpTable_Entry_Make(R_Stringify, R_PersistentDictionary_stringify),
+  R_JumpTable_Entry_NULL
+};
+R_Type_Define(R_PersistentDictionary,
+  .dtor = (R_Type_Destructor)R_PersistentDictionary_Destructor,
+  .copy = (R_Type_Copier)R_PersistentDictionary_Copier,
+  .interfaces = methods);
+
+static R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_Destructor(R_PersistentDictionary* self) {
+  R_Type_DeleteAndNull(self->root);
+  self->size = 0;
+  return self;
+}
+
+static R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_Copier(R_PersistentDictionary* self, R_PersistentDictionary* new) {
+  new->root = R_Type_Retain(self->root);
+  new->size = self->size;
+  return new;
+}
+
+/*  R_PersistentDictionary_Edit
+    One key being set or removed. pair is the pair being set, which the edit keeps a reference to.
+ */
+typedef struct {
+  uint32_t hash;
+  const uint8_t* key;
+  size_t length;
+  R_KeyValuePair* pair;
+  bool changed;
+  bool failed;
+} R_PersistentDictionary_Edit;
+
+//32 bit FNV-1a
+static uint32_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_hash(const uint8_t* key, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i=0; i<length; i++) hash = (hash ^ key[i]) * 16777619u;
+  return hash;
+}
+
+static uint32_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_hashOfPair(R_KeyValuePair* pair) {
+  R_MutableString* key = R_KeyValuePair_key(pair);
+  return R_PersistentDictionary_hash(R_MutableData_bytes(R_MutableString_bytes(key)), R_MutableString_length(key));
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_PersistentDictionary_isKey(R_KeyValuePair* pair, const uint8_t* key, size_t length) {
+  R_MutableString* pair_key = R_KeyValuePair_key(pair);
+  return R_MutableString_length(pair_key) == length && (length == 0 || os_memcmp(R_MutableData_bytes(R_MutableString_bytes(pair_key)), key, length) == 0);
+}
+
+static uint32_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_bit(uint32_t hash, unsigned shift) {
+  return (uint32_t)1 << ((hash >> shift) & R_PersistentDictionary_Mask);
+}
+
+static uint32_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_index(uint32_t bitmap, uint32_t bit) {
+  return (uint32_t)__builtin_popcount(bitmap & (bit - 1));
+}
+
+static R_PersistentDictionary_Node* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_newNode(uint32_t bitmap, uint32_t count) {
+  R_PersistentDictionary_Node* node = R_Type_New(R_PersistentDictionary_Node);
+  if (node == NULL) return NULL;
+  node->slots = (void**)os_malloc(count*sizeof(void*));
+  if (node->slots == NULL) return R_Type_Delete(node), NULL;
+  node->bitmap = bitmap;
+  node->count = count;
+  return node;
+}
+
+/*  R_PersistentDictionary_editable
+    Returns a reference to a node that's safe to change. A node that only one owner can reach is changed in place,
+   since no other version can see it, and anything else is copied.
+ */
+static R_PersistentDictionary_Node* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_editable(R_PersistentDictionary_Node* node) {
+  if (R_Type_References(node) == 1) return R_Type_Retain(node);
+  R_PersistentDictionary_Node* copy = R_PersistentDictionary_newNode(node->bitmap, node->count);
+  if (copy == NULL) return NULL;
+  for (size_t i=0; i<node->count; i++) copy->slots[i] = R_Type_Retain(node->slots[i]);
+  return copy;
+}
+
+//Swaps the reference in slot for object, which the slot takes over
+#define R_PersistentDictionary_replace(slot, object) do {R_Type_Delete(slot); (slot) = (object);} while(0)
+
+/*  R_PersistentDictionary_withSlot
+    Returns node with slot inserted at index, or with the slot at index removed if slot is NULL, and the new bitmap.
+   Takes over the reference to slot.
+ */
+static R_PersistentDictionary_Node* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_withSlot(R_PersistentDictionary_Node* node, uint32_t index, void* slot, uint32_t bitmap) {
+  uint32_t count = slot ? node->count + 1 : node->count - 1;
+  if (R_Type_References(node) == 1) {
+    void** slots = node->slots;
+    if (slot) {
+      slots = (void**)os_realloc_sized(node->slots, node->count*sizeof(void*), count*sizeof(void*));
+      if (slots == NULL) return R_Type_Delete(slot), NULL;
+      memmove(slots + index + 1, slots + index, (node->count - index)*sizeof(void*));
+      slots[index] = slot;
+    }
+    else {
+      R_Type_Delete(slots[index]);
+      memmove(slots + index, slots + index + 1, (count - index)*sizeof(void*));
+      //Shrinking can't fail, and a failed shrink still leaves a big enough block
+      void** shrunk = (void**)os_realloc_sized(slots, node->count*sizeof(void*), count*sizeof(void*));
+      if (shrunk != NULL || count == 0) slots = shrunk;
+    }
+    node->slots = slots;
+    node->count = count;
+    node->bitmap = bitmap;
+    return R_Type_Retain(node);
+  }
+
+  R_PersistentDictionary_Node* copy = R_PersistentDictionary_newNode(bitmap, count);
+  if (copy == NULL) return R_Type_Delete(slot), NULL;
+  for (uint32_t from=0, to=0; from<node->count || to<count; ) {
+    if (to == index && slot) copy->slots[to++] = slot;
+    else if (from == index && !slot) from++;
+    else copy->slots[to++] = R_Type_Retain(node->slots[from++]);
+  }
+  return copy;
+}
+
+/*  R_PersistentDictionary_split
+    Makes the subtree holding both existing, whose hash is existing_hash, and the pair being set.
+ */
+static R_PersistentDictionary_Node* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_split(R_KeyValuePair* existing, uint32_t existing_hash, unsigned shift, R_PersistentDictionary_Edit* edit) {
+  R_PersistentDictionary_Node* node;
+  if (shift > R_PersistentDictionary_MaxShift) {
+    node = R_PersistentDictionary_newNode(0, 2);
+    if (node == NULL) return NULL;
+    node->slots[0] = R_Type_Retain(existing);
+    node->slots[1] = R_Type_Retain(edit->pair);
+    return node;
+  }
+  uint32_t existing_bit = R_PersistentDictionary_bit(existing_hash, shift);
+  uint32_t bit = R_PersistentDictionary_bit(edit->hash, shift);
+  if (existing_bit == bit) {
+    R_PersistentDictionary_Node* child = R_PersistentDictionary_split(existing, existing_hash, shift + R_PersistentDictionary_Bits, edit);
+    if (child == NULL) return NULL;
+    node = R_PersistentDictionary_newNode(bit, 1);
+    if (node == NULL) return R_Type_Delete(child), NULL;
+    node->slots[0] = child;
+    return node;
+  }
+  node = R_PersistentDictionary_newNode(existing_bit | bit, 2);
+  if (node == NULL) return NULL;
+  node->slots[existing_bit < bit ? 0 : 1] = R_Type_Retain(existing);
+  node->slots[existing_bit < bit ? 1 : 0] = R_Type_Retain(edit->pair);
+  return node;
+}
+
+static R_PersistentDictionary_Node* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_insert(R_PersistentDictionary_Node* parent, unsigned shift, R_PersistentDictionary_Edit* edit) {
+  edit->changed = true;
+  if (parent == NULL) {
+    R_PersistentDictionary_Node* node = R_PersistentDictionary_newNode(R_PersistentDictionary_bit(edit->hash, shift), 1);
+    if (node == NULL) return NULL;
+    node->slots[0] = R_Type_Retain(edit->pair);
+    return node;
+  }
+
+  uint32_t index = parent->count;
+  uint32_t bit = 0;
+  if (shift > R_PersistentDictionary_MaxShift) {
+    for (uint32_t i=0; i<parent->count; i++) {
+      if (R_PersistentDictionary_isKey(parent->slots[i], edit->key, edit->length)) index = i;
+    }
+    if (index == parent->count) return R_PersistentDictionary_withSlot(parent, index, R_Type_Retain(edit->pair), 0);
+  }
+  else {
+    bit = R_PersistentDictionary_bit(edit->hash, shift);
+    index = R_PersistentDictionary_index(parent->bitmap, bit);
+    if (!(parent->bitmap & bit)) return R_PersistentDictionary_withSlot(parent, index, R_Type_Retain(edit->pair), parent->bitmap | bit);
+  }
+
+  //Copy the parent first, so a child it shares with another version isn't changed in place
+  R_PersistentDictionary_Node* node = R_PersistentDictionary_editable(parent);
+  if (node == NULL) return NULL;
+  void* slot = node->slots[index];
+  void* child;
+  if (R_Type_IsOf(slot, R_KeyValuePair)) {
+    if (R_PersistentDictionary_isKey(slot, edit->key, edit->length)) {
+      edit->changed = false;
+      child = R_Type_Retain(edit->pair);
+    }
+    else child = R_PersistentDictionary_split(slot, R_PersistentDictionary_hashOfPair(slot), shift + R_PersistentDictionary_Bits, edit);
+  }
+  else child = R_PersistentDictionary_insert(slot, shift + R_PersistentDictionary_Bits, edit);
+  if (child == NULL) return R_Type_Delete(node), NULL;
+  R_PersistentDictionary_replace(node->slots[index], child);
+  return node;
+}
+
+/*  R_PersistentDictionary_removeKey
+    Removes the key, which must be in the subtree. Returns NULL when that leaves the node empty, or on failure.
+ */
+static R_PersistentDictionary_Node* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_removeKey(R_PersistentDictionary_Node* parent, unsigned shift, R_PersistentDictionary_Edit* edit) {
+  uint32_t index = 0;
+  uint32_t bitmap = 0;
+  if (shift > R_PersistentDictionary_MaxShift) {
+    while (index < parent->count && !R_PersistentDictionary_isKey(parent->slots[index], edit->key, edit->length)) index++;
+  }
+  else {
+    uint32_t bit = R_PersistentDictionary_bit(edit->hash, shift);
+    index = R_PersistentDictionary_index(parent->bitmap, bit);
+    bitmap = parent->bitmap & ~bit;
+  }
+  if (R_Type_IsOf(parent->slots[index], R_KeyValuePair)) {
+    edit->changed = true;
+    if (parent->count == 1) return NULL;
+    R_PersistentDictionary_Node* node = R_PersistentDictionary_withSlot(parent, index, NULL, bitmap);
+    if (node == NULL) edit->failed = true;
+    return node;
+  }
+
+  R_PersistentDictionary_Node* node = R_PersistentDictionary_editable(parent);
+  if (node == NULL) return edit->failed = true, NULL;
+  R_PersistentDictionary_Node* child = R_PersistentDictionary_removeKey(node->slots[index], shift + R_PersistentDictionary_Bits, edit);
+  if (edit->failed) return R_Type_Delete(node), NULL;
+  if (child == NULL) {
+    if (node->count == 1) return R_Type_Delete(node), NULL;
+    R_PersistentDictionary_Node* smaller = R_PersistentDictionary_withSlot(node, index, NULL, bitmap);
+    R_Type_Delete(node);
+    if (smaller == NULL) edit->failed = true;
+    return smaller;
+  }
+  if (child->count == 1 && R_Type_IsOf(child->slots[0], R_KeyValuePair)) {
+    //A lone pair moves up into this node
+    R_PersistentDictionary_replace(node->slots[index], R_Type_Retain(child->slots[0]));
+    R_Type_Delete(child);
+  }
+  else R_PersistentDictionary_replace(node->slots[index], child);
+  return node;
+}
+
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_find(R_PersistentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary) || key == NULL) return NULL;
+  size_t length = os_strlen(key);
+  uint32_t hash = R_PersistentDictionary_hash((const uint8_t*)key, length);
+  R_PersistentDictionary_Node* node = self->root;
+  for (unsigned shift=0; node != NULL; shift+=R_PersistentDictionary_Bits) {
+    if (shift > R_PersistentDictionary_MaxShift) {
+      for (uint32_t i=0; i<node->count; i++) {
+        if (R_PersistentDictionary_isKey(node->slots[i], (const uint8_t*)key, length)) return node->slots[i];
+      }
+      return NULL;
+    }
+    uint32_t bit = R_PersistentDictionary_bit(hash, shift);
+    if (!(node->bitmap & bit)) return NULL;
+    void* slot = node->slots[R_PersistentDictionary_index(node->bitmap, bit)];
+    if (R_Type_IsOf(slot, R_KeyValuePair)) return R_PersistentDictionary_isKey(slot, (const uint8_t*)key, length) ? slot : NULL;
+    node = slot;
+  }
+  return NULL;
+}
+
+/*  R_PersistentDictionary_setInPlace
+    Adds the pair to self, which must be a version nobody else has seen yet. Takes over the reference to pair.
+ */
+static R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setInPlace(R_PersistentDictionary* self, R_KeyValuePair* pair) {
+  R_MutableString* key = R_KeyValuePair_key(pair);
+  R_PersistentDictionary_Edit edit = {0};
+  edit.key = R_MutableData_bytes(R_MutableString_bytes(key));
+  edit.length = R_MutableString_length(key);
+  edit.hash = R_PersistentDictionary_hash(edit.key, edit.length);
+  edit.pair = pair;
+  R_PersistentDictionary_Node* root = R_PersistentDictionary_insert(self->root, 0, &edit);
+  R_Type_Delete(pair);
+  if (root == NULL) return NULL;
+  R_PersistentDictionary_replace(self->root, root);
+  if (edit.changed) self->size++;
+  return self;
+}
+
+static R_KeyValuePair* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_newPair(const char* key, void* value) {
+  R_KeyValuePair* pair = R_Type_New(R_KeyValuePair);
+  if (pair == NULL) return R_Type_Delete(value), NULL;
+  R_KeyValuePair_setKey(pair, key);
+  R_KeyValuePair_setValue(pair, value);
+  return pair;
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_set(R_PersistentDictionary* self, const char* key, void* value) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary) || key == NULL || value == NULL) return R_Type_Delete(value), NULL;
+  R_KeyValuePair* pair = R_PersistentDictionary_newPair(key, value);
+  if (pair == NULL) return NULL;
+  R_PersistentDictionary* version = R_Type_Copy(self);
+  if (version == NULL) return R_Type_Delete(pair), NULL;
+  if (R_PersistentDictionary_setInPlace(version, pair) == NULL) return R_Type_Delete(version), NULL;
+  return version;
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setInteger(R_PersistentDictionary* self, const char* key, int value) {
+  return R_PersistentDictionary_set(self, key, R_Integer_set(R_Type_New(R_Integer), value));
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setFloat(R_PersistentDictionary* self, const char* key, float value) {
+  return R_PersistentDictionary_set(self, key, R_Float_set(R_Type_New(R_Float), value));
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setBoolean(R_PersistentDictionary* self, const char* key, bool value) {
+  return R_PersistentDictionary_set(self, key, R_Boolean_set(R_Type_New(R_Boolean), value));
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_setNull(R_PersistentDictionary* self, const char* key) {
+  return R_PersistentDictionary_set(self, key, R_Type_New(R_Null));
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_remove(R_PersistentDictionary* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary) || key == NULL) return NULL;
+  R_PersistentDictionary* version = R_Type_Copy(self);
+  if (version == NULL || R_PersistentDictionary_find(self, key) == NULL) return version;
+  R_PersistentDictionary_Edit edit = {0};
+  edit.key = (const uint8_t*)key;
+  edit.length = os_strlen(key);
+  edit.hash = R_PersistentDictionary_hash(edit.key, edit.length);
+  R_PersistentDictionary_Node* root = R_PersistentDictionary_removeKey(version->root, 0, &edit);
+  if (edit.failed) return R_Type_Delete(version), NULL;
+  R_PersistentDictionary_replace(version->root, root);
+  version->size--;
+  return version;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_get(R_PersistentDictionary* self, const char* key) {
+  return R_KeyValuePair_value(R_PersistentDictionary_find(self, key));
+}
+
+int R_FUNCTION_ATTRIBUTES R_PersistentDictionary_getInteger(R_PersistentDictionary* self, const char* key) {
+  void* value = R_PersistentDictionary_get(self, key);
+  return R_Type_IsOf(value, R_Integer) ? R_Integer_get(value) : 0;
+}
+
+float R_FUNCTION_ATTRIBUTES R_PersistentDictionary_getFloat(R_PersistentDictionary* self, const char* key) {
+  void* value = R_PersistentDictionary_get(self, key);
+  return R_Type_IsOf(value, R_Float) ? R_Float_get(value) : 0;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_PersistentDictionary_getBoolean(R_PersistentDictionary* self, const char* key) {
+  void* value = R_PersistentDictionary_get(self, key);
+  return R_Type_IsOf(value, R_Boolean) ? R_Boolean_get(value) : false;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_PersistentDictionary_isPresent(R_PersistentDictionary* self, const char* key) {
+  return R_PersistentDictionary_find(self, key) != NULL;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_size(R_PersistentDictionary* self) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary)) return 0;
+  return self->size;
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_PersistentDictionary_eachInNode(R_PersistentDictionary_Node* node, R_PersistentDictionary_Callback callback, void* context, size_t* visited) {
+  for (uint32_t i=0; i<node->count; i++) {
+    void* slot = node->slots[i];
+    if (R_Type_IsOf(slot, R_KeyValuePair)) {
+      (*visited)++;
+      if (!callback(slot, context)) return false;
+    }
+    else if (!R_PersistentDictionary_eachInNode(slot, callback, context, visited)) return false;
+  }
+  return true;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_each(R_PersistentDictionary* self, R_PersistentDictionary_Callback callback, void* context) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary) || callback == NULL || self->root == NULL) return 0;
+  size_t visited = 0;
+  R_PersistentDictionary_eachInNode(self->root, callback, context, &visited);
+  return visited;
+}
+
+/*  R_PersistentDictionary_import
+    Copies a value going into a persistent container, turning mutable containers into persistent ones.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_import(void* value) {
+  if (R_Type_IsOf(value, R_Dictionary)) {
+    R_PersistentDictionary* empty = R_Type_New(R_PersistentDictionary);
+    R_PersistentDictionary* imported = R_PersistentDictionary_fromDictionary(empty, value);
+    R_Type_Delete(empty);
+    return imported;
+  }
+  if (R_Type_IsOf(value, R_List)) {
+    R_PersistentList* empty = R_Type_New(R_PersistentList);
+    R_PersistentList* imported = R_PersistentList_fromList(empty, value);
+    R_Type_Delete(empty);
+    return imported;
+  }
+  return R_Type_Copy(value);
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_fromDictionary(R_PersistentDictionary* self, R_Dictionary* dictionary) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary) || R_Type_IsNotOf(dictionary, R_Dictionary)) return NULL;
+  R_PersistentDictionary* version = R_Type_Copy(self);
+  R_Dictionary_each(dictionary, element) {
+    if (version == NULL) break;
+    R_KeyValuePair* pair = R_Type_New(R_KeyValuePair);
+    if (pair == NULL) return R_Type_Delete(version), NULL;
+    R_MutableString_appendString(R_KeyValuePair_key(pair), R_KeyValuePair_key(element));
+    const R_Type* type = R_KeyValuePair_valueType(element);
+    if (type == R_Type_Object(R_Dictionary) || type == R_Type_Object(R_List)) R_KeyValuePair_setValue(pair, R_PersistentDictionary_import(R_KeyValuePair_value(element)));
+    else R_KeyValuePair_copyValue(pair, element);
+    //Copying or importing leaves no value when it fails
+    if (R_KeyValuePair_valueType(pair) == NULL) return R_Type_Delete(pair), R_Type_Delete(version), NULL;
+    if (R_PersistentDictionary_setInPlace(version, pair) == NULL) R_Type_DeleteAndNull(version);
+  }
+  return version;
+}
+
+typedef struct {
+  R_Dictionary* dictionary;
+  char* key;
+  size_t key_size;
+} R_PersistentDictionary_Exporter;
+
+/*  R_PersistentDictionary_export
+    Copies a value coming out of a persistent container, turning persistent containers back into mutable ones.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_export(void* value) {
+  if (R_Type_IsOf(value, R_PersistentDictionary)) {
+    R_Dictionary* dictionary = R_Type_New(R_Dictionary);
+    if (R_PersistentDictionary_toDictionary(value, dictionary) == NULL) R_Type_DeleteAndNull(dictionary);
+    return dictionary;
+  }
+  if (R_Type_IsOf(value, R_PersistentList)) {
+    R_List* list = R_Type_New(R_List);
+    if (R_PersistentList_toList(value, list) == NULL) R_Type_DeleteAndNull(list);
+    return list;
+  }
+  return R_Type_Copy(value);
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_PersistentDictionary_exportPair(R_KeyValuePair* pair, void* context) {
+  R_PersistentDictionary_Exporter* exporter = context;
+  //The key is copied out rather than read with R_MutableString_cstring, which would change the shared pair
+  R_MutableString* key = R_KeyValuePair_key(pair);
+  size_t length = R_MutableString_length(key);
+  if (length + 1 > exporter->key_size) {
+    char* buffer = (char*)os_realloc_sized(exporter->key, exporter->key_size, length + 1);
+    if (buffer == NULL) return false;
+    exporter->key = buffer;
+    exporter->key_size = length + 1;
+  }
+  if (length) os_memcpy(exporter->key, R_MutableData_bytes(R_MutableString_bytes(key)), length);
+  exporter->key[length] = '\0';
+  void* value = R_PersistentDictionary_export(R_KeyValuePair_value(pair));
+  if (value == NULL) return false;
+  if (R_Dictionary_transferOwnership(exporter->dictionary, exporter->key, value) == NULL) return R_Type_Delete(value), false;
+  return true;
+}
+
+R_Dictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_toDictionary(R_PersistentDictionary* self, R_Dictionary* dictionary) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary) || R_Type_IsNotOf(dictionary, R_Dictionary)) return NULL;
+  R_PersistentDictionary_Exporter exporter = {dictionary, NULL, 0};
+  bool complete = self->root == NULL;
+  if (!complete) {
+    size_t visited = 0;
+    complete = R_PersistentDictionary_eachInNode(self->root, R_PersistentDictionary_exportPair, &exporter, &visited);
+  }
+  os_free_sized(exporter.key, exporter.key_size);
+  return complete ? dictionary : NULL;
+}
+
+R_PersistentDictionary* R_FUNCTION_ATTRIBUTES R_PersistentDictionary_fromJson(R_PersistentDictionary* self, R_MutableString* buffer) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary)) return NULL;
+  R_Dictionary* dictionary = R_Type_New(R_Dictionary);
+  R_PersistentDictionary* version = NULL;
+  if (R_Dictionary_fromJson(dictionary, buffer) != NULL) version = R_PersistentDictionary_fromDictionary(self, dictionary);
+  R_Type_Delete(dictionary);
+  return version;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentDictionary_stringify(R_PersistentDictionary* self, char* buffer, size_t size) {
+  if (R_Type_IsNotOf(self, R_PersistentDictionary)) return 0;
+  R_MutableString* string = R_Type_New(R_MutableString);
+  R_PersistentDictionary_toJson(self, string);
+  size_t output = R_MutableString_stringify(string, buffer, size);
+  R_Type_Delete(string);
+  return output;
+}
+
+#endif
@@ -0,0 +1,364 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_PersistentList.h"
+#include "R_PersistentDictionary.h"
+
+#ifdef R_TYPE_REFCOUNT
+
+#define R_PersistentList_Bits 5
+#define R_PersistentList_Width (1 << R_PersistentList_Bits)
+#define R_PersistentList_Mask (R_PersistentList_Width - 1)
+
+/*  R_PersistentList_Node
+    A branch holds child nodes and a leaf holds elements. Both are R_Type objects, so a node is shared between
+   versions with R_Type_Retain and deleting one deletes whatever it was the last owner of.
+ */
+typedef struct {
+  R_Type* type;
+  void* slots[R_PersistentList_Width];
+} R_PersistentList_Node;
+
+static R_PersistentList_Node* R_FUNCTION_ATTRIBUTES R_PersistentList_Node_Destructor(R_PersistentList_Node* self) {
+  for (size_t i=0; i<R_PersistentList_Width; i++) R_Type_DeleteAndNull(self->slots[i]);
+  return self;
+}
+R_Type_Def(R_PersistentList_Node, NULL, R_PersistentList_Node_Destructor, NULL, NULL);
+
+/*  R_PersistentList
+    Elements [0, tail offset) are in the tree under root and the rest are in tail. shift is how far an index is
+   shifted to pick a child of the root: 5 when the root's children are leaves, and 5 more for each level above that.
+ */
+struct R_PersistentList {
+  R_Type* type;
+  size_t size;
+  unsigned shift;
+  R_PersistentList_Node* root;
+  R_PersistentList_Node* tail;
+};
+
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_Constructor(R_PersistentList* self);
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_Destructor(R_PersistentList* self);
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_Copier(R_PersistentList* self, R_PersistentList* new);
+static R_JumpTable_Entry methods[] = {
+  R_JumpTable_Entry_Make(R_Stringify, R_PersistentList_stringify),
+  R_JumpTable_Entry_NULL
+};
+R_Type_Define(R_PersistentList,
+  .ctor = (R_Type_Constructor)R_PersistentList_Constructor,
+  .dtor = (R_Type_Destructor)R_PersistentList_Destructor,
+  .copy = (R_Type_Copier)R_PersistentList_Copier,
+  .interfaces = methods);
+
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_Constructor(R_PersistentList* self) {
+  self->size = 0;
+  self->shift = R_PersistentList_Bits;
+  self->root = self->tail = NULL;
+  return self;
+}
+
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_Destructor(R_PersistentList* self) {
+  R_Type_DeleteAndNull(self->root);
+  R_Type_DeleteAndNull(self->tail);
+  return self;
+}
+
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_Copier(R_PersistentList* self, R_PersistentList* new) {
+  new->size = self->size;
+  new->shift = self->shift;
+  new->root = R_Type_Retain(self->root);
+  new->tail = R_Type_Retain(self->tail);
+  return new;
+}
+
+static size_t R_FUNCTION_ATTRIBUTES R_PersistentList_tailOffset(size_t size) {
+  return size < R_PersistentList_Width ? 0 : ((size - 1) >> R_PersistentList_Bits) << R_PersistentList_Bits;
+}
+
+/*  R_PersistentList_editable
+    Returns a reference to a node that's safe to change. A node that only one owner can reach is changed in place,
+   since no other version can see it, and anything else is copied. NULL gives a new empty node.
+ */
+static R_PersistentList_Node* R_FUNCTION_ATTRIBUTES R_PersistentList_editable(R_PersistentList_Node* node) {
+  if (node != NULL && R_Type_References(node) == 1) return R_Type_Retain(node);
+  R_PersistentList_Node* copy = R_Type_New(R_PersistentList_Node);
+  if (copy == NULL || node == NULL) return copy;
+  for (size_t i=0; i<R_PersistentList_Width; i++) copy->slots[i] = R_Type_Retain(node->slots[i]);
+  return copy;
+}
+
+//Swaps the reference in slot for node, which the slot takes over
+#define R_PersistentList_replace(slot, node) do {R_Type_Delete(slot); (slot) = (node);} while(0)
+
+static R_PersistentList_Node* R_FUNCTION_ATTRIBUTES R_PersistentList_leafFor(R_PersistentList* self, size_t index) {
+  if (index >= R_PersistentList_tailOffset(self->size)) return self->tail;
+  R_PersistentList_Node* node = self->root;
+  for (unsigned level=self->shift; level>0; level-=R_PersistentList_Bits) node = node->slots[(index >> level) & R_PersistentList_Mask];
+  return node;
+}
+
+/*  R_PersistentList_pushTail
+    Puts a full tail into the tree as the leaf after the last one, making nodes on the way as needed. Takes over the
+   reference to tail even if it fails.
+ */
+static R_PersistentList_Node* R_FUNCTION_ATTRIBUTES R_PersistentList_pushTail(size_t size, unsigned level, R_PersistentList_Node* parent, R_PersistentList_Node* tail) {
+  R_PersistentList_Node* node = R_PersistentList_editable(parent);
+  if (node == NULL) return R_Type_Delete(tail), NULL;
+  size_t index = ((size - 1) >> level) & R_PersistentList_Mask;
+  R_PersistentList_Node* child = tail;
+  if (level > R_PersistentList_Bits) child = R_PersistentList_pushTail(size, level - R_PersistentList_Bits, node->slots[index], tail);
+  if (child == NULL) return R_Type_Delete(node), NULL;
+  R_PersistentList_replace(node->slots[index], child);
+  return node;
+}
+
+static R_PersistentList_Node* R_FUNCTION_ATTRIBUTES R_PersistentList_assoc(unsigned level, R_PersistentList_Node* parent, size_t index, void* object) {
+  R_PersistentList_Node* node = R_PersistentList_editable(parent);
+  if (node == NULL) return R_Type_Delete(object), NULL;
+  size_t slot = (index >> level) & R_PersistentList_Mask;
+  void* child = object;
+  if (level > 0) child = R_PersistentList_assoc(level - R_PersistentList_Bits, node->slots[slot], index, object);
+  if (child == NULL) return R_Type_Delete(node), NULL;
+  R_PersistentList_replace(node->slots[slot], child);
+  return node;
+}
+
+/*  R_PersistentList_popTail
+    Removes the last leaf from the tree. Returns NULL if that leaves the node empty, or on failure.
+ */
+static R_PersistentList_Node* R_FUNCTION_ATTRIBUTES R_PersistentList_popTail(size_t size, unsigned level, R_PersistentList_Node* parent) {
+  size_t index = ((size - 2) >> level) & R_PersistentList_Mask;
+  if (level == R_PersistentList_Bits && index == 0) return NULL;
+  //Copy the parent first, so a child it shares with another version isn't changed in place
+  R_PersistentList_Node* node = R_PersistentList_editable(parent);
+  if (node == NULL) return NULL;
+  R_PersistentList_Node* child = NULL;
+  if (level > R_PersistentList_Bits) {
+    child = R_PersistentList_popTail(size, level - R_PersistentList_Bits, node->slots[index]);
+    if (child == NULL && index == 0) return R_Type_Delete(node), NULL;
+  }
+  R_PersistentList_replace(node->slots[index], child);
+  return node;
+}
+
+//The in-place versions change self, which must be a version nobody else has seen yet
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_appendInPlace(R_PersistentList* self, void* object) {
+  size_t tail_size = self->size - R_PersistentList_tailOffset(self->size);
+  if (tail_size < R_PersistentList_Width) {
+    R_PersistentList_Node* tail = R_PersistentList_editable(self->tail);
+    if (tail == NULL) return R_Type_Delete(object), NULL;
+    tail->slots[tail_size] = object;
+    R_PersistentList_replace(self->tail, tail);
+    self->size++;
+    return self;
+  }
+
+  R_PersistentList_Node* tail = R_Type_New(R_PersistentList_Node);
+  if (tail == NULL) return R_Type_Delete(object), NULL;
+  tail->slots[0] = object;
+  R_PersistentList_Node* root = NULL;
+  unsigned shift = self->shift;
+  if ((self->size >> R_PersistentList_Bits) > ((size_t)1 << self->shift)) {
+    //The tree is full, so it becomes the first child of a new root
+    root = R_Type_New(R_PersistentList_Node);
+    if (root != NULL) {
+      root->slots[0] = R_Type_Retain(self->root);
+      root->slots[1] = R_PersistentList_pushTail(self->size, self->shift, NULL, R_Type_Retain(self->tail));
+      if (root->slots[1] == NULL) R_Type_DeleteAndNull(root);
+    }
+    shift += R_PersistentList_Bits;
+  }
+  else root = R_PersistentList_pushTail(self->size, self->shift, self->root, R_Type_Retain(self->tail));
+  if (root == NULL) return R_Type_Delete(tail), NULL;
+
+  R_PersistentList_replace(self->root, root);
+  R_PersistentList_replace(self->tail, tail);
+  self->shift = shift;
+  self->size++;
+  return self;
+}
+
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_setInPlace(R_PersistentList* self, size_t index, void* object) {
+  if (index >= R_PersistentList_tailOffset(self->size)) {
+    R_PersistentList_Node* tail = R_PersistentList_assoc(0, self->tail, index, object);
+    if (tail == NULL) return NULL;
+    R_PersistentList_replace(self->tail, tail);
+    return self;
+  }
+  R_PersistentList_Node* root = R_PersistentList_assoc(self->shift, self->root, index, object);
+  if (root == NULL) return NULL;
+  R_PersistentList_replace(self->root, root);
+  return self;
+}
+
+static R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_popInPlace(R_PersistentList* self) {
+  size_t tail_size = self->size - R_PersistentList_tailOffset(self->size);
+  if (tail_size > 1) {
+    R_PersistentList_Node* tail = R_PersistentList_editable(self->tail);
+    if (tail == NULL) return NULL;
+    R_Type_DeleteAndNull(tail->slots[tail_size - 1]);
+    R_PersistentList_replace(self->tail, tail);
+    self->size--;
+    return self;
+  }
+  if (self->size == 1) {
+    R_PersistentList_Destructor(self);
+    return R_PersistentList_Constructor(self);
+  }
+
+  //The tail is about to be empty, so the last leaf in the tree becomes the tail
+  R_PersistentList_Node* tail = R_Type_Retain(R_PersistentList_leafFor(self, self->size - 2));
+  R_PersistentList_Node* root = R_PersistentList_popTail(self->size, self->shift, self->root);
+  unsigned shift = self->shift;
+  if (root == NULL && self->size - 1 > R_PersistentList_Width) return R_Type_Delete(tail), NULL;
+  if (root != NULL && shift > R_PersistentList_Bits && root->slots[1] == NULL) {
+    R_PersistentList_Node* child = R_Type_Retain(root->slots[0]);
+    R_Type_Delete(root);
+    root = child;
+    shift -= R_PersistentList_Bits;
+  }
+  R_PersistentList_replace(self->root, root);
+  R_PersistentList_replace(self->tail, tail);
+  self->shift = shift;
+  self->size--;
+  return self;
+}
+
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_append(R_PersistentList* self, void* object) {
+  if (R_Type_IsNotOf(self, R_PersistentList) || object == NULL) return R_Type_Delete(object), NULL;
+  R_PersistentList* version = R_Type_Copy(self);
+  if (version == NULL) return R_Type_Delete(object), NULL;
+  if (R_PersistentList_appendInPlace(version, object) == NULL) return R_Type_Delete(version), NULL;
+  return version;
+}
+
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_set(R_PersistentList* self, size_t index, void* object) {
+  if (R_Type_IsNotOf(self, R_PersistentList) || object == NULL || index >= self->size) return R_Type_Delete(object), NULL;
+  R_PersistentList* version = R_Type_Copy(self);
+  if (version == NULL) return R_Type_Delete(object), NULL;
+  if (R_PersistentList_setInPlace(version, index, object) == NULL) return R_Type_Delete(version), NULL;
+  return version;
+}
+
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_pop(R_PersistentList* self) {
+  if (R_Type_IsNotOf(self, R_PersistentList) || self->size == 0) return NULL;
+  R_PersistentList* version = R_Type_Copy(self);
+  if (version == NULL || R_PersistentList_popInPlace(version) == NULL) return R_Type_Delete(version), NULL;
+  return version;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_PersistentList_get(R_PersistentList* self, size_t index) {
+  if (R_Type_IsNotOf(self, R_PersistentList) || index >= self->size) return NULL;
+  return R_PersistentList_leafFor(self, index)->slots[index & R_PersistentList_Mask];
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentList_size(R_PersistentList* self) {
+  if (R_Type_IsNotOf(self, R_PersistentList)) return 0;
+  return self->size;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentList_each(R_PersistentList* self, R_PersistentList_Callback callback, void* context) {
+  if (R_Type_IsNotOf(self, R_PersistentList) || callback == NULL) return 0;
+  size_t index = 0;
+  while (index < self->size) {
+    R_PersistentList_Node* leaf = R_PersistentList_leafFor(self, index);
+    size_t end = index + R_PersistentList_Width < self->size ? index + R_PersistentList_Width : self->size;
+    for (; index < end; index++) {
+      if (!callback(leaf->slots[index & R_PersistentList_Mask], context)) return index + 1;
+    }
+  }
+  return index;
+}
+
+/*  R_PersistentList_import
+    Copies a value going into a persistent container, turning mutable containers into persistent ones.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_PersistentList_import(void* value) {
+  if (R_Type_IsOf(value, R_Dictionary)) {
+    R_PersistentDictionary* empty = R_Type_New(R_PersistentDictionary);
+    R_PersistentDictionary* imported = R_PersistentDictionary_fromDictionary(empty, value);
+    R_Type_Delete(empty);
+    return imported;
+  }
+  if (R_Type_IsOf(value, R_List)) {
+    R_PersistentList* empty = R_Type_New(R_PersistentList);
+    R_PersistentList* imported = R_PersistentList_fromList(empty, value);
+    R_Type_Delete(empty);
+    return imported;
+  }
+  return R_Type_Copy(value);
+}
+
+R_PersistentList* R_FUNCTION_ATTRIBUTES R_PersistentList_fromList(R_PersistentList* self, R_List* list) {
+  if (R_Type_IsNotOf(self, R_PersistentList) || R_Type_IsNotOf(list, R_List)) return NULL;
+  R_PersistentList* version = R_Type_Copy(self);
+  for (size_t i=0; version != NULL && i<R_List_size(list); i++) {
+    void* value = R_PersistentList_import(R_List_pointerAtIndex(list, i));
+    if (value == NULL || R_PersistentList_appendInPlace(version, value) == NULL) R_Type_DeleteAndNull(version);
+  }
+  return version;
+}
+
+/*  R_PersistentList_export
+    Copies a value coming out of a persistent container, turning persistent containers back into mutable ones.
+ */
+static void* R_FUNCTION_ATTRIBUTES R_PersistentList_export(void* value) {
+  if (R_Type_IsOf(value, R_PersistentDictionary)) {
+    R_Dictionary* dictionary = R_Type_New(R_Dictionary);
+    if (R_PersistentDictionary_toDictionary(value, dictionary) == NULL) R_Type_DeleteAndNull(dictionary);
+    return dictionary;
+  }
+  if (R_Type_IsOf(value, R_PersistentList)) {
+    R_List* list = R_Type_New(R_List);
+    if (R_PersistentList_toList(value, list) == NULL) R_Type_DeleteAndNull(list);
+    return list;
+  }
+  return R_Type_Copy(value);
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_PersistentList_exportElement(void* object, void* context) {
+  void* copy = R_PersistentList_export(object);
+  if (copy == NULL) return false;
+  if (R_List_transferOwnership(context, copy) == NULL) return R_Type_Delete(copy), false;
+  return true;
+}
+
+R_List* R_FUNCTION_ATTRIBUTES R_PersistentList_toList(R_PersistentList* self, R_List* list) {
+  if (R_Type_IsNotOf(self, R_PersistentList) || R_Type_IsNotOf(list, R_List)) return NULL;
+  size_t size = R_List_size(list);
+  if (R_List_reserve(list, size + self->size) == NULL) return NULL;
+  R_PersistentList_each(self, R_PersistentList_exportElement, list);
+  if (R_List_size(list) != size + self->size) return NULL;
+  return list;
+}
+
+typedef struct {
+  char* buffer;
+  size_t size;
+  size_t written;
+} R_PersistentList_Stringifier;
+
+static bool R_FUNCTION_ATTRIBUTES R_PersistentList_stringifyElement(void* object, void* context) {
+  R_PersistentList_Stringifier* stringifier = context;
+  size_t size = stringifier->size - stringifier->written;
+  char* buffer = stringifier->buffer + stringifier->written;
+  size_t this_size = R_Type_hasMethod(object, R_Stringify) ? R_Stringify(object, buffer, size) : (size_t)os_snprintf(buffer, size, "Unknown Type");
+  if (this_size >= size) return false;
+  stringifier->written += this_size;
+  this_size = os_snprintf(buffer + this_size, size - this_size, "\n");
+  if (this_size >= size) return false;
+  stringifier->written += this_size;
+  return true;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_PersistentList_stringify(R_PersistentList* self, char* buffer, size_t size) {
+  if (R_Type_IsNotOf(self, R_PersistentList)) return 0;
+  size_t this_size = os_snprintf(buffer, size, "Persistent list of %zu:\n", self->size);
+  if (this_size >= size) return this_size;
+  R_PersistentList_Stringifier stringifier = {buffer, size, this_size};
+  R_PersistentList_each(self, R_PersistentList_stringifyElement, &stringifier);
+  return stringifier.written;
+}
+
+#endif
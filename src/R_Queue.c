@@ -0,0 +1,240 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "R_OS.h"
+#include "R_Queue.h"
+
+#define R_Queue_DefaultCapacity 256
+#define R_Queue_CacheLine 64
+//Tries before a waiting push or pop goes to sleep, since the other side is usually only a moment away
+#define R_Queue_Spins 64
+
+#ifdef R_OS_THREADS
+  #define R_Queue_load(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+  #define R_Queue_loadRelaxed(pointer) __atomic_load_n(pointer, __ATOMIC_RELAXED)
+  #define R_Queue_store(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+  #define R_Queue_claim(pointer, expected, value) __atomic_compare_exchange_n(pointer, expected, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+  #define R_Queue_add(pointer, value) __atomic_add_fetch(pointer, value, __ATOMIC_SEQ_CST)
+  #define R_Queue_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+  #define R_Queue_load(pointer) (*(pointer))
+  #define R_Queue_loadRelaxed(pointer) (*(pointer))
+  #define R_Queue_store(pointer, value) (*(pointer) = (value))
+  #define R_Queue_claim(pointer, expected, value) (*(pointer) = (value), true)
+  #define R_Queue_add(pointer, value) (*(pointer) += (value))
+  #define R_Queue_fence() do {} while(0)
+#endif
+
+/*  R_Queue_Cell
+    sequence says whose turn the cell is. It equals the push position that may fill it, and one more than that once
+   it's filled, for the pop at that position. Popping moves it on a lap of the ring, to the next push position.
+ */
+typedef struct {
+  size_t sequence;
+  void* object;
+} R_Queue_Cell;
+
+struct R_Queue {
+  R_Type* type;
+  R_Queue_Cell* cells;
+  size_t mask;
+  char padding_push[R_Queue_CacheLine];
+  size_t push_position;
+  char padding_pop[R_Queue_CacheLine];
+  size_t pop_position;
+  char padding_wait[R_Queue_CacheLine];
+  bool closed;
+  size_t pushers_waiting;
+  size_t poppers_waiting;
+#ifdef R_OS_THREADS
+  pthread_mutex_t lock;
+  pthread_cond_t not_full;
+  pthread_cond_t not_empty;
+#endif
+};
+
+static R_Queue* R_FUNCTION_ATTRIBUTES R_Queue_Constructor(R_Queue* self);
+static R_Queue* R_FUNCTION_ATTRIBUTES R_Queue_Destructor(R_Queue* self);
+static void* R_FUNCTION_ATTRIBUTES R_Queue_tryPop(R_Queue* self);
+R_Type_Def(R_Queue, R_Queue_Constructor, R_Queue_Destructor, NULL, NULL);
+
+static R_Queue* R_FUNCTION_ATTRIBUTES R_Queue_Constructor(R_Queue* self) {
+#ifdef R_OS_THREADS
+  pthread_mutex_init(&self->lock, NULL);
+  pthread_cond_init(&self->not_full, NULL);
+  pthread_cond_init(&self->not_empty, NULL);
+#endif
+  return R_Queue_setCapacity(self, R_Queue_DefaultCapacity);
+}
+
+static R_Queue* R_FUNCTION_ATTRIBUTES R_Queue_Destructor(R_Queue* self) {
+  void* object = NULL;
+  while (self->cells != NULL && (object = R_Queue_tryPop(self)) != NULL) R_Type_Delete(object);
+  if (self->cells != NULL) os_free_sized(self->cells, (self->mask + 1)*sizeof(R_Queue_Cell));
+  self->cells = NULL;
+#ifdef R_OS_THREADS
+  pthread_mutex_destroy(&self->lock);
+  pthread_cond_destroy(&self->not_full);
+  pthread_cond_destroy(&self->not_empty);
+#endif
+  return self;
+}
+
+R_Queue* R_FUNCTION_ATTRIBUTES R_Queue_setCapacity(R_Queue* self, size_t capacity) {
+  if (R_Type_IsNotOf(self, R_Queue) || R_Queue_size(self) != 0) return NULL;
+  //The sequence numbers need at least two cells to tell a full cell from an empty one
+  size_t count = 2;
+  while (count < capacity) count *= 2;
+  R_Queue_Cell* cells = (R_Queue_Cell*)os_malloc(count*sizeof(R_Queue_Cell));
+  if (cells == NULL) return NULL;
+  for (size_t i=0; i<count; i++) {
+    cells[i].sequence = i;
+    cells[i].object = NULL;
+  }
+  if (self->cells != NULL) os_free_sized(self->cells, (self->mask + 1)*sizeof(R_Queue_Cell));
+  self->cells = cells;
+  self->mask = count - 1;
+  self->push_position = 0;
+  self->pop_position = 0;
+  return self;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Queue_capacity(R_Queue* self) {
+  if (R_Type_IsNotOf(self, R_Queue) || self->cells == NULL) return 0;
+  return self->mask + 1;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Queue_size(R_Queue* self) {
+  if (R_Type_IsNotOf(self, R_Queue)) return 0;
+  size_t popped = R_Queue_load(&self->pop_position);
+  size_t pushed = R_Queue_load(&self->push_position);
+  //The two positions are read at different times, so a pop in between can put pop_position ahead
+  return pushed > popped ? pushed - popped : 0;
+}
+
+/*  R_Queue_wake
+    Wakes the threads waiting to pop, or to push, if there are any. The fence makes the push or pop just made visible
+   before the count is read. A waiter counts itself in before its last try, so either it sees the change or this sees it.
+ */
+static void R_FUNCTION_ATTRIBUTES R_Queue_wake(R_Queue* self, bool poppers) {
+#ifdef R_OS_THREADS
+  R_Queue_fence();
+  if (R_Queue_loadRelaxed(poppers ? &self->poppers_waiting : &self->pushers_waiting) == 0) return;
+  pthread_mutex_lock(&self->lock);
+  pthread_cond_broadcast(poppers ? &self->not_empty : &self->not_full);
+  pthread_mutex_unlock(&self->lock);
+#endif
+}
+
+/*  R_Queue_tryPush
+    The lock-free part of a push, which doesn't wake anyone, so it can be called with the lock held.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Queue_tryPush(R_Queue* self, void* object) {
+  if (R_Queue_load(&self->closed)) return false;
+  size_t position = R_Queue_loadRelaxed(&self->push_position);
+  R_Queue_Cell* cell = NULL;
+  for (;;) {
+    cell = &self->cells[position & self->mask];
+    intptr_t turn = (intptr_t)R_Queue_load(&cell->sequence) - (intptr_t)position;
+    if (turn == 0) {
+      if (R_Queue_claim(&self->push_position, &position, position + 1)) break;
+    }
+    //The cell still holds the object from a lap ago
+    else if (turn < 0) return false;
+    else position = R_Queue_loadRelaxed(&self->push_position);
+  }
+  cell->object = object;
+  R_Queue_store(&cell->sequence, position + 1);
+  return true;
+}
+
+static void* R_FUNCTION_ATTRIBUTES R_Queue_tryPop(R_Queue* self) {
+  size_t position = R_Queue_loadRelaxed(&self->pop_position);
+  R_Queue_Cell* cell = NULL;
+  for (;;) {
+    cell = &self->cells[position & self->mask];
+    intptr_t turn = (intptr_t)R_Queue_load(&cell->sequence) - (intptr_t)(position + 1);
+    if (turn == 0) {
+      if (R_Queue_claim(&self->pop_position, &position, position + 1)) break;
+    }
+    //Nothing has been pushed to the cell yet
+    else if (turn < 0) return NULL;
+    else position = R_Queue_loadRelaxed(&self->pop_position);
+  }
+  void* object = cell->object;
+  cell->object = NULL;
+  R_Queue_store(&cell->sequence, position + self->mask + 1);
+  return object;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_Queue_push(R_Queue* self, void* object) {
+  if (R_Type_IsNotOf(self, R_Queue) || object == NULL || !R_Queue_tryPush(self, object)) return false;
+  R_Queue_wake(self, true);
+  return true;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Queue_pop(R_Queue* self) {
+  if (R_Type_IsNotOf(self, R_Queue)) return NULL;
+  void* object = R_Queue_tryPop(self);
+  if (object != NULL) R_Queue_wake(self, false);
+  return object;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_Queue_pushWait(R_Queue* self, void* object) {
+  if (R_Type_IsNotOf(self, R_Queue) || object == NULL) return false;
+  for (size_t i=0; i<R_Queue_Spins; i++) {
+    if (R_Queue_push(self, object)) return true;
+    if (R_Queue_load(&self->closed)) return false;
+  }
+#ifdef R_OS_THREADS
+  pthread_mutex_lock(&self->lock);
+  R_Queue_add(&self->pushers_waiting, 1);
+  //Counted as waiting before trying again, so a pop from here on wakes this thread
+  bool pushed = false;
+  while (!(pushed = R_Queue_tryPush(self, object)) && !R_Queue_load(&self->closed)) pthread_cond_wait(&self->not_full, &self->lock);
+  R_Queue_add(&self->pushers_waiting, (size_t)-1);
+  pthread_mutex_unlock(&self->lock);
+  if (pushed) R_Queue_wake(self, true);
+  return pushed;
+#else
+  return false;
+#endif
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Queue_popWait(R_Queue* self) {
+  if (R_Type_IsNotOf(self, R_Queue)) return NULL;
+  void* object = NULL;
+  for (size_t i=0; i<R_Queue_Spins; i++) {
+    if ((object = R_Queue_pop(self)) != NULL) return object;
+    //An object pushed before the close is still there to pop
+    if (R_Queue_load(&self->closed)) return R_Queue_pop(self);
+  }
+#ifdef R_OS_THREADS
+  pthread_mutex_lock(&self->lock);
+  R_Queue_add(&self->poppers_waiting, 1);
+  while ((object = R_Queue_tryPop(self)) == NULL && !R_Queue_load(&self->closed)) pthread_cond_wait(&self->not_empty, &self->lock);
+  R_Queue_add(&self->poppers_waiting, (size_t)-1);
+  pthread_mutex_unlock(&self->lock);
+  if (object == NULL) object = R_Queue_tryPop(self);
+  if (object != NULL) R_Queue_wake(self, false);
+#endif
+  return object;
+}
+
+void R_FUNCTION_ATTRIBUTES R_Queue_close(R_Queue* self) {
+  if (R_Type_IsNotOf(self, R_Queue)) return;
+#ifdef R_OS_THREADS
+  pthread_mutex_lock(&self->lock);
+  R_Queue_store(&self->closed, true);
+  pthread_cond_broadcast(&self->not_full);
+  pthread_cond_broadcast(&self->not_empty);
+  pthread_mutex_unlock(&self->lock);
+#else
+  self->closed = true;
+#endif
+}
+
+bool R_FUNCTION_ATTRIBUTES R_Queue_isClosed(R_Queue* self) {
+  if (R_Type_IsNotOf(self, R_Queue)) return false;
+  return R_Queue_load(&self->closed);
+}
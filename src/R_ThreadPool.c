@@ -0,0 +1,372 @@
+#include <stdlib.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_ThreadPool.h"
+
+#ifdef R_TYPE_REFCOUNT
+
+//Slices per thread in R_ThreadPool_parallelFor, so a thread that finishes early has some left to steal
+#define R_ThreadPool_SlicesPerThread 4
+#define R_ThreadPool_DequeCapacity 16
+
+#ifdef R_OS_THREADS
+  #define R_ThreadPool_load(pointer) __atomic_load_n(pointer, __ATOMIC_ACQUIRE)
+  #define R_ThreadPool_store(pointer, value) __atomic_store_n(pointer, value, __ATOMIC_RELEASE)
+  #define R_ThreadPool_add(pointer, value) __atomic_add_fetch(pointer, value, __ATOMIC_SEQ_CST)
+  #define R_ThreadPool_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+  #define R_ThreadPool_load(pointer) (*(pointer))
+  #define R_ThreadPool_store(pointer, value) (*(pointer) = (value))
+  #define R_ThreadPool_add(pointer, value) (*(pointer) += (value))
+  #define R_ThreadPool_fence() do {} while(0)
+#endif
+
+struct R_ThreadPool_Task {
+  R_Type* type;
+  R_OS_Task function;
+  void* context;
+  bool done;
+};
+R_Type_Def(R_ThreadPool_Task, NULL, NULL, NULL, NULL);
+
+#ifdef R_OS_THREADS
+/*  R_ThreadPool_Worker
+    A worker thread and its deque, a ring of count tasks starting at first. The newest task is at the back. The pool
+   holds a reference to every queued task.
+ */
+typedef struct {
+  R_ThreadPool* pool;
+  pthread_t thread;
+  bool started;
+  pthread_mutex_t lock;
+  R_ThreadPool_Task** tasks;
+  size_t capacity;
+  size_t first;
+  size_t count;
+} R_ThreadPool_Worker;
+
+static __thread R_ThreadPool_Worker* R_ThreadPool_currentWorker = NULL;
+#endif
+
+struct R_ThreadPool {
+  R_Type* type;
+  R_OS_Dispatcher dispatcher;
+  size_t worker_count;
+  size_t pending;
+#ifdef R_OS_THREADS
+  R_ThreadPool_Worker* workers;
+  size_t next_worker;
+  bool stopping;
+  size_t sleepers;
+  size_t waiters;
+  pthread_mutex_t lock;
+  pthread_cond_t work;
+  pthread_cond_t finished;
+#endif
+};
+
+static R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_Constructor(R_ThreadPool* self);
+static R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_Destructor(R_ThreadPool* self);
+R_Type_Def(R_ThreadPool, R_ThreadPool_Constructor, R_ThreadPool_Destructor, NULL, NULL);
+
+static bool R_FUNCTION_ATTRIBUTES R_ThreadPool_dispatch(void* context, R_OS_Task task, void** contexts, size_t count);
+
+static R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_Constructor(R_ThreadPool* self) {
+  self->dispatcher = (R_OS_Dispatcher){R_ThreadPool_dispatch, self};
+#ifdef R_OS_THREADS
+  pthread_mutex_init(&self->lock, NULL);
+  pthread_cond_init(&self->work, NULL);
+  pthread_cond_init(&self->finished, NULL);
+#endif
+  size_t cpus = R_OS_cpuCount();
+  //A pool that fails to start every worker still works, with fewer threads
+  R_ThreadPool_setThreads(self, cpus > 1 ? cpus : 0);
+  return self;
+}
+
+static R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_Destructor(R_ThreadPool* self) {
+  R_ThreadPool_setThreads(self, 0);
+#ifdef R_OS_THREADS
+  pthread_mutex_destroy(&self->lock);
+  pthread_cond_destroy(&self->work);
+  pthread_cond_destroy(&self->finished);
+#endif
+  return self;
+}
+
+#ifdef R_OS_THREADS
+static bool R_FUNCTION_ATTRIBUTES R_ThreadPool_pushTask(R_ThreadPool_Worker* worker, R_ThreadPool_Task* task) {
+  pthread_mutex_lock(&worker->lock);
+  if (worker->count == worker->capacity) {
+    size_t capacity = worker->capacity ? worker->capacity*2 : R_ThreadPool_DequeCapacity;
+    R_ThreadPool_Task** tasks = (R_ThreadPool_Task**)os_malloc(capacity*sizeof(R_ThreadPool_Task*));
+    if (tasks == NULL) return pthread_mutex_unlock(&worker->lock), false;
+    for (size_t i=0; i<worker->count; i++) tasks[i] = worker->tasks[(worker->first + i) % worker->capacity];
+    os_free_sized(worker->tasks, worker->capacity*sizeof(R_ThreadPool_Task*));
+    worker->tasks = tasks;
+    worker->capacity = capacity;
+    worker->first = 0;
+  }
+  worker->tasks[(worker->first + worker->count) % worker->capacity] = task;
+  worker->count++;
+  pthread_mutex_unlock(&worker->lock);
+  return true;
+}
+
+static R_ThreadPool_Task* R_FUNCTION_ATTRIBUTES R_ThreadPool_popNewest(R_ThreadPool_Worker* worker) {
+  pthread_mutex_lock(&worker->lock);
+  R_ThreadPool_Task* task = NULL;
+  if (worker->count > 0) task = worker->tasks[(worker->first + --worker->count) % worker->capacity];
+  pthread_mutex_unlock(&worker->lock);
+  return task;
+}
+
+static R_ThreadPool_Task* R_FUNCTION_ATTRIBUTES R_ThreadPool_popOldest(R_ThreadPool_Worker* worker) {
+  pthread_mutex_lock(&worker->lock);
+  R_ThreadPool_Task* task = NULL;
+  if (worker->count > 0) {
+    task = worker->tasks[worker->first];
+    worker->first = (worker->first + 1) % worker->capacity;
+    worker->count--;
+  }
+  pthread_mutex_unlock(&worker->lock);
+  return task;
+}
+
+/*  R_ThreadPool_find
+    Takes a queued task: the newest from the calling worker's own deque, or else the oldest from the next worker
+   along that has one. Returns NULL if every deque is empty.
+ */
+static R_ThreadPool_Task* R_FUNCTION_ATTRIBUTES R_ThreadPool_find(R_ThreadPool* self) {
+  size_t start = 0;
+  R_ThreadPool_Worker* current = R_ThreadPool_currentWorker;
+  if (current != NULL && current->pool == self) {
+    R_ThreadPool_Task* task = R_ThreadPool_popNewest(current);
+    if (task != NULL) return task;
+    start = (size_t)(current - self->workers) + 1;
+  }
+  for (size_t i=0; i<self->worker_count; i++) {
+    R_ThreadPool_Task* task = R_ThreadPool_popOldest(&self->workers[(start + i) % self->worker_count]);
+    if (task != NULL) return task;
+  }
+  return NULL;
+}
+#endif
+
+//Runs the task and gives back the pool's reference to it
+static void R_FUNCTION_ATTRIBUTES R_ThreadPool_run(R_ThreadPool* self, R_ThreadPool_Task* task) {
+  task->function(task->context);
+  R_ThreadPool_store(&task->done, true);
+  R_ThreadPool_add(&self->pending, (size_t)-1);
+#ifdef R_OS_THREADS
+  //Pairs with waiters counting themselves in before they check again, as in R_Queue
+  R_ThreadPool_fence();
+  if (R_ThreadPool_load(&self->waiters) > 0) {
+    pthread_mutex_lock(&self->lock);
+    pthread_cond_broadcast(&self->finished);
+    pthread_mutex_unlock(&self->lock);
+  }
+#endif
+  R_Type_Release(task);
+}
+
+#ifdef R_OS_THREADS
+static void* R_FUNCTION_ATTRIBUTES R_ThreadPool_main(void* argument) {
+  R_ThreadPool_Worker* worker = (R_ThreadPool_Worker*)argument;
+  R_ThreadPool* pool = worker->pool;
+  R_ThreadPool_currentWorker = worker;
+  for (;;) {
+    R_ThreadPool_Task* task = R_ThreadPool_find(pool);
+    if (task == NULL) {
+      pthread_mutex_lock(&pool->lock);
+      R_ThreadPool_add(&pool->sleepers, 1);
+      while ((task = R_ThreadPool_find(pool)) == NULL && !pool->stopping) pthread_cond_wait(&pool->work, &pool->lock);
+      R_ThreadPool_add(&pool->sleepers, (size_t)-1);
+      pthread_mutex_unlock(&pool->lock);
+      if (task == NULL) break;
+    }
+    R_ThreadPool_run(pool, task);
+  }
+  R_ThreadPool_currentWorker = NULL;
+  return NULL;
+}
+#endif
+
+R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_setThreads(R_ThreadPool* self, size_t count) {
+  if (R_Type_IsNotOf(self, R_ThreadPool)) return NULL;
+  R_ThreadPool_waitAll(self);
+#ifdef R_OS_THREADS
+  if (self->workers != NULL) {
+    pthread_mutex_lock(&self->lock);
+    self->stopping = true;
+    pthread_cond_broadcast(&self->work);
+    pthread_mutex_unlock(&self->lock);
+    for (size_t i=0; i<self->worker_count; i++) {
+      if (self->workers[i].started) pthread_join(self->workers[i].thread, NULL);
+    }
+    //Only once they've all stopped, since any of them may still be looking in another's deque
+    for (size_t i=0; i<self->worker_count; i++) {
+      R_ThreadPool_Worker* worker = &self->workers[i];
+      pthread_mutex_destroy(&worker->lock);
+      os_free_sized(worker->tasks, worker->capacity*sizeof(R_ThreadPool_Task*));
+    }
+    os_free_sized(self->workers, self->worker_count*sizeof(R_ThreadPool_Worker));
+    self->workers = NULL;
+    self->worker_count = 0;
+    self->stopping = false;
+  }
+  if (count == 0) return self;
+
+  self->workers = (R_ThreadPool_Worker*)os_zalloc(count*sizeof(R_ThreadPool_Worker));
+  if (self->workers == NULL) return NULL;
+  for (size_t i=0; i<count; i++) {
+    self->workers[i].pool = self;
+    pthread_mutex_init(&self->workers[i].lock, NULL);
+  }
+  //Every deque is there before any thread starts looking. One without a thread of its own is emptied by the others
+  self->worker_count = count;
+  bool started = true;
+  for (size_t i=0; i<count; i++) {
+    self->workers[i].started = (pthread_create(&self->workers[i].thread, NULL, R_ThreadPool_main, &self->workers[i]) == 0);
+    started = started && self->workers[i].started;
+  }
+  return started ? self : NULL;
+#else
+  return self;
+#endif
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_ThreadPool_threads(R_ThreadPool* self) {
+  if (R_Type_IsNotOf(self, R_ThreadPool)) return 0;
+  return self->worker_count;
+}
+
+R_ThreadPool_Task* R_FUNCTION_ATTRIBUTES R_ThreadPool_submit(R_ThreadPool* self, R_OS_Task task, void* context) {
+  if (R_Type_IsNotOf(self, R_ThreadPool) || task == NULL) return NULL;
+  R_ThreadPool_Task* handle = R_Type_New(R_ThreadPool_Task);
+  if (handle == NULL) {
+    task(context);
+    return NULL;
+  }
+  handle->function = task;
+  handle->context = context;
+  R_ThreadPool_add(&self->pending, 1);
+  //The pool's own reference, given back once the task has run
+  R_Type_Retain(handle);
+#ifdef R_OS_THREADS
+  if (self->worker_count > 0) {
+    R_ThreadPool_Worker* worker = R_ThreadPool_currentWorker;
+    if (worker == NULL || worker->pool != self) worker = &self->workers[R_ThreadPool_add(&self->next_worker, 1) % self->worker_count];
+    if (R_ThreadPool_pushTask(worker, handle)) {
+      R_ThreadPool_fence();
+      if (R_ThreadPool_load(&self->sleepers) > 0) {
+        pthread_mutex_lock(&self->lock);
+        pthread_cond_signal(&self->work);
+        pthread_mutex_unlock(&self->lock);
+      }
+      return handle;
+    }
+  }
+#endif
+  R_ThreadPool_run(self, handle);
+  return handle;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_ThreadPool_isDone(R_ThreadPool_Task* task) {
+  if (R_Type_IsNotOf(task, R_ThreadPool_Task)) return false;
+  return R_ThreadPool_load(&task->done);
+}
+
+/*  R_ThreadPool_waitFor
+    Runs queued tasks until done is true, and sleeps until a task finishes when there's nothing left to run.
+ */
+static void R_FUNCTION_ATTRIBUTES R_ThreadPool_waitFor(R_ThreadPool* self, bool* done, size_t* pending) {
+#ifdef R_OS_THREADS
+  for (;;) {
+    if (done ? R_ThreadPool_load(done) : R_ThreadPool_load(pending) == 0) return;
+    R_ThreadPool_Task* task = R_ThreadPool_find(self);
+    if (task != NULL) {
+      R_ThreadPool_run(self, task);
+      continue;
+    }
+    pthread_mutex_lock(&self->lock);
+    R_ThreadPool_add(&self->waiters, 1);
+    if (done ? !R_ThreadPool_load(done) : R_ThreadPool_load(pending) != 0) pthread_cond_wait(&self->finished, &self->lock);
+    R_ThreadPool_add(&self->waiters, (size_t)-1);
+    pthread_mutex_unlock(&self->lock);
+  }
+#endif
+}
+
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_wait(R_ThreadPool* self, R_ThreadPool_Task* task) {
+  if (R_Type_IsNotOf(self, R_ThreadPool) || R_Type_IsNotOf(task, R_ThreadPool_Task)) return;
+  R_ThreadPool_waitFor(self, &task->done, NULL);
+}
+
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_waitAll(R_ThreadPool* self) {
+  if (R_Type_IsNotOf(self, R_ThreadPool)) return;
+  R_ThreadPool_waitFor(self, NULL, &self->pending);
+}
+
+typedef struct {
+  R_ThreadPool_RangeTask task;
+  void* context;
+  size_t begin;
+  size_t end;
+} R_ThreadPool_Slice;
+
+static void R_FUNCTION_ATTRIBUTES R_ThreadPool_runSlice(void* argument) {
+  R_ThreadPool_Slice* slice = (R_ThreadPool_Slice*)argument;
+  slice->task(slice->context, slice->begin, slice->end);
+}
+
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_parallelFor(R_ThreadPool* self, R_ThreadPool_RangeTask task, void* context, size_t count) {
+  if (R_Type_IsNotOf(self, R_ThreadPool) || task == NULL || count == 0) return;
+  size_t slice_count = (self->worker_count + 1)*R_ThreadPool_SlicesPerThread;
+  if (slice_count > count) slice_count = count;
+  R_ThreadPool_Slice* slices = self->worker_count ? (R_ThreadPool_Slice*)os_malloc(slice_count*sizeof(R_ThreadPool_Slice)) : NULL;
+  R_ThreadPool_Task** handles = slices ? (R_ThreadPool_Task**)os_malloc(slice_count*sizeof(R_ThreadPool_Task*)) : NULL;
+  if (handles == NULL) {
+    if (slices != NULL) os_free_sized(slices, slice_count*sizeof(R_ThreadPool_Slice));
+    task(context, 0, count);
+    return;
+  }
+  for (size_t i=0; i<slice_count; i++) slices[i] = (R_ThreadPool_Slice){task, context, count*i/slice_count, count*(i + 1)/slice_count};
+  //The calling thread takes the first slice itself
+  for (size_t i=1; i<slice_count; i++) handles[i] = R_ThreadPool_submit(self, R_ThreadPool_runSlice, &slices[i]);
+  R_ThreadPool_runSlice(&slices[0]);
+  for (size_t i=1; i<slice_count; i++) {
+    R_ThreadPool_wait(self, handles[i]);
+    R_Type_Delete(handles[i]);
+  }
+  os_free_sized(handles, slice_count*sizeof(R_ThreadPool_Task*));
+  os_free_sized(slices, slice_count*sizeof(R_ThreadPool_Slice));
+}
+
+//The R_OS_Dispatcher of an installed pool. The calling thread takes the first task itself
+static bool R_FUNCTION_ATTRIBUTES R_ThreadPool_dispatch(void* context, R_OS_Task task, void** contexts, size_t count) {
+  R_ThreadPool* self = (R_ThreadPool*)context;
+  R_ThreadPool_Task** handles = (R_ThreadPool_Task**)os_malloc(count*sizeof(R_ThreadPool_Task*));
+  if (handles == NULL) return false;
+  for (size_t i=1; i<count; i++) handles[i] = R_ThreadPool_submit(self, task, contexts[i]);
+  task(contexts[0]);
+  for (size_t i=1; i<count; i++) {
+    R_ThreadPool_wait(self, handles[i]);
+    R_Type_Delete(handles[i]);
+  }
+  os_free_sized(handles, count*sizeof(R_ThreadPool_Task*));
+  return true;
+}
+
+void R_FUNCTION_ATTRIBUTES R_ThreadPool_install(R_ThreadPool* self) {
+  if (self == NULL) R_OS_setDispatcher(NULL);
+  else if (R_Type_IsOf(self, R_ThreadPool)) R_OS_setDispatcher(&self->dispatcher);
+}
+
+R_ThreadPool* R_FUNCTION_ATTRIBUTES R_ThreadPool_installed(void) {
+  const R_OS_Dispatcher* dispatcher = R_OS_dispatcher();
+  if (dispatcher == NULL || dispatcher->run != R_ThreadPool_dispatch) return NULL;
+  return (R_ThreadPool*)dispatcher->context;
+}
+
+#endif
@@ -0,0 +1,618 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_Trie.h"
+
+//Prefixes up to this long are kept in the node itself rather than in a buffer of their own
+#define R_Trie_InlinePrefix 8
+
+//Node kinds, from no children up to one for every byte. A full node grows into the next kind.
+enum {
+  R_Trie_Kind_Leaf,
+  R_Trie_Kind_4,
+  R_Trie_Kind_16,
+  R_Trie_Kind_48,
+  R_Trie_Kind_256
+};
+
+/*  R_Trie_Node
+    The header every node starts with. prefix is the bytes of the key between the byte its parent branched on and the
+   node's own branch, and value is set if a key ends at the node. A leaf is just the header.
+ */
+typedef struct R_Trie_Node R_Trie_Node;
+struct R_Trie_Node {
+  uint8_t kind;
+  uint16_t count;
+  uint32_t prefix_length;
+  union {
+    uint8_t bytes[R_Trie_InlinePrefix];
+    uint8_t* buffer;
+  } prefix;
+  void* value;
+};
+
+//Nodes of up to 4 and 16 children keep their bytes sorted, with the children in the same order
+typedef struct {
+  R_Trie_Node node;
+  uint8_t keys[4];
+  R_Trie_Node* children[4];
+} R_Trie_Node4;
+
+typedef struct {
+  R_Trie_Node node;
+  uint8_t keys[16];
+  R_Trie_Node* children[16];
+} R_Trie_Node16;
+
+//index holds one more than the slot of each byte's child, or 0 if the byte has none
+typedef struct {
+  R_Trie_Node node;
+  uint8_t index[256];
+  R_Trie_Node* children[48];
+} R_Trie_Node48;
+
+typedef struct {
+  R_Trie_Node node;
+  R_Trie_Node* children[256];
+} R_Trie_Node256;
+
+static const size_t R_Trie_nodeSizes[] = {sizeof(R_Trie_Node), sizeof(R_Trie_Node4), sizeof(R_Trie_Node16), sizeof(R_Trie_Node48), sizeof(R_Trie_Node256)};
+static const uint16_t R_Trie_capacities[] = {0, 4, 16, 48, 256};
+//A node with fewer children than this shrinks to the kind below, leaving some room so it doesn't grow straight back
+static const uint16_t R_Trie_shrinkBelow[] = {0, 1, 4, 13, 41};
+
+struct R_Trie {
+  R_Type* type;
+  R_Trie_Node* root;
+  size_t size;
+};
+
+typedef struct {
+  uint8_t* key;
+  size_t length;
+  size_t capacity;
+  R_Trie_Callback callback;
+  void* context;
+  size_t count;
+} R_Trie_Visit;
+
+static R_Trie* R_FUNCTION_ATTRIBUTES R_Trie_Destructor(R_Trie* self);
+static R_Trie* R_FUNCTION_ATTRIBUTES R_Trie_Copier(R_Trie* self, R_Trie* new);
+R_Type_Define(R_Trie,
+  .dtor = (R_Type_Destructor)R_Trie_Destructor,
+  .copy = (R_Type_Copier)R_Trie_Copier);
+
+static uint8_t* R_FUNCTION_ATTRIBUTES R_Trie_prefix(R_Trie_Node* node) {
+  return node->prefix_length > R_Trie_InlinePrefix ? node->prefix.buffer : node->prefix.bytes;
+}
+
+static R_Trie_Node* R_FUNCTION_ATTRIBUTES R_Trie_newNode(uint8_t kind) {
+  R_Trie_Node* node = (R_Trie_Node*)os_zalloc(R_Trie_nodeSizes[kind]);
+  if (node != NULL) node->kind = kind;
+  return node;
+}
+
+//Frees the node and its prefix, but not its value or children
+static void R_FUNCTION_ATTRIBUTES R_Trie_freeNode(R_Trie_Node* node) {
+  if (node->prefix_length > R_Trie_InlinePrefix) os_free_sized(node->prefix.buffer, node->prefix_length);
+  os_free_sized(node, R_Trie_nodeSizes[node->kind]);
+}
+
+/*  R_Trie_setPrefix
+    Sets the node's prefix to a copy of bytes, which may point into its current prefix. Returns false, leaving the
+   prefix as it was, if a buffer for it can't be allocated.
+ */
+static bool R_FUNCTION_ATTRIBUTES R_Trie_setPrefix(R_Trie_Node* node, const uint8_t* bytes, size_t length) {
+  uint8_t* old = node->prefix_length > R_Trie_InlinePrefix ? node->prefix.buffer : NULL;
+  if (length > R_Trie_InlinePrefix) {
+    uint8_t* buffer = (uint8_t*)os_malloc(length);
+    if (buffer == NULL) return false;
+    memcpy(buffer, bytes, length);
+    node->prefix.buffer = buffer;
+  }
+  else {
+    memmove(node->prefix.bytes, bytes, length);
+  }
+  if (old != NULL) os_free_sized(old, node->prefix_length);
+  node->prefix_length = (uint32_t)length;
+  return true;
+}
+
+static R_Trie_Node* R_FUNCTION_ATTRIBUTES R_Trie_newLeaf(const uint8_t* prefix, size_t length) {
+  R_Trie_Node* leaf = R_Trie_newNode(R_Trie_Kind_Leaf);
+  if (leaf != NULL && !R_Trie_setPrefix(leaf, prefix, length)) R_Trie_freeNode(leaf), leaf = NULL;
+  return leaf;
+}
+
+//The sorted bytes and children of a node of kind 4 or 16
+static uint8_t* R_FUNCTION_ATTRIBUTES R_Trie_keys(R_Trie_Node* node) {
+  return node->kind == R_Trie_Kind_4 ? ((R_Trie_Node4*)node)->keys : ((R_Trie_Node16*)node)->keys;
+}
+
+static R_Trie_Node** R_FUNCTION_ATTRIBUTES R_Trie_sortedChildren(R_Trie_Node* node) {
+  return node->kind == R_Trie_Kind_4 ? ((R_Trie_Node4*)node)->children : ((R_Trie_Node16*)node)->children;
+}
+
+//Returns the slot holding the child for byte, or NULL if there's none
+static R_Trie_Node** R_FUNCTION_ATTRIBUTES R_Trie_findChild(R_Trie_Node* node, uint8_t byte) {
+  switch (node->kind) {
+    case R_Trie_Kind_4:
+    case R_Trie_Kind_16: {
+      uint8_t* keys = R_Trie_keys(node);
+      for (size_t i=0; i<node->count && keys[i] <= byte; i++) {
+        if (keys[i] == byte) return &R_Trie_sortedChildren(node)[i];
+      }
+      return NULL;
+    }
+    case R_Trie_Kind_48: {
+      R_Trie_Node48* node48 = (R_Trie_Node48*)node;
+      return node48->index[byte] ? &node48->children[node48->index[byte] - 1] : NULL;
+    }
+    case R_Trie_Kind_256: {
+      R_Trie_Node256* node256 = (R_Trie_Node256*)node;
+      return node256->children[byte] ? &node256->children[byte] : NULL;
+    }
+    default:
+      return NULL;
+  }
+}
+
+/*  R_Trie_nextChild
+    Returns the slot of the next child in byte order, starting from position, and sets byte to its byte. Returns NULL
+   after the last child. position starts at 0.
+ */
+static R_Trie_Node** R_FUNCTION_ATTRIBUTES R_Trie_nextChild(R_Trie_Node* node, size_t* position, uint8_t* byte) {
+  switch (node->kind) {
+    case R_Trie_Kind_4:
+    case R_Trie_Kind_16:
+      if (*position >= node->count) return NULL;
+      *byte = R_Trie_keys(node)[*position];
+      return &R_Trie_sortedChildren(node)[(*position)++];
+    case R_Trie_Kind_48: {
+      R_Trie_Node48* node48 = (R_Trie_Node48*)node;
+      for (; *position < 256; (*position)++) {
+        if (node48->index[*position] == 0) continue;
+        *byte = (uint8_t)*position;
+        return &node48->children[node48->index[(*position)++] - 1];
+      }
+      return NULL;
+    }
+    case R_Trie_Kind_256: {
+      R_Trie_Node256* node256 = (R_Trie_Node256*)node;
+      for (; *position < 256; (*position)++) {
+        if (node256->children[*position] == NULL) continue;
+        *byte = (uint8_t)*position;
+        return &node256->children[(*position)++];
+      }
+      return NULL;
+    }
+    default:
+      return NULL;
+  }
+}
+
+//Adds a child for byte, which mustn't have one yet, to a node with room for it
+static void R_FUNCTION_ATTRIBUTES R_Trie_addChild(R_Trie_Node* node, uint8_t byte, R_Trie_Node* child) {
+  switch (node->kind) {
+    case R_Trie_Kind_4:
+    case R_Trie_Kind_16: {
+      uint8_t* keys = R_Trie_keys(node);
+      R_Trie_Node** children = R_Trie_sortedChildren(node);
+      size_t i = node->count;
+      for (; i > 0 && keys[i - 1] > byte; i--) {
+        keys[i] = keys[i - 1];
+        children[i] = children[i - 1];
+      }
+      keys[i] = byte;
+      children[i] = child;
+      break;
+    }
+    case R_Trie_Kind_48: {
+      R_Trie_Node48* node48 = (R_Trie_Node48*)node;
+      size_t slot = 0;
+      while (node48->children[slot] != NULL) slot++;
+      node48->children[slot] = child;
+      node48->index[byte] = (uint8_t)(slot + 1);
+      break;
+    }
+    case R_Trie_Kind_256:
+      ((R_Trie_Node256*)node)->children[byte] = child;
+      break;
+  }
+  node->count++;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Trie_removeChild(R_Trie_Node* node, uint8_t byte) {
+  switch (node->kind) {
+    case R_Trie_Kind_4:
+    case R_Trie_Kind_16: {
+      uint8_t* keys = R_Trie_keys(node);
+      R_Trie_Node** children = R_Trie_sortedChildren(node);
+      size_t i = 0;
+      while (keys[i] != byte) i++;
+      memmove(&keys[i], &keys[i + 1], node->count - i - 1);
+      memmove(&children[i], &children[i + 1], (node->count - i - 1)*sizeof(R_Trie_Node*));
+      break;
+    }
+    case R_Trie_Kind_48: {
+      R_Trie_Node48* node48 = (R_Trie_Node48*)node;
+      node48->children[node48->index[byte] - 1] = NULL;
+      node48->index[byte] = 0;
+      break;
+    }
+    case R_Trie_Kind_256:
+      ((R_Trie_Node256*)node)->children[byte] = NULL;
+      break;
+  }
+  node->count--;
+}
+
+//Moves the node into a new node of the given kind, which must have room for its children. Returns NULL, leaving the node as it was, if the new node can't be allocated.
+static R_Trie_Node* R_FUNCTION_ATTRIBUTES R_Trie_resize(R_Trie_Node* node, uint8_t kind) {
+  R_Trie_Node* resized = R_Trie_newNode(kind);
+  if (resized == NULL) return NULL;
+  resized->prefix_length = node->prefix_length;
+  resized->prefix = node->prefix;
+  resized->value = node->value;
+  size_t position = 0;
+  uint8_t byte = 0;
+  R_Trie_Node** child = NULL;
+  while ((child = R_Trie_nextChild(node, &position, &byte)) != NULL) R_Trie_addChild(resized, byte, *child);
+  //The prefix buffer now belongs to resized
+  node->prefix_length = 0;
+  R_Trie_freeNode(node);
+  return resized;
+}
+
+static void R_FUNCTION_ATTRIBUTES R_Trie_deleteNode(R_Trie_Node* node) {
+  size_t position = 0;
+  uint8_t byte = 0;
+  R_Trie_Node** child = NULL;
+  while ((child = R_Trie_nextChild(node, &position, &byte)) != NULL) {
+    if (*child != NULL) R_Trie_deleteNode(*child);
+  }
+  R_Type_Delete(node->value);
+  R_Trie_freeNode(node);
+}
+
+static R_Trie_Node* R_FUNCTION_ATTRIBUTES R_Trie_copyNode(R_Trie_Node* node) {
+  R_Trie_Node* copy = (R_Trie_Node*)os_malloc(R_Trie_nodeSizes[node->kind]);
+  if (copy == NULL) return NULL;
+  memcpy(copy, node, R_Trie_nodeSizes[node->kind]);
+  bool failed = false;
+  if (node->prefix_length > R_Trie_InlinePrefix) {
+    copy->prefix.buffer = (uint8_t*)os_malloc(node->prefix_length);
+    if (copy->prefix.buffer != NULL) memcpy(copy->prefix.buffer, node->prefix.buffer, node->prefix_length);
+    else copy->prefix_length = 0, failed = true;
+  }
+  if (node->value != NULL) {
+    copy->value = R_Type_Copy(node->value);
+    failed = failed || copy->value == NULL;
+  }
+
+  //Children that weren't copied are left NULL, which R_Trie_deleteNode skips
+  size_t position = 0;
+  uint8_t byte = 0;
+  R_Trie_Node** child = NULL;
+  while ((child = R_Trie_nextChild(copy, &position, &byte)) != NULL) {
+    *child = failed ? NULL : R_Trie_copyNode(*child);
+    failed = failed || *child == NULL;
+  }
+  if (failed) R_Trie_deleteNode(copy), copy = NULL;
+  return copy;
+}
+
+static R_Trie* R_FUNCTION_ATTRIBUTES R_Trie_Destructor(R_Trie* self) {
+  if (self->root != NULL) R_Trie_deleteNode(self->root);
+  self->root = NULL;
+  self->size = 0;
+  return self;
+}
+
+static R_Trie* R_FUNCTION_ATTRIBUTES R_Trie_Copier(R_Trie* self, R_Trie* new) {
+  if (self->root != NULL) {
+    new->root = R_Trie_copyNode(self->root);
+    if (new->root == NULL) return R_Type_Delete(new), NULL;
+  }
+  new->size = self->size;
+  return new;
+}
+
+/*  R_Trie_split
+    Splits the node in ref where key stops matching its prefix, matched bytes in, under a new node that branches
+   between the rest of the node and the rest of key. Returns the value slot for key, or NULL, leaving the trie as it
+   was, if the nodes can't be allocated.
+ */
+static void** R_FUNCTION_ATTRIBUTES R_Trie_split(R_Trie_Node** ref, const uint8_t* key, size_t length, size_t depth, size_t matched) {
+  R_Trie_Node* node = *ref;
+  uint8_t* prefix = R_Trie_prefix(node);
+  uint8_t branch = prefix[matched];
+  bool ends = (depth + matched == length);
+  R_Trie_Node* parent = R_Trie_newNode(R_Trie_Kind_4);
+  R_Trie_Node* leaf = ends ? NULL : R_Trie_newLeaf(key + depth + matched + 1, length - depth - matched - 1);
+  if (parent == NULL || (!ends && leaf == NULL) || !R_Trie_setPrefix(parent, key + depth, matched) ||
+      !R_Trie_setPrefix(node, prefix + matched + 1, node->prefix_length - matched - 1)) {
+    if (parent != NULL) R_Trie_freeNode(parent);
+    if (leaf != NULL) R_Trie_freeNode(leaf);
+    return NULL;
+  }
+
+  R_Trie_addChild(parent, branch, node);
+  if (!ends) R_Trie_addChild(parent, key[depth + matched], leaf);
+  *ref = parent;
+  return ends ? &parent->value : &leaf->value;
+}
+
+//Adds a leaf for the rest of key, after the byte at depth, to the node in ref, growing the node if it's full
+static void** R_FUNCTION_ATTRIBUTES R_Trie_addLeaf(R_Trie_Node** ref, const uint8_t* key, size_t length, size_t depth) {
+  R_Trie_Node* node = *ref;
+  R_Trie_Node* leaf = R_Trie_newLeaf(key + depth + 1, length - depth - 1);
+  if (leaf == NULL) return NULL;
+  if (node->count == R_Trie_capacities[node->kind]) {
+    node = R_Trie_resize(node, node->kind + 1);
+    if (node == NULL) return R_Trie_freeNode(leaf), NULL;
+    *ref = node;
+  }
+  R_Trie_addChild(node, key[depth], leaf);
+  return &leaf->value;
+}
+
+//Returns the slot for key's value, adding nodes for it if it's missing, or NULL if they can't be allocated
+static void** R_FUNCTION_ATTRIBUTES R_Trie_insert(R_Trie* self, const uint8_t* key, size_t length) {
+  R_Trie_Node** ref = &self->root;
+  size_t depth = 0;
+  while (*ref != NULL) {
+    R_Trie_Node* node = *ref;
+    uint8_t* prefix = R_Trie_prefix(node);
+    size_t matched = 0;
+    while (matched < node->prefix_length && depth + matched < length && prefix[matched] == key[depth + matched]) matched++;
+    if (matched < node->prefix_length) return R_Trie_split(ref, key, length, depth, matched);
+    depth += matched;
+    if (depth == length) return &node->value;
+    R_Trie_Node** child = R_Trie_findChild(node, key[depth]);
+    if (child == NULL) return R_Trie_addLeaf(ref, key, length, depth);
+    ref = child;
+    depth++;
+  }
+  R_Trie_Node* leaf = R_Trie_newLeaf(key, length);
+  if (leaf == NULL) return NULL;
+  *ref = leaf;
+  return &leaf->value;
+}
+
+/*  R_Trie_find
+    Returns the slot of the node where key ends, or NULL if key doesn't exist. Sets parent to the slot of the node
+   above it, or NULL for the root, and branch to the byte the parent branched on.
+ */
+static R_Trie_Node** R_FUNCTION_ATTRIBUTES R_Trie_find(R_Trie* self, const char* key, R_Trie_Node*** parent, uint8_t* branch) {
+  const uint8_t* bytes = (const uint8_t*)key;
+  size_t length = strlen(key);
+  size_t depth = 0;
+  R_Trie_Node** ref = &self->root;
+  R_Trie_Node** above = NULL;
+  uint8_t byte = 0;
+  while (*ref != NULL) {
+    R_Trie_Node* node = *ref;
+    if (length - depth < node->prefix_length || memcmp(R_Trie_prefix(node), bytes + depth, node->prefix_length) != 0) return NULL;
+    depth += node->prefix_length;
+    if (depth == length) break;
+    above = ref;
+    byte = bytes[depth++];
+    ref = R_Trie_findChild(node, byte);
+    if (ref == NULL) return NULL;
+  }
+  if (*ref == NULL || (*ref)->value == NULL) return NULL;
+  if (parent != NULL) *parent = above;
+  if (branch != NULL) *branch = byte;
+  return ref;
+}
+
+/*  R_Trie_tidy
+    Restores the node in ref to its smallest form after a child or its value was removed: a node with neither a
+   value nor a second child is joined to its child, and a node that's become sparse shrinks. Either is skipped if
+   memory for it can't be allocated, which leaves a trie that's larger than it needs to be but still correct.
+ */
+static void R_FUNCTION_ATTRIBUTES R_Trie_tidy(R_Trie_Node** ref) {
+  R_Trie_Node* node = *ref;
+  if (node->value == NULL && node->count == 1) {
+    size_t position = 0;
+    uint8_t byte = 0;
+    R_Trie_Node* child = *R_Trie_nextChild(node, &position, &byte);
+    size_t length = node->prefix_length + 1 + child->prefix_length;
+    uint8_t* joined = (uint8_t*)os_malloc(length);
+    if (joined == NULL) return;
+    memcpy(joined, R_Trie_prefix(node), node->prefix_length);
+    joined[node->prefix_length] = byte;
+    memcpy(joined + node->prefix_length + 1, R_Trie_prefix(child), child->prefix_length);
+    bool joinedPrefix = R_Trie_setPrefix(child, joined, length);
+    os_free_sized(joined, length);
+    if (!joinedPrefix) return;
+    *ref = child;
+    R_Trie_freeNode(node);
+  }
+  else if (node->count < R_Trie_shrinkBelow[node->kind]) {
+    R_Trie_Node* resized = R_Trie_resize(node, node->kind - 1);
+    if (resized != NULL) *ref = resized;
+  }
+}
+
+static bool R_FUNCTION_ATTRIBUTES R_Trie_append(R_Trie_Visit* visit, const uint8_t* bytes, size_t length) {
+  //One more byte for the terminator the callback sees
+  if (visit->length + length + 1 > visit->capacity) {
+    size_t capacity = 2*(visit->length + length + 1);
+    uint8_t* key = (uint8_t*)os_realloc_sized(visit->key, visit->capacity, capacity);
+    if (key == NULL) return false;
+    visit->key = key;
+    visit->capacity = capacity;
+  }
+  memcpy(visit->key + visit->length, bytes, length);
+  visit->length += length;
+  return true;
+}
+
+//Visits the key ending at node, then its children's, with the key so far in visit. Returns false once the callback stops.
+static bool R_FUNCTION_ATTRIBUTES R_Trie_visitNode(R_Trie_Node* node, R_Trie_Visit* visit) {
+  size_t length = visit->length;
+  bool more = R_Trie_append(visit, R_Trie_prefix(node), node->prefix_length);
+  if (more && node->value != NULL) {
+    visit->key[visit->length] = '\0';
+    visit->count++;
+    more = visit->callback((const char*)visit->key, node->value, visit->context);
+  }
+
+  size_t position = 0;
+  uint8_t byte = 0;
+  R_Trie_Node** child = NULL;
+  while (more && (child = R_Trie_nextChild(node, &position, &byte)) != NULL) {
+    more = R_Trie_append(visit, &byte, 1) && R_Trie_visitNode(*child, visit);
+    visit->length = length + node->prefix_length;
+  }
+  visit->length = length;
+  return more;
+}
+
+static size_t R_FUNCTION_ATTRIBUTES R_Trie_nodeBytes(R_Trie_Node* node) {
+  size_t bytes = R_Trie_nodeSizes[node->kind] + (node->prefix_length > R_Trie_InlinePrefix ? node->prefix_length : 0);
+  size_t position = 0;
+  uint8_t byte = 0;
+  R_Trie_Node** child = NULL;
+  while ((child = R_Trie_nextChild(node, &position, &byte)) != NULL) bytes += R_Trie_nodeBytes(*child);
+  return bytes;
+}
+
+//Sets object as the value of key, deleting the value it replaces. Returns NULL if the key can't be added.
+static void* R_FUNCTION_ATTRIBUTES R_Trie_setValue(R_Trie* self, const char* key, void* object) {
+  void** value = R_Trie_insert(self, (const uint8_t*)key, strlen(key));
+  if (value == NULL) return NULL;
+  if (*value == NULL) self->size++;
+  else R_Type_Delete(*value);
+  *value = object;
+  return object;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Trie_addObjectOfType(R_Trie* self, const char* key, const R_Type* type) {
+  if (R_Type_IsNotOf(self, R_Trie) || key == NULL || type == NULL) return NULL;
+  void* object = R_Type_NewObjectOfType(type);
+  if (object == NULL) return NULL;
+  if (R_Trie_setValue(self, key, object) == NULL) return R_Type_Delete(object), NULL;
+  return object;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Trie_addCopy(R_Trie* self, const char* key, const void* object) {
+  if (R_Type_IsNotOf(self, R_Trie) || key == NULL || object == NULL) return NULL;
+  void* copy = R_Type_Copy(object);
+  if (copy == NULL) return NULL;
+  if (R_Trie_setValue(self, key, copy) == NULL) return R_Type_Delete(copy), NULL;
+  return copy;
+}
+
+#ifdef R_TYPE_REFCOUNT
+void* R_FUNCTION_ATTRIBUTES R_Trie_addShared(R_Trie* self, const char* key, void* object) {
+  if (R_Type_IsNotOf(self, R_Trie) || key == NULL || object == NULL) return NULL;
+  if (R_Trie_setValue(self, key, R_Type_Retain(object)) == NULL) return R_Type_Release(object), NULL;
+  return object;
+}
+#endif
+
+void* R_FUNCTION_ATTRIBUTES R_Trie_transferOwnership(R_Trie* self, const char* key, void* object) {
+  if (R_Type_IsNotOf(self, R_Trie) || key == NULL || object == NULL) return NULL;
+  return R_Trie_setValue(self, key, object);
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Trie_get(R_Trie* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_Trie) || key == NULL) return NULL;
+  R_Trie_Node** ref = R_Trie_find(self, key, NULL, NULL);
+  return ref ? (*ref)->value : NULL;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_Trie_isPresent(R_Trie* self, const char* key) {
+  return R_Trie_get(self, key) != NULL;
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Trie_longestPrefix(R_Trie* self, const char* string, size_t* length) {
+  if (R_Type_IsNotOf(self, R_Trie) || string == NULL) return NULL;
+  const uint8_t* bytes = (const uint8_t*)string;
+  size_t string_length = strlen(string);
+  size_t depth = 0;
+  void* value = NULL;
+  R_Trie_Node* node = self->root;
+  while (node != NULL) {
+    if (string_length - depth < node->prefix_length || memcmp(R_Trie_prefix(node), bytes + depth, node->prefix_length) != 0) break;
+    depth += node->prefix_length;
+    if (node->value != NULL) {
+      value = node->value;
+      if (length != NULL) *length = depth;
+    }
+    if (depth == string_length) break;
+    R_Trie_Node** child = R_Trie_findChild(node, bytes[depth++]);
+    node = child ? *child : NULL;
+  }
+  return value;
+}
+
+bool R_FUNCTION_ATTRIBUTES R_Trie_remove(R_Trie* self, const char* key) {
+  if (R_Type_IsNotOf(self, R_Trie) || key == NULL) return false;
+  R_Trie_Node** parent = NULL;
+  uint8_t branch = 0;
+  R_Trie_Node** ref = R_Trie_find(self, key, &parent, &branch);
+  if (ref == NULL) return false;
+
+  R_Trie_Node* node = *ref;
+  R_Type_DeleteAndNull(node->value);
+  self->size--;
+  if (node->count == 0) {
+    R_Trie_freeNode(node);
+    if (parent == NULL) {
+      self->root = NULL;
+      return true;
+    }
+    R_Trie_removeChild(*parent, branch);
+    ref = parent;
+  }
+  R_Trie_tidy(ref);
+  return true;
+}
+
+void R_FUNCTION_ATTRIBUTES R_Trie_removeAll(R_Trie* self) {
+  if (R_Type_IsNotOf(self, R_Trie)) return;
+  R_Trie_Destructor(self);
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Trie_size(R_Trie* self) {
+  if (R_Type_IsNotOf(self, R_Trie)) return 0;
+  return self->size;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Trie_each(R_Trie* self, R_Trie_Callback callback, void* context) {
+  return R_Trie_eachWithPrefix(self, "", callback, context);
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Trie_eachWithPrefix(R_Trie* self, const char* prefix, R_Trie_Callback callback, void* context) {
+  if (R_Type_IsNotOf(self, R_Trie) || prefix == NULL || callback == NULL) return 0;
+  const uint8_t* bytes = (const uint8_t*)prefix;
+  size_t length = strlen(prefix);
+  size_t depth = 0;
+  //Finds the highest node whose keys all start with prefix
+  R_Trie_Node* node = self->root;
+  while (node != NULL) {
+    size_t remaining = length - depth;
+    size_t compared = remaining < node->prefix_length ? remaining : node->prefix_length;
+    if (memcmp(R_Trie_prefix(node), bytes + depth, compared) != 0) return 0;
+    if (remaining <= node->prefix_length) break;
+    depth += node->prefix_length;
+    R_Trie_Node** child = R_Trie_findChild(node, bytes[depth++]);
+    node = child ? *child : NULL;
+  }
+  if (node == NULL) return 0;
+
+  R_Trie_Visit visit = {.callback = callback, .context = context};
+  if (R_Trie_append(&visit, bytes, depth)) R_Trie_visitNode(node, &visit);
+  os_free_sized(visit.key, visit.capacity);
+  return visit.count;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Trie_bytesUsed(R_Trie* self) {
+  if (R_Type_IsNotOf(self, R_Trie)) return 0;
+  return sizeof(R_Trie) + (self->root ? R_Trie_nodeBytes(self->root) : 0);
+}
@@ -4,17 +4,64 @@
 
 size_t R_Type_BytesAllocated = 0;
 
+#ifdef R_TYPE_REFCOUNT
+/*  R_Type_Header
+    Stored just before every object. references counts the owners, starting at 1. The union keeps the object after it
+   aligned for any of its fields.
+ */
+typedef union {
+  size_t references;
+  void* pointer;
+  double number;
+  long long integer;
+} R_Type_Header;
+
+#define R_Type_headerSize sizeof(R_Type_Header)
+#define R_Type_headerOf(object) ((R_Type_Header*)(object) - 1)
+#else
+#define R_Type_headerSize 0
+#endif
+
+#define R_Type_allocatedSize(type) ((type)->size + R_Type_headerSize)
+#define R_Type_allocationOf(object) ((uint8_t*)(object) - R_Type_headerSize)
+
+#ifdef R_OS_ALLOCATOR
+  #define R_Type_zalloc(type, file, line) R_Allocator_zalloc(R_Type_allocatedSize(type), file, line, (type)->name)
+  #define R_Type_free(type, object) R_Allocator_free(R_Type_allocationOf(object), R_Type_allocatedSize(type), __FILE__, __LINE__, (type)->name)
+#else
+  #define R_Type_zalloc(type, file, line) os_zalloc(R_Type_allocatedSize(type))
+  #define R_Type_free(type, object) os_free(R_Type_allocationOf(object))
+#endif
+
+#ifdef R_OS_THREADS
+  #define R_Type_loadReferences(header) __atomic_load_n(&(header)->references, __ATOMIC_ACQUIRE)
+  #define R_Type_retainHeader(header) ((void)__atomic_add_fetch(&(header)->references, 1, __ATOMIC_RELAXED))
+  #define R_Type_releaseHeader(header) __atomic_sub_fetch(&(header)->references, 1, __ATOMIC_ACQ_REL)
+#else
+  #define R_Type_loadReferences(header) ((header)->references)
+  #define R_Type_retainHeader(header) ((void)++(header)->references)
+  #define R_Type_releaseHeader(header) (--(header)->references)
+#endif
+
 void* R_FUNCTION_ATTRIBUTES R_Type_NewObjectOfType(const R_Type* type) {
+  return R_Type_NewObjectOfTypeAt(type, __FILE__, __LINE__);
+}
+
+void* R_FUNCTION_ATTRIBUTES R_Type_NewObjectOfTypeAt(const R_Type* type, const char* file, int line) {
   if (type->size < sizeof(R_Type*)) return NULL; //If they were equal, this object would be useless. No good reason to limit that though...
-  void* new_object = type->alloc ? type->alloc(type->size) : (void*)os_zalloc(type->size);
-  if (new_object == NULL) return NULL;
+  uint8_t* allocation = type->alloc ? type->alloc(R_Type_allocatedSize(type)) : (uint8_t*)R_Type_zalloc(type, file, line);
+  if (allocation == NULL) return NULL;
+  void* new_object = allocation + R_Type_headerSize;
+#ifdef R_TYPE_REFCOUNT
+  R_Type_headerOf(new_object)->references = 1;
+#endif
   *(const R_Type**)new_object = type;
-  R_Type_BytesAllocated += type->size;
+  R_Type_addBytesAllocated(type->size);
   if (type->ctor != NULL && type->ctor(new_object) == NULL) {
     //Constructor has failed
     if (type->dtor != NULL) type->dtor(new_object);
-    os_free(new_object);
-    R_Type_BytesAllocated -= type->size;
+    R_Type_free(type, new_object);
+    R_Type_subtractBytesAllocated(type->size);
     return NULL;
   }
   return new_object;
@@ -22,10 +69,15 @@ void* R_FUNCTION_ATTRIBUTES R_Type_NewObjectOfType(const R_Type* type) {
 
 void R_FUNCTION_ATTRIBUTES R_Type_Delete(void* object) {
   if (object == NULL) return;
+#ifdef R_TYPE_REFCOUNT
+  R_Type_Header* header = R_Type_headerOf(object);
+  //A lone owner can't race with a retain, since nobody else has the pointer to retain it with
+  if (R_Type_loadReferences(header) != 1 && R_Type_releaseHeader(header) != 0) return;
+#endif
   R_Type* type = *(R_Type**)object; //First element of every object must be an R_Type*
-  R_Type_BytesAllocated -= type->size;
-  if (type->dtor != NULL) os_free(type->dtor(object));
-  else os_free(object);
+  R_Type_subtractBytesAllocated(type->size);
+  if (type->dtor != NULL) R_Type_free(type, type->dtor(object));
+  else R_Type_free(type, object);
 }
 
 void* R_FUNCTION_ATTRIBUTES R_Type_Copy(const void* object) {
@@ -38,6 +90,34 @@ void* R_FUNCTION_ATTRIBUTES R_Type_Copy(const void* object) {
   return NULL;
 }
 
+void* R_FUNCTION_ATTRIBUTES R_Type_Move(void* object) {
+  if (object == NULL) return NULL;
+  R_Type* type = *(R_Type**)object; //First element of every object must be an R_Type*
+#ifdef R_TYPE_REFCOUNT
+  if (R_Type_IsShared(object)) return R_Type_Copy(object);
+#endif
+  if (type->move == NULL) return R_Type_Copy(object);
+
+  void* new_object = R_Type_NewObjectOfType(type);
+  if (new_object == NULL) return NULL;
+  void* moved = type->move(object, new_object);
+  if (moved == NULL) R_Type_Delete(new_object);
+  return moved;
+}
+
+#ifdef R_TYPE_REFCOUNT
+void* R_FUNCTION_ATTRIBUTES R_Type_Retain(void* object) {
+  if (object == NULL) return NULL;
+  R_Type_retainHeader(R_Type_headerOf(object));
+  return object;
+}
+
+size_t R_FUNCTION_ATTRIBUTES R_Type_References(const void* object) {
+  if (object == NULL) return 0;
+  return R_Type_loadReferences(R_Type_headerOf(object));
+}
+#endif
+
 int R_FUNCTION_ATTRIBUTES R_Type_IsObjectOfType(const void* object, const R_Type* type) {
   if (object == NULL || type == NULL) return 0;
   R_Type* type_of_object = *(R_Type**)object; //First element of every object must be an R_Type*
@@ -65,8 +145,11 @@ void R_Puts(void* object) {
     size_t bytes = R_Type_call(object, R_Stringify, object, buffer, 2048);
     os_printf("%.*s\n", (int)bytes, buffer);
   }
-  os_free(buffer);
+  os_free_sized(buffer, 2048);
 }
 
 R_JumpTable_DefineKey(R_Stringify);
 R_JumpTable_DefineKey(R_Equals);
+R_JumpTable_DefineKey(R_Compare);
+R_JumpTable_DefineKey(R_Materialize);
+R_JumpTable_DefineKey(R_MaterializedType);
@@ -17,8 +17,13 @@ static size_t R_FUNCTION_ATTRIBUTES R_Integer_stringify(R_Integer* self, char* b
   int bytes_written = os_snprintf(buffer, size, "%d", self->value);
   return bytes_written < size ? bytes_written : size;
 }
+static int R_FUNCTION_ATTRIBUTES R_Integer_compare(R_Integer* self, R_Integer* comparor) {
+  if (R_Type_IsNotOf(self, R_Integer) || R_Type_IsNotOf(comparor, R_Integer)) return (R_Type_Of(self) > R_Type_Of(comparor)) - (R_Type_Of(self) < R_Type_Of(comparor));
+  return (self->value > comparor->value) - (self->value < comparor->value);
+}
 static R_JumpTable_Entry R_Integer_methods[] = {
-  R_JumpTable_Entry_Make(R_Stringify, R_Integer_stringify), 
+  R_JumpTable_Entry_Make(R_Stringify, R_Integer_stringify),
+  R_JumpTable_Entry_Make(R_Compare, R_Integer_compare),
   R_JumpTable_Entry_NULL
 };
 R_Type_Define(R_Integer, .copy = R_Type_shallowCopy, .interfaces = R_Integer_methods);
@@ -39,8 +44,13 @@ static size_t R_FUNCTION_ATTRIBUTES R_Float_stringify(R_Float* self, char* buffe
   int bytes_written = os_snprintf(buffer, size, "%g", self->value);
   return bytes_written < size ? bytes_written : size;
 }
+static int R_FUNCTION_ATTRIBUTES R_Float_compare(R_Float* self, R_Float* comparor) {
+  if (R_Type_IsNotOf(self, R_Float) || R_Type_IsNotOf(comparor, R_Float)) return (R_Type_Of(self) > R_Type_Of(comparor)) - (R_Type_Of(self) < R_Type_Of(comparor));
+  return (self->value > comparor->value) - (self->value < comparor->value);
+}
 static R_JumpTable_Entry R_Float_methods[] = {
-  R_JumpTable_Entry_Make(R_Stringify, R_Float_stringify), 
+  R_JumpTable_Entry_Make(R_Stringify, R_Float_stringify),
+  R_JumpTable_Entry_Make(R_Compare, R_Float_compare),
   R_JumpTable_Entry_NULL
 };
 R_Type_Define(R_Float, .copy = R_Type_shallowCopy, .interfaces = R_Float_methods);
@@ -61,8 +71,13 @@ static size_t R_FUNCTION_ATTRIBUTES R_Unsigned_stringify(R_Unsigned* self, char*
   int bytes_written = os_snprintf(buffer, size, "%u", self->value);
   return bytes_written < size ? bytes_written : size;
 }
+static int R_FUNCTION_ATTRIBUTES R_Unsigned_compare(R_Unsigned* self, R_Unsigned* comparor) {
+  if (R_Type_IsNotOf(self, R_Unsigned) || R_Type_IsNotOf(comparor, R_Unsigned)) return (R_Type_Of(self) > R_Type_Of(comparor)) - (R_Type_Of(self) < R_Type_Of(comparor));
+  return (self->value > comparor->value) - (self->value < comparor->value);
+}
 static R_JumpTable_Entry R_Unsigned_methods[] = {
   R_JumpTable_Entry_Make(R_Stringify, R_Unsigned_stringify),
+  R_JumpTable_Entry_Make(R_Compare, R_Unsigned_compare),
   R_JumpTable_Entry_NULL
 };
 R_Type_Define(R_Unsigned, .copy = R_Type_shallowCopy, .interfaces = R_Unsigned_methods);
@@ -83,8 +98,13 @@ static size_t R_FUNCTION_ATTRIBUTES R_Boolean_stringify(R_Boolean* self, char* b
   int bytes_written = os_snprintf(buffer, size, "%s", self->value ? "true" : "false");
   return bytes_written < size ? bytes_written : size;
 }
+static int R_FUNCTION_ATTRIBUTES R_Boolean_compare(R_Boolean* self, R_Boolean* comparor) {
+  if (R_Type_IsNotOf(self, R_Boolean) || R_Type_IsNotOf(comparor, R_Boolean)) return (R_Type_Of(self) > R_Type_Of(comparor)) - (R_Type_Of(self) < R_Type_Of(comparor));
+  return (self->value > comparor->value) - (self->value < comparor->value);
+}
 static R_JumpTable_Entry R_Boolean_methods[] = {
   R_JumpTable_Entry_Make(R_Stringify, R_Boolean_stringify),
+  R_JumpTable_Entry_Make(R_Compare, R_Boolean_compare),
   R_JumpTable_Entry_NULL
 };
 R_Type_Define(R_Boolean, .copy = R_Type_shallowCopy, .interfaces = R_Boolean_methods);
@@ -98,8 +118,8 @@ R_Type_Define(R_Null, .copy = R_Type_shallowCopy);
 /* R_Data */
 R_Data* R_FUNCTION_ATTRIBUTES R_Data_Destructor(R_Data* self) {
   if (self->bytes) {
-    os_free(self->bytes);
-    R_Type_BytesAllocated -= self->size;
+    os_free_sized(self->bytes, self->size);
+    R_Type_subtractBytesAllocated(self->size);
   }
   self->size = 0;
   self->bytes = NULL;
@@ -109,7 +129,7 @@ R_Data* R_FUNCTION_ATTRIBUTES R_Data_New(uint8_t* bytes, size_t size) {
   R_Data* self = R_Type_New(R_Data);
   if (self == NULL) return NULL;
   self->bytes = (uint8_t*)os_zalloc(size);
-  R_Type_BytesAllocated += size;
+  R_Type_addBytesAllocated(size);
   if (self->bytes == NULL) return R_Data_Destructor(self), NULL;
   if (bytes) os_memcpy(self->bytes, bytes, size);
   self->size = size;
@@ -125,7 +145,7 @@ size_t R_FUNCTION_ATTRIBUTES R_Data_size(R_Data* self) {
 }
 static R_Data* R_Data_Copier(const R_Data* object_input, R_Data* object_output) {
   object_output->bytes = (uint8_t*)os_zalloc(object_input->size);
-  R_Type_BytesAllocated += object_input->size;
+  R_Type_addBytesAllocated(object_input->size);
   if (object_output->bytes == NULL) return NULL;
   os_memcpy(object_output->bytes, object_input->bytes, object_input->size);
   object_output->size = object_input->size;
@@ -156,8 +176,8 @@ R_Type_Define(R_Data, .dtor = (R_Type_Destructor)R_Data_Destructor, .copy = (R_T
 static R_String* R_FUNCTION_ATTRIBUTES R_String_Destructor(R_String* self) {
   if (self->string) {
     size_t size = strlen(self->string);
-    R_Type_BytesAllocated -= size+1;
-    os_free(self->string);
+    R_Type_subtractBytesAllocated(size+1);
+    os_free_sized(self->string, size+1);
   }
   self->string = NULL;
   return self;
@@ -167,7 +187,7 @@ R_String* R_FUNCTION_ATTRIBUTES R_String_New(char* string) {
   if (self == NULL) return NULL;
   size_t size = strlen(string);
   self->string = (uint8_t*)os_zalloc(size+1);
-  R_Type_BytesAllocated += size+1;
+  R_Type_addBytesAllocated(size+1);
   os_strcpy(self->string, string);
   return self;
 }
@@ -178,7 +198,7 @@ char* R_FUNCTION_ATTRIBUTES R_String_get(R_String* self) {
 static R_String* R_String_Copier(const R_String* object_input, R_String* object_output) {
   size_t size = strlen(object_input->string);
   object_output->string = (uint8_t*)os_zalloc(size+1);
-  R_Type_BytesAllocated += size+1;
+  R_Type_addBytesAllocated(size+1);
   os_strcpy(object_output->string, object_input->string);
   return object_output;
 }
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "R_AllocationProfiler.h"
+#include "R_Dictionary.h"
+#include "R_List.h"
+
+void test_counts(void) {
+  R_AllocationProfiler* profiler = R_Type_New(R_AllocationProfiler);
+  assert(R_AllocationProfiler_start(profiler) == profiler);
+  assert(R_AllocationProfiler_start(profiler) == NULL);
+
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<10; i++) R_Integer_set(R_List_add(list, R_Integer), i);
+  assert(R_AllocationProfiler_allocations(profiler) >= 11);
+  size_t live = R_AllocationProfiler_liveBytes(profiler);
+  assert(live >= sizeof(R_Integer)*10);
+  R_Type_Delete(list);
+  assert(R_AllocationProfiler_liveBytes(profiler) == 0);
+  assert(R_AllocationProfiler_peakBytes(profiler) >= live);
+
+  assert(R_AllocationProfiler_stop(profiler) == profiler);
+  size_t allocations = R_AllocationProfiler_allocations(profiler);
+  R_Type_Delete(R_Type_New(R_Integer));
+  assert(R_AllocationProfiler_allocations(profiler) == allocations);
+
+  R_AllocationProfiler_reset(profiler);
+  assert(R_AllocationProfiler_allocations(profiler) == 0);
+  assert(R_AllocationProfiler_peakBytes(profiler) == 0);
+  R_Type_Delete(profiler);
+}
+
+void test_memory_from_before_start(void) {
+  R_MutableString* before = R_MutableString_appendCString(R_Type_New(R_MutableString), "made before profiling");
+  R_AllocationProfiler* profiler = R_AllocationProfiler_start(R_Type_New(R_AllocationProfiler));
+  R_MutableString* during = R_MutableString_appendCString(R_Type_New(R_MutableString), "made while profiling");
+  R_MutableString_appendCString(before, " and grown while profiling");
+  R_Type_Delete(before);
+  R_Type_Delete(profiler); //Stops it
+  R_MutableString_appendCString(during, " and grown after");
+  R_Type_Delete(during);
+}
+
+void test_json(void) {
+  R_AllocationProfiler* profiler = R_AllocationProfiler_start(R_Type_New(R_AllocationProfiler));
+  R_Dictionary* dictionary = R_Type_New(R_Dictionary);
+  R_Dictionary_add(dictionary, "a", R_Integer);
+  R_Dictionary_add(dictionary, "b", R_Integer);
+  R_AllocationProfiler_stop(profiler);
+
+  R_MutableString* json = R_Type_New(R_MutableString);
+  assert(R_AllocationProfiler_toJson(profiler, json) == json);
+  const char* text = R_MutableString_cstring(json);
+  assert(strstr(text, "\"types\":[") != NULL);
+  assert(strstr(text, "{\"type\":\"R_Dictionary\",\"allocations\":1,") != NULL);
+  assert(strstr(text, "{\"type\":\"R_Integer\",\"allocations\":2,") != NULL);
+  assert(strstr(text, "R_AllocationProfiler_test.c") != NULL);
+  assert(strstr(text, "\"histogram\":[{") != NULL);
+
+  R_Dictionary* parsed = R_Dictionary_fromJson(R_Type_New(R_Dictionary), json);
+  assert(R_Dictionary_isPresent(parsed, "peak_bytes"));
+  assert(R_Type_IsOf(R_Dictionary_get(parsed, "sites"), R_List));
+
+  char buffer[16];
+  assert(R_Stringify(profiler, buffer, sizeof(buffer)) > 0);
+  assert(strncmp(buffer, "{\"allocations\":", 15) == 0);
+
+  R_Type_Delete(parsed);
+  R_Type_Delete(json);
+  R_Type_Delete(dictionary);
+  R_Type_Delete(profiler);
+}
+
+void test_json_escaping(void) {
+  R_AllocationProfiler* profiler = R_AllocationProfiler_start(R_Type_New(R_AllocationProfiler));
+  const R_Allocator* allocator = R_Allocator_get();
+  R_Allocator_Site site = {"quoted \"file\".c", 7, "Tag\\Name"};
+  allocator->free(allocator->context, allocator->malloc(allocator->context, 8, &site), 8, &site);
+  R_AllocationProfiler_stop(profiler);
+
+  R_MutableString* json = R_AllocationProfiler_toJson(profiler, R_Type_New(R_MutableString));
+  assert(strstr(R_MutableString_cstring(json), "{\"file\":\"quoted \\\"file\\\".c\",\"line\":7,\"type\":\"Tag\\\\Name\",") != NULL);
+  R_Dictionary* parsed = R_Dictionary_fromJson(R_Type_New(R_Dictionary), json);
+  R_Dictionary* first = R_List_first(R_Dictionary_get(parsed, "types"));
+  assert(R_MutableString_compare(R_Dictionary_get(first, "type"), "Tag\\Name"));
+
+  R_Type_Delete(parsed);
+  R_Type_Delete(json);
+  R_Type_Delete(profiler);
+}
+
+int main(void) {
+  assert(R_Type_BytesAllocated == 0);
+  test_counts();
+  test_memory_from_before_start();
+  test_json();
+  test_json_escaping();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
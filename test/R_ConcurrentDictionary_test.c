@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_MutableString.h"
+#include "R_ConcurrentDictionary.h"
+
+#define test_THREADS 8
+#define test_KEYS 2000
+
+void test_set_get(void) {
+  R_ConcurrentDictionary* dictionary = R_Type_New(R_ConcurrentDictionary);
+  assert(R_ConcurrentDictionary_setInteger(dictionary, "a", 1));
+  assert(R_ConcurrentDictionary_setFloat(dictionary, "b", 2.5));
+  assert(R_ConcurrentDictionary_setBoolean(dictionary, "c", true));
+  assert(R_ConcurrentDictionary_size(dictionary) == 3);
+  assert(R_ConcurrentDictionary_getInteger(dictionary, "a") == 1);
+  assert(R_ConcurrentDictionary_getFloat(dictionary, "b") == 2.5);
+  assert(R_ConcurrentDictionary_getBoolean(dictionary, "c"));
+  assert(R_ConcurrentDictionary_getInteger(dictionary, "b") == 0 && R_ConcurrentDictionary_getInteger(dictionary, "missing") == 0);
+
+  assert(R_ConcurrentDictionary_setInteger(dictionary, "a", 10));
+  assert(R_ConcurrentDictionary_size(dictionary) == 3 && R_ConcurrentDictionary_getInteger(dictionary, "a") == 10);
+
+  //A value from get outlives its removal
+  R_MutableString* string = R_MutableString_setString(R_Type_New(R_MutableString), "shared");
+  assert(R_ConcurrentDictionary_addShared(dictionary, "d", string));
+  assert(R_ConcurrentDictionary_addCopy(dictionary, "e", string));
+  R_MutableString* value = R_ConcurrentDictionary_get(dictionary, "d");
+  assert(value == string && R_Type_References(string) == 3);
+  assert(R_ConcurrentDictionary_remove(dictionary, "d") && !R_ConcurrentDictionary_remove(dictionary, "d"));
+  assert(!R_ConcurrentDictionary_isPresent(dictionary, "d") && R_ConcurrentDictionary_get(dictionary, "d") == NULL);
+  assert(R_MutableString_compare(value, "shared"));
+  R_Type_Release(value);
+  R_MutableString* copy = R_ConcurrentDictionary_get(dictionary, "e");
+  assert(copy != string && R_MutableString_compare(copy, "shared"));
+  R_Type_Release(copy);
+  R_Type_Delete(string);
+
+  R_ConcurrentDictionary* duplicate = R_Type_Copy(dictionary);
+  assert(R_ConcurrentDictionary_size(duplicate) == 4 && R_ConcurrentDictionary_getInteger(duplicate, "a") == 10);
+  R_Type_Delete(duplicate);
+  R_Type_Delete(dictionary);
+}
+
+void test_grow(void) {
+  char key[16];
+  R_ConcurrentDictionary* dictionary = R_Type_New(R_ConcurrentDictionary);
+  for (int i=0; i<test_KEYS*10; i++) {
+    snprintf(key, sizeof(key), "key%d", i);
+    assert(R_ConcurrentDictionary_setInteger(dictionary, key, i));
+  }
+  assert(R_ConcurrentDictionary_size(dictionary) == test_KEYS*10);
+  for (int i=0; i<test_KEYS*10; i++) {
+    snprintf(key, sizeof(key), "key%d", i);
+    assert(R_ConcurrentDictionary_getInteger(dictionary, key) == i);
+    if (i % 2) assert(R_ConcurrentDictionary_remove(dictionary, key));
+  }
+  assert(R_ConcurrentDictionary_size(dictionary) == test_KEYS*5);
+  R_Type_Delete(dictionary);
+}
+
+typedef struct {
+  R_ConcurrentDictionary* dictionary;
+  int thread;
+  bool failed;
+} test_Context;
+
+/*  test_worker
+    Even threads keep rewriting and removing their own keys, odd threads read every key. Values are always the key's
+   number or its negation, so a reader that sees anything else has read a freed or half made entry.
+ */
+static void test_worker(void* argument) {
+  test_Context* context = argument;
+  char key[16];
+  for (int round=0; round<20; round++) {
+    for (int i=0; i<test_KEYS; i++) {
+      snprintf(key, sizeof(key), "key%d", i);
+      if (context->thread % 2 == 0) {
+        if (i % (test_THREADS/2) != context->thread/2) continue;
+        if (round % 3 == 2) R_ConcurrentDictionary_remove(context->dictionary, key);
+        else R_ConcurrentDictionary_setInteger(context->dictionary, key, round % 2 ? -i : i);
+      }
+      else {
+        R_Integer* value = R_ConcurrentDictionary_get(context->dictionary, key);
+        if (value != NULL && R_Integer_get(value) != i && R_Integer_get(value) != -i) context->failed = true;
+        R_Type_Release(value);
+        int number = R_ConcurrentDictionary_getInteger(context->dictionary, key);
+        if (number != 0 && number != i && number != -i) context->failed = true;
+      }
+    }
+  }
+}
+
+void test_threads(void) {
+  R_ConcurrentDictionary* dictionary = R_Type_New(R_ConcurrentDictionary);
+  test_Context contexts[test_THREADS];
+  void* arguments[test_THREADS];
+  for (int i=0; i<test_THREADS; i++) {
+    contexts[i] = (test_Context){dictionary, i, false};
+    arguments[i] = &contexts[i];
+  }
+  R_OS_parallelRun(test_worker, arguments, test_THREADS);
+  for (int i=0; i<test_THREADS; i++) assert(!contexts[i].failed);
+
+  //The last round sets every key to its negation
+  char key[16];
+  for (int i=0; i<test_KEYS; i++) {
+    snprintf(key, sizeof(key), "key%d", i);
+    assert(R_ConcurrentDictionary_getInteger(dictionary, key) == -i);
+  }
+  assert(R_ConcurrentDictionary_size(dictionary) == test_KEYS);
+  R_Type_Delete(dictionary);
+}
+
+int main(void) {
+  test_set_get();
+  test_grow();
+  test_threads();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
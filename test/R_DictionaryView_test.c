@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "R_DictionaryView.h"
+#include "R_Dictionary.h"
+#include "R_NumericArray.h"
+
+static R_Dictionary* test_dictionary(void) {
+  R_Dictionary* dict = R_Type_New(R_Dictionary);
+  R_Dictionary_setInteger(dict, "integer", -42);
+  R_Dictionary_setFloat(dict, "float", 1.5f);
+  R_Dictionary_setBoolean(dict, "boolean", true);
+  R_Dictionary_setNull(dict, "null");
+  R_MutableString_setString(R_Dictionary_add(dict, "string", R_MutableString), "hello");
+  R_MutableData_appendBytes(R_Dictionary_add(dict, "bytes", R_MutableData), 0x00, 0xFF);
+  R_Unsigned_set(R_Dictionary_add(dict, "unsigned", R_Unsigned), 3000000000u);
+  R_List* list = R_Dictionary_add(dict, "list", R_List);
+  R_Integer_set(R_List_add(list, R_Integer), 7);
+  R_MutableString_setString(R_List_add(list, R_MutableString), "item");
+  R_Dictionary_setInteger(R_List_add(list, R_Dictionary), "nested", 9);
+  R_IntArray_appendCArray(R_Dictionary_add(dict, "ints", R_IntArray), (int[]){1, -2, 3}, 3);
+  R_DoubleArray_appendCArray(R_Dictionary_add(dict, "doubles", R_DoubleArray), (double[]){1e100, -0.1}, 2);
+  R_Dictionary_add(dict, "empty", R_Dictionary);
+  return dict;
+}
+
+static void test_check(R_DictionaryView* view) {
+  R_DictionaryView_Value root = R_DictionaryView_root(view);
+  assert(R_DictionaryView_kind(root) == R_DictionaryView_Kind_Dictionary);
+  assert(R_DictionaryView_size(root) == 11);
+  assert(R_DictionaryView_getInteger(R_DictionaryView_get(root, "integer")) == -42);
+  assert(R_DictionaryView_getFloat(R_DictionaryView_get(root, "float")) == 1.5f);
+  assert(R_DictionaryView_getBoolean(R_DictionaryView_get(root, "boolean")) == true);
+  assert(R_DictionaryView_kind(R_DictionaryView_get(root, "null")) == R_DictionaryView_Kind_Null);
+  assert(R_DictionaryView_getUnsigned(R_DictionaryView_get(root, "unsigned")) == 3000000000u);
+
+  R_DictionaryView_Value string = R_DictionaryView_get(root, "string");
+  assert(R_DictionaryView_size(string) == 5);
+  assert(strcmp(R_DictionaryView_getString(string), "hello") == 0);
+  R_DictionaryView_Value bytes = R_DictionaryView_get(root, "bytes");
+  assert(R_DictionaryView_size(bytes) == 2 && R_DictionaryView_getBytes(bytes)[1] == 0xFF);
+
+  R_DictionaryView_Value list = R_DictionaryView_get(root, "list");
+  assert(R_DictionaryView_size(list) == 3);
+  assert(R_DictionaryView_getInteger(R_DictionaryView_valueAt(list, 0)) == 7);
+  assert(strcmp(R_DictionaryView_getString(R_DictionaryView_valueAt(list, 1)), "item") == 0);
+  assert(R_DictionaryView_getInteger(R_DictionaryView_get(R_DictionaryView_valueAt(list, 2), "nested")) == 9);
+  assert(R_DictionaryView_kind(R_DictionaryView_valueAt(list, 3)) == R_DictionaryView_Kind_Missing);
+
+  R_DictionaryView_Value ints = R_DictionaryView_get(root, "ints");
+  assert(R_DictionaryView_size(ints) == 3 && R_DictionaryView_getInts(ints)[1] == -2);
+  R_DictionaryView_Value doubles = R_DictionaryView_get(root, "doubles");
+  assert(R_DictionaryView_size(doubles) == 2 && R_DictionaryView_getDoubles(doubles)[0] == 1e100);
+  assert(R_DictionaryView_getFloats(doubles) == NULL);
+  assert(R_DictionaryView_size(R_DictionaryView_get(root, "empty")) == 0);
+
+  //Missing keys and kinds fall through every accessor
+  R_DictionaryView_Value missing = R_DictionaryView_get(root, "missing");
+  assert(R_DictionaryView_kind(missing) == R_DictionaryView_Kind_Missing);
+  assert(R_DictionaryView_getInteger(missing) == 0);
+  assert(R_DictionaryView_getString(missing) == NULL);
+  assert(R_DictionaryView_kind(R_DictionaryView_get(missing, "integer")) == R_DictionaryView_Kind_Missing);
+  assert(R_DictionaryView_kind(R_DictionaryView_get(root, "integ")) == R_DictionaryView_Kind_Missing);
+
+  //Iteration is in key order
+  const char* previous = "";
+  for (size_t i=0; i<R_DictionaryView_size(root); i++) {
+    const char* key = R_DictionaryView_keyAt(root, i);
+    assert(key != NULL && strcmp(previous, key) < 0);
+    assert(R_DictionaryView_kind(R_DictionaryView_valueAt(root, i)) == R_DictionaryView_kind(R_DictionaryView_get(root, key)));
+    previous = key;
+  }
+  assert(R_DictionaryView_keyAt(root, R_DictionaryView_size(root)) == NULL);
+}
+
+void test_bytes(void) {
+  R_Dictionary* dict = test_dictionary();
+  R_MutableData* buffer = R_DictionaryView_write(dict, R_Type_New(R_MutableData));
+  assert(buffer != NULL);
+  size_t size = R_MutableData_size(buffer);
+  uint64_t* aligned = malloc(size);
+  memcpy(aligned, R_MutableData_bytes(buffer), size);
+
+  R_DictionaryView* view = R_DictionaryView_openBytes(R_Type_New(R_DictionaryView), (const uint8_t*)aligned, size);
+  assert(view != NULL);
+  test_check(view);
+  R_Type_Delete(view);
+
+  free(aligned);
+  R_Type_Delete(buffer);
+  R_Type_Delete(dict);
+}
+
+void test_file(void) {
+  const char* path = "objects/R_DictionaryView_test.rdv";
+  R_Dictionary* dict = test_dictionary();
+  assert(R_DictionaryView_writeFile(dict, path));
+  R_DictionaryView* view = R_DictionaryView_open(R_Type_New(R_DictionaryView), path);
+  assert(view != NULL);
+  test_check(view);
+  //Replacing the file doesn't disturb a view that has it open
+  R_Dictionary_setInteger(dict, "integer", 1);
+  assert(R_DictionaryView_writeFile(dict, path));
+  assert(R_DictionaryView_getInteger(R_DictionaryView_get(R_DictionaryView_root(view), "integer")) == -42);
+  assert(R_DictionaryView_open(view, path) == view);
+  assert(R_DictionaryView_getInteger(R_DictionaryView_get(R_DictionaryView_root(view), "integer")) == 1);
+  R_Type_Delete(view);
+  remove(path);
+  R_Type_Delete(dict);
+}
+
+void test_invalid(void) {
+  R_DictionaryView* view = R_Type_New(R_DictionaryView);
+  assert(R_DictionaryView_open(view, "objects/does_not_exist.rdv") == NULL);
+  uint64_t garbage[4] = {0};
+  assert(R_DictionaryView_openBytes(view, (const uint8_t*)garbage, sizeof(garbage)) == NULL);
+  assert(R_DictionaryView_kind(R_DictionaryView_root(view)) == R_DictionaryView_Kind_Missing);
+
+  //A dictionary whose key offset points past the end reads as missing instead of crashing
+  R_Dictionary* dict = R_Type_New(R_Dictionary);
+  R_Dictionary_setInteger(dict, "a", 1);
+  R_MutableData* buffer = R_DictionaryView_write(dict, R_Type_New(R_MutableData));
+  size_t size = R_MutableData_size(buffer);
+  uint64_t* aligned = malloc(size);
+  memcpy(aligned, R_MutableData_bytes(buffer), size);
+  assert(R_DictionaryView_openBytes(view, (const uint8_t*)aligned, size) == view);
+  assert(R_DictionaryView_getInteger(R_DictionaryView_get(R_DictionaryView_root(view), "a")) == 1);
+  uint32_t entry_key = 0xFFFFFF00;
+  memcpy((uint8_t*)aligned + size - 8 - 16, &entry_key, sizeof(entry_key));
+  assert(R_DictionaryView_kind(R_DictionaryView_get(R_DictionaryView_root(view), "a")) == R_DictionaryView_Kind_Missing);
+  assert(R_DictionaryView_keyAt(R_DictionaryView_root(view), 0) == NULL);
+  free(aligned);
+  R_Type_Delete(buffer);
+  R_Type_Delete(dict);
+  R_Type_Delete(view);
+}
+
+int main(void) {
+  test_bytes();
+  test_file();
+  test_invalid();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
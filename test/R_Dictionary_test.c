@@ -128,6 +128,12 @@ void test_write_json_strings(void) {
 	assert(R_Dictionary_toJson(dict, json) == json);
 	assert(R_MutableString_compare(json, "{\"string key 1\":\"string value 1\",\"string key 2\":\"string value 2\"}"));
 
+	//Control characters without a short escape are written as \u00XX, and read back the same
+	R_Dictionary_removeAll(dict);
+	R_MutableString_appendCString(R_Dictionary_add(dict, "controls", R_MutableString), "a\x01\x1f\tb");
+	assert(R_MutableString_compare(R_Dictionary_toJson(dict, json), "{\"controls\":\"a\\u0001\\u001f\\tb\"}"));
+	assert(R_Dictionary_fromJson(dict, json) == dict && R_MutableString_compare(R_Dictionary_get(dict, "controls"), "a\x01\x1f\tb"));
+
 	R_Type_Delete(json);
 	R_Type_Delete(dict);
 }
@@ -211,6 +217,11 @@ void test_read_json_strings(void) {
 	assert(R_Type_IsOf(R_Dictionary_get(dict, "string key 2"), R_MutableString));
 	assert(R_MutableString_compare(R_Dictionary_get(dict, "string key 2"), "string value 2"));
 
+	//\u escapes become UTF-8, joining surrogate pairs
+	R_MutableString_setString(json1, "{\"escaped\":\"\\u0041\\u00e9\\u20AC\\ud83d\\ude00\"}");
+	assert(R_Dictionary_fromJson(dict, json1) == dict);
+	assert(R_MutableString_compare(R_Dictionary_get(dict, "escaped"), "A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80"));
+
 	R_Type_Delete(dict);
 	R_Type_Delete(json1);
 	R_Type_Delete(json2);
@@ -304,6 +315,224 @@ void test_read_json_arrays(void) {
 	R_Type_Delete(json);
 }
 
+void test_read_json_typed_arrays(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_MutableString* json = R_MutableString_appendCString(R_Type_New(R_MutableString), "{\"ints\":[0, 1,-2,3],\"floats\":[0,1,2.5,-3],\"mixed\":[1,2,\"three\"],\"numbers\":[1,2.5,3,\"x\"],\"empty\":[]}");
+
+	assert(R_Dictionary_fromJsonWithOptions(dict, json, R_Dictionary_JsonOption_TypedArrays) == dict);
+	assert(R_Type_IsOf(R_Dictionary_get(dict, "ints"), R_IntArray));
+	R_IntArray* integers = R_Dictionary_get(dict, "ints");
+	assert(R_IntArray_size(integers) == 4);
+	assert(R_IntArray_get(integers, 2) == -2);
+	assert(R_IntArray_sum(integers) == 2);
+
+	assert(R_Type_IsOf(R_Dictionary_get(dict, "floats"), R_FloatArray));
+	R_FloatArray* floats = R_Dictionary_get(dict, "floats");
+	assert(R_FloatArray_size(floats) == 4);
+	assert(R_FloatArray_get(floats, 1) == 1.0f);
+	assert(R_FloatArray_get(floats, 2) == 2.5f);
+
+	assert(R_Type_IsOf(R_Dictionary_get(dict, "mixed"), R_List));
+	R_List* mixed = R_Dictionary_get(dict, "mixed");
+	assert(R_List_size(mixed) == 3);
+	assert(R_Integer_get(R_List_pointerAtIndex(mixed, 1)) == 2);
+	assert(R_Type_IsOf(R_List_pointerAtIndex(mixed, 2), R_MutableString));
+
+	//Integers and floats keep their own types once a non-number turns the array into a list
+	R_List* numbers = R_Dictionary_get(dict, "numbers");
+	assert(R_Type_IsOf(numbers, R_List) && R_List_size(numbers) == 4);
+	assert(R_Type_IsOf(R_List_pointerAtIndex(numbers, 0), R_Integer) && R_Integer_get(R_List_pointerAtIndex(numbers, 0)) == 1);
+	assert(R_Type_IsOf(R_List_pointerAtIndex(numbers, 1), R_Float) && R_Float_get(R_List_pointerAtIndex(numbers, 1)) == 2.5f);
+	assert(R_Type_IsOf(R_List_pointerAtIndex(numbers, 2), R_Integer) && R_Integer_get(R_List_pointerAtIndex(numbers, 2)) == 3);
+	assert(R_Type_IsOf(R_List_pointerAtIndex(numbers, 3), R_MutableString));
+
+	assert(R_Type_IsOf(R_Dictionary_get(dict, "empty"), R_List));
+
+	R_MutableString_reset(json);
+	assert(R_Dictionary_toJson(dict, json) == json);
+	assert(R_MutableString_compare(json, "{\"ints\":[0,1,-2,3],\"floats\":[0,1,2.5,-3],\"mixed\":[1,2,\"three\"],\"numbers\":[1,2.5,3,\"x\"],\"empty\":[]}"));
+
+	assert(R_Dictionary_fromJson(dict, json) == dict);
+	assert(R_Type_IsOf(R_Dictionary_get(dict, "ints"), R_List));
+
+	R_Type_Delete(dict);
+	R_Type_Delete(json);
+}
+
+void test_read_json_lazy(void) {
+	const char* text = "{\"name\": \"lazy\", \"count\": 3, \"nested\": {\"inner\": {\"value\": 42}, \"label\": \"a}\\\"]\"}, \"rows\": [{\"id\": 1, \"tags\": [1, 2]}, {\"id\": 2, \"tags\": []}], \"ints\": [1, 2, 3]}";
+	R_MutableString* json = R_MutableString_setString(R_Type_New(R_MutableString), text);
+	R_Dictionary* eager = R_Type_New(R_Dictionary);
+	R_Dictionary* lazy = R_Type_New(R_Dictionary);
+
+	size_t before = R_Type_BytesAllocated;
+	assert(R_Dictionary_fromJson(eager, json) == eager);
+	size_t eager_bytes = R_Type_BytesAllocated - before;
+	before = R_Type_BytesAllocated;
+	assert(R_Dictionary_fromJsonWithOptions(lazy, json, R_Dictionary_JsonOption_Lazy | R_Dictionary_JsonOption_TypedArrays) == lazy);
+	assert(R_Type_BytesAllocated - before < eager_bytes / 2);
+
+	assert(R_Dictionary_size(lazy) == 5);
+	//Asking for a type reads it from the text and leaves the value unparsed
+	before = R_Type_BytesAllocated;
+	assert(R_Dictionary_typeOf(lazy, "rows") == R_Type_Object(R_List));
+	assert(R_Dictionary_typeOf(lazy, "ints") == R_Type_Object(R_IntArray));
+	assert(R_Type_BytesAllocated == before);
+	R_MutableString* arrays = R_MutableString_setString(R_Type_New(R_MutableString), "{\"floats\": [1, -2.5e1], \"mixed\": [1, \"2\"], \"empty\": [ ]}");
+	R_Dictionary* typed = R_Dictionary_fromJsonWithOptions(R_Type_New(R_Dictionary), arrays, R_Dictionary_JsonOption_Lazy | R_Dictionary_JsonOption_TypedArrays);
+	const char* keys[] = {"floats", "mixed", "empty"};
+	for (size_t i=0; i<3; i++) {
+		const R_Type* type = R_Dictionary_typeOf(typed, keys[i]);
+		assert(type == R_Type_Of(R_Dictionary_get(typed, keys[i])) && type == R_Dictionary_typeOf(typed, keys[i]));
+	}
+	assert(R_Dictionary_typeOf(typed, "floats") == R_Type_Object(R_FloatArray));
+	R_Type_Delete(typed);
+	R_Type_Delete(arrays);
+	assert(R_MutableString_compare(R_Dictionary_get(lazy, "name"), "lazy"));
+	assert(R_Dictionary_getInteger(lazy, "count") == 3);
+	assert(R_Dictionary_typeOf(lazy, "nested") == R_Type_Object(R_Dictionary));
+	R_Dictionary* nested = R_Dictionary_get(lazy, "nested");
+	assert(R_MutableString_compare(R_Dictionary_get(nested, "label"), "a}\"]"));
+	assert(R_Dictionary_getInteger(R_Dictionary_get(nested, "inner"), "value") == 42);
+	assert(R_Dictionary_get(lazy, "nested") == nested);
+
+	R_List* rows = R_Dictionary_get(lazy, "rows");
+	assert(R_Type_IsOf(rows, R_List) && R_List_size(rows) == 2);
+	assert(R_Dictionary_getInteger(R_List_pointerAtIndex(rows, 1), "id") == 2);
+	assert(R_Type_IsOf(R_Dictionary_get(R_List_pointerAtIndex(rows, 0), "tags"), R_IntArray));
+	assert(R_Type_IsOf(R_Dictionary_get(lazy, "ints"), R_IntArray));
+
+	R_MutableString* eager_json = R_Dictionary_toJson(eager, R_Type_New(R_MutableString));
+	R_Dictionary* untouched = R_Type_New(R_Dictionary);
+	assert(R_Dictionary_fromJsonWithOptions(untouched, json, R_Dictionary_JsonOption_Lazy) == untouched);
+	before = R_Type_BytesAllocated;
+	R_Dictionary* read = R_Dictionary_read(untouched, "nested");
+	assert(R_Type_IsOf(read, R_Dictionary) && R_Dictionary_getInteger(R_Dictionary_get(read, "inner"), "value") == 42);
+	R_Type_Delete(read);
+	assert(R_Integer_get(read = R_Dictionary_read(untouched, "count")) == 3);
+	R_Type_Delete(read);
+	assert(R_Type_BytesAllocated == before && R_Dictionary_read(untouched, "missing") == NULL);
+	R_Dictionary* copy = R_Type_Copy(untouched);
+	R_Dictionary* merged = R_Dictionary_merge(R_Type_New(R_Dictionary), untouched);
+	R_Type_DeleteAndNull(untouched);
+	assert(R_MutableString_compare(R_Dictionary_toJson(copy, json), R_MutableString_cstring(eager_json)));
+	assert(R_MutableString_compare(R_Dictionary_toJson(merged, json), R_MutableString_cstring(eager_json)));
+
+	R_MutableString_setString(json, "{\"good\": 1, \"bad\": {\"a\": }}");
+	assert(R_Dictionary_fromJsonWithOptions(lazy, json, R_Dictionary_JsonOption_Lazy) == lazy);
+	assert(R_Dictionary_getInteger(lazy, "good") == 1);
+	assert(R_Dictionary_get(lazy, "bad") == NULL);
+	R_MutableString_setString(json, "{\"good\": 1, \"open\": [1, {\"a\": 2}");
+	assert(R_Dictionary_fromJsonWithOptions(lazy, json, R_Dictionary_JsonOption_Lazy) == lazy);
+	assert(R_Dictionary_isNotPresent(lazy, "open"));
+
+	R_Type_Delete(copy);
+	R_Type_Delete(merged);
+	R_Type_Delete(eager_json);
+	R_Type_Delete(eager);
+	R_Type_Delete(lazy);
+	R_Type_Delete(json);
+}
+
+void test_read_json_parallel(void) {
+	R_MutableString* json = R_MutableString_appendCString(R_Type_New(R_MutableString), "{\"count\": 3000, \"records\": [ ");
+	for (int i=0; i<3000; i++) {
+		if (i > 0) R_MutableString_appendCString(json, " ,\n");
+		R_MutableString_appendCString(json, "{\"id\": ");
+		R_MutableString_appendInt(json, i);
+		R_MutableString_appendCString(json, ", \"name\": \"record ] } ,\\\" ");
+		R_MutableString_appendInt(json, i);
+		R_MutableString_appendCString(json, "\", \"values\": [1, 2.5, [true, null]], \"child\": {\"a\": [{}]}}");
+	}
+	R_MutableString_appendCString(json, " ], \"empty\": [], \"numbers\": [1, 2, 3]}");
+	assert(R_MutableString_length(json) > 64*1024);
+
+	R_Dictionary* eager = R_Dictionary_fromJson(R_Type_New(R_Dictionary), json);
+	R_MutableString* expected = R_Dictionary_toJson(eager, R_Type_New(R_MutableString));
+	R_Dictionary* parallel = R_Type_New(R_Dictionary);
+	R_MutableString* output = R_Type_New(R_MutableString);
+	for (size_t threads=1; threads<=7; threads+=2) {
+		assert(R_Dictionary_fromJsonWithThreads(parallel, json, R_Dictionary_JsonOption_Parallel | R_Dictionary_JsonOption_TypedArrays, threads) == parallel);
+		R_List* records = R_Dictionary_get(parallel, "records");
+		assert(R_List_size(records) == 3000);
+		assert(R_Dictionary_getInteger(R_List_pointerAtIndex(records, 2999), "id") == 2999);
+		assert(R_Type_IsOf(R_Dictionary_get(parallel, "numbers"), R_IntArray));
+		assert(R_Dictionary_fromJsonWithThreads(parallel, json, R_Dictionary_JsonOption_Parallel, threads) == parallel);
+		assert(R_MutableString_compare(R_Dictionary_toJson(parallel, output), R_MutableString_cstring(expected)));
+	}
+
+	R_MutableString_setString(output, R_MutableString_cstring(json));
+	for (int i=0; i<38; i++) R_MutableString_pop(output);
+	assert(R_Dictionary_fromJsonWithThreads(parallel, output, R_Dictionary_JsonOption_Parallel, 4) == parallel);
+	assert(R_Dictionary_isNotPresent(parallel, "records"));
+	R_MutableString_appendCString(output, ", {\"id\": }]}");
+	assert(R_Dictionary_fromJsonWithThreads(parallel, output, R_Dictionary_JsonOption_Parallel, 4) == parallel);
+	assert(R_Dictionary_isNotPresent(parallel, "records"));
+	assert(R_Dictionary_getInteger(parallel, "count") == 3000);
+
+	R_Type_Delete(output);
+	R_Type_Delete(expected);
+	R_Type_Delete(parallel);
+	R_Type_Delete(eager);
+	R_Type_Delete(json);
+}
+
+void test_inline_scalars(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	assert(R_Dictionary_setInteger(dict, "integer", 5) == dict);
+	assert(R_Dictionary_setFloat(dict, "float", 2.5f) == dict);
+	assert(R_Dictionary_setBoolean(dict, "boolean", true) == dict);
+	assert(R_Dictionary_setNull(dict, "null") == dict);
+	assert(R_Dictionary_size(dict) == 4);
+
+	assert(R_Dictionary_getInteger(dict, "integer") == 5);
+	assert(R_Dictionary_getFloat(dict, "float") == 2.5f);
+	assert(R_Dictionary_getBoolean(dict, "boolean") == true);
+	assert(R_Dictionary_getInteger(dict, "float") == 0);
+	assert(R_Dictionary_getInteger(dict, "missing") == 0);
+	assert(R_Dictionary_typeOf(dict, "null") == R_Type_Object(R_Null));
+	assert(R_Dictionary_typeOf(dict, "missing") == NULL);
+
+	R_Dictionary* copy = R_Type_Copy(dict);
+	R_Dictionary* merged = R_Dictionary_merge(R_Type_New(R_Dictionary), dict);
+	assert(R_Dictionary_getFloat(copy, "float") == 2.5f);
+	assert(R_Dictionary_getInteger(merged, "integer") == 5);
+
+	R_Integer_set(R_Dictionary_get(dict, "integer"), 6);
+	assert(R_Dictionary_getInteger(dict, "integer") == 6);
+	assert(R_Dictionary_getInteger(copy, "integer") == 5);
+
+	R_MutableString* json = R_Type_New(R_MutableString);
+	assert(R_Dictionary_toJson(copy, json) == json);
+	assert(R_MutableString_compare(json, "{\"integer\":5,\"float\":2.5,\"boolean\":true,\"null\":null}"));
+
+	R_Type_Delete(json);
+	R_Type_Delete(merged);
+	R_Type_Delete(copy);
+	R_Type_Delete(dict);
+}
+
+void test_read_json_inline_scalars(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_MutableString* json = R_MutableString_appendCString(R_Type_New(R_MutableString), "{\"a\":1,\"b\":-2.5,\"c\":false,\"d\":null,\"e\":\"nullable\"}");
+	assert(R_Dictionary_fromJson(dict, json) == dict);
+	assert(R_Dictionary_typeOf(dict, "a") == R_Type_Object(R_Integer));
+	assert(R_Dictionary_getInteger(dict, "a") == 1);
+	assert(R_Dictionary_getFloat(dict, "b") == -2.5f);
+	assert(R_Dictionary_typeOf(dict, "c") == R_Type_Object(R_Boolean));
+	assert(R_Dictionary_getBoolean(dict, "c") == false);
+	assert(R_Dictionary_typeOf(dict, "d") == R_Type_Object(R_Null));
+	assert(R_Dictionary_typeOf(dict, "e") == R_Type_Object(R_MutableString));
+
+	R_MutableString* output = R_Type_New(R_MutableString);
+	R_Dictionary_toJson(dict, output);
+	assert(R_MutableString_compare(output, "{\"a\":1,\"b\":-2.5,\"c\":false,\"d\":null,\"e\":\"nullable\"}"));
+
+	R_Type_Delete(output);
+	R_Type_Delete(json);
+	R_Type_Delete(dict);
+}
+
 void test_json_nulls(void) {
 	R_Dictionary* dict = R_Type_New(R_Dictionary);
 	R_MutableString* json = R_MutableString_appendCString(R_Type_New(R_MutableString), "{\"this\":null}");
@@ -369,6 +598,119 @@ void test_empty_object(void) {
 	R_Type_Delete(dict);
 }
 
+void test_cbor_encoding(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_MutableData* cbor = R_Type_New(R_MutableData);
+	R_Dictionary_setInteger(dict, "a", 1);
+	R_Dictionary_setInteger(dict, "b", -500);
+	R_Dictionary_setBoolean(dict, "c", true);
+	R_Dictionary_setNull(dict, "d");
+	assert(R_Dictionary_toCbor(dict, cbor) == cbor);
+	uint8_t expected[] = {0xA4, 0x61, 'a', 0x01, 0x61, 'b', 0x39, 0x01, 0xF3, 0x61, 'c', 0xF5, 0x61, 'd', 0xF6};
+	assert(R_MutableData_compareWithCArray(cbor, expected, sizeof(expected)) == 0);
+	R_Type_Delete(cbor);
+	R_Type_Delete(dict);
+}
+
+void test_cbor_round_trip(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_Dictionary_setInteger(dict, "integer", 123456);
+	R_Dictionary_setFloat(dict, "float", 2.5f);
+	R_Dictionary_setBoolean(dict, "boolean", false);
+	R_Dictionary_setNull(dict, "null");
+	R_MutableString_setString(R_Dictionary_add(dict, "string", R_MutableString), "hello");
+	R_MutableData_appendBytes(R_Dictionary_add(dict, "bytes", R_MutableData), 0x00, 0xFF, 0x10);
+	R_Dictionary_add(dict, "empty string", R_MutableString);
+	R_Dictionary_add(dict, "empty bytes", R_MutableData);
+	R_Dictionary_transferOwnership(dict, "data", R_Data_New((uint8_t[]){1, 2, 3, 4}, 4));
+	R_Unsigned_set(R_Dictionary_add(dict, "unsigned", R_Unsigned), 3000000000u);
+	R_List* list = R_Dictionary_add(dict, "list", R_List);
+	R_Integer_set(R_List_add(list, R_Integer), -7);
+	R_MutableString_setString(R_List_add(list, R_MutableString), "item");
+	R_Integer_set(R_Dictionary_add(R_List_add(list, R_Dictionary), "nested", R_Integer), 9);
+	R_IntArray_appendCArray(R_Dictionary_add(dict, "ints", R_IntArray), (int[]){1, -2, 3}, 3);
+	R_FloatArray_appendCArray(R_Dictionary_add(dict, "floats", R_FloatArray), (float[]){0.5f, -1.25f}, 2);
+	R_DoubleArray_appendCArray(R_Dictionary_add(dict, "doubles", R_DoubleArray), (double[]){1e100, -0.1}, 2);
+
+	R_MutableData* cbor = R_Dictionary_toCbor(dict, R_Type_New(R_MutableData));
+	R_Dictionary* copy = R_Dictionary_fromCbor(R_Type_New(R_Dictionary), cbor);
+	assert(copy != NULL);
+	assert(R_Dictionary_size(copy) == R_Dictionary_size(dict));
+	assert(R_Dictionary_typeOf(copy, "integer") == R_Type_Object(R_Integer));
+	assert(R_Dictionary_getInteger(copy, "integer") == 123456);
+	assert(R_Dictionary_getFloat(copy, "float") == 2.5f);
+	assert(R_Dictionary_typeOf(copy, "boolean") == R_Type_Object(R_Boolean));
+	assert(R_Dictionary_getBoolean(copy, "boolean") == false);
+	assert(R_Dictionary_typeOf(copy, "null") == R_Type_Object(R_Null));
+	assert(R_MutableString_compare(R_Dictionary_get(copy, "string"), "hello"));
+	assert(R_MutableData_isSame(R_Dictionary_get(copy, "bytes"), R_Dictionary_get(dict, "bytes")));
+	assert(R_Dictionary_typeOf(copy, "empty string") == R_Type_Object(R_MutableString) && R_MutableString_length(R_Dictionary_get(copy, "empty string")) == 0);
+	assert(R_Dictionary_typeOf(copy, "empty bytes") == R_Type_Object(R_MutableData) && R_MutableData_size(R_Dictionary_get(copy, "empty bytes")) == 0);
+	R_Data* data = R_Dictionary_get(copy, "data");
+	assert(R_Type_IsOf(data, R_Data) && R_Data_size(data) == 4 && R_Data_bytes(data)[3] == 4);
+	assert(R_Unsigned_get(R_Dictionary_get(copy, "unsigned")) == 3000000000u);
+	R_List* copied_list = R_Dictionary_get(copy, "list");
+	assert(R_List_size(copied_list) == 3);
+	assert(R_Integer_get(R_List_pointerAtIndex(copied_list, 0)) == -7);
+	assert(R_MutableString_compare(R_List_pointerAtIndex(copied_list, 1), "item"));
+	assert(R_Dictionary_getInteger(R_List_pointerAtIndex(copied_list, 2), "nested") == 9);
+	assert(R_IntArray_isSame(R_Dictionary_get(copy, "ints"), R_Dictionary_get(dict, "ints")));
+	assert(R_FloatArray_isSame(R_Dictionary_get(copy, "floats"), R_Dictionary_get(dict, "floats")));
+	assert(R_DoubleArray_isSame(R_Dictionary_get(copy, "doubles"), R_Dictionary_get(dict, "doubles")));
+
+	R_Type_Delete(copy);
+	R_Type_Delete(cbor);
+	R_Type_Delete(dict);
+}
+
+void test_cbor_malformed(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_MutableData* cbor = R_Type_New(R_MutableData);
+	R_MutableData_setBytes(cbor, 0xA1, 0x61, 'a', 0x82, 0x01);
+	assert(R_Dictionary_fromCbor(dict, cbor) == NULL); //truncated array
+	R_MutableData_setBytes(cbor, 0xA1, 0x61, 'a', 0x9B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF);
+	assert(R_Dictionary_fromCbor(dict, cbor) == NULL); //huge length prefix
+	R_MutableData_setBytes(cbor, 0xA1, 0x01, 0x01);
+	assert(R_Dictionary_fromCbor(dict, cbor) == NULL); //key isn't a string
+	R_MutableData_setBytes(cbor, 0x81, 0x01);
+	assert(R_Dictionary_fromCbor(dict, cbor) == NULL); //not a map
+	R_MutableData_setBytes(cbor, 0xA0, 0x00);
+	assert(R_Dictionary_fromCbor(dict, cbor) == NULL); //trailing bytes
+	R_MutableData_setBytes(cbor, 0xA0);
+	assert(R_Dictionary_fromCbor(dict, cbor) == dict);
+	assert(R_Dictionary_size(dict) == 0);
+	R_Type_Delete(cbor);
+	R_Type_Delete(dict);
+}
+
+void test_cbor_other_encoders(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_MutableData* cbor = R_Type_New(R_MutableData);
+	//Half floats: 1.5, -0.0, the smallest subnormal and infinity, inline and in an array
+	R_MutableData_setBytes(cbor, 0xA3, 0x61, 'h', 0xF9, 0x3E, 0x00, 0x61, 'z', 0xF9, 0x80, 0x00,
+		0x61, 'a', 0x82, 0xF9, 0x00, 0x01, 0xF9, 0x7C, 0x00);
+	assert(R_Dictionary_fromCbor(dict, cbor) == dict);
+	assert(R_Dictionary_getFloat(dict, "h") == 1.5f && R_Dictionary_typeOf(dict, "z") == R_Type_Object(R_Float));
+	R_List* halves = R_Dictionary_get(dict, "a");
+	assert(R_Float_get(R_List_pointerAtIndex(halves, 0)) == 1.0f/16777216.0f && R_Float_get(R_List_pointerAtIndex(halves, 1)) > 3.4e38f);
+
+	//Integers past an int become floats
+	R_MutableData_setBytes(cbor, 0xA3, 0x61, 'u', 0x1B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+		0x61, 'n', 0x3A, 0x80, 0x00, 0x00, 0x00, 0x61, 'a', 0x81, 0x3B, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00);
+	assert(R_Dictionary_fromCbor(dict, cbor) == dict);
+	assert(R_Dictionary_getFloat(dict, "u") == 4294967296.0f && R_Dictionary_getFloat(dict, "n") == -2147483649.0f);
+	assert(R_Float_get(R_List_pointerAtIndex(R_Dictionary_get(dict, "a"), 0)) == -4294967297.0f);
+
+	//Unassigned and one-byte simple values are left out
+	R_MutableData_setBytes(cbor, 0xA3, 0x61, 's', 0xF0, 0x61, 'b', 0xF8, 0xFF, 0x61, 'a', 0x83, 0x01, 0xF8, 0x20, 0x02);
+	assert(R_Dictionary_fromCbor(dict, cbor) == dict);
+	assert(R_Dictionary_size(dict) == 1 && R_List_size(R_Dictionary_get(dict, "a")) == 2);
+	assert(R_Integer_get(R_List_pointerAtIndex(R_Dictionary_get(dict, "a"), 1)) == 2);
+
+	R_Type_Delete(cbor);
+	R_Type_Delete(dict);
+}
+
 void test_puts(void) {
 	R_Dictionary* dict = R_Type_New(R_Dictionary);
 
@@ -409,12 +751,204 @@ void test_foreach(void) {
 	R_Type_Delete(dict);
 }
 
+void test_write_json_options(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_MutableString* json = R_Type_New(R_MutableString);
+	R_Dictionary_setFloat(dict, "b", 2.0);
+	R_Dictionary_setInteger(dict, "a", 1);
+	R_Dictionary* nested = R_Dictionary_add(dict, "c", R_Dictionary);
+	R_Dictionary_setFloat(nested, "z", 0.1f);
+	R_Dictionary_setFloat(nested, "y", -1.5e-7f);
+	R_Dictionary_add(nested, "x", R_List);
+	R_FloatArray_append(R_Dictionary_add(dict, "array", R_FloatArray), 1e20f);
+	R_MutableString_setString(R_Dictionary_add(dict, "\xc3\xa9/", R_MutableString), "caf\xc3\xa9");
+
+	assert(R_MutableString_compare(R_Dictionary_toJsonWithOptions(dict, json, R_Dictionary_JsonOutput_Canonical),
+		"{\"a\":1,\"array\":[1e20],\"b\":2,\"c\":{\"x\":[],\"y\":-1.5e-7,\"z\":0.1},\"\xc3\xa9\\/\":\"caf\xc3\xa9\"}"));
+	assert(R_MutableString_compare(R_Dictionary_toJsonWithOptions(nested, json, R_Dictionary_JsonOutput_Pretty | R_Dictionary_JsonOutput_SortedKeys),
+		"{\n  \"x\": [],\n  \"y\": -1.5e-07,\n  \"z\": 0.1\n}"));
+	assert(R_MutableString_compare(R_Dictionary_toJsonWithOptions(nested, json, R_Dictionary_JsonOutput_Compact), "{\"z\":0.1,\"y\":-1.5e-07,\"x\":[]}"));
+	R_Dictionary_removeAll(nested);
+	R_IntArray_append(R_Dictionary_add(nested, "list", R_IntArray), 3);
+	R_IntArray_append(R_Dictionary_get(nested, "list"), 4);
+	R_Dictionary_add(nested, "empty", R_Dictionary);
+	assert(R_MutableString_compare(R_Dictionary_toJsonWithOptions(nested, json, R_Dictionary_JsonOutput_Pretty),
+		"{\n  \"list\": [\n    3,\n    4\n  ],\n  \"empty\": {}\n}"));
+
+	//Round trips through the reader
+	R_Dictionary* copy = R_Dictionary_fromJson(R_Type_New(R_Dictionary), R_Dictionary_toJsonWithOptions(dict, json, R_Dictionary_JsonOutput_Pretty));
+	assert(copy != NULL && R_Dictionary_getInteger(copy, "a") == 1);
+	R_Type_Delete(copy);
+
+	R_Type_Delete(json);
+	R_Type_Delete(dict);
+}
+
+void test_hash(void) {
+	R_Dictionary* first = R_Type_New(R_Dictionary);
+	R_Dictionary* second = R_Type_New(R_Dictionary);
+	R_Dictionary_setInteger(first, "a", 1);
+	R_Dictionary_setFloat(first, "b", 0.25f);
+	R_MutableString_setString(R_Dictionary_add(first, "c", R_MutableString), "text");
+	R_MutableString_setString(R_Dictionary_add(second, "c", R_MutableString), "text");
+	R_Dictionary_setFloat(second, "a", 1.0f);
+	R_Dictionary_setFloat(second, "b", 0.25f);
+	assert(R_Dictionary_hash(first) == R_Dictionary_hash(second));
+	assert(R_Dictionary_hash(first) != 0);
+	R_Dictionary_setFloat(second, "b", 0.5f);
+	assert(R_Dictionary_hash(first) != R_Dictionary_hash(second));
+	assert(R_Dictionary_hash(NULL) == 0);
+
+	//Hashing folds the json in chunks, which must give the same answer as hashing it all at once
+	R_List* list = R_Dictionary_add(first, "list", R_List);
+	for (int i=0; i<2000; i++) R_Integer_set(R_List_add(list, R_Integer), i);
+	R_MutableString* json = R_Dictionary_toJsonWithOptions(first, R_Type_New(R_MutableString), R_Dictionary_JsonOutput_Canonical);
+	uint64_t expected = 14695981039346656037ULL;
+	const uint8_t* bytes = R_MutableData_bytes(R_MutableString_bytes(json));
+	for (size_t i=0; i<R_MutableString_length(json); i++) expected = (expected ^ bytes[i]) * 1099511628211ULL;
+	assert(R_MutableString_length(json) > 8192);
+	assert(R_Dictionary_hash(first) == expected);
+	R_Type_Delete(json);
+
+	R_Type_Delete(first);
+	R_Type_Delete(second);
+}
+
+void test_merge_move(void) {
+	R_Dictionary* dict = R_Type_New(R_Dictionary);
+	R_Dictionary* other = R_Type_New(R_Dictionary);
+	R_Dictionary_setInteger(other, "a", 1);
+	R_MutableString* text = R_MutableString_setString(R_Dictionary_add(other, "b", R_MutableString), "text");
+	assert(R_Dictionary_mergeMove(dict, other) == dict);
+	assert(R_Dictionary_size(other) == 0 && R_Dictionary_size(dict) == 2);
+	assert(R_Dictionary_get(dict, "b") == text);
+
+	R_Dictionary_setInteger(other, "a", 2);
+	R_Dictionary* nested = R_Dictionary_add(other, "c", R_Dictionary);
+	R_Dictionary_setBoolean(nested, "d", true);
+	R_MutableString* replacement = R_MutableString_setString(R_Dictionary_add(other, "b", R_MutableString), "replacement");
+	size_t bytes = R_Type_BytesAllocated;
+	assert(R_Dictionary_mergeMove(dict, other) == dict);
+	assert(R_Type_BytesAllocated < bytes);
+	assert(R_Dictionary_size(other) == 0 && R_Dictionary_size(dict) == 3);
+	assert(R_Dictionary_getInteger(dict, "a") == 2);
+	assert(R_Dictionary_get(dict, "b") == replacement);
+	assert(R_Dictionary_get(dict, "c") == nested && R_Dictionary_getBoolean(nested, "d"));
+	assert(R_Dictionary_mergeMove(dict, dict) == dict && R_Dictionary_size(dict) == 3);
+
+	R_MutableString* value = R_MutableString_setString(R_Type_New(R_MutableString), "value");
+	R_MutableString* added = R_Dictionary_addMove(other, "e", value);
+	assert(added != value && R_MutableString_compare(added, "value") && R_MutableString_length(value) == 0);
+	R_Dictionary* moved = R_Type_Move(dict);
+	assert(R_Dictionary_size(moved) == 3 && R_Dictionary_size(dict) == 0 && R_Dictionary_get(moved, "c") == nested);
+
+	R_Type_Delete(value);
+	R_Type_Delete(moved);
+	R_Type_Delete(other);
+	R_Type_Delete(dict);
+}
+
+#ifdef R_TYPE_REFCOUNT
+void test_shared(void) {
+	R_Dictionary* config = R_Type_New(R_Dictionary);
+	R_Dictionary_setInteger(config, "retries", 3);
+	R_Dictionary* documentA = R_Type_New(R_Dictionary);
+	R_Dictionary* documentB = R_Type_New(R_Dictionary);
+	R_List* list = R_Type_New(R_List);
+	assert(R_Dictionary_addShared(documentA, "config", config) == config);
+	assert(R_Dictionary_addShared(documentB, "config", config) == config);
+	assert(R_List_addShared(list, config) == config && R_Type_References(config) == 4);
+	assert(R_Dictionary_get(documentA, "config") == config && R_Dictionary_get(documentB, "config") == config);
+
+	R_MutableString* json = R_Dictionary_toJson(documentB, R_Type_New(R_MutableString));
+	assert(R_MutableString_compare(json, "{\"config\":{\"retries\":3}}"));
+	R_Type_Delete(json);
+
+	//Replacing the value only lets go of this document's reference
+	R_Dictionary_addShared(documentA, "config", config);
+	assert(R_Type_References(config) == 4);
+	R_Dictionary_setNull(documentA, "config");
+	R_Type_Delete(list);
+	R_Type_Delete(config);
+	assert(R_Type_References(config) == 1 && R_Dictionary_getInteger(config, "retries") == 3);
+
+	//Copies of a document get their own copy of the shared value
+	R_Dictionary* copy = R_Type_Copy(documentB);
+	assert(R_Dictionary_get(copy, "config") != config && R_Dictionary_getInteger(R_Dictionary_get(copy, "config"), "retries") == 3);
+
+	R_Type_Delete(copy);
+	R_Type_Delete(documentA);
+	R_Type_Delete(documentB);
+}
+#endif
+
+static void* test_map_values_describe(const char* key, void* value, void* context) {
+	R_MutableString* string = R_Type_New(R_MutableString);
+	R_MutableString_appendCString(string, key);
+	R_MutableString_appendCString(string, R_Type_IsOf(value, R_Integer) ? " is an integer" : " isn't an integer");
+	return string;
+}
+
+void test_map_values(void) {
+	R_Dictionary* dictionary = R_Type_New(R_Dictionary);
+	R_Dictionary_setInteger(dictionary, "b", 2);
+	R_Dictionary_setBoolean(dictionary, "a", true);
+	R_Dictionary_setNull(dictionary, "c");
+	R_Dictionary* mapped = R_Dictionary_mapValues(dictionary, test_map_values_describe, NULL, 4);
+	R_MutableString* json = R_Dictionary_toJson(mapped, R_Type_New(R_MutableString));
+	assert(R_MutableString_compare(json, "{\"b\":\"b is an integer\",\"a\":\"a isn't an integer\",\"c\":\"c isn't an integer\"}"));
+	assert(R_Dictionary_getInteger(dictionary, "b") == 2);
+	R_Type_Delete(json);
+	R_Type_Delete(mapped);
+	R_Type_Delete(dictionary);
+}
+
+static void* test_map_values_sum(const char* key, void* value, void* context) {
+	R_Dictionary* row = value;
+	int sum = 0;
+	R_List* values = R_Dictionary_get(row, "values");
+	for (size_t i=0; i<R_List_size(values); i++) sum += R_Integer_get(R_List_pointerAtIndex(values, i));
+	return R_Integer_set(R_Type_New(R_Integer), sum + R_Dictionary_getInteger(row, "base"));
+}
+
+void test_map_values_lazy(void) {
+	R_MutableString* json = R_Type_New(R_MutableString);
+	R_MutableString_appendCString(json, "{");
+	char row[96];
+	for (int i=0; i<64; i++) {
+		snprintf(row, sizeof(row), "%s\"row%d\": {\"base\": %d, \"values\": [1, 2, 3]}", i ? ", " : "", i, i);
+		R_MutableString_appendCString(json, row);
+	}
+	R_MutableString_appendCString(json, "}");
+	R_Dictionary* dictionary = R_Dictionary_fromJsonWithOptions(R_Type_New(R_Dictionary), json, R_Dictionary_JsonOption_Lazy);
+
+	//Every row is still unparsed, and stays that way while the workers read it
+	size_t before = R_Type_BytesAllocated;
+	R_Dictionary* mapped = R_Dictionary_mapValues(dictionary, test_map_values_sum, NULL, 4);
+	assert(R_Dictionary_size(mapped) == 64);
+	for (int i=0; i<64; i++) {
+		snprintf(row, sizeof(row), "row%d", i);
+		assert(R_Dictionary_getInteger(mapped, row) == 6 + i);
+	}
+	R_Type_Delete(mapped);
+	assert(R_Type_BytesAllocated == before);
+
+	R_Type_Delete(dictionary);
+	R_Type_Delete(json);
+}
+
 int main(void) {
 	assert(R_Type_BytesAllocated == 0);
 	test_allocation();
 	test_key_creation();
 	test_copy();
 	test_merge();
+	test_merge_move();
+#ifdef R_TYPE_REFCOUNT
+	test_shared();
+#endif
+	test_map_values();
+	test_map_values_lazy();
 	test_integers();
 	test_mixed();
 	test_foreach();
@@ -423,15 +957,26 @@ int main(void) {
 	test_write_json_objects();
 	test_write_json_booleans();
 	test_write_json_arrays();
+	test_write_json_options();
+	test_hash();
 	test_read_json_strings();
 	test_read_json_numbers();
 	test_read_json_booleans();
 	test_read_json_objects();
 	test_read_json_arrays();
+	test_read_json_typed_arrays();
+	test_read_json_lazy();
+	test_read_json_parallel();
+	test_inline_scalars();
+	test_read_json_inline_scalars();
 	test_json_nulls();
 	test_empty_array();
 	test_array_with_one_object();
 	test_empty_object();
+	test_cbor_encoding();
+	test_cbor_round_trip();
+	test_cbor_malformed();
+	test_cbor_other_encoders();
 	test_puts();
 
 	assert(R_Type_BytesAllocated == 0);
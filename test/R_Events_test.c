@@ -122,10 +122,134 @@ void test_runonce(void) {
 	R_Type_Delete(events);
 }
 
+char* test_batch_key = "batch key";
+int test_batch_single_calls = 0;
+int test_batch_single_sum = 0;
+int test_batch_batch_calls = 0;
+size_t test_batch_batch_count = 0;
+void test_batch_single_callback(void* target, const char* event_key, void* payload) {
+	assert(strcmp(event_key, test_batch_key) == 0);
+	test_batch_single_calls++;
+	test_batch_single_sum += R_Integer_get(payload);
+}
+void test_batch_batch_callback(void* target, const char* event_key, void** payloads, size_t count) {
+	assert(strcmp(event_key, test_batch_key) == 0);
+	test_batch_batch_calls++;
+	test_batch_batch_count += count;
+	for (size_t i=0; i<count; i++) assert(R_Integer_get(payloads[i]) == (int)i+1);
+}
+void test_batch(void) {
+	R_Events* events = R_Type_New(R_Events);
+	R_Integer* payload_1 = R_Integer_set(R_Type_New(R_Integer), 1);
+	R_Integer* payload_2 = R_Integer_set(R_Type_New(R_Integer), 2);
+	R_Integer* payload_3 = R_Integer_set(R_Type_New(R_Integer), 3);
+	void* payloads[] = {payload_1, payload_2, payload_3};
+
+	assert(R_Events_register(events, test_batch_key, NULL, test_batch_single_callback) == events);
+	assert(R_Events_registerBatch(events, test_batch_key, NULL, test_batch_batch_callback) == events);
+	assert(R_Events_notifyBatch(events, test_batch_key, payloads, 3) == events);
+	assert(test_batch_single_calls == 3);
+	assert(test_batch_single_sum == 6);
+	assert(test_batch_batch_calls == 1);
+	assert(test_batch_batch_count == 3);
+
+	assert(R_Events_notify(events, test_batch_key, payload_1) == events);
+	assert(test_batch_single_calls == 4);
+	assert(test_batch_batch_calls == 2);
+	assert(test_batch_batch_count == 4);
+
+	assert(R_Events_removeBatch(events, test_batch_key, NULL, test_batch_batch_callback) == events);
+	assert(R_Events_notifyBatch(events, test_batch_key, payloads, 3) == events);
+	assert(test_batch_single_calls == 7);
+	assert(test_batch_batch_calls == 2);
+
+	R_Type_Delete(events);
+	R_Type_Delete(payload_1);
+	R_Type_Delete(payload_2);
+	R_Type_Delete(payload_3);
+}
+
+void* test_coalescing_merger(void* pending_payload, void* new_payload) {
+	R_Integer_set(pending_payload, R_Integer_get(pending_payload) + R_Integer_get(new_payload));
+	return pending_payload;
+}
+void test_coalescing(void) {
+	R_Events* events = R_Type_New(R_Events);
+	R_Integer* payload_1 = R_Integer_set(R_Type_New(R_Integer), 1);
+	R_Integer* payload_2 = R_Integer_set(R_Type_New(R_Integer), 2);
+	R_Integer* payload_3 = R_Integer_set(R_Type_New(R_Integer), 3);
+	test_batch_batch_calls = 0;
+	test_batch_batch_count = 0;
+
+	assert(R_Events_registerBatch(events, test_batch_key, NULL, test_batch_batch_callback) == events);
+	assert(R_Events_setCoalescing(events, test_batch_key, true, NULL) == events);
+	assert(R_Events_post(events, test_batch_key, payload_1) == events);
+	assert(R_Events_post(events, test_batch_key, payload_2) == events);
+	assert(R_Events_post(events, test_batch_key, payload_3) == events);
+	assert(R_Events_pendingCount(events, test_batch_key) == 3);
+	assert(test_batch_batch_calls == 0);
+	assert(R_Events_drain(events) == events);
+	assert(R_Events_pendingCount(events, test_batch_key) == 0);
+	assert(test_batch_batch_calls == 1);
+	assert(test_batch_batch_count == 3);
+	assert(R_Events_drain(events) == events);
+	assert(test_batch_batch_calls == 1);
+
+	//Merged payloads stay pending as a single payload
+	test_batch_single_calls = 0;
+	test_batch_single_sum = 0;
+	assert(R_Events_removeBatch(events, test_batch_key, NULL, test_batch_batch_callback) == events);
+	assert(R_Events_register(events, test_batch_key, NULL, test_batch_single_callback) == events);
+	assert(R_Events_setCoalescing(events, test_batch_key, true, test_coalescing_merger) == events);
+	assert(R_Events_post(events, test_batch_key, payload_1) == events);
+	assert(R_Events_post(events, test_batch_key, payload_2) == events);
+	assert(R_Events_post(events, test_batch_key, payload_3) == events);
+	assert(R_Events_pendingCount(events, test_batch_key) == 1);
+	assert(R_Events_setCoalescing(events, test_batch_key, false, NULL) == events);
+	assert(test_batch_single_calls == 1);
+	assert(test_batch_single_sum == 6);
+
+	//Without coalescing, posts are delivered immediately
+	assert(R_Events_post(events, test_batch_key, payload_2) == events);
+	assert(test_batch_single_calls == 2);
+	assert(R_Events_pendingCount(events, test_batch_key) == 0);
+
+	R_Type_Delete(events);
+	R_Type_Delete(payload_1);
+	R_Type_Delete(payload_2);
+	R_Type_Delete(payload_3);
+}
+
+int test_drain_calls = 0;
+void test_drain_uncoalescing_callback(void* target, const char* event_key, void* payload) {
+	test_drain_calls++;
+	//Removes this key's pending queue while drain is still going
+	assert(R_Events_setCoalescing(target, event_key, false, NULL) == target);
+}
+void test_drain_removing(void) {
+	R_Events* events = R_Type_New(R_Events);
+	R_Integer* payload = R_Integer_set(R_Type_New(R_Integer), 1);
+	const char* keys[] = {"first", "second", "third"};
+	for (int i=0; i<3; i++) {
+		assert(R_Events_register(events, keys[i], events, test_drain_uncoalescing_callback) == events);
+		assert(R_Events_setCoalescing(events, keys[i], true, NULL) == events);
+		assert(R_Events_post(events, keys[i], payload) == events);
+	}
+	assert(R_Events_drain(events) == events);
+	assert(test_drain_calls == 3);
+	for (int i=0; i<3; i++) assert(R_Events_pendingCount(events, keys[i]) == 0);
+
+	R_Type_Delete(events);
+	R_Type_Delete(payload);
+}
+
 int main(void) {
 	test_simple();
 	test_mulitples();
 	test_runonce();
+	test_batch();
+	test_coalescing();
+	test_drain_removing();
 
 	assert(R_Type_BytesAllocated == 0);
 	printf("Pass\n");
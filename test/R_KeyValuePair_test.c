@@ -2,12 +2,23 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include "R_OS.h"
 #include "R_KeyValuePair.h"
 
+#define test_THREADS 8
+
 void test_stuff(void);
+void test_inline_scalars(void);
+void test_move(void);
+void test_read_value(void);
+void test_concurrent_value(void);
 
 int main(void) {
   test_stuff();
+  test_inline_scalars();
+  test_move();
+  test_read_value();
+  test_concurrent_value();
   assert(R_Type_BytesAllocated == 0);
   printf("PASS\n");
 }
@@ -32,3 +43,104 @@ void test_stuff(void) {
   R_Type_Delete(copy);
   R_Type_Delete(pair);
 }
+
+void test_inline_scalars(void) {
+  R_KeyValuePair* pair = R_Type_New(R_KeyValuePair);
+  size_t pair_bytes = R_Type_BytesAllocated;
+
+  assert(R_KeyValuePair_setInteger(pair, 42) == pair);
+  assert(R_Type_BytesAllocated == pair_bytes);
+  assert(R_KeyValuePair_valueType(pair) == R_Type_Object(R_Integer));
+  assert(R_KeyValuePair_getInteger(pair) == 42);
+  assert(R_KeyValuePair_getFloat(pair) == 0);
+
+  R_KeyValuePair* copy = R_Type_Copy(pair);
+  assert(R_KeyValuePair_getInteger(copy) == 42);
+  R_Type_Delete(copy);
+
+  //Boxing keeps changes made through the box
+  R_Integer* boxed = R_KeyValuePair_value(pair);
+  assert(R_Type_IsOf(boxed, R_Integer));
+  assert(R_Integer_get(boxed) == 42);
+  assert(R_KeyValuePair_value(pair) == boxed);
+  R_Integer_set(boxed, 7);
+  assert(R_KeyValuePair_getInteger(pair) == 7);
+
+  assert(R_KeyValuePair_setFloat(pair, 1.5f) == pair);
+  assert(R_Type_BytesAllocated == pair_bytes);
+  assert(R_KeyValuePair_getFloat(pair) == 1.5f);
+  assert(R_KeyValuePair_setBoolean(pair, true) == pair);
+  assert(R_KeyValuePair_getBoolean(pair) == true);
+  assert(R_KeyValuePair_setNull(pair) == pair);
+  assert(R_KeyValuePair_valueType(pair) == R_Type_Object(R_Null));
+  assert(R_Type_IsOf(R_KeyValuePair_value(pair), R_Null));
+
+  R_Type_Delete(pair);
+}
+
+void test_move(void) {
+  R_KeyValuePair* pair = R_KeyValuePair_setInteger(R_KeyValuePair_setKey(R_Type_New(R_KeyValuePair), "key"), 3);
+  R_KeyValuePair* moved = R_Type_Move(pair);
+  assert(R_MutableString_compare(R_KeyValuePair_key(moved), "key") && R_KeyValuePair_getInteger(moved) == 3);
+  assert(R_MutableString_length(R_KeyValuePair_key(pair)) == 0 && R_KeyValuePair_value(pair) == NULL);
+
+  R_Integer* integer = R_Integer_set(R_Type_New(R_Integer), 4);
+  R_KeyValuePair_setValue(pair, integer);
+  assert(R_KeyValuePair_moveValue(moved, pair) == moved);
+  assert(R_KeyValuePair_value(moved) == integer && R_KeyValuePair_value(pair) == NULL);
+
+  R_Type_Delete(moved);
+  R_Type_Delete(pair);
+}
+
+void test_read_value(void) {
+  R_KeyValuePair* pair = R_KeyValuePair_setInteger(R_Type_New(R_KeyValuePair), 5);
+  size_t pair_bytes = R_Type_BytesAllocated;
+
+  //Reading boxes into a new object and leaves the pair as it was
+  R_Integer* first = R_KeyValuePair_readValue(pair);
+  R_Integer* second = R_KeyValuePair_readValue(pair);
+  assert(first != second && R_Integer_get(first) == 5 && R_Integer_get(second) == 5);
+  R_Type_Delete(first);
+  R_Type_Delete(second);
+  assert(R_Type_BytesAllocated == pair_bytes);
+
+  R_MutableString* string = R_MutableString_setString(R_Type_New(R_MutableString), "text");
+  R_KeyValuePair_setValue(pair, string);
+  R_MutableString* read = R_KeyValuePair_readValue(pair);
+#ifdef R_TYPE_REFCOUNT
+  assert(read == string && R_Type_References(string) == 2);
+#else
+  assert(read != string && R_MutableString_compare(read, "text"));
+#endif
+  R_Type_Delete(read);
+  assert(R_KeyValuePair_readValue(R_KeyValuePair_setValue(pair, NULL)) == NULL);
+
+  R_Type_Delete(pair);
+}
+
+//Each thread asks the shared pair for its value and keeps what it got
+static void test_value_worker(void* argument) {
+  void** context = argument;
+  context[1] = R_KeyValuePair_value(context[0]);
+}
+
+void test_concurrent_value(void) {
+  R_KeyValuePair* pair = R_KeyValuePair_setInteger(R_Type_New(R_KeyValuePair), 9);
+  void* contexts[test_THREADS][2];
+  void* arguments[test_THREADS];
+  for (int i=0; i<test_THREADS; i++) {
+    contexts[i][0] = pair;
+    contexts[i][1] = NULL;
+    arguments[i] = contexts[i];
+  }
+
+  //Threads racing to box the same scalar all get the one box that was published
+  R_OS_parallelRun(test_value_worker, arguments, test_THREADS);
+  R_Integer* boxed = R_KeyValuePair_value(pair);
+  for (int i=0; i<test_THREADS; i++) assert(contexts[i][1] == boxed);
+  assert(R_Integer_get(boxed) == 9 && R_KeyValuePair_getInteger(pair) == 9);
+  assert(R_KeyValuePair_valueType(pair) == R_Type_Object(R_Integer));
+
+  R_Type_Delete(pair);
+}
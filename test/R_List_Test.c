@@ -191,6 +191,35 @@ void test_transfer(void) {
   R_Type_Delete(array);
 }
 
+void test_splice(void) {
+  R_List* first = R_Type_New(R_List);
+  R_List* second = R_Type_New(R_List);
+  for (int i=0; i<3; i++) R_Integer_set(R_List_add(second, R_Integer), i);
+  R_Integer* moved = R_List_first(second);
+
+  //Into an empty list, the pointer array changes hands
+  void** pointers = R_List_pointers(second);
+  assert(R_List_splice(first, second) == first);
+  assert(R_List_pointers(first) == pointers && R_List_size(first) == 3 && R_List_size(second) == 0);
+  assert(R_List_first(first) == moved);
+
+  for (int i=3; i<6; i++) R_Integer_set(R_List_add(second, R_Integer), i);
+  assert(R_List_transferList(first, second) == first);
+  assert(R_List_size(first) == 6 && R_List_size(second) == 0);
+  for (int i=0; i<6; i++) assert(R_Integer_get(R_List_pointerAtIndex(first, i)) == i);
+  assert(R_List_splice(first, second) == first && R_List_size(first) == 6);
+  assert(R_List_splice(first, first) == NULL);
+
+  R_List* list = R_Type_Move(first);
+  assert(R_List_size(list) == 6 && R_List_size(first) == 0 && R_List_first(list) == moved);
+  R_Integer_set(R_List_add(first, R_Integer), 6);
+  assert(R_List_size(first) == 1);
+
+  R_Type_Delete(list);
+  R_Type_Delete(first);
+  R_Type_Delete(second);
+}
+
 void test_copy(void) {
   R_List* array = R_Type_New(R_List);
   R_Integer* integer = R_List_add(array, R_Integer);
@@ -254,6 +283,221 @@ void test_puts(void) {
   R_Type_Delete(list);
 }
 
+int test_sort_descending(void* object_a, void* object_b) {
+  return R_Integer_get(object_b) - R_Integer_get(object_a);
+}
+
+void test_sort(void) {
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<1000; i++) R_Integer_set(R_List_add(list, R_Integer), (i*7919) % 1000);
+
+  assert(R_List_sort(list, NULL) == list);
+  assert(R_List_size(list) == 1000);
+  for (int i=0; i<1000; i++) assert(R_Integer_get(R_List_pointerAtIndex(list, i)) == i);
+
+  assert(R_List_sort(list, test_sort_descending) == list);
+  for (int i=0; i<1000; i++) assert(R_Integer_get(R_List_pointerAtIndex(list, i)) == 999-i);
+
+  R_Type_Delete(list);
+
+  list = R_Type_New(R_List);
+  R_MutableString_setString(R_List_add(list, R_MutableString), "pear");
+  R_MutableString_setString(R_List_add(list, R_MutableString), "apple");
+  R_MutableString_setString(R_List_add(list, R_MutableString), "app");
+  assert(R_List_sort(list, NULL) == list);
+  assert(R_MutableString_compare(R_List_pointerAtIndex(list, 0), "app"));
+  assert(R_MutableString_compare(R_List_pointerAtIndex(list, 1), "apple"));
+  assert(R_MutableString_compare(R_List_pointerAtIndex(list, 2), "pear"));
+  R_Type_Delete(list);
+}
+
+int test_stable_sort_tens(void* object_a, void* object_b) {
+  return ((Integer*)object_a)->integer/10 - ((Integer*)object_b)->integer/10;
+}
+
+void test_stable_sort(void) {
+  R_List* list = R_Type_New(R_List);
+  //Each ten shares a sort key, the ones digit records the original order
+  for (int i=0; i<100; i++) {
+    Integer* integer = R_List_add(list, Integer);
+    integer->integer = ((99-i)/10)*10 + i%10;
+  }
+  assert(R_List_stableSort(list, test_stable_sort_tens) == list);
+  for (int i=0; i<100; i++) assert(((Integer*)R_List_pointerAtIndex(list, i))->integer == i);
+  R_Type_Delete(list);
+  Integer_Destructor_Called = 0;
+  Integer_Constructor_Called = 0;
+}
+
+void test_parallel_sort(void) {
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<10000; i++) R_Integer_set(R_List_add(list, R_Integer), (i*7919) % 10000);
+  assert(R_List_parallelSort(list, NULL, 4) == list);
+  assert(R_List_size(list) == 10000);
+  for (int i=0; i<10000; i++) assert(R_Integer_get(R_List_pointerAtIndex(list, i)) == i);
+  assert(R_List_parallelSort(list, test_sort_descending, 3) == list);
+  for (int i=0; i<10000; i++) assert(R_Integer_get(R_List_pointerAtIndex(list, i)) == 9999-i);
+  R_Type_Delete(list);
+}
+
+void test_binary_search(void) {
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<50; i++) R_Integer_set(R_List_add(list, R_Integer), i*2);
+  R_Integer* needle = R_Type_New(R_Integer);
+
+  R_Integer_set(needle, 42);
+  assert(R_List_binarySearch(list, needle, NULL) == 21);
+  R_Integer_set(needle, 0);
+  assert(R_List_binarySearch(list, needle, NULL) == 0);
+  R_Integer_set(needle, 98);
+  assert(R_List_binarySearch(list, needle, NULL) == 49);
+  R_Integer_set(needle, 43);
+  assert(R_List_binarySearch(list, needle, NULL) == -1);
+  R_Integer_set(needle, 100);
+  assert(R_List_binarySearch(list, needle, NULL) == -1);
+
+  R_Type_Delete(needle);
+  R_Type_Delete(list);
+}
+
+static void* test_map_square(void* object, void* context) {
+  int value = R_Integer_get(object);
+  //Fails on the value context points at, if any
+  if (context != NULL && value == *(int*)context) return NULL;
+  return R_Integer_set(R_Type_New(R_Integer), value*value);
+}
+
+static bool test_filter_isMultipleOfThree(void* object, void* context) {
+  return R_Integer_get(object) % 3 == 0;
+}
+
+static void test_reduce_sum(void* accumulator, void* object, void* context) {
+  R_Integer_set(accumulator, R_Integer_get(accumulator) + R_Integer_get(object));
+}
+
+static void test_reduce_combine(void* accumulator, void* partial, void* context) {
+  R_Integer_set(accumulator, R_Integer_get(accumulator) + R_Integer_get(partial));
+}
+
+void test_map_filter_reduce(void) {
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<10000; i++) R_Integer_set(R_List_add(list, R_Integer), i);
+
+  for (size_t threads=1; threads<=4; threads+=3) {
+    R_List* squares = R_List_map(list, test_map_square, NULL, threads);
+    assert(R_List_size(squares) == 10000);
+    for (int i=0; i<10000; i++) assert(R_Integer_get(R_List_pointerAtIndex(squares, i)) == i*i);
+    R_Type_Delete(squares);
+
+    R_List* threes = R_List_filter(list, test_filter_isMultipleOfThree, NULL, threads);
+    assert(R_List_size(threes) == 3334);
+#ifdef R_TYPE_REFCOUNT
+    for (int i=0; i<3334; i++) assert(R_List_pointerAtIndex(threes, i) == R_List_pointerAtIndex(list, i*3));
+    assert(R_Type_References(R_List_first(list)) == 2);
+#else
+    for (int i=0; i<3334; i++) assert(R_Integer_get(R_List_pointerAtIndex(threes, i)) == i*3);
+#endif
+    R_Type_Delete(threes);
+
+    R_Integer* sum = R_Type_New(R_Integer);
+    assert(R_List_reduce(list, sum, test_reduce_sum, test_reduce_combine, NULL, threads) == sum);
+    assert(R_Integer_get(sum) == 10000*9999/2);
+    R_Type_Delete(sum);
+  }
+
+  //A failure in any slice fails the whole map, without leaking what the other slices made
+  int failing = 7500;
+  assert(R_List_map(list, test_map_square, &failing, 4) == NULL);
+
+  //Without a combiner the reduce stays on the calling thread
+  R_Integer* sum = R_Integer_set(R_Type_New(R_Integer), 5);
+  assert(R_List_reduce(list, sum, test_reduce_sum, NULL, NULL, 4) == sum && R_Integer_get(sum) == 5 + 10000*9999/2);
+  R_Type_Delete(sum);
+
+  R_List* empty = R_Type_New(R_List);
+  R_List* mapped = R_List_map(empty, test_map_square, NULL, 0);
+  assert(mapped != NULL && R_List_size(mapped) == 0);
+  R_Type_Delete(mapped);
+  R_Type_Delete(empty);
+  R_Type_Delete(list);
+}
+
+bool test_remove_if_isOdd(void* object, void* context) {
+  (*(int*)context)++;
+  return R_Integer_get(object) % 2 == 1;
+}
+
+void test_remove_if(void) {
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<10; i++) R_Integer_set(R_List_add(list, R_Integer), i);
+  int calls = 0;
+  assert(R_List_removeIf(list, test_remove_if_isOdd, &calls) == 5);
+  assert(calls == 10);
+  assert(R_List_size(list) == 5);
+  for (int i=0; i<5; i++) assert(R_Integer_get(R_List_pointerAtIndex(list, i)) == i*2);
+
+  R_Integer* duplicate = R_List_pointerAtIndex(list, 2);
+  R_List_transferOwnership(list, duplicate);
+  R_List_transferOwnership(list, duplicate);
+  assert(R_List_size(list) == 7);
+  R_List_removePointer(list, duplicate);
+  assert(R_List_size(list) == 4);
+  assert(R_Integer_get(R_List_pointerAtIndex(list, 2)) == 6);
+  R_Type_Delete(list);
+}
+
+void test_swap_remove(void) {
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<5; i++) R_Integer_set(R_List_add(list, R_Integer), i);
+  R_List_swapRemove(list, 1);
+  assert(R_List_size(list) == 4);
+  assert(R_Integer_get(R_List_pointerAtIndex(list, 0)) == 0);
+  assert(R_Integer_get(R_List_pointerAtIndex(list, 1)) == 4);
+  assert(R_Integer_get(R_List_pointerAtIndex(list, 2)) == 2);
+  assert(R_Integer_get(R_List_pointerAtIndex(list, 3)) == 3);
+  R_List_swapRemove(list, 3);
+  assert(R_List_size(list) == 3);
+  assert(R_Integer_get(R_List_last(list)) == 2);
+  R_List_swapRemove(list, 3);
+  assert(R_List_size(list) == 3);
+  R_Type_Delete(list);
+}
+
+void test_remove_range(void) {
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<10; i++) R_Integer_set(R_List_add(list, R_Integer), i);
+  R_List_removeRange(list, 2, 3);
+  assert(R_List_size(list) == 7);
+  assert(R_Integer_get(R_List_pointerAtIndex(list, 1)) == 1);
+  assert(R_Integer_get(R_List_pointerAtIndex(list, 2)) == 5);
+  R_List_removeRange(list, 5, 100);
+  assert(R_List_size(list) == 5);
+  assert(R_Integer_get(R_List_last(list)) == 7);
+  R_Type_Delete(list);
+}
+
+void test_shift(void) {
+  R_List* list = R_Type_New(R_List);
+  //Interleave adds and shifts so the head offset has to be reclaimed
+  int next = 0;
+  for (int round=0; round<100; round++) {
+    for (int i=0; i<3; i++) R_Integer_set(R_List_add(list, R_Integer), next++);
+    R_List_shift(list);
+    R_List_shift(list);
+  }
+  assert(R_List_size(list) == 100);
+  for (int i=0; i<100; i++) assert(R_Integer_get(R_List_pointerAtIndex(list, i)) == 200+i);
+  R_List_each(list, R_Integer, integer) assert(R_Integer_get(integer) >= 200);
+  while (R_List_size(list)) R_List_shift(list);
+  assert(R_List_first(list) == NULL);
+  R_Integer_set(R_List_add(list, R_Integer), 42);
+  assert(R_Integer_get(R_List_first(list)) == 42);
+
+  assert(R_List_reserve(list, 1000) == list);
+  assert(R_List_size(list) == 1);
+  R_Type_Delete(list);
+}
+
 int main(void) {
 	test_allocations();
 	test_integer();
@@ -265,7 +509,17 @@ int main(void) {
 	test_add_copy();
 	test_copy();
 	test_append();
+	test_splice();
   test_puts();
+  test_sort();
+  test_stable_sort();
+  test_parallel_sort();
+  test_binary_search();
+  test_map_filter_reduce();
+  test_remove_if();
+  test_swap_remove();
+  test_remove_range();
+  test_shift();
 
 	assert(R_Type_BytesAllocated == 0);
 	printf("Pass\n");
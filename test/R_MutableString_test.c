@@ -4,6 +4,7 @@
 #include <string.h>
 #include "R_MutableString.h"
 #include "R_MutableData.h"
+#include "R_OS.h"
 
 void test_set_get(void) {
 	R_MutableString* string = R_Type_New(R_MutableString);
@@ -93,6 +94,94 @@ void test_setHex(void) {
 	R_Type_Delete(string);
 }
 
+void test_take(void) {
+	R_MutableString* stringA = R_MutableString_setString(R_Type_New(R_MutableString), "old");
+	R_MutableString* stringB = R_MutableString_setString(R_Type_New(R_MutableString), "taken");
+	const uint8_t* bytes = R_MutableData_bytes(R_MutableString_bytes(stringB));
+	R_MutableString_cstring(stringA);
+	assert(R_MutableString_take(stringA, stringB) == stringA);
+	assert(R_MutableString_compare(stringA, "taken") && R_MutableString_length(stringB) == 0);
+	assert(R_MutableData_bytes(R_MutableString_bytes(stringA)) == bytes);
+	assert(R_MutableString_compare(R_MutableString_appendCString(stringB, "reused"), "reused"));
+
+	R_MutableString* moved = R_Type_Move(stringA);
+	assert(R_MutableString_compare(moved, "taken") && R_MutableString_length(stringA) == 0);
+	assert(R_MutableData_bytes(R_MutableString_bytes(moved)) == bytes);
+
+	R_MutableData* source = R_MutableData_appendCArray(R_Type_New(R_MutableData), bytes, 5);
+	bytes = R_MutableData_bytes(source);
+	R_MutableData* data = R_Type_Move(source);
+	assert(R_MutableData_bytes(data) == bytes && R_MutableData_size(source) == 0);
+	assert(R_MutableData_take(data, data) == data && R_MutableData_size(data) == 5);
+	R_Type_Delete(source);
+
+	R_Type_Delete(data);
+	R_Type_Delete(moved);
+	R_Type_Delete(stringA);
+	R_Type_Delete(stringB);
+}
+
+void test_copy_on_write(void) {
+	R_MutableString* original = R_MutableString_setString(R_Type_New(R_MutableString), "shared bytes");
+	const uint8_t* bytes = R_MutableData_bytes(R_MutableString_bytes(original));
+	R_MutableString* copyA = R_Type_Copy(original);
+	R_MutableString* copyB = R_Type_Copy(copyA);
+	assert(R_MutableData_bytes(R_MutableString_bytes(copyA)) == bytes && R_MutableData_bytes(R_MutableString_bytes(copyB)) == bytes);
+
+	//Shifting only moves the view
+	R_MutableString_shiftCharacters(copyB, 7);
+	assert(R_MutableString_compare(copyB, "bytes") && R_MutableData_bytes(R_MutableString_bytes(copyB)) == bytes+7);
+
+	//Writing copies
+	R_MutableString_appendCString(copyA, "!");
+	assert(R_MutableString_compare(copyA, "shared bytes!") && R_MutableData_bytes(R_MutableString_bytes(copyA)) != bytes);
+	R_MutableString_setString(copyB, "set");
+	assert(R_MutableString_compare(copyB, "set") && R_MutableString_compare(original, "shared bytes"));
+
+	//The last one left writes in place
+	assert(R_MutableString_appendCString(original, "?") && R_MutableString_compare(original, "shared bytes?"));
+	R_Type_Delete(copyA);
+	R_Type_Delete(copyB);
+
+	R_MutableData* data = R_MutableData_appendCArray(R_Type_New(R_MutableData), (const uint8_t*)"abcdef", 6);
+	R_MutableData* shifted = R_Type_Copy(data);
+	R_MutableData_shift(shifted);
+	R_MutableData_unshift(shifted, 'z');
+	assert(R_MutableData_compareWithCArray(shifted, (const uint8_t*)"zbcdef", 6) == 0);
+	assert(R_MutableData_compareWithCArray(data, (const uint8_t*)"abcdef", 6) == 0);
+
+	R_MutableData* moved = R_Type_New(R_MutableData);
+	R_MutableData_share(shifted, data);
+	R_MutableData_moveSubArray(moved, shifted, 1, 2);
+	assert(R_MutableData_compareWithCArray(moved, (const uint8_t*)"bc", 2) == 0);
+	assert(R_MutableData_compareWithCArray(shifted, (const uint8_t*)"adef", 4) == 0);
+	assert(R_MutableData_compareWithCArray(data, (const uint8_t*)"abcdef", 6) == 0);
+
+	//Sharing an empty array shares nothing
+	R_MutableData_share(moved, R_MutableData_reset(shifted));
+	assert(R_MutableData_size(moved) == 0 && R_MutableData_share(data, data) == data);
+
+	R_Type_Delete(moved);
+	R_Type_Delete(shifted);
+	R_Type_Delete(data);
+	R_Type_Delete(original);
+}
+
+static void test_copyRepeatedly(void* context) {
+	for (int i=0; i<1000; i++) R_Type_Delete(R_Type_Copy(context));
+}
+
+//Copying only reads the original, so threads can copy one that's never been shared before at the same time
+void test_concurrent_copies(void) {
+	for (int round=0; round<20; round++) {
+		R_MutableString* original = R_MutableString_setString(R_Type_New(R_MutableString), "copied from every thread");
+		void* contexts[] = {original, original, original, original};
+		R_OS_parallelRun(test_copyRepeatedly, contexts, 4);
+		assert(R_MutableString_appendCString(original, "!") && R_MutableString_compare(original, "copied from every thread!"));
+		R_Type_Delete(original);
+	}
+}
+
 void test_is_same(void) {
 	R_MutableString* stringA = R_Type_New(R_MutableString);
 	R_MutableString* stringB = R_Type_New(R_MutableString);
@@ -160,6 +249,11 @@ void test_shift(void) {
 	assert(R_MutableString_push(string, '6') == string);
 	assert(R_MutableString_length(string) == 2);
 	assert(R_MutableString_last(string) == '6');
+	R_MutableString_setString(string, "012345");
+	assert(R_MutableString_shiftCharacters(string, 4) == string);
+	assert(R_MutableString_compare(string, "45"));
+	assert(R_MutableString_shiftCharacters(string, 10) == string);
+	assert(R_MutableString_length(string) == 0);
 	R_Type_Delete(string);
 }
 
@@ -235,6 +329,9 @@ int main(void) {
 	test_base64();
 	test_puts();
 	test_is_same();
+	test_take();
+	test_copy_on_write();
+	test_concurrent_copies();
 
 	assert(R_Type_BytesAllocated == 0);
 	printf("Pass\n");
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "R_Ndjson.h"
+#include "R_OS.h"
+
+typedef struct {
+  R_MutableString* ids;
+  size_t limit;
+} test_context;
+
+static bool test_collect(R_Dictionary* record, void* context) {
+  test_context* collected = context;
+  R_MutableString_appendInt(collected->ids, R_Dictionary_getInteger(record, "id"));
+  R_MutableString_push(collected->ids, ';');
+  return --collected->limit > 0;
+}
+
+void test_read_json(void) {
+  R_Dictionary* dict = R_Type_New(R_Dictionary);
+  R_MutableString* buffer = R_MutableString_setString(R_Type_New(R_MutableString), "  {\"id\": 1}{\"id\": [2, 3]} {\"id\":");
+  assert(R_Dictionary_readJson(dict, buffer, R_Dictionary_JsonOption_None) == dict);
+  assert(R_Dictionary_getInteger(dict, "id") == 1);
+  assert(R_Dictionary_readJson(dict, buffer, R_Dictionary_JsonOption_None) == dict);
+  assert(R_Type_IsOf(R_Dictionary_get(dict, "id"), R_List));
+  assert(R_MutableString_compare(buffer, "{\"id\":"));
+  assert(R_Dictionary_readJson(dict, buffer, R_Dictionary_JsonOption_None) == NULL);
+  R_Type_Delete(buffer);
+  R_Type_Delete(dict);
+}
+
+void test_each(void) {
+  const char* lines = "{\"id\": 1}\r\n\n   \n{\"id\": 2, \"name\": \"two\"}\nnot json\n{\"id\": 3} trailing\n[4]\n{\"id\": 5}";
+  R_Dictionary* record = R_Type_New(R_Dictionary);
+  test_context context = {R_Type_New(R_MutableString), 100};
+  assert(R_Ndjson_each(record, lines, strlen(lines), R_Dictionary_JsonOption_None, test_collect, &context) == 3);
+  assert(R_MutableString_compare(context.ids, "1;2;5;"));
+
+  R_MutableString_reset(context.ids);
+  context.limit = 2;
+  assert(R_Ndjson_each(record, lines, strlen(lines), R_Dictionary_JsonOption_Lazy, test_collect, &context) == 2);
+  assert(R_MutableString_compare(context.ids, "1;2;"));
+  assert(R_Ndjson_each(record, "", 0, R_Dictionary_JsonOption_None, test_collect, &context) == 0);
+  R_Type_Delete(context.ids);
+  R_Type_Delete(record);
+}
+
+void test_writer(void) {
+  R_NdjsonWriter* writer = R_Type_New(R_NdjsonWriter);
+  R_Dictionary* record = R_Type_New(R_Dictionary);
+  R_Dictionary_setInteger(record, "id", 1);
+  assert(R_NdjsonWriter_write(writer, record) == writer);
+  R_Dictionary_setInteger(record, "id", 2);
+  assert(R_NdjsonWriter_write(writer, record) == writer);
+  assert(R_NdjsonWriter_flush(writer) == writer);
+  assert(R_MutableData_size(R_NdjsonWriter_buffer(writer)) == 18);
+  assert(memcmp(R_MutableData_bytes(R_NdjsonWriter_buffer(writer)), "{\"id\":1}\n{\"id\":2}\n", 18) == 0);
+  R_Type_Delete(record);
+  R_Type_Delete(writer);
+}
+
+void test_file(void) {
+  const char* path = "objects/R_Ndjson_test.ndjson";
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  assert(fd >= 0);
+
+  //Small flushes, and one record longer than a read block
+  R_NdjsonWriter* writer = R_NdjsonWriter_setFd(R_Type_New(R_NdjsonWriter), fd, 100);
+  R_Dictionary* record = R_Type_New(R_Dictionary);
+  for (int index=1; index<=500; index++) {
+    R_Dictionary_setInteger(record, "id", index);
+    if (index == 250) {
+      R_MutableString* padding = R_Dictionary_add(record, "padding", R_MutableString);
+      for (int count=0; count<R_Ndjson_BlockSize; count++) R_MutableString_push(padding, 'x');
+    }
+    if (index == 251) R_Dictionary_remove(record, "padding");
+    assert(R_NdjsonWriter_write(writer, record) == writer);
+    assert(R_MutableData_size(R_NdjsonWriter_buffer(writer)) < 100);
+  }
+  R_Type_Delete(writer);
+
+  test_context context = {R_Type_New(R_MutableString), 1000};
+  assert(lseek(fd, 0, SEEK_SET) == 0);
+  assert(R_Ndjson_eachFromFd(record, fd, R_Dictionary_JsonOption_None, test_collect, &context) == 500);
+  assert(strncmp(R_MutableString_getString(context.ids), "1;2;3;", 6) == 0);
+  assert(R_MutableString_length(context.ids) == strlen("1;") * 9 + strlen("10;") * 90 + strlen("100;") * 401);
+  close(fd);
+
+  size_t size = 0;
+  const char* mapped = R_OS_mapFile(path, &size);
+  assert(mapped != NULL);
+  R_MutableString_reset(context.ids);
+  context.limit = 1000;
+  assert(R_Ndjson_each(record, mapped, size, R_Dictionary_JsonOption_Lazy, test_collect, &context) == 500);
+  R_OS_unmapFile(mapped, size);
+  unlink(path);
+
+  R_Type_Delete(context.ids);
+  R_Type_Delete(record);
+}
+
+int main(void) {
+  test_read_json();
+  test_each();
+  test_writer();
+  test_file();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
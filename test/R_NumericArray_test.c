@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "R_OS.h"
+#include "R_NumericArray.h"
+
+void test_allocation(void) {
+  R_IntArray* integers = R_Type_New(R_IntArray);
+  R_FloatArray* floats = R_Type_New(R_FloatArray);
+  R_DoubleArray* doubles = R_Type_New(R_DoubleArray);
+  assert(R_IntArray_size(integers) == 0);
+  assert(R_FloatArray_size(floats) == 0);
+  assert(R_DoubleArray_size(doubles) == 0);
+  R_Type_Delete(integers);
+  R_Type_Delete(floats);
+  R_Type_Delete(doubles);
+  assert(R_Type_BytesAllocated == 0);
+}
+
+void test_append(void) {
+  R_IntArray* integers = R_Type_New(R_IntArray);
+  for (int i=0; i<1000; i++) assert(R_IntArray_append(integers, i) == integers);
+  assert(R_IntArray_size(integers) == 1000);
+  assert(R_IntArray_get(integers, 999) == 999);
+  assert(R_IntArray_get(integers, 1000) == 0);
+  assert(R_IntArray_values(integers)[10] == 10);
+
+  assert(R_IntArray_set(integers, 10, -10) == integers);
+  assert(R_IntArray_get(integers, 10) == -10);
+  assert(R_IntArray_set(integers, 1000, 1) == NULL);
+
+  const int values[] = {1, 2, 3};
+  assert(R_IntArray_appendCArray(integers, values, 3) == integers);
+  assert(R_IntArray_size(integers) == 1003);
+  assert(R_IntArray_get(integers, 1002) == 3);
+
+  assert(R_IntArray_reset(integers) == integers);
+  assert(R_IntArray_size(integers) == 0);
+  R_Type_Delete(integers);
+}
+
+void test_reductions(void) {
+  R_IntArray* integers = R_Type_New(R_IntArray);
+  assert(R_IntArray_sum(integers) == 0);
+  assert(R_IntArray_min(integers) == 0);
+  assert(R_IntArray_max(integers) == 0);
+  R_IntArray_reserve(integers, 101);
+  for (int i=-50; i<=50; i++) R_IntArray_append(integers, i*3);
+  assert(R_IntArray_sum(integers) == 0);
+  assert(R_IntArray_min(integers) == -150);
+  assert(R_IntArray_max(integers) == 150);
+  R_IntArray_append(integers, 2147483647);
+  R_IntArray_append(integers, 2147483647);
+  assert(R_IntArray_sum(integers) == 4294967294LL);
+  R_Type_Delete(integers);
+
+  R_FloatArray* floats = R_Type_New(R_FloatArray);
+  for (int i=1; i<=7; i++) R_FloatArray_append(floats, i*0.5f);
+  assert(R_FloatArray_sum(floats) == 14.0);
+  assert(R_FloatArray_min(floats) == 0.5f);
+  assert(R_FloatArray_max(floats) == 3.5f);
+  R_Type_Delete(floats);
+
+  R_DoubleArray* doubles = R_Type_New(R_DoubleArray);
+  const double values[] = {3.0, -1.5, 8.25, 0.0, 2.0};
+  R_DoubleArray_appendCArray(doubles, values, 5);
+  assert(R_DoubleArray_sum(doubles) == 11.75);
+  assert(R_DoubleArray_min(doubles) == -1.5);
+  assert(R_DoubleArray_max(doubles) == 8.25);
+  R_Type_Delete(doubles);
+}
+
+void test_copy_and_equals(void) {
+  R_FloatArray* floats = R_Type_New(R_FloatArray);
+  for (int i=0; i<20; i++) R_FloatArray_append(floats, i/4.0f);
+  R_FloatArray* copy = R_Type_Copy(floats);
+  assert(copy != NULL && copy != floats);
+  assert(R_FloatArray_values(copy) != R_FloatArray_values(floats));
+  assert(R_Equals(floats, copy));
+  R_FloatArray_set(copy, 3, 100.0f);
+  assert(!R_Equals(floats, copy));
+  R_FloatArray_set(copy, 3, R_FloatArray_get(floats, 3));
+  R_FloatArray_append(copy, 1.0f);
+  assert(!R_FloatArray_isSame(floats, copy));
+  R_Type_Delete(copy);
+  R_Type_Delete(floats);
+}
+
+//Lets allowed more allocations through, then fails every one until it's uninstalled
+static size_t test_allowed = 0;
+static void* test_failing_malloc(void* context, size_t size, const R_Allocator_Site* site) {
+  if (test_allowed == 0) return NULL;
+  test_allowed--;
+  return malloc(size);
+}
+static void* test_failing_zalloc(void* context, size_t size, const R_Allocator_Site* site) {
+  if (test_allowed == 0) return NULL;
+  test_allowed--;
+  return calloc(1, size);
+}
+static void* test_failing_realloc(void* context, void* pointer, size_t old_size, size_t size, const R_Allocator_Site* site) {
+  if (test_allowed == 0) return NULL;
+  test_allowed--;
+  return realloc(pointer, size);
+}
+static void test_failing_free(void* context, void* pointer, size_t size, const R_Allocator_Site* site) {
+  free(pointer);
+}
+static const R_Allocator test_failing = {test_failing_malloc, test_failing_zalloc, test_failing_realloc, test_failing_free, NULL};
+
+void test_failed_copy(void) {
+  R_IntArray* integers = R_Type_New(R_IntArray);
+  for (int i=0; i<5; i++) R_IntArray_append(integers, i);
+  size_t bytes = R_Type_BytesAllocated;
+
+  //The copy itself is allocated but its values aren't, so it's deleted rather than returned short
+  test_allowed = 1;
+  R_Allocator_set(&test_failing);
+  assert(R_Type_Copy(integers) == NULL);
+  R_Allocator_set(NULL);
+  assert(R_Type_BytesAllocated == bytes);
+
+  R_Type_Delete(integers);
+}
+
+void test_stringify(void) {
+  char buffer[64];
+  R_IntArray* integers = R_Type_New(R_IntArray);
+  assert(R_Stringify(integers, buffer, sizeof(buffer)) == 2);
+  assert(strcmp(buffer, "[]") == 0);
+  R_IntArray_append(integers, 1);
+  R_IntArray_append(integers, -2);
+  R_IntArray_append(integers, 3);
+  assert(R_Stringify(integers, buffer, sizeof(buffer)) == 8);
+  assert(strcmp(buffer, "[1,-2,3]") == 0);
+  R_Type_Delete(integers);
+
+  R_DoubleArray* doubles = R_Type_New(R_DoubleArray);
+  R_DoubleArray_append(doubles, 0.25);
+  R_DoubleArray_append(doubles, 4);
+  R_Stringify(doubles, buffer, sizeof(buffer));
+  assert(strcmp(buffer, "[0.25,4]") == 0);
+  R_Type_Delete(doubles);
+}
+
+int main(void) {
+  assert(R_Type_BytesAllocated == 0);
+  test_allocation();
+  test_append();
+  test_reductions();
+  test_copy_and_equals();
+  test_failed_copy();
+  test_stringify();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
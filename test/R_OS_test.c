@@ -2,14 +2,23 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <string.h>
+#include <pthread.h>
 #include "R_OS.h"
 
 void test_atoi(void);
 void test_atof(void);
+void test_allocator(void);
+void test_allocator_sizes(void);
+void test_allocator_thread(void);
+void test_realloc_alt(void);
 
 int main(void) {
   test_atoi();
   test_atof();
+  test_allocator();
+  test_allocator_sizes();
+  test_allocator_thread();
+  test_realloc_alt();
   printf("PASS\n");
 }
 
@@ -37,3 +46,90 @@ void test_atof(void) {
   assert(os_atof_alt("-1e0") == -1e0);
 }
 
+
+static size_t test_allocator_calls = 0;
+static void* test_allocator_malloc(void* context, size_t size, const R_Allocator_Site* site) {
+  test_allocator_calls++;
+  assert(context == &test_allocator_calls);
+  return malloc(size);
+}
+static void* test_allocator_zalloc(void* context, size_t size, const R_Allocator_Site* site) {
+  test_allocator_calls++;
+  return calloc(1, size);
+}
+static size_t test_allocator_old_size = 0;
+static size_t test_allocator_freed_size = 0;
+static void* test_allocator_realloc(void* context, void* pointer, size_t old_size, size_t size, const R_Allocator_Site* site) {
+  test_allocator_calls++;
+  test_allocator_old_size = old_size;
+  assert(site != NULL && site->line > 0 && strstr(site->file, "R_OS_test.c") != NULL);
+  return realloc(pointer, size);
+}
+static void test_allocator_free(void* context, void* pointer, size_t size, const R_Allocator_Site* site) {
+  test_allocator_calls++;
+  test_allocator_freed_size = size;
+  free(pointer);
+}
+
+void test_allocator(void) {
+  const R_Allocator allocator = {test_allocator_malloc, test_allocator_zalloc, test_allocator_realloc, test_allocator_free, &test_allocator_calls};
+  assert(R_Allocator_get() == R_Allocator_system());
+  R_Allocator_set(&allocator);
+  assert(R_Allocator_get() == &allocator);
+  char* bytes = os_malloc(4);
+  bytes = os_realloc(bytes, 8);
+  os_free(bytes);
+  os_free(os_zalloc(4));
+  assert(test_allocator_calls == 5);
+  R_Allocator_set(NULL);
+  assert(R_Allocator_get() == R_Allocator_system());
+}
+
+void test_allocator_sizes(void) {
+  const R_Allocator allocator = {test_allocator_malloc, test_allocator_zalloc, test_allocator_realloc, test_allocator_free, &test_allocator_calls};
+  R_Allocator_set(&allocator);
+  char* bytes = os_malloc(4);
+  bytes = os_realloc(bytes, 8);
+  assert(test_allocator_old_size == R_OS_UNKNOWN_SIZE);
+  bytes = os_realloc_sized(bytes, 8, 16);
+  assert(test_allocator_old_size == 8);
+  os_free_sized(bytes, 16);
+  assert(test_allocator_freed_size == 16);
+  os_free(os_malloc(4));
+  assert(test_allocator_freed_size == R_OS_UNKNOWN_SIZE);
+  R_Allocator_set(NULL);
+}
+
+static void* test_allocator_thread_main(void* argument) {
+  const R_Allocator* allocator = (const R_Allocator*)argument;
+  assert(R_Allocator_get() == R_Allocator_system());
+  R_Allocator_setForThread(allocator);
+  assert(R_Allocator_get() == allocator);
+  os_free(os_malloc(4));
+  R_Allocator_setForThread(NULL);
+  assert(R_Allocator_get() == R_Allocator_system());
+  return NULL;
+}
+
+void test_allocator_thread(void) {
+  const R_Allocator allocator = {test_allocator_malloc, test_allocator_zalloc, test_allocator_realloc, test_allocator_free, &test_allocator_calls};
+  test_allocator_calls = 0;
+  pthread_t thread;
+  assert(pthread_create(&thread, NULL, test_allocator_thread_main, (void*)&allocator) == 0);
+  assert(pthread_join(thread, NULL) == 0);
+  assert(test_allocator_calls == 2);
+  assert(R_Allocator_get() == R_Allocator_system());
+  os_free(os_malloc(4));
+  assert(test_allocator_calls == 2);
+}
+
+void test_realloc_alt(void) {
+  char* bytes = (char*)os_malloc(16);
+  memcpy(bytes, "0123456789abcdef", 16);
+  bytes = (char*)os_realloc_alt(bytes, 4, 32);
+  assert(bytes != NULL);
+  assert(memcmp(bytes, "0123", 4) == 0);
+  bytes = (char*)os_realloc_alt(bytes, 32, 2);
+  assert(memcmp(bytes, "01", 2) == 0);
+  os_free(bytes);
+}
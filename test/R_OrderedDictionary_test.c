@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "R_OrderedDictionary.h"
+
+#define test_KEYS 5000
+
+typedef struct {
+  char keys[test_KEYS][24];
+  size_t count;
+} test_Keys;
+
+static bool test_collect(R_KeyValuePair* pair, void* context) {
+  test_Keys* keys = context;
+  const char* key = R_MutableString_cstring(R_KeyValuePair_key(pair));
+  strncpy(keys->keys[keys->count++], key, 23);
+  return true;
+}
+
+static bool test_stopAtThree(R_KeyValuePair* pair, void* context) {
+  return ++*(int*)context < 3;
+}
+
+void test_add_get_remove(void) {
+  R_OrderedDictionary* dictionary = R_Type_New(R_OrderedDictionary);
+  assert(R_OrderedDictionary_get(dictionary, "missing") == NULL && !R_OrderedDictionary_remove(dictionary, "missing"));
+
+  R_OrderedDictionary_setInteger(dictionary, "b", 2);
+  R_OrderedDictionary_setFloat(dictionary, "a", 1.5f);
+  R_OrderedDictionary_setBoolean(dictionary, "c", true);
+  R_OrderedDictionary_setNull(dictionary, "d");
+  R_MutableString_setString(R_OrderedDictionary_add(dictionary, "e", R_MutableString), "text");
+  assert(R_OrderedDictionary_size(dictionary) == 5);
+  assert(R_OrderedDictionary_getInteger(dictionary, "b") == 2 && R_OrderedDictionary_getFloat(dictionary, "a") == 1.5f);
+  assert(R_OrderedDictionary_getBoolean(dictionary, "c") && R_Type_IsOf(R_OrderedDictionary_get(dictionary, "d"), R_Null));
+  assert(R_MutableString_compare(R_OrderedDictionary_get(dictionary, "e"), "text"));
+
+  //Setting a key again replaces its value
+  R_OrderedDictionary_setInteger(dictionary, "b", 20);
+  assert(R_OrderedDictionary_size(dictionary) == 5 && R_OrderedDictionary_getInteger(dictionary, "b") == 20);
+
+#ifdef R_TYPE_REFCOUNT
+  R_Integer* shared = R_Integer_set(R_Type_New(R_Integer), 7);
+  assert(R_OrderedDictionary_addShared(dictionary, "f", shared) == shared && R_Type_References(shared) == 2);
+  assert(R_OrderedDictionary_remove(dictionary, "f") && R_Type_References(shared) == 1);
+  R_Type_Delete(shared);
+#endif
+  assert(R_OrderedDictionary_remove(dictionary, "a") && !R_OrderedDictionary_isPresent(dictionary, "a"));
+  assert(R_OrderedDictionary_size(dictionary) == 4);
+
+  R_MutableString* json = R_OrderedDictionary_toJson(dictionary, R_Type_New(R_MutableString));
+  assert(R_MutableString_compare(json, "{\"b\":20,\"c\":true,\"d\":null,\"e\":\"text\"}"));
+  char buffer[64];
+  assert(R_Stringify(dictionary, buffer, sizeof(buffer)) == 37);
+  assert(strcmp(buffer, "{\"b\":20,\"c\":true,\"d\":null,\"e\":\"text\"}") == 0);
+
+  R_OrderedDictionary* copy = R_Type_Copy(dictionary);
+  R_OrderedDictionary_removeAll(dictionary);
+  assert(R_OrderedDictionary_size(dictionary) == 0 && R_OrderedDictionary_get(dictionary, "b") == NULL);
+  assert(R_OrderedDictionary_toJson(copy, json) == json && R_MutableString_compare(json, "{\"b\":20,\"c\":true,\"d\":null,\"e\":\"text\"}"));
+
+  R_Type_Delete(json);
+  R_Type_Delete(copy);
+  R_Type_Delete(dictionary);
+}
+
+void test_many_keys(void) {
+  R_OrderedDictionary* dictionary = R_Type_New(R_OrderedDictionary);
+  static bool present[test_KEYS];
+  static test_Keys keys;
+  char key[16];
+  size_t size = 0;
+
+  //Adds and removes in a scrambled order, so nodes split, borrow and merge at every level
+  unsigned int state = 1;
+  for (int round=0; round<4*test_KEYS; round++) {
+    state = state*1103515245 + 12345;
+    int index = (state >> 8) % test_KEYS;
+    snprintf(key, sizeof(key), "key%05d", index);
+    if (round < 2*test_KEYS || (state & 0x10)) {
+      size += !present[index];
+      present[index] = true;
+      assert(R_OrderedDictionary_setInteger(dictionary, key, index) == dictionary);
+    }
+    else {
+      assert(R_OrderedDictionary_remove(dictionary, key) == present[index]);
+      size -= present[index];
+      present[index] = false;
+    }
+    assert(R_OrderedDictionary_size(dictionary) == size);
+  }
+
+  keys.count = 0;
+  assert(R_OrderedDictionary_each(dictionary, test_collect, &keys) == size && keys.count == size);
+  for (size_t i=1; i<keys.count; i++) assert(strcmp(keys.keys[i - 1], keys.keys[i]) < 0);
+  for (int i=0; i<test_KEYS; i++) {
+    snprintf(key, sizeof(key), "key%05d", i);
+    assert(R_OrderedDictionary_isPresent(dictionary, key) == present[i]);
+    if (present[i]) assert(R_OrderedDictionary_getInteger(dictionary, key) == i);
+  }
+
+  //Everything goes again, leaving an empty tree
+  for (int i=0; i<test_KEYS; i++) {
+    snprintf(key, sizeof(key), "key%05d", i);
+    assert(R_OrderedDictionary_remove(dictionary, key) == present[i]);
+  }
+  assert(R_OrderedDictionary_size(dictionary) == 0 && R_OrderedDictionary_each(dictionary, test_collect, &keys) == 0);
+  R_Type_Delete(dictionary);
+}
+
+void test_ranges(void) {
+  R_OrderedDictionary* dictionary = R_Type_New(R_OrderedDictionary);
+  static test_Keys keys;
+  char key[32];
+  //Keys longer than the 8 bytes kept in the nodes, so ties between heads are common
+  for (int i=0; i<1000; i++) {
+    snprintf(key, sizeof(key), "metrics.%s.%04d", (i % 2) ? "cpu" : "memory", i);
+    R_OrderedDictionary_setInteger(dictionary, key, i);
+  }
+
+  R_KeyValuePair* bound = R_OrderedDictionary_lowerBound(dictionary, "metrics.cpu.0500");
+  assert(R_MutableString_compare(R_KeyValuePair_key(bound), "metrics.cpu.0501"));
+  assert(R_OrderedDictionary_lowerBound(dictionary, "metrics.memory.0998") == R_OrderedDictionary_lowerBound(dictionary, "metrics.memory.0997"));
+  assert(R_OrderedDictionary_lowerBound(dictionary, "z") == NULL);
+  assert(R_MutableString_compare(R_KeyValuePair_key(R_OrderedDictionary_lowerBound(dictionary, "")), "metrics.cpu.0001"));
+
+  keys.count = 0;
+  assert(R_OrderedDictionary_range(dictionary, "metrics.cpu.0100", "metrics.cpu.0200", test_collect, &keys) == 50);
+  assert(strcmp(keys.keys[0], "metrics.cpu.0101") == 0 && strcmp(keys.keys[49], "metrics.cpu.0199") == 0);
+
+  keys.count = 0;
+  assert(R_OrderedDictionary_eachWithPrefix(dictionary, "metrics.memory.", test_collect, &keys) == 500);
+  for (size_t i=0; i<keys.count; i++) assert(strncmp(keys.keys[i], "metrics.memory.", 15) == 0);
+  assert(R_OrderedDictionary_eachWithPrefix(dictionary, "metrics.disk", test_collect, &keys) == 0);
+  assert(R_OrderedDictionary_range(dictionary, NULL, "metrics.cpu.0010", test_collect, &keys) == 5);
+  assert(R_OrderedDictionary_range(dictionary, "metrics.memory.0990", NULL, test_collect, &keys) == 5);
+
+  int calls = 0;
+  assert(R_OrderedDictionary_each(dictionary, test_stopAtThree, &calls) == 3 && calls == 3);
+  R_Type_Delete(dictionary);
+}
+
+void test_json(void) {
+  R_OrderedDictionary* dictionary = R_Type_New(R_OrderedDictionary);
+  R_OrderedDictionary_setInteger(dictionary, "count", 1);
+  R_MutableString* json = R_Type_New(R_MutableString);
+  R_MutableString_setString(json, "{\"zebra\":[1,2],\"apple\":{\"b\":1,\"a\":2},\"count\":3}");
+  assert(R_OrderedDictionary_fromJson(dictionary, json) == dictionary);
+  assert(R_OrderedDictionary_size(dictionary) == 3 && R_OrderedDictionary_getInteger(dictionary, "count") == 3);
+  assert(R_OrderedDictionary_toJson(dictionary, json) == json);
+  assert(R_MutableString_compare(json, "{\"apple\":{\"b\":1,\"a\":2},\"count\":3,\"zebra\":[1,2]}"));
+
+  //An ordered dictionary nested in a dictionary writes its keys in order too
+  R_Dictionary* document = R_Type_New(R_Dictionary);
+  R_Dictionary_transferOwnership(document, "sorted", dictionary);
+  R_Dictionary_toJson(document, json);
+  assert(R_MutableString_compare(json, "{\"sorted\":{\"apple\":{\"b\":1,\"a\":2},\"count\":3,\"zebra\":[1,2]}}"));
+  assert(R_OrderedDictionary_fromJson(dictionary, NULL) == NULL);
+
+  R_Type_Delete(document);
+  R_Type_Delete(json);
+}
+
+int main(void) {
+  test_add_get_remove();
+  test_many_keys();
+  test_ranges();
+  test_json();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "R_Path.h"
+#include "R_Dictionary.h"
+#include "R_NumericArray.h"
+
+static const char* test_document = "{\"orders\": [{\"id\": 1, \"line_items\": [{\"price\": \"1.50\"}, {\"price\": \"2.25\"}]},"
+  " {\"id\": 2, \"line_items\": [{\"price\": \"9.99\", \"sku\": \"x\"}], \"a/b\": {\"m~n\": true}, \"odd \\\"key\\\"\": [1, 2]}],"
+  " \"count\": 2, \"empty\": {}, \"none\": []}";
+
+static R_Dictionary* test_dictionary(uint32_t options) {
+  R_MutableString* json = R_MutableString_setString(R_Type_New(R_MutableString), test_document);
+  R_Dictionary* dict = R_Dictionary_fromJsonWithOptions(R_Type_New(R_Dictionary), json, options);
+  R_Type_Delete(json);
+  return dict;
+}
+
+static bool test_collect(void* value, void* context) {
+  R_MutableString_appendString(context, value);
+  R_MutableString_push(context, ';');
+  return true;
+}
+
+static bool test_collectJson(const char* json, size_t length, void* context) {
+  R_MutableString_appendBytes(context, json, length);
+  R_MutableString_push(context, ';');
+  return true;
+}
+
+void test_compile(void) {
+  R_Path* path = R_Type_New(R_Path);
+  assert(R_Path_compile(path, "") == path && R_Path_size(path) == 0);
+  assert(R_Path_compile(path, "$") == path && R_Path_size(path) == 0);
+  assert(R_Path_compile(path, "/orders/0/id") == path && R_Path_size(path) == 3);
+  assert(R_Path_compile(path, "orders[3].line_items[*].price") == path && R_Path_size(path) == 5);
+  assert(R_Path_compile(path, "$.orders.*[\"odd \\\"key\\\"\"]") == path && R_Path_size(path) == 3);
+  assert(R_Path_compile(path, "/a~2") == NULL && R_Path_size(path) == 0);
+  assert(R_Path_compile(path, "orders[x]") == NULL);
+  assert(R_Path_compile(path, "orders[01]") == NULL);
+  assert(R_Path_compile(path, "orders[1") == NULL);
+  assert(R_Path_compile(path, "orders..id") == NULL);
+  assert(R_Path_compile(path, "orders[0]id") == NULL);
+  R_Path* copy = R_Type_Copy(R_Path_compile(path, "orders[1].id"));
+  assert(R_Path_size(copy) == 3);
+  R_Type_Delete(copy);
+  R_Type_Delete(path);
+}
+
+static void test_tree(uint32_t options) {
+  R_Dictionary* dict = test_dictionary(options);
+  R_Path* path = R_Type_New(R_Path);
+  R_MutableString* found = R_Type_New(R_MutableString);
+
+  assert(R_Path_get(R_Path_compile(path, ""), dict) == dict);
+  assert(R_Integer_get(R_Path_get(R_Path_compile(path, "/orders/1/id"), dict)) == 2);
+  assert(R_Integer_get(R_Path_get(R_Path_compile(path, "orders[1].id"), dict)) == 2);
+  assert(R_Integer_get(R_Path_get(R_Path_compile(path, "orders.1.id"), dict)) == 2);
+  assert(R_Integer_get(R_Path_get(R_Path_compile(path, "count"), dict)) == 2);
+  assert(R_Boolean_get(R_Path_get(R_Path_compile(path, "/orders/1/a~1b/m~0n"), dict)));
+  assert(R_Type_IsOf(R_Path_get(R_Path_compile(path, "orders[1][\"odd \\\"key\\\"\"]"), dict), R_List));
+  assert(R_Path_get(R_Path_compile(path, "orders[2].id"), dict) == NULL);
+  assert(R_Path_get(R_Path_compile(path, "count.id"), dict) == NULL);
+  assert(R_Path_get(R_Path_compile(path, "orders.id"), dict) == NULL);
+  assert(R_Path_get(R_Path_compile(path, "empty[0]"), dict) == NULL);
+
+  R_Path_compile(path, "orders[*].line_items[*].price");
+  assert(R_Path_each(path, dict, test_collect, found) == 3);
+  assert(R_MutableString_compare(found, "1.50;2.25;9.99;"));
+  assert(R_MutableString_compare(R_Path_get(path, dict), "1.50"));
+  assert(R_Path_each(R_Path_compile(path, "none[*]"), dict, test_collect, found) == 0);
+  assert(R_Path_each(R_Path_compile(path, "orders[1].line_items[0].*"), dict, test_collect, R_MutableString_reset(found)) == 2);
+  assert(R_MutableString_compare(found, "9.99;x;"));
+  assert(R_Integer_get(R_Path_get(R_Path_compile(path, "[1].id"), R_Dictionary_get(dict, "orders"))) == 2);
+
+  R_Type_Delete(found);
+  R_Type_Delete(path);
+  R_Type_Delete(dict);
+}
+
+void test_dictionary_tree(void) {
+  test_tree(R_Dictionary_JsonOption_None);
+}
+
+void test_lazy_tree(void) {
+  test_tree(R_Dictionary_JsonOption_Lazy);
+}
+
+void test_raw_json(void) {
+  R_MutableString* json = R_MutableString_setString(R_Type_New(R_MutableString), test_document);
+  R_Path* path = R_Type_New(R_Path);
+  R_MutableString* found = R_Type_New(R_MutableString);
+
+  assert(R_Path_getJson(R_Path_compile(path, "/orders/1/id"), json, found) == found);
+  assert(R_MutableString_compare(found, "2"));
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "orders[0].line_items"), json, found), "[{\"price\": \"1.50\"}, {\"price\": \"2.25\"}]"));
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "/orders/1/a~1b/m~0n"), json, found), "true"));
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "orders[1][\"odd \\\"key\\\"\"][1]"), json, found), "2"));
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "empty"), json, found), "{}"));
+  assert(R_Path_getJson(R_Path_compile(path, "orders[2]"), json, found) == NULL);
+  assert(R_Path_getJson(R_Path_compile(path, "count[0]"), json, found) == NULL);
+
+  R_Path_compile(path, "orders[*].line_items[*].price");
+  assert(R_Path_eachJson(path, json, test_collectJson, R_MutableString_reset(found)) == 3);
+  assert(R_MutableString_compare(found, "\"1.50\";\"2.25\";\"9.99\";"));
+
+  R_MutableString_setString(json, "{\"a\": [1, 2], \"b\": {\"c\": ");
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "a[1]"), json, found), "2"));
+  assert(R_Path_getJson(R_Path_compile(path, "b.c"), json, found) == NULL);
+  assert(R_Path_getJson(R_Path_compile(path, "b.d"), json, found) == NULL);
+
+  //Keys are matched after decoding \u escapes, surrogate pairs included, the way R_Dictionary_fromJson reads them
+  R_MutableString_setString(json, "{\"caf\\u00e9\": 1, \"\\ud83d\\ude00\": 2, \"\\u0041B\": 3}");
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "[\"caf\xc3\xa9\"]"), json, found), "1"));
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "[\"\xf0\x9f\x98\x80\"]"), json, found), "2"));
+  assert(R_MutableString_compare(R_Path_getJson(R_Path_compile(path, "AB"), json, found), "3"));
+  assert(R_Path_getJson(R_Path_compile(path, "caf"), json, found) == NULL);
+
+  R_Type_Delete(found);
+  R_Type_Delete(path);
+  R_Type_Delete(json);
+}
+
+int main(void) {
+  test_compile();
+  test_dictionary_tree();
+  test_lazy_tree();
+  test_raw_json();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
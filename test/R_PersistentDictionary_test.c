@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "R_PersistentDictionary.h"
+
+static bool test_count(R_KeyValuePair* pair, void* context) {
+  (*(int*)context)++;
+  return true;
+}
+
+void test_set_get(void) {
+  R_PersistentDictionary* empty = R_Type_New(R_PersistentDictionary);
+  R_PersistentDictionary* one = R_PersistentDictionary_setInteger(empty, "a", 1);
+  R_PersistentDictionary* two = R_PersistentDictionary_setFloat(one, "b", 2.5);
+  R_PersistentDictionary* three = R_PersistentDictionary_setBoolean(two, "c", true);
+  R_PersistentDictionary* four = R_PersistentDictionary_setNull(three, "d");
+  R_PersistentDictionary* replaced = R_PersistentDictionary_setInteger(four, "a", 10);
+
+  assert(R_PersistentDictionary_size(empty) == 0 && R_PersistentDictionary_size(one) == 1);
+  assert(R_PersistentDictionary_size(four) == 4 && R_PersistentDictionary_size(replaced) == 4);
+  assert(!R_PersistentDictionary_isPresent(empty, "a") && R_PersistentDictionary_isPresent(one, "a"));
+  assert(R_PersistentDictionary_getInteger(one, "a") == 1 && R_PersistentDictionary_getInteger(replaced, "a") == 10);
+  assert(R_PersistentDictionary_getInteger(four, "a") == 1);
+  assert(R_PersistentDictionary_getFloat(four, "b") == 2.5);
+  assert(R_PersistentDictionary_getBoolean(four, "c") == true);
+  assert(R_Type_IsOf(R_PersistentDictionary_get(four, "d"), R_Null));
+  assert(R_PersistentDictionary_get(three, "d") == NULL && R_PersistentDictionary_getInteger(four, "b") == 0);
+
+  R_MutableString* string = R_MutableString_setString(R_Type_New(R_MutableString), "value");
+  R_PersistentDictionary* with_string = R_PersistentDictionary_set(replaced, "e", string);
+  assert(R_PersistentDictionary_get(with_string, "e") == string);
+
+  R_Type_Delete(with_string);
+  R_Type_Delete(replaced);
+  R_Type_Delete(four);
+  R_Type_Delete(three);
+  R_Type_Delete(two);
+  R_Type_Delete(one);
+  R_Type_Delete(empty);
+}
+
+void test_many(void) {
+  //Enough keys to fill several levels, and to make hash collisions between keys likely
+  const int count = 20000;
+  char key[16];
+  R_PersistentDictionary* dictionary = R_Type_New(R_PersistentDictionary);
+  R_PersistentDictionary* half = NULL;
+  for (int i=0; i<count; i++) {
+    snprintf(key, sizeof(key), "key%d", i);
+    R_PersistentDictionary* next = R_PersistentDictionary_setInteger(dictionary, key, i);
+    assert(next != NULL);
+    R_Type_Delete(dictionary);
+    dictionary = next;
+    if (i == count/2-1) half = R_Type_Copy(dictionary);
+  }
+  assert(R_PersistentDictionary_size(dictionary) == count && R_PersistentDictionary_size(half) == count/2);
+  for (int i=0; i<count; i++) {
+    snprintf(key, sizeof(key), "key%d", i);
+    assert(R_PersistentDictionary_getInteger(dictionary, key) == i);
+    assert(R_PersistentDictionary_isPresent(half, key) == (i < count/2));
+  }
+  int visited = 0;
+  assert(R_PersistentDictionary_each(dictionary, test_count, &visited) == count && visited == count);
+
+  //Remove the even keys from a new version
+  R_PersistentDictionary* odd = R_Type_Copy(dictionary);
+  for (int i=0; i<count; i+=2) {
+    snprintf(key, sizeof(key), "key%d", i);
+    R_PersistentDictionary* next = R_PersistentDictionary_remove(odd, key);
+    R_Type_Delete(odd);
+    odd = next;
+  }
+  R_PersistentDictionary* unchanged = R_PersistentDictionary_remove(odd, "missing");
+  assert(R_PersistentDictionary_size(odd) == count/2 && R_PersistentDictionary_size(unchanged) == count/2);
+  for (int i=0; i<count; i++) {
+    snprintf(key, sizeof(key), "key%d", i);
+    assert(R_PersistentDictionary_isPresent(odd, key) == (i % 2 == 1));
+    assert(R_PersistentDictionary_getInteger(dictionary, key) == i);
+  }
+
+  R_Type_Delete(unchanged);
+  R_Type_Delete(odd);
+  R_Type_Delete(half);
+  R_Type_Delete(dictionary);
+}
+
+void test_convert(void) {
+  R_Dictionary* source = R_Type_New(R_Dictionary);
+  R_MutableString* json = R_MutableString_setString(R_Type_New(R_MutableString), "{\"name\":\"test\",\"count\":3,\"inner\":{\"flag\":true},\"items\":[1,2,{\"x\":null}]}");
+  assert(R_Dictionary_fromJson(source, json) == source);
+
+  R_PersistentDictionary* empty = R_Type_New(R_PersistentDictionary);
+  R_PersistentDictionary* dictionary = R_PersistentDictionary_fromDictionary(empty, source);
+  assert(R_PersistentDictionary_size(empty) == 0 && R_PersistentDictionary_size(dictionary) == 4);
+  assert(R_PersistentDictionary_getInteger(dictionary, "count") == 3);
+  assert(R_MutableString_compare(R_PersistentDictionary_get(dictionary, "name"), "test"));
+  R_PersistentDictionary* inner = R_PersistentDictionary_get(dictionary, "inner");
+  assert(R_Type_IsOf(inner, R_PersistentDictionary) && R_PersistentDictionary_getBoolean(inner, "flag"));
+  R_PersistentList* items = R_PersistentDictionary_get(dictionary, "items");
+  assert(R_Type_IsOf(items, R_PersistentList) && R_PersistentList_size(items) == 3);
+  assert(R_Type_IsOf(R_PersistentList_get(items, 2), R_PersistentDictionary));
+
+  //Updating a nested dictionary means setting a new version of it
+  R_PersistentDictionary* new_inner = R_PersistentDictionary_setBoolean(inner, "flag", false);
+  R_PersistentDictionary* updated = R_PersistentDictionary_set(dictionary, "inner", new_inner);
+  assert(R_PersistentDictionary_getBoolean(inner, "flag") && !R_PersistentDictionary_getBoolean(R_PersistentDictionary_get(updated, "inner"), "flag"));
+  assert(R_PersistentDictionary_get(updated, "items") == items);
+
+  R_MutableString* output = R_PersistentDictionary_toJsonWithOptions(updated, R_Type_New(R_MutableString), R_Dictionary_JsonOutput_SortedKeys);
+  assert(R_MutableString_compare(output, "{\"count\":3,\"inner\":{\"flag\":false},\"items\":[1,2,{\"x\":null}],\"name\":\"test\"}"));
+
+  R_Dictionary* back = R_PersistentDictionary_toDictionary(dictionary, R_Type_New(R_Dictionary));
+  assert(back != NULL && R_Dictionary_size(back) == 4 && R_Dictionary_getInteger(back, "count") == 3);
+  assert(R_Type_IsOf(R_Dictionary_get(back, "inner"), R_Dictionary) && R_Type_IsOf(R_Dictionary_get(back, "items"), R_List));
+
+  R_PersistentDictionary* parsed = R_PersistentDictionary_fromJson(empty, json);
+  assert(parsed != NULL && R_PersistentDictionary_size(parsed) == 4);
+  assert(R_PersistentDictionary_fromJson(empty, NULL) == NULL);
+
+  R_Type_Delete(parsed);
+  R_Type_Delete(back);
+  R_Type_Delete(output);
+  R_Type_Delete(updated);
+  R_Type_Delete(dictionary);
+  R_Type_Delete(empty);
+  R_Type_Delete(json);
+  R_Type_Delete(source);
+}
+
+int main(void) {
+  test_set_get();
+  test_many();
+  test_convert();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
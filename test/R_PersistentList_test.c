@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include "R_PersistentList.h"
+#include "R_PersistentDictionary.h"
+
+static R_Integer* test_integer(int value) {
+  return R_Integer_set(R_Type_New(R_Integer), value);
+}
+
+static bool test_sum(void* object, void* context) {
+  *(long*)context += R_Integer_get(object);
+  return true;
+}
+
+static bool test_stopAtTen(void* object, void* context) {
+  return R_Integer_get(object) < 10;
+}
+
+void test_append_get(void) {
+  //Enough elements for a tree three levels deep under the root
+  const int count = 40000;
+  R_PersistentList* list = R_Type_New(R_PersistentList);
+  R_PersistentList* at100 = NULL;
+  for (int i=0; i<count; i++) {
+    R_PersistentList* next = R_PersistentList_append(list, test_integer(i));
+    assert(next != NULL && next != list);
+    R_Type_Delete(list);
+    list = next;
+    if (i == 99) at100 = R_Type_Copy(list);
+  }
+  assert(R_PersistentList_size(list) == count && R_PersistentList_size(at100) == 100);
+  for (int i=0; i<count; i++) assert(R_Integer_get(R_PersistentList_get(list, i)) == i);
+  assert(R_PersistentList_get(list, count) == NULL && R_PersistentList_get(at100, 100) == NULL);
+  //The snapshot shares its elements with the newest version
+  assert(R_PersistentList_get(at100, 42) == R_PersistentList_get(list, 42));
+
+  long sum = 0;
+  assert(R_PersistentList_each(list, test_sum, &sum) == count && sum == (long)count*(count-1)/2);
+  assert(R_PersistentList_each(list, test_stopAtTen, NULL) == 11);
+
+  R_Type_Delete(at100);
+  R_Type_Delete(list);
+}
+
+void test_set_pop(void) {
+  R_PersistentList* list = R_Type_New(R_PersistentList);
+  for (int i=0; i<1100; i++) {
+    R_PersistentList* next = R_PersistentList_append(list, test_integer(i));
+    R_Type_Delete(list);
+    list = next;
+  }
+
+  R_PersistentList* changed = R_PersistentList_set(list, 5, test_integer(-5));
+  R_PersistentList* changed_tail = R_PersistentList_set(changed, 1099, test_integer(-1099));
+  assert(R_Integer_get(R_PersistentList_get(list, 5)) == 5 && R_Integer_get(R_PersistentList_get(changed, 5)) == -5);
+  assert(R_Integer_get(R_PersistentList_get(changed, 1099)) == 1099 && R_Integer_get(R_PersistentList_get(changed_tail, 1099)) == -1099);
+  assert(R_Integer_get(R_PersistentList_get(changed_tail, 5)) == -5);
+  assert(R_PersistentList_get(changed, 6) == R_PersistentList_get(list, 6));
+  assert(R_PersistentList_set(list, 1100, test_integer(0)) == NULL);
+
+  //Pop everything off a copy, checking the original is never touched
+  R_PersistentList* popped = R_Type_Copy(list);
+  for (size_t size=1100; size>0; size--) {
+    assert(R_PersistentList_size(popped) == size && R_Integer_get(R_PersistentList_get(popped, size-1)) == (int)size-1);
+    R_PersistentList* next = R_PersistentList_pop(popped);
+    R_Type_Delete(popped);
+    popped = next;
+  }
+  assert(R_PersistentList_size(popped) == 0 && R_PersistentList_pop(popped) == NULL);
+  for (int i=0; i<1100; i++) assert(R_Integer_get(R_PersistentList_get(list, i)) == i);
+
+  //A popped list can grow again
+  R_PersistentList* regrown = R_PersistentList_append(popped, test_integer(7));
+  assert(R_PersistentList_size(regrown) == 1 && R_Integer_get(R_PersistentList_get(regrown, 0)) == 7);
+
+  R_Type_Delete(regrown);
+  R_Type_Delete(popped);
+  R_Type_Delete(changed_tail);
+  R_Type_Delete(changed);
+  R_Type_Delete(list);
+}
+
+void test_convert(void) {
+  R_List* source = R_Type_New(R_List);
+  for (int i=0; i<70; i++) R_List_transferOwnership(source, test_integer(i));
+  R_Dictionary* nested = R_List_add(source, R_Dictionary);
+  R_Dictionary_setInteger(nested, "a", 1);
+  R_MutableString_setString(R_List_add(source, R_MutableString), "text");
+
+  R_PersistentList* empty = R_Type_New(R_PersistentList);
+  R_PersistentList* list = R_PersistentList_fromList(empty, source);
+  assert(R_PersistentList_size(empty) == 0 && R_PersistentList_size(list) == 72);
+  assert(R_Integer_get(R_PersistentList_get(list, 69)) == 69);
+  assert(R_Type_IsOf(R_PersistentList_get(list, 70), R_PersistentDictionary));
+  assert(R_PersistentDictionary_getInteger(R_PersistentList_get(list, 70), "a") == 1);
+  assert(R_MutableString_compare(R_PersistentList_get(list, 71), "text"));
+
+  R_List* back = R_PersistentList_toList(list, R_Type_New(R_List));
+  assert(back != NULL && R_List_size(back) == 72);
+  assert(R_Type_IsOf(R_List_pointerAtIndex(back, 70), R_Dictionary) && R_Dictionary_getInteger(R_List_pointerAtIndex(back, 70), "a") == 1);
+
+  char buffer[32];
+  size_t length = R_Stringify(list, buffer, sizeof(buffer));
+  assert(length > 0 && strncmp(buffer, "Persistent list of 72:\n0\n", length < 25 ? length : 25) == 0);
+
+  R_Type_Delete(back);
+  R_Type_Delete(list);
+  R_Type_Delete(empty);
+  R_Type_Delete(source);
+}
+
+int main(void) {
+  test_append_get();
+  test_set_pop();
+  test_convert();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "R_OS.h"
+#include "R_Dictionary.h"
+#include "R_Queue.h"
+
+#define test_PRODUCERS 4
+#define test_CONSUMERS 4
+#define test_RECORDS 5000
+
+static R_Integer* test_integer(int value) {
+  return R_Integer_set(R_Type_New(R_Integer), value);
+}
+
+void test_push_pop(void) {
+  R_Queue* queue = R_Type_New(R_Queue);
+  assert(R_Queue_capacity(queue) == 256 && R_Queue_size(queue) == 0);
+  assert(R_Queue_setCapacity(queue, 5) == queue && R_Queue_capacity(queue) == 8);
+  assert(R_Queue_pop(queue) == NULL);
+
+  for (int i=0; i<8; i++) assert(R_Queue_push(queue, test_integer(i)));
+  R_Integer* extra = test_integer(8);
+  assert(!R_Queue_push(queue, extra) && R_Queue_size(queue) == 8);
+  assert(R_Queue_setCapacity(queue, 16) == NULL);
+
+  //Wrap around the ring a few times, checking the order
+  for (int i=0; i<20; i++) {
+    R_Integer* value = R_Queue_pop(queue);
+    assert(value != NULL && R_Integer_get(value) == i);
+    R_Type_Delete(value);
+    assert(R_Queue_push(queue, test_integer(i + 8)));
+  }
+  assert(R_Queue_size(queue) == 8);
+
+  R_Queue_close(queue);
+  assert(R_Queue_isClosed(queue) && !R_Queue_push(queue, extra) && !R_Queue_pushWait(queue, extra));
+  R_Integer* value = R_Queue_popWait(queue);
+  assert(value != NULL && R_Integer_get(value) == 20);
+  R_Type_Delete(value);
+  R_Type_Delete(extra);
+
+  //The queue deletes what's left in it
+  R_Type_Delete(queue);
+}
+
+typedef struct {
+  R_Queue* queue;
+  size_t* producers_left;
+  int thread;
+  long sum;
+  int count;
+} test_Context;
+
+/*  test_stage
+    The first threads produce dictionaries, the rest consume them until the queue closes. The last producer to
+   finish closes it.
+ */
+static void test_stage(void* argument) {
+  test_Context* context = argument;
+  if (context->thread < test_PRODUCERS) {
+    for (int i=0; i<test_RECORDS; i++) {
+      R_Dictionary* record = R_Type_New(R_Dictionary);
+      R_Dictionary_setInteger(record, "id", context->thread*test_RECORDS + i);
+      assert(R_Queue_pushWait(context->queue, record));
+    }
+    if (__atomic_sub_fetch(context->producers_left, 1, __ATOMIC_ACQ_REL) == 0) R_Queue_close(context->queue);
+    return;
+  }
+  R_Dictionary* record = NULL;
+  while ((record = R_Queue_popWait(context->queue)) != NULL) {
+    context->sum += R_Dictionary_getInteger(record, "id");
+    context->count++;
+    R_Type_Delete(record);
+  }
+}
+
+void test_threads(void) {
+  R_Queue* queue = R_Queue_setCapacity(R_Type_New(R_Queue), 64);
+  size_t producers_left = test_PRODUCERS;
+  test_Context contexts[test_PRODUCERS + test_CONSUMERS];
+  void* arguments[test_PRODUCERS + test_CONSUMERS];
+  for (int i=0; i<test_PRODUCERS + test_CONSUMERS; i++) {
+    contexts[i] = (test_Context){queue, &producers_left, i, 0, 0};
+    arguments[i] = &contexts[i];
+  }
+  R_OS_parallelRun(test_stage, arguments, test_PRODUCERS + test_CONSUMERS);
+
+  long sum = 0;
+  int count = 0;
+  for (int i=test_PRODUCERS; i<test_PRODUCERS + test_CONSUMERS; i++) {
+    sum += contexts[i].sum;
+    count += contexts[i].count;
+  }
+  const long total = test_PRODUCERS*test_RECORDS;
+  assert(count == total && sum == total*(total - 1)/2);
+  assert(R_Queue_size(queue) == 0);
+  R_Type_Delete(queue);
+}
+
+int main(void) {
+  test_push_pop();
+  test_threads();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
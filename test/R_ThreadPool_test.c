@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "R_OS.h"
+#include "R_List.h"
+#include "R_ThreadPool.h"
+
+#define test_VALUES 100000
+#define test_LEAVES 64
+
+static void test_increment(void* context) {
+  __atomic_add_fetch((int*)context, 1, __ATOMIC_SEQ_CST);
+}
+
+void test_submit(void) {
+  R_ThreadPool* pool = R_Type_New(R_ThreadPool);
+  assert(R_ThreadPool_setThreads(pool, 4) == pool && R_ThreadPool_threads(pool) == 4);
+
+  int counter = 0;
+  R_ThreadPool_Task* task = R_ThreadPool_submit(pool, test_increment, &counter);
+  R_ThreadPool_wait(pool, task);
+  assert(R_ThreadPool_isDone(task) && counter == 1);
+  R_Type_Delete(task);
+
+  //Deleting a handle doesn't cancel its task
+  for (int i=0; i<100; i++) R_Type_Delete(R_ThreadPool_submit(pool, test_increment, &counter));
+  R_ThreadPool_waitAll(pool);
+  assert(counter == 101);
+
+  //Replacing the workers waits for what's queued first
+  for (int i=0; i<100; i++) R_Type_Delete(R_ThreadPool_submit(pool, test_increment, &counter));
+  assert(R_ThreadPool_setThreads(pool, 2) == pool && R_ThreadPool_threads(pool) == 2);
+  assert(counter == 201);
+  R_Type_Delete(pool);
+}
+
+typedef struct {
+  R_ThreadPool* pool;
+  size_t begin;
+  size_t end;
+  long sum;
+} test_Range;
+
+/*  test_sumTree
+    Splits the range in two, summing one half in a new task and the other here, so the tasks wait on each other all
+   the way down.
+ */
+static void test_sumTree(void* argument) {
+  test_Range* range = argument;
+  if (range->end - range->begin <= test_VALUES/test_LEAVES) {
+    for (size_t i=range->begin; i<range->end; i++) range->sum += (long)i;
+    return;
+  }
+  size_t middle = range->begin + (range->end - range->begin)/2;
+  test_Range left = {range->pool, range->begin, middle, 0};
+  test_Range right = {range->pool, middle, range->end, 0};
+  R_ThreadPool_Task* task = R_ThreadPool_submit(range->pool, test_sumTree, &left);
+  test_sumTree(&right);
+  R_ThreadPool_wait(range->pool, task);
+  R_Type_Delete(task);
+  range->sum = left.sum + right.sum;
+}
+
+void test_nested(void) {
+  R_ThreadPool* pool = R_ThreadPool_setThreads(R_Type_New(R_ThreadPool), 3);
+  test_Range range = {pool, 0, test_VALUES, 0};
+  R_ThreadPool_Task* task = R_ThreadPool_submit(pool, test_sumTree, &range);
+  R_ThreadPool_wait(pool, task);
+  R_Type_Delete(task);
+  assert(range.sum == (long)test_VALUES*(test_VALUES - 1)/2);
+  R_Type_Delete(pool);
+}
+
+static void test_square(void* context, size_t begin, size_t end) {
+  long* values = context;
+  for (size_t i=begin; i<end; i++) values[i] = (long)(i*i);
+}
+
+void test_parallelFor(void) {
+  long* values = calloc(test_VALUES, sizeof(long));
+  R_ThreadPool* pool = R_ThreadPool_setThreads(R_Type_New(R_ThreadPool), 4);
+  R_ThreadPool_parallelFor(pool, test_square, values, test_VALUES);
+  for (size_t i=0; i<test_VALUES; i++) assert(values[i] == (long)(i*i));
+
+  //Without workers everything runs on the calling thread
+  assert(R_ThreadPool_setThreads(pool, 0) == pool && R_ThreadPool_threads(pool) == 0);
+  for (size_t i=0; i<test_VALUES; i++) values[i] = 0;
+  R_ThreadPool_parallelFor(pool, test_square, values, test_VALUES);
+  for (size_t i=0; i<test_VALUES; i++) assert(values[i] == (long)(i*i));
+  int counter = 0;
+  R_ThreadPool_Task* task = R_ThreadPool_submit(pool, test_increment, &counter);
+  assert(R_ThreadPool_isDone(task) && counter == 1);
+  R_Type_Delete(task);
+  R_Type_Delete(pool);
+  free(values);
+}
+
+void test_parallelRun(void) {
+  R_ThreadPool* pool = R_ThreadPool_setThreads(R_Type_New(R_ThreadPool), 4);
+  R_ThreadPool_install(pool);
+  assert(R_ThreadPool_installed() == pool);
+
+  int counters[16] = {0};
+  void* contexts[16];
+  for (int i=0; i<16; i++) contexts[i] = &counters[i];
+  R_OS_parallelRun(test_increment, contexts, 16);
+  for (int i=0; i<16; i++) assert(counters[i] == 1);
+
+  //Sorting splits its work with R_OS_parallelRun
+  R_List* list = R_Type_New(R_List);
+  for (int i=0; i<test_VALUES; i++) R_Integer_set(R_List_add(list, R_Integer), (i*7919) % test_VALUES);
+  assert(R_List_parallelSort(list, NULL, 4) == list);
+  for (int i=0; i<test_VALUES; i++) assert(R_Integer_get(R_List_pointerAtIndex(list, i)) == i);
+  R_Type_Delete(list);
+
+  R_ThreadPool_install(NULL);
+  assert(R_ThreadPool_installed() == NULL && R_OS_dispatcher() == NULL);
+  R_Type_Delete(pool);
+}
+
+int main(void) {
+  test_submit();
+  test_nested();
+  test_parallelFor();
+  test_parallelRun();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
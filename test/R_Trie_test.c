@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "R_MutableString.h"
+#include "R_Trie.h"
+
+//Appends every key visited, each followed by a comma
+static bool test_join(const char* key, void* value, void* context) {
+  R_MutableString_appendCString(context, key);
+  R_MutableString_appendCString(context, ",");
+  return true;
+}
+
+static bool test_stopAtThree(const char* key, void* value, void* context) {
+  return ++*(int*)context < 3;
+}
+
+static void test_expectKeys(R_Trie* trie, const char* prefix, const char* keys) {
+  R_MutableString* joined = R_Type_New(R_MutableString);
+  R_Trie_eachWithPrefix(trie, prefix, test_join, joined);
+  assert(R_MutableString_compare(joined, keys));
+  R_Type_Delete(joined);
+}
+
+static int test_value(R_Trie* trie, const char* key) {
+  R_Integer* integer = R_Trie_get(trie, key);
+  assert(integer != NULL);
+  return R_Integer_get(integer);
+}
+
+//Lets allowed more allocations through, then fails every one until it's uninstalled
+static size_t test_allowed = 0;
+static void* test_failing_malloc(void* context, size_t size, const R_Allocator_Site* site) {
+  if (test_allowed == 0) return NULL;
+  test_allowed--;
+  return malloc(size);
+}
+static void* test_failing_zalloc(void* context, size_t size, const R_Allocator_Site* site) {
+  if (test_allowed == 0) return NULL;
+  test_allowed--;
+  return calloc(1, size);
+}
+static void* test_failing_realloc(void* context, void* pointer, size_t old_size, size_t size, const R_Allocator_Site* site) {
+  if (test_allowed == 0) return NULL;
+  test_allowed--;
+  return realloc(pointer, size);
+}
+static void test_failing_free(void* context, void* pointer, size_t size, const R_Allocator_Site* site) {
+  free(pointer);
+}
+static const R_Allocator test_failing = {test_failing_malloc, test_failing_zalloc, test_failing_realloc, test_failing_free, NULL};
+
+void test_split_and_join(void) {
+  R_Trie* trie = R_Type_New(R_Trie);
+  assert(R_Trie_get(trie, "missing") == NULL && !R_Trie_remove(trie, "missing"));
+  R_Integer_set(R_Trie_add(trie, "orders.shipped", R_Integer), 1);
+  size_t one = R_Trie_bytesUsed(trie);
+
+  //A key ending inside another's prefix splits it, and removing the key joins the halves back up
+  R_Integer_set(R_Trie_add(trie, "orders", R_Integer), 2);
+  assert(test_value(trie, "orders") == 2 && test_value(trie, "orders.shipped") == 1);
+  assert(!R_Trie_isPresent(trie, "order") && !R_Trie_isPresent(trie, "orders.") && !R_Trie_isPresent(trie, "orders.shipped.today"));
+  assert(R_Trie_remove(trie, "orders") && R_Trie_bytesUsed(trie) == one);
+
+  //So does a key branching off partway through
+  R_Integer_set(R_Trie_add(trie, "orders.pending", R_Integer), 3);
+  R_Integer_set(R_Trie_add(trie, "", R_Integer), 4);
+  test_expectKeys(trie, "", ",orders.pending,orders.shipped,");
+  assert(R_Trie_remove(trie, "orders.pending") && R_Trie_remove(trie, "") && R_Trie_bytesUsed(trie) == one);
+
+  //Setting a key again replaces its value
+#ifdef R_TYPE_REFCOUNT
+  R_MutableString* shared = R_MutableString_setString(R_Type_New(R_MutableString), "shared");
+  assert(R_Trie_addShared(trie, "orders.shipped", shared) == shared && R_Type_References(shared) == 2);
+  assert(R_Trie_size(trie) == 1 && R_Trie_get(trie, "orders.shipped") == shared);
+  R_MutableString* copy = R_Trie_addCopy(trie, "orders.shipped", shared);
+  assert(copy != shared && R_MutableString_compare(copy, "shared") && R_Type_References(shared) == 1);
+  R_Type_Delete(shared);
+#endif
+
+  R_Trie_removeAll(trie);
+  assert(R_Trie_size(trie) == 0 && R_Trie_get(trie, "orders.shipped") == NULL);
+  R_Type_Delete(trie);
+}
+
+void test_failed_tidy(void) {
+  R_Trie* trie = R_Type_New(R_Trie);
+  R_Trie* joined = R_Type_New(R_Trie);
+  const char* keys[] = {"alpha.one", "alpha.two"};
+  for (int i=0; i<2; i++) {
+    R_Integer_set(R_Trie_add(trie, keys[i], R_Integer), i);
+    R_Integer_set(R_Trie_add(joined, keys[i], R_Integer), i);
+  }
+  assert(R_Trie_remove(joined, "alpha.one"));
+
+  //Without memory for the joined prefix, "alpha." stays a node of its own, with no value and one child
+  R_Allocator_set(&test_failing);
+  assert(R_Trie_remove(trie, "alpha.one"));
+  R_Allocator_set(NULL);
+  assert(R_Trie_bytesUsed(trie) > R_Trie_bytesUsed(joined));
+  assert(R_Trie_size(trie) == 1 && test_value(trie, "alpha.two") == 1);
+  assert(R_Trie_get(trie, "alpha.") == NULL && !R_Trie_remove(trie, "alpha.") && R_Trie_size(trie) == 1);
+  test_expectKeys(trie, "", "alpha.two,");
+  test_expectKeys(trie, "alpha", "alpha.two,");
+  size_t length = 0;
+  assert(R_Trie_longestPrefix(trie, "alpha.", &length) == NULL);
+  assert(R_Integer_get(R_Trie_longestPrefix(trie, "alpha.two.three", &length)) == 1 && length == 9);
+
+  //The node left behind takes a value and children like any other
+  R_Integer_set(R_Trie_add(trie, "alpha.", R_Integer), 2);
+  R_Integer_set(R_Trie_add(trie, "alpha.three", R_Integer), 3);
+  test_expectKeys(trie, "", "alpha.,alpha.three,alpha.two,");
+  assert(R_Trie_remove(trie, "alpha.") && R_Trie_remove(trie, "alpha.two") && R_Trie_remove(trie, "alpha.three"));
+  assert(R_Trie_size(trie) == 0 && R_Trie_get(trie, "alpha.") == NULL);
+  test_expectKeys(trie, "", "");
+
+  //A node that can't shrink keeps its children in the kind it had
+  char key[3] = "k?";
+  for (char byte='a'; byte<='e'; byte++) {
+    key[1] = byte;
+    R_Integer_set(R_Trie_add(trie, key, R_Integer), byte);
+  }
+  assert(R_Trie_remove(trie, "ke"));
+  R_Allocator_set(&test_failing);
+  assert(R_Trie_remove(trie, "kd"));
+  R_Allocator_set(NULL);
+  size_t unshrunk = R_Trie_bytesUsed(trie);
+  test_expectKeys(trie, "k", "ka,kb,kc,");
+  assert(test_value(trie, "kb") == 'b' && R_Trie_get(trie, "kd") == NULL);
+  assert(R_Trie_remove(trie, "kc") && R_Trie_bytesUsed(trie) < unshrunk);
+  test_expectKeys(trie, "", "ka,kb,");
+
+  //A split that can't be allocated leaves the trie as it was
+  R_MutableString* value = R_Type_New(R_MutableString);
+  size_t before = R_Trie_bytesUsed(trie);
+  R_Allocator_set(&test_failing);
+  assert(R_Trie_transferOwnership(trie, "j", value) == NULL);
+  test_allowed = 1;
+  assert(R_Trie_transferOwnership(trie, "kab", value) == NULL);
+  test_allowed = 0;
+  R_Allocator_set(NULL);
+  assert(R_Trie_size(trie) == 2 && R_Trie_bytesUsed(trie) == before);
+  test_expectKeys(trie, "", "ka,kb,");
+  R_Type_Delete(value);
+
+  R_Type_Delete(joined);
+  R_Type_Delete(trie);
+}
+
+void test_copy_node48(void) {
+  R_Trie* trie = R_Type_New(R_Trie);
+  char key[3] = "n?";
+  //Thirty children make a Node48. Removing every third leaves gaps in its slots, which the next two fill
+  for (int i=0; i<30; i++) {
+    key[1] = (char)('A' + i);
+    R_Integer_set(R_Trie_add(trie, key, R_Integer), i);
+  }
+  for (int i=0; i<30; i+=3) {
+    key[1] = (char)('A' + i);
+    assert(R_Trie_remove(trie, key));
+  }
+  R_Integer_set(R_Trie_add(trie, "nz", R_Integer), 100);
+  R_Integer_set(R_Trie_add(trie, "na", R_Integer), 101);
+
+  R_Trie* copy = R_Type_Copy(trie);
+  assert(copy != NULL && R_Trie_size(copy) == 22 && R_Trie_bytesUsed(copy) == R_Trie_bytesUsed(trie));
+  R_MutableString* expected = R_Type_New(R_MutableString);
+  for (int i=0; i<30; i++) {
+    if (i % 3 == 0) continue;
+    key[1] = (char)('A' + i);
+    R_MutableString_appendCString(R_MutableString_appendCString(expected, key), ",");
+  }
+  R_MutableString_appendCString(expected, "na,nz,");
+  test_expectKeys(copy, "", R_MutableString_getString(expected));
+
+  //The copy has values of its own, and doesn't notice the original emptying
+  assert(R_Trie_get(copy, "nB") != R_Trie_get(trie, "nB"));
+  for (int i=0; i<30; i++) {
+    key[1] = (char)('A' + i);
+    R_Trie_remove(trie, key);
+  }
+  R_Trie_remove(trie, "na");
+  R_Trie_remove(trie, "nz");
+  assert(R_Trie_size(trie) == 0);
+  test_expectKeys(copy, "", R_MutableString_getString(expected));
+  assert(test_value(copy, "nB") == 1 && test_value(copy, "na") == 101 && test_value(copy, "nz") == 100);
+  assert(R_Trie_get(copy, "nA") == NULL);
+
+  R_Type_Delete(expected);
+  R_Type_Delete(copy);
+  R_Type_Delete(trie);
+}
+
+void test_longest_prefix(void) {
+  R_Trie* routes = R_Type_New(R_Trie);
+  R_Integer_set(R_Trie_add(routes, "/", R_Integer), 1);
+  R_Integer_set(R_Trie_add(routes, "/api", R_Integer), 2);
+  //Longer than fits in a node, so the prefix below "/api/" is kept in a buffer
+  R_Integer_set(R_Trie_add(routes, "/api/v1/orders/items", R_Integer), 3);
+  R_Integer_set(R_Trie_add(routes, "/api/v1/orders/lines", R_Integer), 4);
+
+  size_t length = 0;
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "/api/v1/orders/items/42", &length)) == 3 && length == 20);
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "/api/v1/orders/lines", &length)) == 4 && length == 20);
+  //Strings ending inside a compressed prefix, or turning off partway through one, match the key above it
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "/api/v1/ord", &length)) == 2 && length == 4);
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "/api/v1/orders/ite", &length)) == 2 && length == 4);
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "/api/v2/orders/items", &length)) == 2 && length == 4);
+  //"/api/v1/orders/" is only where the two routes branch, not a key
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "/api/v1/orders/", &length)) == 2 && length == 4);
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "/ap", &length)) == 1 && length == 1);
+  assert(R_Trie_longestPrefix(routes, "api", &length) == NULL && R_Trie_longestPrefix(routes, "", NULL) == NULL);
+  R_Integer_set(R_Trie_add(routes, "", R_Integer), 0);
+  assert(R_Integer_get(R_Trie_longestPrefix(routes, "api", &length)) == 0 && length == 0);
+  R_Type_Delete(routes);
+}
+
+void test_wide_nodes(void) {
+  R_Trie* trie = R_Type_New(R_Trie);
+  R_MutableString* expected = R_Type_New(R_MutableString);
+  char key[3] = "x?";
+  //Every byte after x, so the node under x grows through each kind up to 256 children and back down
+  for (int byte=1; byte<256; byte++) {
+    key[1] = (char)byte;
+    R_Integer_set(R_Trie_add(trie, key, R_Integer), byte);
+    R_MutableString_appendCString(R_MutableString_appendCString(expected, key), ",");
+  }
+  assert(R_Trie_size(trie) == 255);
+  test_expectKeys(trie, "x", R_MutableString_getString(expected));
+  for (int byte=255; byte>1; byte--) {
+    key[1] = (char)byte;
+    assert(R_Trie_remove(trie, key));
+    for (int other=1; other<byte; other+=37) {
+      key[1] = (char)other;
+      assert(test_value(trie, key) == other);
+    }
+  }
+  assert(R_Trie_size(trie) == 1 && test_value(trie, "x\x01") == 1);
+  R_Type_Delete(expected);
+  R_Type_Delete(trie);
+}
+
+void test_prefixes(void) {
+  R_Trie* trie = R_Type_New(R_Trie);
+  const char* prefix = "tenants/acme/regions/europe-west/services/orders/customers/";
+  char key[80];
+  for (int i=0; i<1000; i++) {
+    snprintf(key, sizeof(key), "%s%04d", prefix, i);
+    R_Integer_set(R_Trie_add(trie, key, R_Integer), i);
+  }
+  //The shared part is stored once, so the nodes take less than the keys would on their own
+  assert(R_Trie_bytesUsed(trie) < 1000*strlen(prefix));
+
+  int calls = 0;
+  assert(R_Trie_eachWithPrefix(trie, prefix, test_stopAtThree, &calls) == 3 && calls == 3);
+  calls = 0;
+  //A prefix ending partway through a node's own prefix still finds the node's keys
+  assert(R_Trie_eachWithPrefix(trie, "tenants/acme/reg", test_stopAtThree, &calls) == 3);
+  snprintf(key, sizeof(key), "%s099", prefix);
+  calls = 0;
+  assert(R_Trie_eachWithPrefix(trie, key, test_stopAtThree, &calls) == 3);
+  snprintf(key, sizeof(key), "%s0999", prefix);
+  test_expectKeys(trie, key, "tenants/acme/regions/europe-west/services/orders/customers/0999,");
+  snprintf(key, sizeof(key), "%s09999", prefix);
+  test_expectKeys(trie, key, "");
+  test_expectKeys(trie, "tenants/acme/regions/asia", "");
+  R_Type_Delete(trie);
+}
+
+int main(void) {
+  test_split_and_join();
+  test_failed_tidy();
+  test_copy_node48();
+  test_longest_prefix();
+  test_wide_nodes();
+  test_prefixes();
+  assert(R_Type_BytesAllocated == 0);
+  printf("Pass\n");
+}
@@ -14,6 +14,8 @@ typedef struct Testor ConstructorTestor;
 typedef struct Testor DestructorTestor;
 typedef struct Testor CopierTestor;
 typedef struct Testor FullTestor;
+typedef struct Testor MoverTestor;
+typedef struct Testor BadMoverTestor;
 
 int Testor_Constructor_Called = 0;
 Testor* Testor_Constructor(Testor* testor) {
@@ -41,6 +43,20 @@ R_Type_Def(DestructorTestor, NULL, Testor_Destructor, NULL, NULL);
 R_Type_Def(CopierTestor, NULL, NULL, Testor_Copier, NULL);
 R_Type_Def(FullTestor, Testor_Constructor, Testor_Destructor, Testor_Copier, NULL);
 
+int Testor_Mover_Called = 0;
+Testor* Testor_Mover(Testor* testor, Testor* new_testor) {
+  Testor_Mover_Called++;
+  new_testor->test = testor->test;
+  testor->test = 0;
+  return new_testor;
+}
+R_Type_Define(MoverTestor, .copy = (R_Type_Copier)Testor_Copier, .move = (R_Type_Mover)Testor_Mover);
+
+Testor* BadMoverTestor_Mover(Testor* testor, Testor* new_testor) {
+  return NULL;
+}
+R_Type_Define(BadMoverTestor, .copy = (R_Type_Copier)Testor_Copier, .move = (R_Type_Mover)BadMoverTestor_Mover);
+
 void test_simple(void) {
   assert(R_Type_Object(Testor)->size == sizeof(Testor));
   assert(R_Type_Object(Testor)->ctor == NULL);
@@ -190,6 +206,65 @@ void test_bad_constructor(void) {
   assert(BadConstructorTestor_Destructor_Called);
 }
 
+void test_mover(void) {
+  assert(R_Type_Object(MoverTestor)->move == (R_Type_Mover)Testor_Mover);
+  assert(R_Type_Object(FullTestor)->move == NULL);
+  int copies = Testor_Copier_Called;
+
+  Testor* testor = R_Type_New(MoverTestor);
+  testor->test = 7;
+  Testor* moved = R_Type_Move(testor);
+  assert(Testor_Mover_Called == 1 && Testor_Copier_Called == copies);
+  assert(moved != testor && moved->test == 7 && testor->test == 0);
+  assert(R_Type_BytesAllocated == 2*sizeof(Testor));
+  R_Type_Delete(moved);
+  R_Type_Delete(testor);
+
+  //Without a mover, the object is copied and left alone
+  testor = R_Type_New(CopierTestor);
+  testor->test = 8;
+  moved = R_Type_Move(testor);
+  assert(Testor_Copier_Called == copies + 1);
+  assert(moved->test == 8 && testor->test == 8);
+  R_Type_Delete(moved);
+  R_Type_Delete(testor);
+  assert(R_Type_Move(NULL) == NULL);
+
+  //A failed move frees the object it was moving into
+  testor = R_Type_New(BadMoverTestor);
+  assert(R_Type_Move(testor) == NULL && R_Type_BytesAllocated == sizeof(Testor));
+  R_Type_Delete(testor);
+}
+
+#ifdef R_TYPE_REFCOUNT
+void test_retain(void) {
+  int destructed = Testor_Destructor_Called;
+  Testor* testor = R_Type_New(FullTestor);
+  assert(R_Type_References(testor) == 1 && !R_Type_IsShared(testor));
+  assert(R_Type_Retain(testor) == testor && R_Type_Retain(testor) == testor);
+  assert(R_Type_References(testor) == 3 && R_Type_IsShared(testor));
+
+  R_Type_Release(testor);
+  R_Type_Delete(testor);
+  assert(Testor_Destructor_Called == destructed && R_Type_BytesAllocated == sizeof(Testor));
+  assert(testor->test == 42 && R_Type_References(testor) == 1);
+
+  //A shared object is copied rather than emptied by a move
+  MoverTestor* mover = R_Type_Retain(R_Type_New(MoverTestor));
+  mover->test = 9;
+  int moves = Testor_Mover_Called;
+  Testor* moved = R_Type_Move(mover);
+  assert(Testor_Mover_Called == moves && moved->test == 9 && mover->test == 9);
+  R_Type_Delete(moved);
+  R_Type_Release(mover);
+  R_Type_Release(mover);
+
+  R_Type_Release(testor);
+  assert(Testor_Destructor_Called == destructed + 1);
+  assert(R_Type_Retain(NULL) == NULL && R_Type_References(NULL) == 0);
+}
+#endif
+
 int main(void) {
   test_simple();
   test_constructor();
@@ -197,6 +272,10 @@ int main(void) {
   test_copier();
   test_full();
   test_bad_constructor();
+  test_mover();
+#ifdef R_TYPE_REFCOUNT
+  test_retain();
+#endif
 
   assert(R_Type_BytesAllocated == 0);
   printf("Pass\n");